@@ -0,0 +1,23 @@
+/**
+ * @file Arduino.h
+ * Host stand-in for the Arduino core.
+ * `lv_conf.h` reads the tick from `millis()` via `LV_TICK_CUSTOM_INCLUDE`,
+ * here it is backed by the virtual clock of the benchmark.
+ */
+
+#ifndef BENCH_ARDUINO_H
+#define BENCH_ARDUINO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+uint32_t millis(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*BENCH_ARDUINO_H*/
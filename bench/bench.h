@@ -0,0 +1,48 @@
+/**
+ * @file bench.h
+ * Shared helpers of the host benchmarks
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <lvgl.h>
+
+/* Statistics gathered by the memory framebuffer's `flush_cb` */
+struct BenchFlushStats
+{
+    uint32_t flush_cnt;
+    uint32_t px_cnt;
+};
+
+/* Frame buffer the display is flushed into (LV_HOR_RES_MAX x LV_VER_RES_MAX) */
+extern lv_color_t bench_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+extern BenchFlushStats bench_flush;
+
+/* Register a display with the same size and draw buffer as the device */
+void benchDisplayInit();
+
+/* Advance the virtual clock returned by `millis()` */
+void benchTickAdvance(uint32_t ms);
+
+/* Monotonic wall clock in microseconds */
+uint64_t benchMicros();
+
+/* CPU cycle counter (time stamp counter on x86, nanoseconds elsewhere) */
+uint64_t benchCycles();
+
+/* Write the frame buffer as a binary PPM image */
+bool benchWritePpm(const char *path);
+
+/* Scenarios */
+int benchDashboard(int argc, char **argv);
+int benchBlend(int argc, char **argv);
+int benchArc(int argc, char **argv);
+int benchMask(int argc, char **argv);
+int benchChart(int argc, char **argv);
+int benchLabel(int argc, char **argv);
+int benchMem(int argc, char **argv);
+int benchTft(int argc, char **argv);
+
+#endif /*BENCH_H*/
@@ -0,0 +1,95 @@
+/**
+ * @file bench_arc.cpp
+ * Benchmark of `lv_draw_arc` across radii, thicknesses and cap styles.
+ * Every arc is drawn strip by strip into the draw buffer, the same way a
+ * refresh of the whole screen would render it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "bench.h"
+
+#define ARC_STRIP_H 10
+#define ARC_RUNS 5
+
+struct ArcCase
+{
+    const char *name;
+    uint16_t radius;
+    lv_coord_t width;
+    uint16_t start_angle;
+    uint16_t end_angle;
+    bool rounded;
+};
+
+static const ArcCase cases[] = {
+    {"r25 w2 270deg", 25, 2, 135, 45, false},
+    {"r62 w5 full ring", 62, 5, 0, 360, false},
+    {"r62 w5 240deg", 62, 5, 120, 0, false},
+    {"r62 w5 240deg round", 62, 5, 120, 0, true},
+    {"r62 w5 60deg", 62, 5, 120, 180, false},
+    {"r110 w20 270deg", 110, 20, 135, 45, false},
+    {"r110 w20 270deg round", 110, 20, 135, 45, true},
+    {"r110 w110 pie 90deg", 110, 110, 0, 90, false},
+};
+
+/* Draw the arc in strips of the draw buffer's height, like `lv_refr` does */
+static void drawOnce(const ArcCase &c, lv_disp_buf_t *vdb)
+{
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = lv_color_hex(0x50ff7d);
+    dsc.width = c.width;
+    dsc.round_start = c.rounded;
+    dsc.round_end = c.rounded;
+
+    lv_coord_t cx = LV_HOR_RES_MAX / 2;
+    lv_coord_t cy = LV_VER_RES_MAX / 2;
+    for (lv_coord_t y = cy - c.radius; y < cy + c.radius; y += ARC_STRIP_H)
+    {
+        lv_area_t strip = {0, y, LV_HOR_RES_MAX - 1, (lv_coord_t)(y + ARC_STRIP_H - 1)};
+        vdb->area = strip;
+        lv_draw_arc(cx, cy, c.radius, c.start_angle, c.end_angle, &strip, &dsc);
+    }
+}
+
+int benchArc(int argc, char **argv)
+{
+    uint32_t iters = argc > 0 ? (uint32_t)atoi(argv[0]) : 2000;
+    if (iters == 0)
+        iters = 1;
+
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_disp_buf_t *vdb = lv_disp_get_buf(disp);
+    _lv_refr_set_disp_refreshing(disp);
+
+    printf("%-24s %10s %10s\n", "case", "us/arc", "cycles/px");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const ArcCase &c = cases[i];
+
+        /* Best of a few runs to filter out the noise of the host */
+        uint64_t cycles = UINT64_MAX;
+        uint64_t us = UINT64_MAX;
+        for (int run = 0; run < ARC_RUNS; run++)
+        {
+            uint64_t t0 = benchMicros();
+            uint64_t c0 = benchCycles();
+            for (uint32_t n = 0; n < iters; n++)
+            {
+                drawOnce(c, vdb);
+            }
+            cycles = std::min(cycles, benchCycles() - c0);
+            us = std::min(us, benchMicros() - t0);
+        }
+
+        /* Normalize to the bounding box of the ring, the area the old mask path evaluated */
+        double px = 4.0 * c.radius * c.radius * iters;
+        printf("%-24s %10.2f %10.2f\n", c.name, (double)us / iters, cycles / px);
+    }
+
+    _lv_refr_set_disp_refreshing(NULL);
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file bench_blend.cpp
+ * Microbenchmark of `_lv_blend_fill` and `_lv_blend_map` on the draw buffer
+ * of the display, with the shapes the dashboard produces most often.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "bench.h"
+
+#define BLEND_BUF_W LV_HOR_RES_MAX
+#define BLEND_BUF_H 10
+#define BLEND_RUNS 5
+
+enum BlendKind
+{
+    BLEND_FILL,
+    BLEND_MAP,
+};
+
+enum BlendMask
+{
+    MASK_NONE,  // LV_DRAW_MASK_RES_FULL_COVER
+    MASK_COVER, // every mask byte is 0xFF (inside of a rounded/clipped shape)
+    MASK_EDGE,  // anti-aliased edges: 0x00, 0xFF and partial values mixed
+};
+
+struct BlendCase
+{
+    const char *name;
+    BlendKind kind;
+    lv_coord_t x1;
+    lv_coord_t w;
+    BlendMask mask;
+    lv_opa_t opa;
+    lv_coord_t map_ofs; // first map pixel; odd values misalign the source
+};
+
+static const BlendCase cases[] = {
+    {"fill opaque 240", BLEND_FILL, 0, 240, MASK_NONE, LV_OPA_COVER, 0},
+    {"fill opaque 7 odd x", BLEND_FILL, 1, 7, MASK_NONE, LV_OPA_COVER, 0},
+    {"fill opa 50%", BLEND_FILL, 0, 240, MASK_NONE, LV_OPA_50, 0},
+    {"fill mask cover", BLEND_FILL, 1, 200, MASK_COVER, LV_OPA_COVER, 0},
+    {"fill mask edge", BLEND_FILL, 0, 200, MASK_EDGE, LV_OPA_COVER, 0},
+    {"fill mask opa 50%", BLEND_FILL, 0, 200, MASK_EDGE, LV_OPA_50, 0},
+    {"map opaque 240", BLEND_MAP, 0, 240, MASK_NONE, LV_OPA_COVER, 0},
+    {"map opaque misalign", BLEND_MAP, 0, 238, MASK_NONE, LV_OPA_COVER, 1},
+    {"map opa 50%", BLEND_MAP, 0, 240, MASK_NONE, LV_OPA_50, 0},
+    {"map mask cover", BLEND_MAP, 1, 200, MASK_COVER, LV_OPA_COVER, 0},
+    {"map mask edge", BLEND_MAP, 0, 200, MASK_EDGE, LV_OPA_COVER, 0},
+};
+
+static lv_color_t map_buf[BLEND_BUF_W * BLEND_BUF_H];
+static lv_opa_t mask_buf[BLEND_BUF_W];
+
+static void fillMask(BlendMask type, lv_coord_t w)
+{
+    for (lv_coord_t i = 0; i < w; i++)
+    {
+        if (type == MASK_EDGE)
+            mask_buf[i] = (i % 16) < 6 ? (lv_opa_t)LV_OPA_COVER : (i % 16) < 10 ? (lv_opa_t)(i * 37) : (lv_opa_t)LV_OPA_TRANSP;
+        else
+            mask_buf[i] = LV_OPA_COVER;
+    }
+}
+
+/* Blend one buffer worth of rows, the same way the draw functions do: masked shapes row by row */
+static void blendOnce(const BlendCase &c)
+{
+    lv_area_t clip = {0, 0, BLEND_BUF_W - 1, BLEND_BUF_H - 1};
+    lv_area_t area = {c.x1, 0, (lv_coord_t)(c.x1 + c.w - 1), BLEND_BUF_H - 1};
+    lv_color_t color = lv_color_hex(0x50ff7d);
+
+    if (c.mask == MASK_NONE)
+    {
+        if (c.kind == BLEND_FILL)
+        {
+            _lv_blend_fill(&clip, &area, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, c.opa, LV_BLEND_MODE_NORMAL);
+        }
+        else
+        {
+            lv_area_t map_area = area;
+            map_area.x1 -= c.map_ofs;
+            map_area.x2 = map_area.x1 + BLEND_BUF_W - 1;
+            _lv_blend_map(&area, &map_area, map_buf, NULL, LV_DRAW_MASK_RES_FULL_COVER, c.opa, LV_BLEND_MODE_NORMAL);
+        }
+        return;
+    }
+
+    for (lv_coord_t y = 0; y < BLEND_BUF_H; y++)
+    {
+        lv_area_t row = {c.x1, y, (lv_coord_t)(c.x1 + c.w - 1), y};
+        if (c.kind == BLEND_FILL)
+        {
+            _lv_blend_fill(&clip, &row, color, mask_buf, LV_DRAW_MASK_RES_CHANGED, c.opa, LV_BLEND_MODE_NORMAL);
+        }
+        else
+        {
+            lv_area_t map_area = {c.x1, y, (lv_coord_t)(c.x1 + c.w - 1), y};
+            _lv_blend_map(&clip, &map_area, map_buf + y * BLEND_BUF_W, mask_buf, LV_DRAW_MASK_RES_CHANGED, c.opa,
+                          LV_BLEND_MODE_NORMAL);
+        }
+    }
+}
+
+int benchBlend(int argc, char **argv)
+{
+    uint32_t px_target = argc > 0 ? (uint32_t)atoi(argv[0]) * 1000000u : 20000000u;
+    if (px_target == 0)
+        px_target = 1000000u;
+
+    /* Draw straight into the draw buffer, as if the refresh of its first 10 rows was running */
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_disp_buf_t *vdb = lv_disp_get_buf(disp);
+    vdb->area.x1 = 0;
+    vdb->area.y1 = 0;
+    vdb->area.x2 = BLEND_BUF_W - 1;
+    vdb->area.y2 = BLEND_BUF_H - 1;
+    _lv_refr_set_disp_refreshing(disp);
+
+    for (uint32_t i = 0; i < BLEND_BUF_W * BLEND_BUF_H; i++)
+    {
+        map_buf[i] = lv_color_make(i * 3, i * 5, i * 7);
+    }
+
+    printf("%-22s %10s %10s\n", "case", "cycles/px", "ns/px");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const BlendCase &c = cases[i];
+        fillMask(c.mask, c.w);
+
+        uint32_t px_per_call = (uint32_t)c.w * BLEND_BUF_H;
+        uint32_t calls = px_target / px_per_call;
+
+        /* Best of a few runs to filter out the noise of the host */
+        uint64_t cycles = UINT64_MAX;
+        uint64_t us = UINT64_MAX;
+        for (int run = 0; run < BLEND_RUNS; run++)
+        {
+            uint64_t t0 = benchMicros();
+            uint64_t c0 = benchCycles();
+            for (uint32_t n = 0; n < calls; n++)
+            {
+                blendOnce(c);
+            }
+            cycles = std::min(cycles, benchCycles() - c0);
+            us = std::min(us, benchMicros() - t0);
+        }
+
+        double px = (double)calls * px_per_call;
+        printf("%-22s %10.2f %10.3f\n", c.name, cycles / px, us * 1000.0 / px);
+    }
+
+    _lv_refr_set_disp_refreshing(NULL);
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file bench_chart.cpp
+ * Benchmark of the chart series: the 220x70 chart of the dashboard is refreshed as a whole
+ * with the same history drawn as a line, a line with the faded area under it, or a min/max envelope.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "bench.h"
+
+#define CHART_RUNS 5
+
+struct ChartCase
+{
+    const char *name;
+    lv_chart_type_t type;
+    uint16_t points;
+    bool area;
+};
+
+static const ChartCase cases[] = {
+    {"line 10", LV_CHART_TYPE_LINE, 10, false},
+    {"line 10 area", LV_CHART_TYPE_LINE, 10, true},
+    {"line 220", LV_CHART_TYPE_LINE, 220, false},
+    {"line 220 area", LV_CHART_TYPE_LINE, 220, true},
+    {"line 1000", LV_CHART_TYPE_LINE, 1000, false},
+    {"line 1000 area", LV_CHART_TYPE_LINE, 1000, true},
+    {"envelope 220", LV_CHART_TYPE_ENVELOPE, 220, false},
+    {"envelope 440", LV_CHART_TYPE_ENVELOPE, 440, false},
+};
+
+/* Bursty traffic: a slowly changing base with short spikes, in KB/s */
+static void syntheticSample(uint32_t i, lv_coord_t &min, lv_coord_t &max, lv_coord_t &mean)
+{
+    uint32_t r = (i * 1103515245u + 12345u) >> 16;
+    mean = 1000 + (lv_coord_t)((i * 13) % 600) + (lv_coord_t)(r % 200);
+    min = mean - 150 - (lv_coord_t)(r % 300);
+    max = r % 23 == 0 ? 3900 : mean + 200 + (lv_coord_t)(r % 400);
+}
+
+static lv_obj_t *createChart(const ChartCase &c)
+{
+    lv_obj_t *chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_obj_set_size(chart, 220, 70);
+    lv_obj_align(chart, NULL, LV_ALIGN_CENTER, 0, -40);
+    lv_chart_set_type(chart, c.type);
+    lv_chart_set_range(chart, 0, 4096);
+    lv_chart_set_point_count(chart, c.points);
+
+    if (c.area)
+    {
+        /* The same fade as the network chart of the dashboard */
+        lv_obj_set_style_local_bg_opa(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_50);
+        lv_obj_set_style_local_bg_grad_dir(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+        lv_obj_set_style_local_bg_main_stop(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 255);
+        lv_obj_set_style_local_bg_grad_stop(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);
+    }
+
+    lv_chart_series_t *ser = lv_chart_add_series(chart, LV_COLOR_GREEN);
+    for (uint16_t i = 0; i < c.points; i++)
+    {
+        lv_coord_t min, max, mean;
+        syntheticSample(i, min, max, mean);
+        if (c.type == LV_CHART_TYPE_ENVELOPE)
+            lv_chart_set_next_envelope(chart, ser, min, max, mean);
+        else
+            lv_chart_set_next(chart, ser, mean);
+    }
+
+    return chart;
+}
+
+int benchChart(int argc, char **argv)
+{
+    uint32_t iters = argc > 0 ? (uint32_t)atoi(argv[0]) : 200;
+    if (iters == 0)
+        iters = 1;
+
+    printf("%-24s %10s %10s\n", "case", "us/frame", "px/frame");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const ChartCase &c = cases[i];
+        lv_obj_t *chart = createChart(c);
+        lv_refr_now(NULL);
+
+        /* Best of a few runs to filter out the noise of the host */
+        uint64_t us = UINT64_MAX;
+        for (int run = 0; run < CHART_RUNS; run++)
+        {
+            bench_flush.px_cnt = 0;
+            uint64_t t0 = benchMicros();
+            for (uint32_t n = 0; n < iters; n++)
+            {
+                lv_obj_invalidate(chart);
+                lv_refr_now(NULL);
+            }
+            us = std::min(us, benchMicros() - t0);
+        }
+
+        printf("%-24s %10.1f %10u\n", c.name, (double)us / iters, bench_flush.px_cnt / iters);
+        lv_obj_del(chart);
+        lv_refr_now(NULL);
+    }
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file bench_dashboard.cpp
+ * Render the firmware's monitor page and feed it synthetic metrics,
+ * one update per simulated second like the `update` task on the device.
+ * With `scroll` the drawn chart plot is moved in the frame buffer instead of being redrawn,
+ * like `tftScrollChart` does on the TFT.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "bench.h"
+#include "../src/Dashboard.h"
+#include "../src/FramePacer.h"
+
+LV_FONT_DECLARE(tencent_w7_22)
+LV_FONT_DECLARE(tencent_w7_24)
+
+/* Deterministic metric sequence so runs are comparable */
+static void syntheticMetrics(uint32_t t, DashboardMetrics &m)
+{
+    static uint32_t seed = 1;
+    seed = seed * 1103515245u + 12345u;
+    uint32_t rnd = (seed >> 16) & 0x7fff;
+
+    m.cpu_usage = 30.0 + 25.0 * sin(t / 7.0);
+    m.mem_usage = 40.0 + 10.0 * sin(t / 31.0);
+    m.temp_value = 55.0 + 30.0 * sin(t / 13.0);
+
+    /* Mostly idle WAN with occasional bursts */
+    m.down_speed = 200.0 + (rnd % 300);
+    if (rnd % 17 == 0)
+        m.down_speed += 20000.0;
+    m.up_speed = -(40.0 + (rnd % 60));
+    m.ip = "192.168.8.100";
+}
+
+/* The calls of `update()` in src/main.cpp after the requests: the first fetch shows the monitor page */
+static void fetchUpdate(const DashboardMetrics &m)
+{
+    dashboardShowMonitor();
+    dashboardPushDownSpeed(m.down_speed);
+    dashboardPushUpSpeed(m.up_speed);
+    dashboardUpdate(m);
+}
+
+static uint32_t scroll_cnt = 0;
+
+/* Move the pixels inside the area of the memory frame buffer */
+static bool benchScrollChart(lv_obj_t *chart, const lv_area_t *area, lv_coord_t dx)
+{
+    LV_UNUSED(chart);
+    lv_coord_t w = lv_area_get_width(area) - LV_MATH_ABS(dx);
+    lv_coord_t src_x = dx < 0 ? area->x1 - dx : area->x1;
+    for (lv_coord_t y = area->y1; y <= area->y2; y++)
+    {
+        lv_color_t *row = &bench_fb[y * LV_HOR_RES_MAX];
+        memmove(&row[src_x + dx], &row[src_x], w * sizeof(lv_color_t));
+    }
+    scroll_cnt++;
+    return true;
+}
+
+static void printStats(const char *name, std::vector<uint64_t> &v)
+{
+    std::sort(v.begin(), v.end());
+    uint64_t sum = 0;
+    for (uint64_t x : v)
+        sum += x;
+    printf("%-10s avg %7.1f us  min %6llu  p95 %6llu  max %6llu\n", name, (double)sum / v.size(),
+           (unsigned long long)v.front(), (unsigned long long)v[v.size() * 95 / 100], (unsigned long long)v.back());
+}
+
+int benchDashboard(int argc, char **argv)
+{
+    int frames = argc > 0 ? atoi(argv[0]) : 300;
+    const char *ppm = argc > 1 && strcmp(argv[1], "-") != 0 ? argv[1] : NULL;
+    bool scroll = argc > 2 && strcmp(argv[2], "scroll") == 0;
+    if (frames < 1)
+        frames = 1;
+
+    dashboardCreate();
+    dashboardShowMonitor();
+    if (scroll)
+        dashboardSetChartScrollCb(benchScrollChart);
+
+    uint64_t start = benchMicros();
+    lv_refr_now(NULL);
+    uint64_t first = benchMicros() - start;
+    printf("first frame: %llu us, %u px in %u flushes\n", (unsigned long long)first,
+           bench_flush.px_cnt, bench_flush.flush_cnt);
+
+    std::vector<uint64_t> update_us, render_us;
+    uint64_t px_total = 0;
+    uint32_t flush_total = 0;
+
+    for (int i = 0; i < frames; i++)
+    {
+        DashboardMetrics m;
+        syntheticMetrics(i, m);
+
+        start = benchMicros();
+        fetchUpdate(m);
+        update_us.push_back(benchMicros() - start);
+
+        bench_flush.px_cnt = 0;
+        bench_flush.flush_cnt = 0;
+        benchTickAdvance(1000);
+        start = benchMicros();
+        lv_task_handler();
+        render_us.push_back(benchMicros() - start);
+
+        px_total += bench_flush.px_cnt;
+        flush_total += bench_flush.flush_cnt;
+    }
+
+    printf("frames:    %d\n", frames);
+    printStats("update", update_us);
+    printStats("render", render_us);
+    printf("flushed    avg %.0f px/frame (%.1f%% of screen), %.1f flushes/frame\n",
+           (double)px_total / frames, 100.0 * px_total / frames / (LV_HOR_RES_MAX * LV_VER_RES_MAX),
+           (double)flush_total / frames);
+    printf("chart      range changed %u times\n", dashboardGetChartRangeChanges());
+    if (scroll)
+        printf("chart      %u of %d updates scrolled\n", scroll_cnt, frames);
+    /* Only a change of the range has to redraw the whole plot */
+    bool scroll_ok = !scroll || scroll_cnt + dashboardGetChartRangeChanges() >= (uint32_t)frames;
+    if (!scroll_ok)
+        printf("chart      FAIL: the plot was redrawn instead of scrolled\n");
+
+    /* Run the firmware's loop on the virtual clock: sleep until the deadline
+     * reported by the frame pacer, one metric update per simulated second */
+    uint32_t wakeups = 0;
+    uint32_t now = 0;
+    uint32_t next_update = 0;
+    bench_flush.flush_cnt = 0;
+    while (now < 10000)
+    {
+        if (now >= next_update)
+        {
+            DashboardMetrics m;
+            syntheticMetrics(frames + now / 1000, m);
+            fetchUpdate(m);
+            next_update += 1000;
+        }
+
+        uint32_t sleep_ms = framePacerHandler(100);
+        sleep_ms = LV_MATH_MIN(sleep_ms, next_update - now);
+        if (sleep_ms == 0)
+            sleep_ms = 1;
+        benchTickAdvance(sleep_ms);
+        now += sleep_ms;
+        wakeups++;
+    }
+    printf("paced loop %.1f wakeups/s, %.1f flushes/s over %u s\n", wakeups / 10.0,
+           bench_flush.flush_cnt / 10.0, now / 1000);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    printf("lv_mem     %u of %u bytes at peak, %u%% used, %u%% frag\n", mon.max_used, mon.total_size,
+           mon.used_pct, mon.frag_pct);
+
+    lv_draw_mask_circle_cache_stat_t circles;
+    lv_draw_mask_circle_cache_get_stat(&circles);
+    printf("circles    %u hits, %u misses, %u cached in %u bytes\n", circles.hit_cnt, circles.miss_cnt,
+           circles.entry_cnt, circles.used_size);
+
+    lv_draw_grad_cache_stat_t grads;
+    lv_draw_grad_cache_get_stat(&grads);
+    printf("gradients  %u hits, %u misses, %u cached in %u bytes\n", grads.hit_cnt, grads.miss_cnt,
+           grads.entry_cnt, grads.used_size);
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    const struct
+    {
+        const char *name;
+        const lv_font_t *font;
+    } fonts[] = {{"font 22", &tencent_w7_22}, {"font 24", &tencent_w7_24}};
+    for (const auto &f : fonts)
+    {
+        lv_font_fmt_txt_cache_stat_t glyphs;
+        lv_font_fmt_txt_get_cache_stat(f.font, &glyphs);
+        printf("%-10s glyphs %u hits, %u misses, kerning %u hits, %u misses\n", f.name, glyphs.glyph_hit_cnt,
+               glyphs.glyph_miss_cnt, glyphs.kern_hit_cnt, glyphs.kern_miss_cnt);
+    }
+#endif
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_stat_t bitmaps;
+    lv_font_fmt_txt_glyph_cache_get_stat(&bitmaps);
+    printf("bitmaps    %u hits, %u misses, %u cached in %u bytes\n", bitmaps.hit_cnt, bitmaps.miss_cnt,
+           bitmaps.entry_cnt, bitmaps.used_size);
+#endif
+
+    if (ppm && !benchWritePpm(ppm))
+    {
+        printf("can't write %s\n", ppm);
+        return 1;
+    }
+
+    return scroll_ok ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file bench_label.cpp
+ * Benchmark of the numeric labels of the dashboard: the same labels are redrawn
+ * with the glyphs unpacked from the fonts and with the glyphs of a font atlas (`lv_font_atlas_create`).
+ * The values are also updated like on the dashboard to time the layout of the texts (`lv_label_refr_text`).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "bench.h"
+
+LV_FONT_DECLARE(tencent_w7_22)
+LV_FONT_DECLARE(tencent_w7_24)
+
+#define LABEL_RUNS 5
+
+struct LabelCase
+{
+    const lv_font_t *font;
+    const char *text;
+    lv_opa_t opa;
+};
+
+/* The values of the monitor page, the last one with the opacity of a fading label */
+static const LabelCase cases[] = {
+    {&tencent_w7_22, "56.78", LV_OPA_COVER},
+    {&tencent_w7_22, "123.4", LV_OPA_COVER},
+    {&tencent_w7_22, "34.5%", LV_OPA_COVER},
+    {&tencent_w7_22, "42%", LV_OPA_COVER},
+    {&tencent_w7_24, "72°C", LV_OPA_COVER},
+    {&tencent_w7_24, "1024.8", LV_OPA_70},
+};
+
+static lv_obj_t *labels[sizeof(cases) / sizeof(cases[0])];
+static lv_color_t ref_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+
+static void createLabels()
+{
+    lv_obj_set_style_local_bg_color(lv_scr_act(), LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, lv_color_hex(0x081418));
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        lv_obj_t *label = lv_label_create(lv_scr_act(), NULL);
+        lv_obj_set_style_local_text_font(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, cases[i].font);
+        lv_obj_set_style_local_text_color(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+        lv_obj_set_style_local_text_opa(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, cases[i].opa);
+        lv_label_set_text(label, cases[i].text);
+        lv_obj_set_pos(label, 10 + (i % 2) * 110, 10 + (i / 2) * 40);
+        labels[i] = label;
+    }
+}
+
+/* Best time of a few runs to redraw all the labels, in microseconds per frame */
+static double drawLabels(uint32_t iters)
+{
+    uint64_t us = UINT64_MAX;
+    for (int run = 0; run < LABEL_RUNS; run++)
+    {
+        uint64_t t0 = benchMicros();
+        for (uint32_t n = 0; n < iters; n++)
+        {
+            for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++)
+                lv_obj_invalidate(labels[i]);
+            lv_refr_now(NULL);
+        }
+        us = std::min(us, benchMicros() - t0);
+    }
+
+    return (double)us / iters;
+}
+
+/* Best time of a few runs to set new values to all the labels and redraw them, in microseconds per frame */
+static double updateLabels(uint32_t iters)
+{
+    uint64_t us = UINT64_MAX;
+    for (int run = 0; run < LABEL_RUNS; run++)
+    {
+        uint64_t t0 = benchMicros();
+        for (uint32_t n = 0; n < iters; n++)
+        {
+            for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++)
+            {
+                /* The same format with changing values */
+                double v = (n * 7 + i * 13) % 1000 / 10.0;
+                lv_label_set_text_fmt(labels[i], cases[i].font == &tencent_w7_24 ? "%.1f°C" : "%.2f", v);
+            }
+            lv_refr_now(NULL);
+        }
+        us = std::min(us, benchMicros() - t0);
+    }
+
+    for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++)
+        lv_label_set_text(labels[i], cases[i].text);
+
+    return (double)us / iters;
+}
+
+int benchLabel(int argc, char **argv)
+{
+    uint32_t iters = argc > 0 ? (uint32_t)atoi(argv[0]) : 2000;
+    if (iters == 0)
+        iters = 1;
+
+    createLabels();
+    lv_refr_now(NULL);
+    double update_us = updateLabels(iters);
+    lv_refr_now(NULL);
+    double font_us = drawLabels(iters);
+    memcpy(ref_fb, bench_fb, sizeof(ref_fb));
+
+    /* The letter sets of the dashboard */
+    static lv_font_atlas_t atlas_22;
+    static lv_font_atlas_t atlas_24;
+    const char *letters_22 = "0123456789.%";
+    const char *letters_24 = "0123456789.°C";
+    uint32_t size_22 = lv_font_atlas_get_buf_size(&tencent_w7_22, letters_22);
+    uint32_t size_24 = lv_font_atlas_get_buf_size(&tencent_w7_24, letters_24);
+    void *buf_22 = malloc(size_22);
+    void *buf_24 = malloc(size_24);
+    if (!lv_font_atlas_create(&atlas_22, &tencent_w7_22, letters_22, buf_22, size_22) ||
+        !lv_font_atlas_create(&atlas_24, &tencent_w7_24, letters_24, buf_24, size_24))
+    {
+        printf("can't create the font atlases\n");
+        return 1;
+    }
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    double atlas_us = drawLabels(iters);
+    bool same = memcmp(ref_fb, bench_fb, sizeof(ref_fb)) == 0;
+
+    printf("%-10s %10s\n", "glyphs", "us/frame");
+    printf("%-10s %10.1f\n", "font", font_us);
+    printf("%-10s %10.1f\n", "atlas", atlas_us);
+    printf("%-10s %10.1f\n", "update", update_us);
+    printf("atlas size %u + %u bytes, frames %s\n", size_22, size_24, same ? "identical" : "DIFFER");
+
+    lv_font_atlas_remove(&atlas_22);
+    lv_font_atlas_remove(&atlas_24);
+    free(buf_22);
+    free(buf_24);
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file bench_main.cpp
+ * Host benchmark runner: renders with the firmware's LVGL configuration
+ * into a memory frame buffer instead of the SPI panel.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Arduino.h"
+#include "bench.h"
+
+struct BenchScenario
+{
+    const char *name;
+    int (*run)(int argc, char **argv);
+    const char *help;
+};
+
+static const BenchScenario scenarios[] = {
+    {"dashboard", benchDashboard, "[frames] [out.ppm]  render the monitor page with synthetic metrics"},
+    {"blend", benchBlend, "[Mpx]  cycles per pixel of the fill and map blend kernels"},
+    {"arc", benchArc, "[iterations]  lv_draw_arc across radii, thicknesses and caps"},
+    {"mask", benchMask, "[iterations]  masked rectangles: rounded bars and the faded chart area"},
+    {"chart", benchChart, "[iterations]  refresh of the dashboard chart with line and envelope series"},
+    {"label", benchLabel, "[iterations]  numeric labels drawn from the fonts and from font atlases"},
+    {"mem", benchMem, "[frames] [out.trace] | replay <trace>  lv_mem calls of the dashboard replayed"},
+    {"tft", benchTft, "[scrolls]  TFT_eSPI hardware scroll positions checked against a model of the frame memory"},
+};
+
+lv_color_t bench_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+BenchFlushStats bench_flush;
+
+static uint32_t tick_ms;
+static lv_disp_buf_t disp_buf;
+static lv_color_t buf[LV_HOR_RES_MAX * 10];
+
+uint32_t millis(void)
+{
+    return tick_ms;
+}
+
+void benchTickAdvance(uint32_t ms)
+{
+    tick_ms += ms;
+}
+
+uint64_t benchMicros()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000u;
+}
+
+uint64_t benchCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+static void fb_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    uint32_t w = (area->x2 - area->x1 + 1);
+
+    for (lv_coord_t y = area->y1; y <= area->y2; y++)
+    {
+        memcpy(&bench_fb[y * LV_HOR_RES_MAX + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    bench_flush.flush_cnt++;
+    bench_flush.px_cnt += w * (area->y2 - area->y1 + 1);
+
+    lv_disp_flush_ready(disp);
+}
+
+void benchDisplayInit()
+{
+    lv_disp_buf_init(&disp_buf, buf, NULL, LV_HOR_RES_MAX * 10);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = 240;
+    disp_drv.ver_res = 240;
+    disp_drv.flush_cb = fb_flush;
+    disp_drv.buffer = &disp_buf;
+    lv_disp_drv_register(&disp_drv);
+}
+
+bool benchWritePpm(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return false;
+
+    fprintf(f, "P6\n%d %d\n255\n", LV_HOR_RES_MAX, LV_VER_RES_MAX);
+    for (uint32_t i = 0; i < LV_HOR_RES_MAX * LV_VER_RES_MAX; i++)
+    {
+        uint32_t c = lv_color_to32(bench_fb[i]);
+        uint8_t rgb[3] = {(uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c};
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+    fclose(f);
+    return true;
+}
+
+static void usage(const char *bin)
+{
+    printf("usage: %s <scenario> [args]\n", bin);
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        printf("  %-10s %s\n", scenarios[i].name, scenarios[i].help);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        if (strcmp(argv[1], scenarios[i].name) == 0)
+        {
+            lv_init();
+            benchDisplayInit();
+            return scenarios[i].run(argc - 2, argv + 2);
+        }
+    }
+
+    usage(argv[0]);
+    return 1;
+}
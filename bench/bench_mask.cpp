@@ -0,0 +1,186 @@
+/**
+ * @file bench_mask.cpp
+ * Benchmark of masked rectangle drawing: the rounded bars and the faded
+ * chart series area of the dashboard, and the gradients of the rectangles. Every shape is drawn strip by strip
+ * into the draw buffer, the same way a refresh of the whole screen would render it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "bench.h"
+
+#define MASK_STRIP_H 10
+#define MASK_RUNS 5
+#define MASK_CHART_POINTS 20
+
+enum MaskKind
+{
+    MASK_BAR,    // indicator of a bar: radius mask of the background and the indicator
+    MASK_ROUND,  // narrow rounded rectangle, only its own radius mask
+    MASK_CHART,  // area under a chart series: a line mask per segment and a fade mask
+    MASK_FADE,   // a whole area faded by one mask, e.g. the background of a chart
+    MASK_GRAD,   // no mask, a vertical or horizontal color gradient
+};
+
+struct MaskCase
+{
+    const char *name;
+    MaskKind kind;
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t radius;
+    lv_grad_dir_t grad_dir;
+};
+
+static const MaskCase cases[] = {
+    {"bar 200x20 r10", MASK_BAR, 200, 20, 10, LV_GRAD_DIR_NONE},
+    {"bar 200x40 r8", MASK_BAR, 200, 40, 8, LV_GRAD_DIR_NONE},
+    {"bar 200x8 circle", MASK_BAR, 200, 8, LV_RADIUS_CIRCLE, LV_GRAD_DIR_NONE},
+    {"round 60x60 r8", MASK_ROUND, 60, 60, 8, LV_GRAD_DIR_NONE},
+    {"chart fade 220x70", MASK_CHART, 220, 70, 0, LV_GRAD_DIR_VER},
+    {"area fade 220x70", MASK_FADE, 220, 70, 0, LV_GRAD_DIR_VER},
+    {"grad ver 220x70", MASK_GRAD, 220, 70, 0, LV_GRAD_DIR_VER},
+    {"grad hor 220x70", MASK_GRAD, 220, 70, 0, LV_GRAD_DIR_HOR},
+    {"grad ver 220x70 r8", MASK_GRAD, 220, 70, 8, LV_GRAD_DIR_VER},
+};
+
+static void drawStrip(const MaskCase &c, const lv_area_t &coords, const lv_area_t &strip)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(0x50ff7d);
+    dsc.radius = c.radius;
+
+    if (c.kind == MASK_GRAD)
+    {
+        dsc.bg_grad_dir = c.grad_dir;
+        dsc.bg_grad_color = lv_color_hex(0x1a3c8c);
+        dsc.bg_main_color_stop = LV_OPA_10;
+        dsc.bg_grad_color_stop = LV_OPA_90;
+        lv_draw_rect(&coords, &strip, &dsc);
+        return;
+    }
+
+    if (c.kind == MASK_ROUND)
+    {
+        lv_draw_rect(&coords, &strip, &dsc);
+        return;
+    }
+
+    if (c.kind == MASK_BAR)
+    {
+        /* The same masks `lv_bar` adds to draw its indicator */
+        lv_area_t indic = coords;
+        indic.x2 = indic.x1 + c.w * 2 / 3;
+        lv_draw_mask_radius_param_t bg_p;
+        lv_draw_mask_radius_param_t indic_p;
+        lv_draw_mask_radius_init(&bg_p, &coords, c.radius, false);
+        lv_draw_mask_radius_init(&indic_p, &indic, c.radius, false);
+        int16_t bg_id = lv_draw_mask_add(&bg_p, NULL);
+        int16_t indic_id = lv_draw_mask_add(&indic_p, NULL);
+        lv_draw_rect(&coords, &strip, &dsc);
+        lv_draw_mask_remove_id(indic_id);
+        lv_draw_mask_remove_id(bg_id);
+        return;
+    }
+
+    /* The same masks `lv_chart` adds to draw the area under a series */
+    dsc.radius = 0;
+    dsc.bg_grad_dir = c.grad_dir;
+    dsc.bg_grad_color = dsc.bg_color;
+    dsc.bg_main_color_stop = LV_OPA_70;
+    dsc.bg_grad_color_stop = LV_OPA_10;
+
+    lv_draw_mask_fade_param_t fade_p;
+    lv_draw_mask_fade_init(&fade_p, &coords, dsc.bg_main_color_stop, coords.y1, dsc.bg_grad_color_stop, coords.y2);
+
+    if (c.kind == MASK_FADE)
+    {
+        int16_t fade_id = lv_draw_mask_add(&fade_p, NULL);
+        lv_draw_rect(&coords, &strip, &dsc);
+        lv_draw_mask_remove_id(fade_id);
+        return;
+    }
+
+    lv_point_t p1;
+    lv_point_t p2 = {coords.x1, (lv_coord_t)(coords.y1 + c.h / 2)};
+    for (int i = 1; i < MASK_CHART_POINTS; i++)
+    {
+        p1 = p2;
+        p2.x = coords.x1 + (c.w * i) / (MASK_CHART_POINTS - 1);
+        p2.y = coords.y1 + (lv_coord_t)((i * 37) % (c.h - 10)) + 5;
+
+        lv_draw_mask_line_param_t line_p;
+        lv_draw_mask_line_points_init(&line_p, p1.x, p1.y, p2.x, p2.y, LV_DRAW_MASK_LINE_SIDE_BOTTOM);
+        int16_t line_id = lv_draw_mask_add(&line_p, NULL);
+        int16_t fade_id = lv_draw_mask_add(&fade_p, NULL);
+
+        lv_area_t a = {p1.x, std::min(p1.y, p2.y), (lv_coord_t)(p2.x - 1), coords.y2};
+        lv_draw_rect(&a, &strip, &dsc);
+
+        lv_draw_mask_remove_id(fade_id);
+        lv_draw_mask_remove_id(line_id);
+    }
+}
+
+/* Draw the shape in strips of the draw buffer's height, like `lv_refr` does */
+static void drawOnce(const MaskCase &c, lv_disp_buf_t *vdb)
+{
+    lv_area_t coords;
+    coords.x1 = (LV_HOR_RES_MAX - c.w) / 2;
+    coords.y1 = (LV_VER_RES_MAX - c.h) / 2;
+    coords.x2 = coords.x1 + c.w - 1;
+    coords.y2 = coords.y1 + c.h - 1;
+
+    for (lv_coord_t y = coords.y1; y <= coords.y2; y += MASK_STRIP_H)
+    {
+        lv_area_t strip = {0, y, LV_HOR_RES_MAX - 1, (lv_coord_t)(y + MASK_STRIP_H - 1)};
+        vdb->area = strip;
+        drawStrip(c, coords, strip);
+    }
+}
+
+int benchMask(int argc, char **argv)
+{
+    uint32_t iters = argc > 0 ? (uint32_t)atoi(argv[0]) : 2000;
+    if (iters == 0)
+        iters = 1;
+
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_disp_buf_t *vdb = lv_disp_get_buf(disp);
+    _lv_refr_set_disp_refreshing(disp);
+
+    printf("%-24s %10s %10s\n", "case", "us/draw", "cycles/px");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const MaskCase &c = cases[i];
+
+        /* Best of a few runs to filter out the noise of the host */
+        uint64_t cycles = UINT64_MAX;
+        uint64_t us = UINT64_MAX;
+        for (int run = 0; run < MASK_RUNS; run++)
+        {
+            uint64_t t0 = benchMicros();
+            uint64_t c0 = benchCycles();
+            for (uint32_t n = 0; n < iters; n++)
+            {
+                drawOnce(c, vdb);
+            }
+            cycles = std::min(cycles, benchCycles() - c0);
+            us = std::min(us, benchMicros() - t0);
+        }
+
+        double px = (double)c.w * c.h * iters;
+        printf("%-24s %10.2f %10.2f\n", c.name, (double)us / iters, cycles / px);
+    }
+
+    lv_draw_grad_cache_stat_t grads;
+    lv_draw_grad_cache_get_stat(&grads);
+    printf("gradients  %u hits, %u misses, %u cached in %u bytes\n", grads.hit_cnt, grads.miss_cnt,
+           grads.entry_cnt, grads.used_size);
+
+    _lv_refr_set_disp_refreshing(NULL);
+    return 0;
+}
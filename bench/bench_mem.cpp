@@ -0,0 +1,374 @@
+/**
+ * @file bench_mem.cpp
+ * Replay of the `lv_mem` allocations of the dashboard: the calls of a run are recorded
+ * and then replayed in the emptied work memory to time the allocator and to follow the fragmentation.
+ * Build with `DEFINES=-DLV_MEM_TLSF=0` or `1` to compare the allocators on the same trace.
+ * The histogram of the sizes gives the pools of `LV_MEM_SLAB_CLASSES`.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "../src/Dashboard.h"
+
+#define MEM_REPLAY_RUNS 20
+#define MEM_TOTAL_RUNS 200
+#define MEM_SAMPLE_OPS 16
+#define MEM_HIST_SIZES 10
+
+/* The calls from the other objects are redirected here by the linker (`-Wl,--wrap`) */
+extern "C" void *__real_lv_mem_alloc(size_t size);
+extern "C" void __real_lv_mem_free(const void *data);
+extern "C" void *__real_lv_mem_realloc(void *data_p, size_t new_size);
+
+struct MemOp
+{
+    char type; // 'a': alloc, 'f': free, 'r': realloc
+    uint32_t id;
+    uint32_t size;
+};
+
+static bool recording;
+static std::vector<MemOp> trace;
+static std::unordered_map<const void *, uint32_t> live_ids;
+static uint32_t next_id;
+
+static void recordAlloc(char type, const void *old_p, void *new_p, size_t size)
+{
+    uint32_t id;
+    auto it = live_ids.find(old_p);
+    if (type == 'r' && it != live_ids.end())
+    {
+        id = it->second;
+        if (new_p == NULL)
+            return;
+        live_ids.erase(it);
+    }
+    else
+    {
+        /* Also a realloc of NULL or of a not recorded memory */
+        if (new_p == NULL || size == 0)
+            return;
+        type = 'a';
+        id = next_id++;
+    }
+
+    live_ids[new_p] = id;
+    trace.push_back({type, id, (uint32_t)size});
+}
+
+extern "C" void *__wrap_lv_mem_alloc(size_t size)
+{
+    void *p = __real_lv_mem_alloc(size);
+    if (recording)
+        recordAlloc('a', NULL, p, size);
+    return p;
+}
+
+extern "C" void __wrap_lv_mem_free(const void *data)
+{
+    if (recording)
+    {
+        auto it = live_ids.find(data);
+        if (it != live_ids.end())
+        {
+            trace.push_back({'f', it->second, 0});
+            live_ids.erase(it);
+        }
+    }
+    __real_lv_mem_free(data);
+}
+
+extern "C" void *__wrap_lv_mem_realloc(void *data_p, size_t new_size)
+{
+    void *p = __real_lv_mem_realloc(data_p, new_size);
+    if (recording)
+        recordAlloc('r', data_p, p, new_size);
+    return p;
+}
+
+/* Metric updates of the dashboard like `benchDashboard` does, from the creation of the pages */
+static void recordDashboard(int frames)
+{
+    recording = true;
+    dashboardCreate();
+    dashboardSetLoadingText("Connecting...");
+    lv_refr_now(NULL);
+    dashboardShowMonitor();
+    lv_refr_now(NULL);
+
+    for (int i = 0; i < frames; i++)
+    {
+        double v = i % 97;
+        DashboardMetrics m;
+        m.cpu_usage = v / 2;
+        m.mem_usage = 40.0 + v / 10;
+        m.temp_value = 50.0 + v / 4;
+        m.down_speed = (i % 17 == 0) ? 20000.0 + v : 200.0 + v * 3;
+        m.up_speed = -(40.0 + v);
+        m.ip = "192.168.8.100";
+        dashboardPushDownSpeed(m.down_speed);
+        dashboardPushUpSpeed(m.up_speed);
+        dashboardUpdate(m);
+        benchTickAdvance(1000);
+        lv_task_handler();
+    }
+    recording = false;
+}
+
+static bool readTrace(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+        return false;
+
+    char line[64];
+    while (fgets(line, sizeof(line), f))
+    {
+        MemOp op = {0, 0, 0};
+        if (line[0] == '#')
+            continue;
+        if (sscanf(line, "%c %u %u", &op.type, &op.id, &op.size) < 2)
+            continue;
+        trace.push_back(op);
+        next_id = std::max(next_id, op.id + 1);
+    }
+    fclose(f);
+    return true;
+}
+
+static bool writeTrace(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+        return false;
+
+    fprintf(f, "# lv_mem trace: a <id> <size> | r <id> <size> | f <id>\n");
+    for (const MemOp &op : trace)
+    {
+        if (op.type == 'f')
+            fprintf(f, "f %u\n", op.id);
+        else
+            fprintf(f, "%c %u %u\n", op.type, op.id, op.size);
+    }
+    fclose(f);
+    return true;
+}
+
+struct ReplayStats
+{
+    std::vector<uint32_t> cycles[3]; // alloc, free, realloc
+    uint32_t fail_cnt;
+    uint32_t max_used;
+    uint32_t max_frag_pct;
+    uint32_t min_biggest;
+    lv_mem_monitor_t end;
+};
+
+/* Replay the trace in the empty work memory, the cycles of every call are added to `stats` */
+static void replay(ReplayStats &stats, bool sample)
+{
+    _lv_mem_deinit();
+    std::vector<void *> ptrs(next_id, NULL);
+
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const MemOp &op = trace[i];
+        void *p = NULL;
+        uint64_t t0 = benchCycles();
+        switch (op.type)
+        {
+        case 'a':
+            p = lv_mem_alloc(op.size);
+            break;
+        case 'r':
+            p = lv_mem_realloc(ptrs[op.id], op.size);
+            break;
+        case 'f':
+            lv_mem_free(ptrs[op.id]);
+            break;
+        }
+        uint64_t t1 = benchCycles();
+
+        int k = op.type == 'a' ? 0 : op.type == 'f' ? 1 : 2;
+        stats.cycles[k].push_back((uint32_t)(t1 - t0));
+
+        if (op.type == 'f')
+            ptrs[op.id] = NULL;
+        else if (p == NULL)
+            stats.fail_cnt++;
+        else
+            ptrs[op.id] = p;
+
+        if (sample && i % MEM_SAMPLE_OPS == 0)
+        {
+            lv_mem_monitor_t mon;
+            lv_mem_monitor(&mon);
+            stats.max_frag_pct = std::max(stats.max_frag_pct, (uint32_t)mon.frag_pct);
+            stats.min_biggest = std::min(stats.min_biggest, mon.free_biggest_size);
+        }
+    }
+
+    lv_mem_monitor(&stats.end);
+    stats.max_used = stats.end.max_used;
+}
+
+struct SizeCount
+{
+    uint32_t size;
+    uint32_t calls;
+    uint32_t live;
+    uint32_t max_live;
+};
+
+/* The most frequent sizes of the trace, rounded like `lv_mem_alloc`, with the most blocks alive at the same time */
+static void printHistogram()
+{
+    std::vector<SizeCount> hist;
+    std::vector<uint32_t> sizes(next_id, 0);
+    auto count = [&hist](uint32_t size, int delta) {
+#ifdef LV_ARCH_64
+        size = (size + 7) & ~7u;
+#else
+        size = (size + 3) & ~3u;
+#endif
+        auto it = std::find_if(hist.begin(), hist.end(), [size](const SizeCount &c) { return c.size == size; });
+        if (it == hist.end())
+            it = hist.insert(hist.end(), {size, 0, 0, 0});
+        if (delta > 0)
+        {
+            it->calls++;
+            it->max_live = std::max(it->max_live, ++it->live);
+        }
+        else
+            it->live--;
+    };
+
+    for (const MemOp &op : trace)
+    {
+        if (op.type != 'a' && sizes[op.id] != 0)
+            count(sizes[op.id], -1);
+        sizes[op.id] = op.type == 'f' ? 0 : op.size;
+        if (op.type != 'f')
+            count(op.size, 1);
+    }
+
+    std::sort(hist.begin(), hist.end(), [](const SizeCount &a, const SizeCount &b) { return a.calls > b.calls; });
+    printf("%-8s %8s %8s\n", "size", "calls", "peak");
+    for (size_t i = 0; i < hist.size() && i < MEM_HIST_SIZES; i++)
+        printf("%-8u %8u %8u\n", hist[i].size, hist[i].calls, hist[i].max_live);
+}
+
+static void printSlabs()
+{
+    uint32_t cnt = lv_mem_slab_get_class_cnt();
+    if (cnt == 0)
+        return;
+
+    printf("%-8s %8s %8s %8s %8s\n", "pool", "blocks", "peak", "allocs", "misses");
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        lv_mem_slab_stat_t stat;
+        lv_mem_slab_get_stat(i, &stat);
+        printf("%-8u %8u %8u %8u %8u\n", stat.size, stat.cnt, stat.max_used_cnt, stat.alloc_cnt, stat.miss_cnt);
+    }
+}
+
+/* Cycles of a whole replay without the timer around the calls, which costs as much as the small allocations */
+static uint64_t replayTotal()
+{
+    _lv_mem_deinit();
+    std::vector<void *> ptrs(next_id, NULL);
+
+    uint64_t t0 = benchCycles();
+    for (const MemOp &op : trace)
+    {
+        switch (op.type)
+        {
+        case 'a':
+            ptrs[op.id] = lv_mem_alloc(op.size);
+            break;
+        case 'r':
+            ptrs[op.id] = lv_mem_realloc(ptrs[op.id], op.size);
+            break;
+        case 'f':
+            lv_mem_free(ptrs[op.id]);
+            ptrs[op.id] = NULL;
+            break;
+        }
+    }
+    return benchCycles() - t0;
+}
+
+static void printCycles(const char *name, std::vector<uint32_t> &v)
+{
+    if (v.empty())
+        return;
+
+    std::sort(v.begin(), v.end());
+    uint64_t sum = 0;
+    for (uint32_t x : v)
+        sum += x;
+    printf("%-8s %8zu %10.1f %8u %8u\n", name, v.size(), (double)sum / v.size(), v[v.size() / 2],
+           v[v.size() * 999 / 1000]);
+}
+
+int benchMem(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[0], "replay") == 0)
+    {
+        if (!readTrace(argv[1]))
+        {
+            printf("can't read %s\n", argv[1]);
+            return 1;
+        }
+    }
+    else
+    {
+        int frames = argc > 0 ? atoi(argv[0]) : 300;
+        if (frames < 1)
+            frames = 1;
+        recordDashboard(frames);
+        if (argc > 1 && !writeTrace(argv[1]))
+        {
+            printf("can't write %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    /* Nothing may point into the work memory during the replays */
+    lv_font_fmt_txt_glyph_cache_clear();
+
+    ReplayStats stats = {};
+    stats.min_biggest = UINT32_MAX;
+    replay(stats, true);
+    for (int run = 1; run < MEM_REPLAY_RUNS; run++)
+        replay(stats, false);
+    uint64_t total = UINT64_MAX;
+    for (int run = 0; run < MEM_TOTAL_RUNS; run++)
+        total = std::min(total, replayTotal());
+
+    printf("allocator %s%s, %u bytes, %zu calls\n", LV_MEM_TLSF ? "tlsf" : "first-fit",
+           lv_mem_slab_get_class_cnt() ? " + pools" : "", (unsigned)LV_MEM_SIZE, trace.size());
+    printf("%-8s %8s %10s %8s %8s\n", "call", "count", "cyc avg", "p50", "p99.9");
+    printCycles("alloc", stats.cycles[0]);
+    printCycles("free", stats.cycles[1]);
+    printCycles("realloc", stats.cycles[2]);
+    printf("replay   %8zu %10.1f\n", trace.size(), (double)total / trace.size());
+    printf("failed    %u\n", stats.fail_cnt / MEM_REPLAY_RUNS);
+    printf("peak used %u bytes, min biggest free %u bytes, max frag %u%%\n", stats.max_used, stats.min_biggest,
+           stats.max_frag_pct);
+    printf("end       used %u in %u blocks, free %u in %u blocks + %u in the pools, frag %u%%\n",
+           stats.end.total_size - stats.end.free_size - stats.end.slab_free_size, stats.end.used_cnt,
+           stats.end.free_size, stats.end.free_cnt, stats.end.slab_free_size, stats.end.frag_pct);
+    printf("\n");
+    printHistogram();
+    printSlabs();
+
+    return stats.fail_cnt == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file bench_tft.cpp
+ * Check of the hardware scroll of TFT_eSPI (`setScrollArea`, `scrollBy`, `scrollMap`) against a model
+ * of the ST7789 frame memory: the pixels written to `scrollMap(pos)` must be shown at `pos`, and after
+ * `scrollBy(d)` the content of the area must be shown moved by d without writing it again.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ScrollMap.h"
+#include "bench.h"
+
+/* Lines of the ST7789 frame memory (TFT_VSCR_LINES) and of the 240x240 screen */
+#define TFT_LINES 320
+#define TFT_SIZE 240
+
+/* The frame memory along the scroll axis with the scroll registers */
+struct TftModel
+{
+    int32_t first;  /* rowstart or colstart */
+    bool reversed;  /* the inverted rotations 2 and 3 */
+    int32_t tfa, vsa, ssa;
+    int32_t mem[TFT_LINES];
+
+    int32_t line(int32_t pos) const
+    {
+        int32_t l = pos + first;
+        return reversed ? TFT_LINES - 1 - l : l;
+    }
+
+    /* VSCRSADD: the first scan line of the area shows the memory line ssa, the others follow cyclically */
+    int32_t shown(int32_t pos) const
+    {
+        int32_t l = line(pos);
+        if (l >= tfa && l < tfa + vsa)
+            l = tfa + (ssa - tfa + l - tfa) % vsa;
+        return mem[l];
+    }
+
+    /* Like TFT_eSPI::setScrollArea() and scrollBy() */
+    void write(const TFT_ScrollMap &scroll)
+    {
+        int32_t l = line(scroll.start);
+        tfa = scroll.firstLine(l, reversed);
+        vsa = scroll.len;
+        ssa = scroll.startLine(l, reversed);
+    }
+};
+
+static int32_t expected(const TFT_ScrollMap &scroll, int32_t pos, int32_t d, int32_t frame)
+{
+    int32_t i = pos - scroll.start;
+    if (i >= 0 && i < scroll.len)
+    {
+        i = (i - d) % scroll.len;
+        if (i < 0)
+            i += scroll.len;
+        pos = scroll.start + i;
+    }
+    return frame * TFT_LINES + pos;
+}
+
+/* Draws frames with scrolls of random steps in between, the count of wrong pixels */
+static uint32_t checkArea(TftModel &tft, int32_t start, int32_t len, uint32_t steps)
+{
+    TFT_ScrollMap scroll;
+    scroll.set(start, len);
+    tft.write(scroll);
+
+    uint32_t err_cnt = 0;
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        int32_t frame = (int32_t)step + 1;
+        for (int32_t pos = 0; pos < TFT_SIZE; pos++)
+            tft.mem[tft.line(scroll.map(pos))] = frame * TFT_LINES + pos;
+        for (int32_t pos = 0; pos < TFT_SIZE; pos++)
+            err_cnt += tft.shown(pos) != expected(scroll, pos, 0, frame);
+
+        int32_t d = rand() % (2 * len + 1) - len;
+        scroll.scrollBy(d);
+        tft.write(scroll);
+        for (int32_t pos = 0; pos < TFT_SIZE; pos++)
+            err_cnt += tft.shown(pos) != expected(scroll, pos, d, frame);
+    }
+    return err_cnt;
+}
+
+int benchTft(int argc, char **argv)
+{
+    uint32_t steps = argc > 0 ? (uint32_t)atoi(argv[0]) : 200;
+    if (steps == 0)
+        steps = 1;
+
+    /* The whole screen, the chart of the dashboard and areas at the ends */
+    static const int32_t areas[][2] = {{0, TFT_SIZE}, {10, 70}, {0, 1}, {TFT_SIZE - 37, 37}, {100, 2}};
+    static const int32_t firsts[] = {0, 80};
+
+    srand(1);
+    uint32_t area_cnt = 0;
+    uint32_t fail_cnt = 0;
+    for (int reversed = 0; reversed < 2; reversed++)
+    {
+        for (size_t f = 0; f < sizeof(firsts) / sizeof(firsts[0]); f++)
+        {
+            for (size_t a = 0; a < sizeof(areas) / sizeof(areas[0]); a++)
+            {
+                static TftModel tft;
+                tft.first = firsts[f];
+                tft.reversed = reversed;
+                uint32_t err_cnt = checkArea(tft, areas[a][0], areas[a][1], steps);
+                if (err_cnt)
+                {
+                    printf("FAIL: reversed %d, first line %d, area %d+%d: %u wrong pixels\n", reversed,
+                           (int)firsts[f], (int)areas[a][0], (int)areas[a][1], err_cnt);
+                    fail_cnt++;
+                }
+                area_cnt++;
+            }
+        }
+    }
+
+    printf("tft: %u scroll areas, %u scrolls each, %u failed\n", area_cnt, steps, fail_cnt);
+    return fail_cnt ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+/***************************************************************************************
+// Positions of the hardware scroll area (setScrollArea(), scrollBy()), kept apart from
+// the class so the mapping has no dependencies and can be checked on a host
+***************************************************************************************/
+
+#ifndef _TFT_SCROLL_MAP_H_
+#define _TFT_SCROLL_MAP_H_
+
+#include <stdint.h>
+
+struct TFT_ScrollMap {
+  // Start and length along the scroll axis, len 0 if no area is scrolled
+  int32_t  start  = 0;
+  int32_t  len    = 0;
+  // The pixels shown at pos are at start + (pos - start + offset) % len
+  int32_t  offset = 0;
+
+  void     set(int32_t s, int32_t l) { start = s; len = l; offset = 0; }
+  void     clear(void)               { set(0, 0); }
+
+  // Move the content cyclically by d pixels (negative: up or left)
+  void     scrollBy(int32_t d) {
+    if (!len) return;
+    offset = (offset - d) % len;
+    if (offset < 0) offset += len;
+  }
+
+  // Position to write to, to show a pixel at pos
+  int32_t  map(int32_t pos) const {
+    int32_t i = pos - start;
+    if (i < 0 || i >= len) return pos;
+    i += offset;
+    if (i >= len) i -= len;
+    return start + i;
+  }
+
+  // First frame memory line of the area (TFA), line is the one at start.
+  // reversed: the lines run the other way (the inverted rotations)
+  int32_t  firstLine(int32_t line, bool reversed) const {
+    return reversed ? line - (len - 1) : line;
+  }
+
+  // Scroll start address (VSCRSADD): the frame memory line shown on the first line of the area
+  int32_t  startLine(int32_t line, bool reversed) const {
+    int32_t tfa = firstLine(line, reversed);
+    return reversed ? tfa + (len - offset) % len : tfa + offset;
+  }
+};
+
+#endif
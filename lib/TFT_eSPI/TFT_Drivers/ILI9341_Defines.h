@@ -69,6 +69,13 @@
 #define TFT_INVOFF  0x20
 #define TFT_INVON   0x21
 
+#if (defined (ILI9341_DRIVER) || defined (ILI9341_2_DRIVER)) && !defined (M5STACK)
+  // Hardware scrolling of the frame memory lines, see TFT_eSPI::setScrollArea()
+  #define TFT_VSCRDEF    0x33 // Vertical scrolling definition
+  #define TFT_VSCRSADD   0x37 // Vertical scrolling start address
+  #define TFT_VSCR_LINES 320  // Lines of the frame memory
+#endif
+
 
 // All ILI9341 specific commands some are used by init()
 #define ILI9341_NOP     0x00
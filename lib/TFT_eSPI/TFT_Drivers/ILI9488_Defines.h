@@ -18,6 +18,11 @@
 #define TFT_INVOFF  0x20
 #define TFT_INVON   0x21
 
+// Hardware scrolling of the frame memory lines, see TFT_eSPI::setScrollArea()
+#define TFT_VSCRDEF    0x33 // Vertical scrolling definition
+#define TFT_VSCRSADD   0x37 // Vertical scrolling start address
+#define TFT_VSCR_LINES 480  // Lines of the frame memory
+
 #define TFT_DISPOFF 0x28
 #define TFT_DISPON  0x29
 
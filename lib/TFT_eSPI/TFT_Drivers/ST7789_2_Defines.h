@@ -69,6 +69,11 @@
 #define TFT_MADCTL  0x36
 #define TFT_COLMOD  0x3A
 
+// Hardware scrolling of the frame memory lines, see TFT_eSPI::setScrollArea()
+#define TFT_VSCRDEF    0x33 // Vertical scrolling definition
+#define TFT_VSCRSADD   0x37 // Vertical scrolling start address
+#define TFT_VSCR_LINES 320  // Lines of the frame memory
+
 // Flags for TFT_MADCTL
 #define TFT_MAD_MY  0x80
 #define TFT_MAD_MX  0x40
@@ -34,6 +34,11 @@
 #define TFT_INVOFF  0x20
 #define TFT_INVON   0x21
 
+// Hardware scrolling of the frame memory lines, see TFT_eSPI::setScrollArea()
+#define TFT_VSCRDEF    0x33 // Vertical scrolling definition
+#define TFT_VSCRSADD   0x37 // Vertical scrolling start address
+#define TFT_VSCR_LINES 480  // Lines of the frame memory
+
 
 // ST7796 specific commands
 #define ST7796_NOP     0x00
@@ -14,6 +14,7 @@
  ****************************************************/
 
 #include "TFT_eSPI.h"
+#include <rgb565_blend.h> // SWAR alpha blending shared with LVGL
 
 #if defined (ESP32)
   #if defined(CONFIG_IDF_TARGET_ESP32S3)
@@ -859,6 +860,9 @@ void TFT_eSPI::setRotation(uint8_t m)
   addr_row = 0xFFFF;
   addr_col = 0xFFFF;
 
+  // The scrolled lines would be on other positions now
+  if (_scroll.len) resetScroll();
+
   // Reset the viewport to the whole screen
   resetViewport();
 }
@@ -4774,6 +4778,147 @@ void TFT_eSPI::invertDisplay(bool i)
 }
 
 
+/***************************************************************************************
+** Function name:           setScrollArea
+** Description:             Define the lines scrolled by the hardware, start and length
+**                          are screen coordinates along the scroll axis
+***************************************************************************************/
+bool TFT_eSPI::setScrollArea(int32_t start, int32_t len)
+{
+#if defined (TFT_VSCRDEF) && defined (TFT_VSCRSADD)
+  // The rotations 4-7 mirror the lines differently
+  if (rotation > 3) return false;
+
+  int32_t size = scrollAxisX() ? _width : _height;
+  if (start < 0 || len < 1 || start + len > size) return false;
+
+  _scroll.set(start, len);
+
+  // The area in the frame memory, reversed in the inverted rotations
+  int32_t line = scrollLine(start);
+  writeScroll(_scroll.firstLine(line, rotation > 1), len, _scroll.startLine(line, rotation > 1));
+  return true;
+#else
+  (void)start;
+  (void)len;
+  return false;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           scrollBy
+** Description:             Move the content of the scroll area cyclically by d pixels
+***************************************************************************************/
+void TFT_eSPI::scrollBy(int32_t d)
+{
+  if (!_scroll.len) return;
+
+  _scroll.scrollBy(d);
+
+  // The frame memory lines run the other way in the inverted rotations
+  int32_t line = scrollLine(_scroll.start);
+  writeScroll(_scroll.firstLine(line, rotation > 1), _scroll.len, _scroll.startLine(line, rotation > 1));
+}
+
+
+/***************************************************************************************
+** Function name:           resetScroll
+** Description:             Show the frame memory unscrolled again
+***************************************************************************************/
+void TFT_eSPI::resetScroll(void)
+{
+#if defined (TFT_VSCRDEF) && defined (TFT_VSCRSADD)
+  _scroll.clear();
+
+  writeScroll(0, TFT_VSCR_LINES, 0);
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           scrollAxisX
+** Description:             The frame memory lines are screen columns in landscape
+***************************************************************************************/
+bool TFT_eSPI::scrollAxisX(void)
+{
+  return rotation & 1;
+}
+
+
+/***************************************************************************************
+** Function name:           scrollMap
+** Description:             Position to write to, to show a pixel at pos along the axis
+***************************************************************************************/
+int32_t TFT_eSPI::scrollMap(int32_t pos)
+{
+  return _scroll.map(pos);
+}
+
+
+/***************************************************************************************
+** Function name:           getScrollStart, getScrollLength
+** Description:             The hardware scroll area along the scroll axis
+***************************************************************************************/
+int32_t TFT_eSPI::getScrollStart(void)
+{
+  return _scroll.start;
+}
+
+int32_t TFT_eSPI::getScrollLength(void)
+{
+  return _scroll.len;
+}
+
+
+/***************************************************************************************
+** Function name:           scrollLine
+** Description:             Line of the frame memory showing pos along the scroll axis
+***************************************************************************************/
+int32_t TFT_eSPI::scrollLine(int32_t pos)
+{
+#if defined (TFT_VSCR_LINES)
+  // Landscape swaps the axes (MV), so the lines start at colstart. The inverted
+  // rotations read the lines from the end of the frame memory (MY).
+  int32_t line = pos + (scrollAxisX() ? colstart : rowstart);
+  if (rotation > 1) line = TFT_VSCR_LINES - 1 - line;
+  return line;
+#else
+  return pos;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           writeScroll
+** Description:             Write the top fixed area, scroll area and scroll start line
+***************************************************************************************/
+void TFT_eSPI::writeScroll(int32_t tfa, int32_t vsa, int32_t ssa)
+{
+#if defined (TFT_VSCRDEF) && defined (TFT_VSCRSADD)
+  int32_t bfa = TFT_VSCR_LINES - tfa - vsa;
+
+  begin_tft_write();
+  writecommand(TFT_VSCRDEF);
+  writedata(tfa >> 8);
+  writedata(tfa);
+  writedata(vsa >> 8);
+  writedata(vsa);
+  writedata(bfa >> 8);
+  writedata(bfa);
+
+  writecommand(TFT_VSCRSADD);
+  writedata(ssa >> 8);
+  writedata(ssa);
+  end_tft_write();
+#else
+  (void)tfa;
+  (void)vsa;
+  (void)ssa;
+#endif
+}
+
+
 /**************************************************************************
 ** Function name:           setAttribute
 ** Description:             Sets a control parameter of an attribute
@@ -4908,11 +5053,8 @@ uint16_t TFT_eSPI::decodeUTF8(uint8_t *buf, uint16_t *index, uint16_t remaining)
 *************************************************************************************x*/
 inline uint16_t TFT_eSPI::alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc)
 {
-  uint32_t rxb = bgc & 0xF81F;
-  rxb += ((fgc & 0xF81F) - rxb) * (alpha >> 2) >> 6;
-  uint32_t xgx = bgc & 0x07E0;
-  xgx += ((fgc & 0x07E0) - xgx) * alpha >> 8;
-  return (rxb & 0xF81F) | (xgx & 0x07E0);
+  // All three channels with one spread word, rounded to nearest (within 1 LSB of an exact blend)
+  return rgb565_blend(fgc, bgc, rgb565_alpha(alpha));
 }
 
 /***************************************************************************************
@@ -31,6 +31,8 @@
 #include <Print.h>
 #include <SPI.h>
 
+#include "Extensions/ScrollMap.h"
+
 /***************************************************************************************
 **                         Section 2: Load library and processor specific header files
 ***************************************************************************************/
@@ -454,6 +456,17 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   void     invertDisplay(bool i);  // Tell TFT to invert all displayed colours
 
+  // Hardware scrolling of whole lines of the frame memory (drivers defining TFT_VSCRDEF and TFT_VSCRSADD)
+  // The lines are screen rows in portrait and screen columns in landscape rotations, see scrollAxisX()
+  // While the area is scrolled the pixels shown at a position are written to scrollMap(position)
+  bool     setScrollArea(int32_t start, int32_t len); // Start and length along the scroll axis, false if not supported
+  void     scrollBy(int32_t d);    // Move the content of the scroll area cyclically by d pixels (negative: up or left)
+  void     resetScroll(void);      // Show the frame memory unscrolled again
+  bool     scrollAxisX(void);      // true: the area scrolls horizontally, false: vertically
+  int32_t  scrollMap(int32_t pos); // Position to write to, to show a pixel at pos along the scroll axis
+  int32_t  getScrollStart(void);
+  int32_t  getScrollLength(void);  // 0 if no area is scrolled
+
 
   // The TFT_eSprite class inherits the following functions (not all are useful to Sprite class
   void     setAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h); // Note: start coordinates + width and height
@@ -859,6 +872,11 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Helper function: calculate distance of a point from a finite length line between two points
   float    wedgeLineDistance(float pax, float pay, float bax, float bay, float dr);
 
+           // Line of the frame memory showing a position along the scroll axis
+  int32_t  scrollLine(int32_t pos);
+           // Write the hardware scroll area and start line
+  void     writeScroll(int32_t tfa, int32_t vsa, int32_t ssa);
+
            // Display variant settings
   uint8_t  tabcolor,                   // ST7735 screen protector "tab" colour (now invalid)
            colstart = 0, rowstart = 0; // Screen display area to CGRAM area coordinate offsets
@@ -903,6 +921,9 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   bool     _vpDatum;
   bool     _vpOoB;
 
+  // Hardware scroll area
+  TFT_ScrollMap _scroll;
+
   int32_t  cursor_x, cursor_y, padX;       // Text cursor x,y and padding setting
   int32_t  bg_cursor_x;                    // Background fill cursor
   int32_t  last_cursor_x;                  // Previous text cursor position when fill used
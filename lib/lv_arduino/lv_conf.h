@@ -47,8 +47,15 @@
 #define LV_ANTIALIAS        1
 
 /* Default display refresh period.
- * Can be changed in the display driver (`lv_disp_drv_t`).*/
-#define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
+ * Can be changed in the display driver (`lv_disp_drv_t`).
+ * Also the period of the animations. The frame pacer of the application
+ * (src/FramePacer.cpp) keeps it only while animations are running.*/
+#define LV_DISP_DEF_REFR_PERIOD      20      /*[ms]*/
+
+/* Invalidated areas kept until a refresh (9 bytes each, more areas invalidate the whole screen).
+ * A scrolled chart plot invalidates about 20 areas (the new points, the division lines)
+ * besides the digits of the changed labels, so the default 32 would fall back to redrawing the plot.*/
+#define LV_INV_BUF_SIZE     48
 
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
@@ -91,12 +98,51 @@ typedef int32_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: find the free blocks in size classes (two-level segregated fit) instead of walking all the blocks.
+ * The free blocks are always joined with their free neighbours, `LV_MEM_AUTO_DEFRAG` is not used.
+ * LV_MEM_SIZE can be at most 256 kB */
+#  ifndef LV_MEM_TLSF
+#    define LV_MEM_TLSF  1
+#  endif
+
+/* 1: serve the most frequent small sizes from pools of fixed size blocks without headers
+ * at the beginning of the work memory: constant time and no per-block overhead.
+ * `LV_MEM_SLAB_CLASSES` lists `{size, count}` of the pools in increasing size. The sizes are multiples of 4
+ * (8 with `LV_ARCH_64`). A request goes to the smallest pool it fits in if it uses more than 7/8 of a block,
+ * to the heap if the pool is full. See `lv_mem_slab_get_stat()`. */
+#  ifndef LV_MEM_SLAB
+#    define LV_MEM_SLAB  1
+#  endif
+/* From the peak counts of `router_bench mem`: label texts (4, 8), style lists (1-2 pointers) and objects.
+ * 64 bit: 8 bytes 60 blocks, 16 bytes 25 blocks, 168 bytes (`lv_obj_t` in its list node) 23 blocks.
+ * 32 bit: not a 32 bit run (no -m32 libraries on the host), the same trace with the sizes of the callers'
+ * structures at -m32: 4 bytes 42 blocks, 8 bytes 39 blocks (the 2 pointer style lists too, so no 16 byte pool:
+ * 4 blocks), 100 bytes 24 blocks (22 objects and 96 byte text layouts). Check it with the heap of the device. */
+#  ifndef LV_MEM_SLAB_CLASSES
+#    if UINTPTR_MAX > 0xFFFFFFFFu  /*The 64 bit hosts of bench/ and tests/*/
+#      define LV_MEM_SLAB_CLASSES   {{8, 64}, {16, 32}, {168, 24}}
+#    else
+#      define LV_MEM_SLAB_CLASSES   {{4, 48}, {8, 48}, {100, 26}}
+#    endif
+#  endif
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
 #  define LV_MEM_CUSTOM_FREE    free         /*Wrapper to free*/
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: report every `lv_mem_alloc/realloc/free` and the address it was called from to a function of the application,
+ * e.g. to trace the allocations. `void LV_MEM_TRACE_CB(void * old_p, void * new_p, size_t size, void * caller)`:
+ * alloc: `old_p == NULL`, free: `new_p == NULL` and `size == 0`, failed allocation: `new_p == NULL` and `size > 0`.
+ * The caller is known with GCC and Clang. */
+#ifndef LV_MEM_TRACE
+#  define LV_MEM_TRACE    0       /*1 in the `nodemcuv2_heaptrace` environment of platformio.ini*/
+#endif
+#if LV_MEM_TRACE
+#  define LV_MEM_TRACE_CB   heapTraceLvMem  /*src/HeapTrace.cpp*/
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -160,6 +206,21 @@ typedef void * lv_anim_user_data_t;
 #define LV_SHADOW_CACHE_SIZE    0
 #endif
 
+/* Number of circles whose corner coverage is calculated once and reused by the radius masks
+ * of every rounded rectangle with the same radius. The least recently used one is replaced.
+ * A circle takes about `6 * radius` bytes from the work memory (`LV_MEM_SIZE`).
+ * LV_CIRCLE_CACHE_SIZE must be >= 1
+ * The dashboard draws 5 different radii (about 110 bytes in total).*/
+#define LV_CIRCLE_CACHE_SIZE    6
+
+/* Number of gradients (colors of a gradient or opacities of a fade mask) calculated once
+ * and reused by every rectangle and fade mask with the same stops and size.
+ * The least recently used one is replaced.
+ * A gradient takes `size * sizeof(lv_color_t)` bytes (a fade `size` bytes) from the work memory.
+ * LV_GRAD_CACHE_SIZE must be >= 1
+ * The dashboard only fades the area under the network chart series (70 bytes).*/
+#define LV_GRAD_CACHE_SIZE      2
+
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
 #define LV_USE_BLEND_MODES      1
 
@@ -235,7 +296,14 @@ typedef void * lv_img_decoder_user_data_t;
 
 /* Attribute to mark large constant arrays for example
  * font's bitmaps */
+#if defined(ARDUINO_ARCH_ESP8266)
+/* Keep the font tables in flash. Otherwise the ESP8266 copies every constant into DRAM.
+ * The flash can be read only with aligned 32 bit loads, see `LV_FONT_FMT_TXT_ALIGNED_READ`*/
+#include <pgmspace.h>
+#define LV_ATTRIBUTE_LARGE_CONST PROGMEM
+#else
 #define LV_ATTRIBUTE_LARGE_CONST
+#endif
 
 /* Prefix performance critical functions to place them into a faster memory (e.g RAM)
  * Uses 15-20 kB extra memory */
@@ -355,10 +423,19 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
 #define LV_FONT_MONTSERRAT_44    0
 #define LV_FONT_MONTSERRAT_46    0
 #define LV_FONT_MONTSERRAT_48    0
+/* The fonts of the firmware. `tools/font_subset.py` sets them to 0 when it builds subsets of them */
+#ifndef TENCENT_W7_16
 #define TENCENT_W7_16            1
+#endif
+#ifndef TENCENT_W7_22
 #define TENCENT_W7_22            1
+#endif
+#ifndef TENCENT_W7_24
 #define TENCENT_W7_24            1
+#endif
+#ifndef ICONFONT_SYMBOL
 #define ICONFONT_SYMBOL          1
+#endif
 
 /* Demonstrate special features */
 #define LV_FONT_MONTSERRAT_12_SUBPX      0
@@ -383,12 +460,36 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  * but with > 10,000 characters if you see issues probably you need to enable it.*/
 #define LV_FONT_FMT_TXT_LARGE   0
 
+/* Read the tables of the fonts (`LV_ATTRIBUTE_LARGE_CONST`) only with aligned 32 bit loads.
+ * Required if they are in a memory which can't be read by byte, e.g. the flash of ESP8266.*/
+#ifndef LV_FONT_FMT_TXT_ALIGNED_READ
+#if defined(ARDUINO_ARCH_ESP8266)
+#define LV_FONT_FMT_TXT_ALIGNED_READ    1
+#else
+#define LV_FONT_FMT_TXT_ALIGNED_READ    0
+#endif
+#endif
+
+/* Number of letters and kerning pairs (power of 2) whose glyph IDs and values are cached by every font
+ * in addition to a table of the printable ASCII letters. 0: cache only the last letter.
+ * Every font needs about 100 + 11 * LV_FONT_FMT_TXT_CACHE_SIZE bytes of RAM for them.*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE      16
+
+/* Keep the decompressed glyph bitmaps of the compressed fonts across the frames in a least recently used cache
+ * in the work memory. Its size in bytes, 0: decompress the glyphs on every draw.
+ * The cache is emptied if the work memory runs out.*/
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE    2048
+
 /* Set the pixel order of the display.
  * Important only if "subpx fonts" are used.
  * With "normal" font it doesn't matter.
  */
 #define LV_FONT_SUBPX_BGR    0
 
+/* Enable `lv_font_atlas_create()` to draw the glyphs of a declared set of letters
+ * (e.g. digits) from pre-expanded 8 bit coverage maps instead of the font's bitmaps.*/
+#define LV_USE_FONT_ATLAS    1
+
 /*Declare the type of the user data of fonts (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_font_user_data_t;
 
@@ -592,6 +693,14 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Keep the line breaks and letter positions of the labels with texts up to this many bytes
+ *to get their size and draw them without measuring the letters again. 0: measure them on every draw*/
+#  define LV_LABEL_LAYOUT_CACHE_LEN       32
+
+/*1: Allow writing the text of a label into cells of fixed width with tabular digits (`lv_label_set_cells`)
+ *to keep its size and redraw only the changed letters*/
+#  define LV_LABEL_CELLS                  1
 #endif
 
 /*LED (dependencies: -)*/
@@ -91,12 +91,34 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: find the free blocks in size classes (two-level segregated fit) instead of walking all the blocks.
+ * The free blocks are always joined with their free neighbours, `LV_MEM_AUTO_DEFRAG` is not used.
+ * LV_MEM_SIZE can be at most 256 kB */
+#  define LV_MEM_TLSF  0
+
+/* 1: serve the most frequent small sizes from pools of fixed size blocks without headers
+ * at the beginning of the work memory: constant time and no per-block overhead.
+ * `LV_MEM_SLAB_CLASSES` lists `{size, count}` of the pools in increasing size. The sizes are multiples of 4
+ * (8 with `LV_ARCH_64`). A request goes to the smallest pool it fits in if it uses more than 7/8 of a block,
+ * to the heap if the pool is full. See `lv_mem_slab_get_stat()`. */
+#  define LV_MEM_SLAB  0
+#  define LV_MEM_SLAB_CLASSES   {{8, 32}, {16, 32}}
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
 #  define LV_MEM_CUSTOM_FREE    free         /*Wrapper to free*/
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: report every `lv_mem_alloc/realloc/free` and the address it was called from to a function of the application,
+ * e.g. to trace the allocations. `void LV_MEM_TRACE_CB(void * old_p, void * new_p, size_t size, void * caller)`:
+ * alloc: `old_p == NULL`, free: `new_p == NULL` and `size == 0`, failed allocation: `new_p == NULL` and `size > 0`.
+ * The caller is known with GCC and Clang. */
+#define LV_MEM_TRACE    0
+#if LV_MEM_TRACE
+#  define LV_MEM_TRACE_CB   my_mem_trace_cb
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -160,6 +182,19 @@ typedef void * lv_anim_user_data_t;
 #define LV_SHADOW_CACHE_SIZE    0
 #endif
 
+/* Number of circles whose corner coverage is calculated once and reused by the radius masks
+ * of every rounded rectangle with the same radius. The least recently used one is replaced.
+ * A circle takes about `6 * radius` bytes from the work memory (`LV_MEM_SIZE`).
+ * LV_CIRCLE_CACHE_SIZE must be >= 1 */
+#define LV_CIRCLE_CACHE_SIZE    4
+
+/* Number of gradients (colors of a gradient or opacities of a fade mask) calculated once
+ * and reused by every rectangle and fade mask with the same stops and size.
+ * The least recently used one is replaced.
+ * A gradient takes `size * sizeof(lv_color_t)` bytes (a fade `size` bytes) from the work memory.
+ * LV_GRAD_CACHE_SIZE must be >= 1 */
+#define LV_GRAD_CACHE_SIZE      4
+
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
 #define LV_USE_BLEND_MODES      1
 
@@ -379,12 +414,30 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  * but with > 10,000 characters if you see issues probably you need to enable it.*/
 #define LV_FONT_FMT_TXT_LARGE   0
 
+/* Read the tables of the fonts (`LV_ATTRIBUTE_LARGE_CONST`) only with aligned 32 bit loads.
+ * Required if they are in a memory which can't be read by byte, e.g. the flash of ESP8266.*/
+#define LV_FONT_FMT_TXT_ALIGNED_READ    0
+
+/* Number of letters and kerning pairs (power of 2) whose glyph IDs and values are cached by every font
+ * in addition to a table of the printable ASCII letters. 0: cache only the last letter.
+ * Every font needs about 100 + 11 * LV_FONT_FMT_TXT_CACHE_SIZE bytes of RAM for them.*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE      32
+
+/* Keep the decompressed glyph bitmaps of the compressed fonts across the frames in a least recently used cache
+ * in the work memory. Its size in bytes, 0: decompress the glyphs on every draw.
+ * The cache is emptied if the work memory runs out.*/
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE    0
+
 /* Set the pixel order of the display.
  * Important only if "subpx fonts" are used.
  * With "normal" font it doesn't matter.
  */
 #define LV_FONT_SUBPX_BGR    0
 
+/* Enable `lv_font_atlas_create()` to draw the glyphs of a declared set of letters
+ * (e.g. digits) from pre-expanded 8 bit coverage maps instead of the font's bitmaps.*/
+#define LV_USE_FONT_ATLAS    1
+
 /*Declare the type of the user data of fonts (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_font_user_data_t;
 
@@ -585,6 +638,14 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Keep the line breaks and letter positions of the labels with texts up to this many bytes
+ *to get their size and draw them without measuring the letters again. 0: measure them on every draw*/
+#  define LV_LABEL_LAYOUT_CACHE_LEN       0
+
+/*1: Allow writing the text of a label into cells of fixed width with tabular digits (`lv_label_set_cells`)
+ *to keep its size and redraw only the changed letters*/
+#  define LV_LABEL_CELLS                  0
 #endif
 
 /*LED (dependencies: -)*/
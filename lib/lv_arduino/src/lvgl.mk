@@ -7,4 +7,5 @@ include $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_themes/lv_themes.mk
 include $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_draw/lv_draw.mk
 include $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_gpu/lv_gpu.mk
 
-
+# RGB565 blend kernels shared with TFT_eSPI (found by PlatformIO's library finder on the device)
+CFLAGS += "-I$(LVGL_DIR)/../rgb565_blend"
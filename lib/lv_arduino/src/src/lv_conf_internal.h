@@ -135,6 +135,25 @@
 #ifndef LV_MEM_AUTO_DEFRAG
 #  define LV_MEM_AUTO_DEFRAG  1
 #endif
+
+/* 1: find the free blocks in size classes (two-level segregated fit) instead of walking all the blocks.
+ * The free blocks are always joined with their free neighbours, `LV_MEM_AUTO_DEFRAG` is not used.
+ * LV_MEM_SIZE can be at most 256 kB */
+#ifndef LV_MEM_TLSF
+#  define LV_MEM_TLSF  0
+#endif
+
+/* 1: serve the most frequent small sizes from pools of fixed size blocks without headers
+ * at the beginning of the work memory: constant time and no per-block overhead.
+ * `LV_MEM_SLAB_CLASSES` lists `{size, count}` of the pools in increasing size. The sizes are multiples of 4
+ * (8 with `LV_ARCH_64`). A request goes to the smallest pool it fits in if it uses more than 7/8 of a block,
+ * to the heap if the pool is full. See `lv_mem_slab_get_stat()`. */
+#ifndef LV_MEM_SLAB
+#  define LV_MEM_SLAB  0
+#endif
+#ifndef LV_MEM_SLAB_CLASSES
+#  define LV_MEM_SLAB_CLASSES   {{8, 32}, {16, 32}}
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
@@ -147,6 +166,19 @@
 #endif
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: report every `lv_mem_alloc/realloc/free` and the address it was called from to a function of the application,
+ * e.g. to trace the allocations. `void LV_MEM_TRACE_CB(void * old_p, void * new_p, size_t size, void * caller)`:
+ * alloc: `old_p == NULL`, free: `new_p == NULL` and `size == 0`, failed allocation: `new_p == NULL` and `size > 0`.
+ * The caller is known with GCC and Clang. */
+#ifndef LV_MEM_TRACE
+#define LV_MEM_TRACE    0
+#endif
+#if LV_MEM_TRACE
+#ifndef LV_MEM_TRACE_CB
+#  define LV_MEM_TRACE_CB   my_mem_trace_cb
+#endif
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -237,6 +269,23 @@
 #endif
 #endif
 
+/* Number of circles whose corner coverage is calculated once and reused by the radius masks
+ * of every rounded rectangle with the same radius. The least recently used one is replaced.
+ * A circle takes about `6 * radius` bytes from the work memory (`LV_MEM_SIZE`).
+ * LV_CIRCLE_CACHE_SIZE must be >= 1 */
+#ifndef LV_CIRCLE_CACHE_SIZE
+#define LV_CIRCLE_CACHE_SIZE    4
+#endif
+
+/* Number of gradients (colors of a gradient or opacities of a fade mask) calculated once
+ * and reused by every rectangle and fade mask with the same stops and size.
+ * The least recently used one is replaced.
+ * A gradient takes `size * sizeof(lv_color_t)` bytes (a fade `size` bytes) from the work memory.
+ * LV_GRAD_CACHE_SIZE must be >= 1 */
+#ifndef LV_GRAD_CACHE_SIZE
+#define LV_GRAD_CACHE_SIZE      4
+#endif
+
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
 #ifndef LV_USE_BLEND_MODES
 #define LV_USE_BLEND_MODES      1
@@ -569,6 +618,26 @@
 #define LV_FONT_FMT_TXT_LARGE   0
 #endif
 
+/* Read the tables of the fonts (`LV_ATTRIBUTE_LARGE_CONST`) only with aligned 32 bit loads.
+ * Required if they are in a memory which can't be read by byte, e.g. the flash of ESP8266.*/
+#ifndef LV_FONT_FMT_TXT_ALIGNED_READ
+#define LV_FONT_FMT_TXT_ALIGNED_READ    0
+#endif
+
+/* Number of letters and kerning pairs (power of 2) whose glyph IDs and values are cached by every font
+ * in addition to a table of the printable ASCII letters. 0: cache only the last letter.
+ * Every font needs about 100 + 11 * LV_FONT_FMT_TXT_CACHE_SIZE bytes of RAM for them.*/
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+#define LV_FONT_FMT_TXT_CACHE_SIZE      32
+#endif
+
+/* Keep the decompressed glyph bitmaps of the compressed fonts across the frames in a least recently used cache
+ * in the work memory. Its size in bytes, 0: decompress the glyphs on every draw.
+ * The cache is emptied if the work memory runs out.*/
+#ifndef LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE    0
+#endif
+
 /* Set the pixel order of the display.
  * Important only if "subpx fonts" are used.
  * With "normal" font it doesn't matter.
@@ -577,6 +646,12 @@
 #define LV_FONT_SUBPX_BGR    0
 #endif
 
+/* Enable `lv_font_atlas_create()` to draw the glyphs of a declared set of letters
+ * (e.g. digits) from pre-expanded 8 bit coverage maps instead of the font's bitmaps.*/
+#ifndef LV_USE_FONT_ATLAS
+#define LV_USE_FONT_ATLAS    1
+#endif
+
 /*Declare the type of the user data of fonts (can be e.g. `void *`, `int`, `struct`)*/
 
 /*================
@@ -885,6 +960,18 @@
 #ifndef LV_LABEL_LONG_TXT_HINT
 #  define LV_LABEL_LONG_TXT_HINT          0
 #endif
+
+/*Keep the line breaks and letter positions of the labels with texts up to this many bytes
+ *to get their size and draw them without measuring the letters again. 0: measure them on every draw*/
+#ifndef LV_LABEL_LAYOUT_CACHE_LEN
+#  define LV_LABEL_LAYOUT_CACHE_LEN       0
+#endif
+
+/*1: Allow writing the text of a label into cells of fixed width with tabular digits (`lv_label_set_cells`)
+ *to keep its size and redraw only the changed letters*/
+#ifndef LV_LABEL_CELLS
+#  define LV_LABEL_CELLS                  0
+#endif
 #endif
 
 /*LED (dependencies: -)*/
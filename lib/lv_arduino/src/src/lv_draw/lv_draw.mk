@@ -1,6 +1,7 @@
 CSRCS += lv_draw_mask.c
 CSRCS += lv_draw_blend.c
 CSRCS += lv_draw_rect.c
+CSRCS += lv_draw_grad.c
 CSRCS += lv_draw_label.c
 CSRCS += lv_draw_line.c
 CSRCS += lv_draw_img.c
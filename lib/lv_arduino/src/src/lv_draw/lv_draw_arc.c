@@ -7,43 +7,75 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_arc.h"
-#include "lv_draw_rect.h"
+#include "lv_draw_blend.h"
 #include "lv_draw_mask.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
-#define SPLIT_RADIUS_LIMIT 10  /*With radius greater then this the arc will drawn in quarters. A quarter is drawn only if there is arc in it */
-#define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
+#define RING_RADIUS_MAX 4095    /*Keeps every squared distance and edge function of the rasterizer in 32 bit*/
+#define RING_FIX_SHIFT  16      /*Fractional bits of the precomputed reciprocals*/
+#define RING_RUN_MIN_LEN 32     /*Shorter spans are cheaper pixel by pixel than splitting them into runs*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+/* A round cap is a disc of `width` diameter on the middle of the ring.
+ * Coordinates are relative to the ring's center in 1/16 pixel units.*/
+typedef struct {
+    lv_area_t area;     /*Absolute bounding box of the cap*/
+    int32_t x;
+    int32_t y;
+} ring_cap_t;
+
+/* The ring is rasterized in "doubled" coordinates: the center lies on the pixel corner
+ * at (center_x, center_y), so the center of pixel `px` is at `X = 2 * (px - center_x) + 1`.
+ * Squared distances are compared against the squares of the edge radii +/- half a pixel,
+ * and the anti-aliased coverage of the edges is linear in the squared distance:
+ * (R^2 - d^2) / 2R differs from (R - d) by less than 1/(8R) pixel.*/
 typedef struct {
     lv_coord_t center_x;
     lv_coord_t center_y;
-    lv_coord_t radius;
-    uint16_t start_angle;
-    uint16_t end_angle;
-    uint16_t start_quarter;
-    uint16_t end_quarter;
-    lv_coord_t width;
-    lv_draw_rect_dsc_t * draw_dsc;
-    const lv_area_t * draw_area;
-    const lv_area_t * clip_area;
-} quarter_draw_dsc_t;
-
+    uint32_t out_sq;        /*(2r + 1)^2: nothing is covered from here*/
+    uint32_t out_full_sq;   /*(2r - 1)^2: fully covered below (unless in the hole)*/
+    uint32_t out_recip;     /*255 / (out_sq - out_full_sq)*/
+    uint32_t in_sq;         /*(2r_in - 1)^2: nothing is covered below, the hole*/
+    uint32_t in_full_sq;    /*(2r_in + 1)^2*/
+    uint32_t in_recip;
+    /*Unit vectors of the start and end edges (Q14).
+     *The arc is the intersection of the two half planes, or their union if it's wider than 180 deg.*/
+    int32_t start_sin;
+    int32_t start_cos;
+    int32_t end_sin;
+    int32_t end_cos;
+    uint8_t full_ring : 1;
+    uint8_t has_hole : 1;
+    uint8_t wide : 1;
+    uint8_t cap_cnt;
+    ring_cap_t caps[2];
+    uint32_t cap_out_sq;    /*(8w + 8)^2 in 1/16 px: the cap's radius + half a pixel*/
+    uint32_t cap_full_sq;   /*(8w - 8)^2*/
+    uint32_t cap_recip;
+} ring_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void draw_quarter_0(quarter_draw_dsc_t * q);
-static void draw_quarter_1(quarter_draw_dsc_t * q);
-static void draw_quarter_2(quarter_draw_dsc_t * q);
-static void draw_quarter_3(quarter_draw_dsc_t * q);
-static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t tickness, lv_area_t * res_area);
-
+static void ring_init(ring_dsc_t * r, lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                      uint16_t start_angle, uint16_t end_angle, bool full_ring, const lv_draw_line_dsc_t * dsc);
+static void ring_get_area(const ring_dsc_t * r, lv_coord_t radius, lv_coord_t width, uint16_t start_angle,
+                          uint16_t end_angle, lv_area_t * res_area);
+static bool angle_in_arc(uint16_t angle, uint16_t start_angle, uint16_t end_angle);
+static void ring_radial_row(const ring_dsc_t * r, lv_opa_t * mask_buf, int32_t dx, uint32_t dy_sq, lv_coord_t len);
+static void ring_wedge_row(const ring_dsc_t * r, lv_opa_t * mask_buf, int32_t dx, uint32_t dy_sq, int32_t vs,
+                           int32_t ve, lv_coord_t len);
+static uint8_t ring_edge_breaks(lv_coord_t * brk, int32_t v, int32_t step, lv_coord_t len);
+static void ring_draw_span(const ring_dsc_t * r, lv_coord_t y, lv_coord_t x1, lv_coord_t x2, lv_opa_t * mask_buf,
+                           const lv_area_t * clip_area, const lv_draw_line_dsc_t * dsc);
+static lv_coord_t ring_px_cnt(int32_t sq);
+static uint32_t ring_isqrt(uint32_t x);
 
 /**********************
  *  STATIC VARIABLES
@@ -59,14 +91,15 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t tickness,
 
 /**
  * Draw an arc. (Can draw pie too with great thickness.)
+ * The ring is rasterized span by span: on every row only the pixels between the inner and outer circle are visited,
+ * their coverage is calculated directly (no mask stack) and the opaque parts are blended as full cover runs.
  * @param center_x the x coordinate of the center of the arc
  * @param center_y the y coordinate of the center of the arc
  * @param radius the radius of the arc
  * @param mask the arc will be drawn only in this mask
- * @param start_angle the start angle of the arc (0 deg on the bottom, 90 deg on the right)
+ * @param start_angle the start angle of the arc (0 deg on the right, 90 deg on the bottom)
  * @param end_angle the end angle of the arc
- * @param style style of the arc (`body.thickness`, `body.main_color`, `body.opa` is used)
- * @param opa_scale scale down all opacities by the factor
+ * @param dsc `width`, `color`, `opa`, `blend_mode`, `round_start` and `round_end` are used
  */
 void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uint16_t start_angle, uint16_t end_angle,
                  const lv_area_t * clip_area, lv_draw_line_dsc_t * dsc)
@@ -75,360 +108,460 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
     if(dsc->width == 0) return;
     if(start_angle == end_angle) return;
 
+    if(radius == 0) return;
+    if(radius > RING_RADIUS_MAX) radius = RING_RADIUS_MAX;
     if(dsc->width > radius) dsc->width = radius;
 
-    lv_draw_rect_dsc_t cir_dsc;
-    lv_draw_rect_dsc_init(&cir_dsc);
-    cir_dsc.radius = LV_RADIUS_CIRCLE;
-    cir_dsc.bg_opa = LV_OPA_TRANSP;
-    cir_dsc.border_opa = dsc->opa;
-    cir_dsc.border_color = dsc->color;
-    cir_dsc.border_width = dsc->width;
-    cir_dsc.border_blend_mode = dsc->blend_mode;
-
-    lv_area_t area;
-    area.x1 = center_x - radius;
-    area.y1 = center_y - radius;
-    area.x2 = center_x + radius - 1;  /*-1 because the center already belongs to the left/bottom part*/
-    area.y2 = center_y + radius - 1;
-
-    /*Draw a full ring*/
-    if(start_angle + 360 == end_angle || start_angle == end_angle + 360) {
-        lv_draw_rect(&area, clip_area, &cir_dsc);
-        return;
-    }
+    bool full_ring = start_angle + 360 == end_angle || start_angle == end_angle + 360;
 
     if(start_angle >= 360) start_angle -= 360;
     if(end_angle >= 360) end_angle -= 360;
 
-    lv_draw_mask_angle_param_t mask_angle_param;
-    lv_draw_mask_angle_init(&mask_angle_param, center_x, center_y, start_angle, end_angle);
+    ring_dsc_t ring;
+    ring_init(&ring, center_x, center_y, radius, dsc->width, start_angle, end_angle, full_ring, dsc);
 
-    int16_t mask_angle_id = lv_draw_mask_add(&mask_angle_param, NULL);
+    lv_area_t arc_area;
+    ring_get_area(&ring, radius, dsc->width, start_angle, end_angle, &arc_area);
 
-    int32_t angle_gap;
-    if(end_angle > start_angle) {
-        angle_gap = 360 - (end_angle - start_angle);
-    }
-    else {
-        angle_gap = start_angle - end_angle;
-    }
-    if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
-        /*Handle each quarter individually and skip which is empty*/
-        quarter_draw_dsc_t q_dsc;
-        q_dsc.center_x = center_x;
-        q_dsc.center_y = center_y;
-        q_dsc.radius = radius;
-        q_dsc.start_angle = start_angle;
-        q_dsc.end_angle = end_angle;
-        q_dsc.start_quarter = (start_angle / 90) & 0x3;
-        q_dsc.end_quarter = (end_angle / 90) & 0x3;
-        q_dsc.width = dsc->width;
-        q_dsc.draw_dsc =  &cir_dsc;
-        q_dsc.draw_area = &area;
-        q_dsc.clip_area = clip_area;
-
-        draw_quarter_0(&q_dsc);
-        draw_quarter_1(&q_dsc);
-        draw_quarter_2(&q_dsc);
-        draw_quarter_3(&q_dsc);
-    }
-    else {
-        lv_draw_rect(&area, clip_area, &cir_dsc);
-    }
-    lv_draw_mask_remove_id(mask_angle_id);
+    lv_area_t draw_area;
+    if(_lv_area_intersect(&draw_area, &arc_area, clip_area) == false) return;
 
-    if(dsc->round_start || dsc->round_end) {
-        cir_dsc.bg_color        = dsc->color;
-        cir_dsc.bg_opa        = dsc->opa;
-        cir_dsc.bg_blend_mode = dsc->blend_mode;
-        cir_dsc.border_width = 0;
-
-        lv_area_t round_area;
-        if(dsc->round_start) {
-            get_rounded_area(start_angle, radius, dsc->width, &round_area);
-            round_area.x1 += center_x;
-            round_area.x2 += center_x;
-            round_area.y1 += center_y;
-            round_area.y2 += center_y;
-
-            lv_draw_rect(&round_area, clip_area, &cir_dsc);
-        }
+    lv_opa_t * mask_buf = _lv_mem_buf_get(lv_area_get_width(&draw_area));
+
+    lv_coord_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        int32_t dy = 2 * (y - center_y) + 1;
+        uint32_t dy_sq = dy * dy;
+        if(dy_sq >= ring.out_sq) continue;
 
-        if(dsc->round_end) {
-            get_rounded_area(end_angle, radius, dsc->width, &round_area);
-            round_area.x1 += center_x;
-            round_area.x2 += center_x;
-            round_area.y1 += center_y;
-            round_area.y2 += center_y;
+        /*The row crosses the ring in one span, or in two if it crosses the hole too*/
+        lv_coord_t out_cnt = ring_px_cnt(ring.out_sq - 1 - dy_sq);
+        lv_coord_t hole_cnt = ring.has_hole ? ring_px_cnt((int32_t)ring.in_sq - (int32_t)dy_sq) : 0;
 
-            lv_draw_rect(&round_area, clip_area, &cir_dsc);
+        if(hole_cnt == 0) {
+            ring_draw_span(&ring, y, center_x - out_cnt, center_x + out_cnt - 1, mask_buf, &draw_area, dsc);
+        }
+        else {
+            ring_draw_span(&ring, y, center_x - out_cnt, center_x - hole_cnt - 1, mask_buf, &draw_area, dsc);
+            ring_draw_span(&ring, y, center_x + hole_cnt, center_x + out_cnt - 1, mask_buf, &draw_area, dsc);
         }
     }
+
+    _lv_mem_buf_release(mask_buf);
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static void draw_quarter_0(quarter_draw_dsc_t * q)
+static void ring_init(ring_dsc_t * r, lv_coord_t center_x, lv_coord_t center_y, lv_coord_t radius, lv_coord_t width,
+                      uint16_t start_angle, uint16_t end_angle, bool full_ring, const lv_draw_line_dsc_t * dsc)
 {
-    lv_area_t quarter_area;
-
-    if(q->start_quarter == 0 && q->end_quarter == 0 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-        quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-
-        quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
-        quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    _lv_memset_00(r, sizeof(ring_dsc_t));
+
+    r->center_x = center_x;
+    r->center_y = center_y;
+
+    uint32_t d = 2 * radius;
+    r->out_sq = (d + 1) * (d + 1);
+    r->out_full_sq = (d - 1) * (d - 1);
+    r->out_recip = (255 << RING_FIX_SHIFT) / (r->out_sq - r->out_full_sq);
+
+    lv_coord_t radius_in = radius - width;
+    if(radius_in > 0) {
+        d = 2 * radius_in;
+        r->has_hole = 1;
+        r->in_sq = (d - 1) * (d - 1);
+        r->in_full_sq = (d + 1) * (d + 1);
+        r->in_recip = (255 << RING_FIX_SHIFT) / (r->in_full_sq - r->in_sq);
+    }
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+    if(full_ring) {
+        r->full_ring = 1;
+        return;
     }
-    else if(q->start_quarter == 0 || q->end_quarter == 0) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 0) {
-            quarter_area.x1 = q->center_x;
-            quarter_area.y2 = q->center_y + q->radius;
 
-            quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
+    r->start_sin = _lv_trigo_sin(start_angle) >> 1;
+    r->start_cos = _lv_trigo_sin(start_angle + 90) >> 1;
+    r->end_sin = _lv_trigo_sin(end_angle) >> 1;
+    r->end_cos = _lv_trigo_sin(end_angle + 90) >> 1;
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
-        }
-        if(q->end_quarter == 0) {
-            quarter_area.x2 = q->center_x + q->radius;
-            quarter_area.y1 = q->center_y;
+    int32_t span = end_angle > start_angle ? end_angle - start_angle : end_angle + 360 - start_angle;
+    r->wide = span > 180 ? 1 : 0;
 
-            quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
-            quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+    if(dsc->round_start || dsc->round_end) {
+        /*Center of the caps on the middle of the ring in 1/16 px. Q15 sine but radius <= 4095 so it fits*/
+        int32_t mid_r = 16 * radius - 8 * width;
+        int32_t cap_r = 8 * width;
+        uint16_t angles[2] = {start_angle, end_angle};
+        bool enabled[2] = {dsc->round_start, dsc->round_end};
+        uint8_t i;
+        for(i = 0; i < 2; i++) {
+            if(!enabled[i]) continue;
+            ring_cap_t * cap = &r->caps[r->cap_cnt];
+            cap->x = (mid_r * _lv_trigo_sin(angles[i] + 90)) >> LV_TRIGO_SHIFT;
+            cap->y = (mid_r * _lv_trigo_sin(angles[i])) >> LV_TRIGO_SHIFT;
+            cap->area.x1 = center_x + ((cap->x - cap_r) >> 4) - 1;
+            cap->area.x2 = center_x + ((cap->x + cap_r) >> 4) + 1;
+            cap->area.y1 = center_y + ((cap->y - cap_r) >> 4) - 1;
+            cap->area.y2 = center_y + ((cap->y + cap_r) >> 4) + 1;
+            r->cap_cnt++;
         }
-    }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 0 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 2 && q->end_quarter == 1) ||
-            (q->start_quarter == 3 && q->end_quarter == 2) ||
-            (q->start_quarter == 3 && q->end_quarter == 1)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center_x;
-        quarter_area.y1 = q->center_y;
-        quarter_area.x2 = q->center_x + q->radius;
-        quarter_area.y2 = q->center_y + q->radius;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+
+        r->cap_out_sq = (cap_r + 8) * (cap_r + 8);
+        r->cap_full_sq = (cap_r - 8) * (cap_r - 8);
+        r->cap_recip = (255 << RING_FIX_SHIFT) / (r->cap_out_sq - r->cap_full_sq);
     }
 }
 
-static void draw_quarter_1(quarter_draw_dsc_t * q)
+static bool angle_in_arc(uint16_t angle, uint16_t start_angle, uint16_t end_angle)
 {
-    lv_area_t quarter_area;
-
-    if(q->start_quarter == 1 && q->end_quarter == 1 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
-        quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-
-        quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-        quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
+    if(start_angle <= end_angle) return angle >= start_angle && angle <= end_angle;
+    else return angle >= start_angle || angle <= end_angle;
+}
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+/**
+ * Get the bounding box of the arc: the ends on the inner and outer circle, the points
+ * where the arc crosses an axis and the caps. Rows and columns outside of it are not visited.
+ */
+static void ring_get_area(const ring_dsc_t * r, lv_coord_t radius, lv_coord_t width, uint16_t start_angle,
+                          uint16_t end_angle, lv_area_t * res_area)
+{
+    res_area->x1 = r->center_x - radius;
+    res_area->y1 = r->center_y - radius;
+    res_area->x2 = r->center_x + radius - 1;  /*-1 because the center already belongs to the right/bottom part*/
+    res_area->y2 = r->center_y + radius - 1;
+
+    if(r->full_ring) return;
+
+    int32_t x_min = radius;
+    int32_t x_max = -radius;
+    int32_t y_min = radius;
+    int32_t y_max = -radius;
+
+    lv_coord_t rads[2] = {radius, radius - width};
+    uint16_t angles[6] = {start_angle, end_angle, 0, 90, 180, 270};
+    uint8_t i;
+    for(i = 0; i < 6; i++) {
+        if(i >= 2 && !angle_in_arc(angles[i], start_angle, end_angle)) continue;
+        int32_t s = _lv_trigo_sin(angles[i]);
+        int32_t c = _lv_trigo_sin(angles[i] + 90);
+        uint8_t j;
+        for(j = 0; j < (i < 2 ? 2 : 1); j++) {
+            int32_t x = (rads[j] * c) >> LV_TRIGO_SHIFT;
+            int32_t y = (rads[j] * s) >> LV_TRIGO_SHIFT;
+            x_min = LV_MATH_MIN(x_min, x);
+            x_max = LV_MATH_MAX(x_max, x);
+            y_min = LV_MATH_MIN(y_min, y);
+            y_max = LV_MATH_MAX(y_max, y);
+        }
     }
-    else if(q->start_quarter == 1 || q->end_quarter == 1) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 1) {
-            quarter_area.x1 = q->center_x - q->radius;
-            quarter_area.y1 = q->center_y;
 
-            quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
-            quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    /*One more pixel for the rounding and the anti-aliasing*/
+    lv_area_t a;
+    a.x1 = r->center_x + x_min - 1;
+    a.x2 = r->center_x + x_max;
+    a.y1 = r->center_y + y_min - 1;
+    a.y2 = r->center_y + y_max;
+
+    for(i = 0; i < r->cap_cnt; i++) {
+        a.x1 = LV_MATH_MIN(a.x1, r->caps[i].area.x1);
+        a.x2 = LV_MATH_MAX(a.x2, r->caps[i].area.x2);
+        a.y1 = LV_MATH_MIN(a.y1, r->caps[i].area.y1);
+        a.y2 = LV_MATH_MAX(a.y2, r->caps[i].area.y2);
+    }
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
-        }
-        if(q->end_quarter == 1) {
-            quarter_area.x2 = q->center_x - 1;
-            quarter_area.y2 = q->center_y + q->radius;
+    _lv_area_intersect(res_area, res_area, &a);
+}
 
-            quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
+/**
+ * Coverage of a pixel by a straight edge of the arc
+ * @param v signed distance of the pixel's center from the edge in 1/32768 px (1/2 px in Q14)
+ */
+static inline lv_opa_t ring_edge_cover(int32_t v)
+{
+    int32_t c = 128 + (v >> 7);
+    if(c <= 0) return LV_OPA_TRANSP;
+    if(c >= 255) return LV_OPA_COVER;
+    return c;
+}
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
-        }
-    }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 1 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 0 && q->end_quarter == 2) ||
-            (q->start_quarter == 0 && q->end_quarter == 3) ||
-            (q->start_quarter == 3 && q->end_quarter == 2)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center_x - q->radius;
-        quarter_area.y1 = q->center_y;
-        quarter_area.x2 = q->center_x - 1;
-        quarter_area.y2 = q->center_y + q->radius;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+static inline lv_opa_t ring_radial_cover(const ring_dsc_t * r, uint32_t d_sq)
+{
+    uint32_t c = LV_OPA_COVER;
+    if(d_sq > r->out_full_sq) c = ((r->out_sq - d_sq) * r->out_recip) >> RING_FIX_SHIFT;
+    if(d_sq < r->in_full_sq) {
+        uint32_t c_in = ((d_sq - r->in_sq) * r->in_recip) >> RING_FIX_SHIFT;
+        if(c_in < c) c = c_in;
     }
+    return c;
 }
 
-static void draw_quarter_2(quarter_draw_dsc_t * q)
+/**
+ * Radial coverage of `len` pixels where the wedge covers every pixel.
+ * Only the anti-aliased bands are calculated, the pixels between them are set in runs.
+ */
+static void ring_radial_row(const ring_dsc_t * r, lv_opa_t * mask_buf, int32_t dx, uint32_t dy_sq, lv_coord_t len)
 {
-    lv_area_t quarter_area;
-
-    if(q->start_quarter == 2 && q->end_quarter == 2 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-        quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    lv_coord_t i;
+    if(len < RING_RUN_MIN_LEN) {
+        for(i = 0; i < len; i++, dx += 2) {
+            uint32_t d_sq = dx * dx + dy_sq;
+            mask_buf[i] = (d_sq > r->out_full_sq || d_sq < r->in_full_sq) ? ring_radial_cover(r, d_sq) : LV_OPA_COVER;
+        }
+        return;
+    }
 
-        quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
-        quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    /*The pixels with `full_min <= |dx| <= full_max` are fully covered*/
+    int32_t full_max = -1;
+    if(r->out_full_sq >= dy_sq) full_max = ring_isqrt(r->out_full_sq - dy_sq);
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+    int32_t full_min = 0;
+    if(r->in_full_sq > dy_sq) {
+        uint32_t sq = r->in_full_sq - dy_sq;
+        full_min = ring_isqrt(sq);
+        if((uint32_t)(full_min * full_min) < sq) full_min++;
     }
-    else if(q->start_quarter == 2 || q->end_quarter == 2) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 2) {
-            quarter_area.x2 = q->center_x - 1;
-            quarter_area.y1 = q->center_y - q->radius;
-
-            quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-            quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+    i = 0;
+    while(i < len) {
+        int32_t abs_dx = dx < 0 ? -dx : dx;
+        if(abs_dx >= full_min && abs_dx <= full_max) {
+            int32_t dx_last = (dx < 0 && full_min > 0) ? -full_min : full_max;
+            lv_coord_t run = LV_MATH_MIN((dx_last - dx) / 2 + 1, len - i);
+            _lv_memset_ff(&mask_buf[i], run);
+            i += run;
+            dx += 2 * run;
         }
-        if(q->end_quarter == 2) {
-            quarter_area.x1 = q->center_x - q->radius;
-            quarter_area.y2 = q->center_y - 1;
-
-            quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
-
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        else {
+            mask_buf[i] = ring_radial_cover(r, dx * dx + dy_sq);
+            i++;
+            dx += 2;
         }
     }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 2 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 0 && q->end_quarter == 3) ||
-            (q->start_quarter == 1 && q->end_quarter == 3) ||
-            (q->start_quarter == 1 && q->end_quarter == 0)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center_x - q->radius;
-        quarter_area.y1 = q->center_y - q->radius;
-        quarter_area.x2 = q->center_x - 1;
-        quarter_area.y2 = q->center_y - 1;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
-    }
 }
 
+/**
+ * Coverage of `len` pixels crossed by the start and/or end edge: the wedge's coverage times the radial coverage
+ */
+static void ring_wedge_row(const ring_dsc_t * r, lv_opa_t * mask_buf, int32_t dx, uint32_t dy_sq, int32_t vs,
+                           int32_t ve, lv_coord_t len)
+{
+    int32_t vs_step = -2 * r->start_sin;
+    int32_t ve_step = 2 * r->end_sin;
+    lv_coord_t i;
+    for(i = 0; i < len; i++, dx += 2, vs += vs_step, ve += ve_step) {
+        lv_opa_t s = ring_edge_cover(vs);
+        lv_opa_t e = ring_edge_cover(ve);
+
+        lv_opa_t a;
+        if(r->wide) a = s > e ? s : e;
+        else a = s < e ? s : e;
+
+        if(a == LV_OPA_TRANSP) {
+            mask_buf[i] = LV_OPA_TRANSP;
+            continue;
+        }
 
-static void draw_quarter_3(quarter_draw_dsc_t * q)
+        lv_opa_t rad = ring_radial_cover(r, dx * dx + dy_sq);
+        if(a == LV_OPA_COVER) mask_buf[i] = rad;
+        else if(rad == LV_OPA_COVER) mask_buf[i] = a;
+        else mask_buf[i] = LV_MATH_UDIV255(a * rad);
+    }
+}
+
+/**
+ * Add the pixel indices where an edge's coverage starts and stops changing along a row
+ * @param brk append the indices here
+ * @param v signed distance of the first pixel from the edge
+ * @param step change of `v` by pixel
+ * @param len length of the span
+ * @return number of indices added
+ */
+static uint8_t ring_edge_breaks(lv_coord_t * brk, int32_t v, int32_t step, lv_coord_t len)
 {
-    lv_area_t quarter_area;
+    if(step == 0) return 0;
+
+    /*Partial coverage is between -1/2 and +1/2 px*/
+    int32_t i1 = (-(128 << 7) - v) / step;
+    int32_t i2 = ((127 << 7) - v) / step;
+    if(i1 > i2) {
+        int32_t t = i1;
+        i1 = i2;
+        i2 = t;
+    }
 
-    if(q->start_quarter == 3 && q->end_quarter == 3 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-        quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
+    uint8_t n = 0;
+    if(i1 > 0 && i1 < len) brk[n++] = i1;
+    if(i2 + 1 > 0 && i2 + 1 < len) brk[n++] = i2 + 1;
+    return n;
+}
 
-        quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-        quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+/**
+ * Calculate the coverage of the pixels `x1..x2` of row `y` and blend them.
+ * The span is between the inner and outer circle, so only the edges need per pixel work:
+ * the span is split where the start and end edges cross it and the parts fully inside or outside the wedge
+ * are handled without evaluating the edges.
+ */
+static void ring_draw_span(const ring_dsc_t * r, lv_coord_t y, lv_coord_t x1, lv_coord_t x2, lv_opa_t * mask_buf,
+                           const lv_area_t * clip_area, const lv_draw_line_dsc_t * dsc)
+{
+    if(x1 < clip_area->x1) x1 = clip_area->x1;
+    if(x2 > clip_area->x2) x2 = clip_area->x2;
+    if(x1 > x2) return;
+
+    lv_coord_t len = x2 - x1 + 1;
+    int32_t dx = 2 * (x1 - r->center_x) + 1;
+    int32_t dy = 2 * (y - r->center_y) + 1;
+    uint32_t dy_sq = dy * dy;
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+    if(r->full_ring) {
+        ring_radial_row(r, mask_buf, dx, dy_sq, len);
     }
-    else if(q->start_quarter == 3 || q->end_quarter == 3) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 3) {
-            quarter_area.x2 = q->center_x + q->radius;
-            quarter_area.y2 = q->center_y - 1;
+    else {
+        /*Signed distances from the start and end edges. Both are linear along the row*/
+        int32_t vs = r->start_cos * dy - r->start_sin * dx;
+        int32_t ve = r->end_sin * dx - r->end_cos * dy;
+        int32_t vs_step = -2 * r->start_sin;
+        int32_t ve_step = 2 * r->end_sin;
+
+        lv_coord_t brk[6];
+        uint8_t brk_cnt = 0;
+        brk[brk_cnt++] = 0;
+        if(len >= RING_RUN_MIN_LEN) {
+            brk_cnt += ring_edge_breaks(&brk[brk_cnt], vs, vs_step, len);
+            brk_cnt += ring_edge_breaks(&brk[brk_cnt], ve, ve_step, len);
+        }
+        brk[brk_cnt++] = len;
+
+        /*Insertion sort of a handful of indices*/
+        uint8_t i;
+        for(i = 1; i < brk_cnt; i++) {
+            lv_coord_t t = brk[i];
+            uint8_t j = i;
+            while(j > 0 && brk[j - 1] > t) {
+                brk[j] = brk[j - 1];
+                j--;
+            }
+            brk[j] = t;
+        }
 
-            quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
+        bool visible = false;
+        for(i = 0; i + 1 < brk_cnt; i++) {
+            lv_coord_t p1 = brk[i];
+            lv_coord_t p2 = brk[i + 1];
+            if(p1 == p2) continue;
+
+            /*The edge functions are monotonic so checking the ends of the part is enough*/
+            lv_opa_t s1 = ring_edge_cover(vs + vs_step * p1);
+            lv_opa_t s2 = ring_edge_cover(vs + vs_step * (p2 - 1));
+            lv_opa_t e1 = ring_edge_cover(ve + ve_step * p1);
+            lv_opa_t e2 = ring_edge_cover(ve + ve_step * (p2 - 1));
+            bool s_full = s1 == LV_OPA_COVER && s2 == LV_OPA_COVER;
+            bool e_full = e1 == LV_OPA_COVER && e2 == LV_OPA_COVER;
+            bool s_zero = s1 == LV_OPA_TRANSP && s2 == LV_OPA_TRANSP;
+            bool e_zero = e1 == LV_OPA_TRANSP && e2 == LV_OPA_TRANSP;
+
+            bool full;
+            bool zero;
+            if(r->wide) {
+                full = s_full || e_full;
+                zero = s_zero && e_zero;
+            }
+            else {
+                full = s_full && e_full;
+                zero = s_zero || e_zero;
+            }
+
+            if(zero) {
+                _lv_memset_00(&mask_buf[p1], p2 - p1);
+            }
+            else if(full) {
+                ring_radial_row(r, &mask_buf[p1], dx + 2 * p1, dy_sq, p2 - p1);
+                visible = true;
+            }
+            else {
+                ring_wedge_row(r, &mask_buf[p1], dx + 2 * p1, dy_sq, vs + vs_step * p1, ve + ve_step * p1, p2 - p1);
+                visible = true;
+            }
+        }
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        /*The caps are discs inside the ring: take the larger coverage*/
+        for(i = 0; i < r->cap_cnt; i++) {
+            const ring_cap_t * cap = &r->caps[i];
+            if(y < cap->area.y1 || y > cap->area.y2) continue;
+            lv_coord_t cx1 = LV_MATH_MAX(x1, cap->area.x1);
+            lv_coord_t cx2 = LV_MATH_MIN(x2, cap->area.x2);
+            int32_t cdy = 16 * (y - r->center_y) + 8 - cap->y;
+            lv_coord_t x;
+            for(x = cx1; x <= cx2; x++) {
+                int32_t cdx = 16 * (x - r->center_x) + 8 - cap->x;
+                uint32_t d_sq = cdx * cdx + cdy * cdy;
+                if(d_sq >= r->cap_out_sq) continue;
+                lv_opa_t cov = LV_OPA_COVER;
+                if(d_sq > r->cap_full_sq) cov = ((r->cap_out_sq - d_sq) * r->cap_recip) >> RING_FIX_SHIFT;
+                if(cov > mask_buf[x - x1]) mask_buf[x - x1] = cov;
+                visible = true;
+            }
         }
-        if(q->end_quarter == 3) {
-            quarter_area.x1 = q->center_x;
-            quarter_area.y1 = q->center_y - q->radius;
 
-            quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-            quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+        if(!visible) return;
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        /*Don't blend the transparent ends of the span*/
+        while(len > 0 && mask_buf[0] == LV_OPA_TRANSP) {
+            mask_buf++;
+            x1++;
+            len--;
         }
+        while(len > 0 && mask_buf[len - 1] == LV_OPA_TRANSP) len--;
+        if(len == 0) return;
+        x2 = x1 + len - 1;
     }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 3 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 2 && q->end_quarter == 0) ||
-            (q->start_quarter == 1 && q->end_quarter == 0) ||
-            (q->start_quarter == 2 && q->end_quarter == 1)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center_x;
-        quarter_area.y1 = q->center_y - q->radius;
-        quarter_area.x2 = q->center_x + q->radius;
-        quarter_area.y2 = q->center_y - 1;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+
+    lv_draw_mask_res_t mask_res = LV_DRAW_MASK_RES_CHANGED;
+    if(lv_draw_mask_get_cnt() > 0) {
+        mask_res = lv_draw_mask_apply(mask_buf, x1, y, len);
+        if(mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+        mask_res = LV_DRAW_MASK_RES_CHANGED;
     }
-}
 
+    lv_area_t fill_area;
+    fill_area.x1 = x1;
+    fill_area.x2 = x2;
+    fill_area.y1 = y;
+    fill_area.y2 = y;
+    _lv_blend_fill(clip_area, &fill_area, dsc->color, mask_buf, mask_res, dsc->opa, dsc->blend_mode);
+}
 
-static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t tickness, lv_area_t * res_area)
+/**
+ * Number of pixels on one side of the center with `(2k + 1)^2 <= sq`
+ */
+static lv_coord_t ring_px_cnt(int32_t sq)
 {
-    const uint8_t ps = 8;
-    const uint8_t pa = 127;
-
-    int32_t thick_half = tickness / 2;
-    uint8_t thick_corr = (tickness & 0x01) ? 0 : 1;
-
-    int32_t rx_corr;
-    int32_t ry_corr;
-
-    if(angle > 90 && angle < 270) rx_corr = 0;
-    else  rx_corr = 0;
-
-    if(angle > 0 && angle < 180) ry_corr = 0;
-    else  ry_corr = 0;
+    if(sq < 1) return 0;
+    return (ring_isqrt(sq) + 1) >> 1;
+}
 
-    int32_t cir_x;
-    int32_t cir_y;
+/**
+ * Integer square root (floor)
+ */
+static uint32_t ring_isqrt(uint32_t x)
+{
+    uint32_t root = 0;
+    uint32_t bit = (uint32_t)1 << 30;
 
-    cir_x = ((radius - rx_corr - thick_half) * _lv_trigo_sin(90 - angle)) >> (LV_TRIGO_SHIFT - ps);
-    cir_y = ((radius - ry_corr - thick_half) * _lv_trigo_sin(angle)) >> (LV_TRIGO_SHIFT - ps);
+    while(bit > x) bit >>= 2;
 
-    /* Actually the center of the pixel need to be calculated so apply 1/2 px offset*/
-    if(cir_x > 0) {
-        cir_x = (cir_x - pa) >> ps;
-        res_area->x1 = cir_x - thick_half + thick_corr;
-        res_area->x2 = cir_x + thick_half;
-    }
-    else {
-        cir_x = (cir_x + pa) >> ps;
-        res_area->x1 = cir_x - thick_half;
-        res_area->x2 = cir_x + thick_half - thick_corr;
+    while(bit) {
+        if(x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
     }
 
-    if(cir_y > 0) {
-        cir_y = (cir_y - pa) >> ps;
-        res_area->y1 = cir_y - thick_half + thick_corr;
-        res_area->y2 = cir_y + thick_half;
-    }
-    else {
-        cir_y = (cir_y + pa) >> ps;
-        res_area->y1 = cir_y - thick_half;
-        res_area->y2 = cir_y + thick_half - thick_corr;
-    }
+    return root;
 }
-
@@ -33,10 +33,9 @@ extern "C" {
  * @param center_y the y coordinate of the center of the arc
  * @param radius the radius of the arc
  * @param mask the arc will be drawn only in this mask
- * @param start_angle the start angle of the arc (0 deg on the bottom, 90 deg on the right)
+ * @param start_angle the start angle of the arc (0 deg on the right, 90 deg on the bottom)
  * @param end_angle the end angle of the arc
- * @param style style of the arc (`body.thickness`, `body.main_color`, `body.opa` is used)
- * @param opa_scale scale down all opacities by the factor
+ * @param dsc `width`, `color`, `opa`, `blend_mode`, `round_start` and `round_end` are used
  */
 void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uint16_t start_angle, uint16_t end_angle,
                  const lv_area_t * clip_area, lv_draw_line_dsc_t * dsc);
@@ -14,11 +14,26 @@
 
 #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
 
+/*RGB565 pixels are blended with the SWAR kernels shared with TFT_eSPI*/
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+#define BLEND_RGB565_SWAR   1
+#include "rgb565_blend.h"
+#else
+#define BLEND_RGB565_SWAR   0
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 #define GPU_SIZE_LIMIT      240
 
+/*The misaligned row copy assembles words from the halves of two source words so it depends on the byte order*/
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BLEND_LITTLE_ENDIAN 1
+#else
+#define BLEND_LITTLE_ENDIAN 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -56,6 +71,18 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
 static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 
+static inline lv_color_t blend_px(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
+
+#if LV_COLOR_DEPTH == 16
+static inline void fill_row_16(lv_color_t * dest, lv_color_t color, int32_t px_num);
+static inline void copy_row_16(lv_color_t * dest, const lv_color_t * src, int32_t px_num);
+#endif
+
+#if BLEND_RGB565_SWAR
+static inline void fill_row_opa_16(lv_color_t * dest, int32_t px_num, uint32_t pre_a, uint32_t pre_b, uint32_t a_inv);
+static inline void map_row_opa_16(lv_color_t * dest, const lv_color_t * src, int32_t px_num, lv_opa_t opa);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -68,7 +95,7 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 #define FILL_NORMAL_MASK_PX(out_x,  color)                                                          \
     if(*mask_tmp_x) {          \
         if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[out_x] = color;                                 \
-        else disp_buf_first[out_x] = lv_color_mix(color, disp_buf_first[out_x], *mask_tmp_x);            \
+        else disp_buf_first[out_x] = blend_px(color, disp_buf_first[out_x], *mask_tmp_x);            \
     }                                                                                               \
     mask_tmp_x++;
 
@@ -78,7 +105,7 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
         if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[out_x] = color;                                 \
         else if(disp->driver.screen_transp) lv_color_mix_with_alpha(disp_buf_first[out_x], disp_buf_first[out_x].ch.alpha,              \
                                                                         color, *mask_tmp_x, &disp_buf_first[out_x], &disp_buf_first[out_x].ch.alpha);           \
-        else disp_buf_first[out_x] = lv_color_mix(color, disp_buf_first[out_x], *mask_tmp_x);            \
+        else disp_buf_first[out_x] = blend_px(color, disp_buf_first[out_x], *mask_tmp_x);            \
     }                                                                                                      \
     mask_tmp_x++;
 
@@ -86,7 +113,7 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 #define MAP_NORMAL_MASK_PX(x)                                                          \
     if(*mask_tmp_x) {          \
         if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[x] = map_buf_first[x];                                 \
-        else disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], *mask_tmp_x);            \
+        else disp_buf_first[x] = blend_px(map_buf_first[x], disp_buf_first[x], *mask_tmp_x);            \
     }                                                                                               \
     mask_tmp_x++;
 
@@ -95,7 +122,7 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
         if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[x] = map_buf_first[x];                                 \
         else if(disp->driver.screen_transp) lv_color_mix_with_alpha(disp_buf_first[x], disp_buf_first[x].ch.alpha,              \
                                                                         map_buf_first[x], *mask_tmp_x, &disp_buf_first[x], &disp_buf_first[x].ch.alpha);                  \
-        else disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], *mask_tmp_x);            \
+        else disp_buf_first[x] = blend_px(map_buf_first[x], disp_buf_first[x], *mask_tmp_x);            \
     }                                                                                               \
     mask_tmp_x++;
 
@@ -168,6 +195,43 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
     }
 }
 
+/**
+ * Fill a line of the display buffer span by span as `lv_draw_mask_apply_spans` classified it.
+ * The transparent spans are skipped and the uniform spans are filled without a mask.
+ * @param clip_area clip the fill to this area  (absolute coordinates)
+ * @param fill_area the line to fill (absolute coordinates). Its first pixel is the first pixel of `mask` and `spans`.
+ * @param color fill color
+ * @param mask the mask buffer of the line. Only the spans with `changed == 1` are read.
+ *             The opacity of the fill has to be already applied on them.
+ * @param spans the spans of the line
+ * @param span_cnt number of spans
+ * @param opa opacity of the fill. Applied on the uniform spans.
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill_spans(const lv_area_t * clip_area, const lv_area_t * fill_area,
+                                                lv_color_t color, lv_opa_t * mask, const lv_draw_mask_span_t * spans,
+                                                uint8_t span_cnt, lv_opa_t opa, lv_blend_mode_t mode)
+{
+    lv_area_t span_area;
+    span_area.y1 = fill_area->y1;
+    span_area.y2 = fill_area->y2;
+
+    uint8_t i;
+    for(i = 0; i < span_cnt; i++) {
+        const lv_draw_mask_span_t * s = &spans[i];
+        span_area.x1 = fill_area->x1 + s->x;
+        span_area.x2 = span_area.x1 + s->len - 1;
+
+        if(s->changed) {
+            _lv_blend_fill(clip_area, &span_area, color, &mask[s->x], LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER, mode);
+        }
+        else if(s->opa > LV_OPA_MIN) {
+            lv_opa_t span_opa = s->opa >= LV_OPA_MAX ? opa : LV_MATH_UDIV255(opa * s->opa);
+            _lv_blend_fill(clip_area, &span_area, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, span_opa, mode);
+        }
+    }
+}
+
 /**
  * Copy a map (image) to a display buffer.
  * @param clip_area clip the map to this area (absolute coordinates)
@@ -330,7 +394,11 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
 #endif
             /*Software rendering*/
             for(y = 0; y < draw_area_h; y++) {
+#if LV_COLOR_DEPTH == 16
+                fill_row_16(disp_buf_first, color, draw_area_w);
+#else
                 lv_color_fill(disp_buf_first, color, draw_area_w);
+#endif
                 disp_buf_first += disp_w;
             }
         }
@@ -368,6 +436,20 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 return;
             }
 #endif
+
+#if BLEND_RGB565_SWAR
+            /*Blend two pixels at once with the pre-multiplied color*/
+            uint32_t a = rgb565_alpha(opa);
+            uint32_t pre_a;
+            uint32_t pre_b;
+            rgb565_premult2(color.full | ((uint32_t)color.full << 16), a, &pre_a, &pre_b);
+
+            for(y = 0; y < draw_area_h; y++) {
+                fill_row_opa_16(disp_buf_first, draw_area_w, pre_a, pre_b, RGB565_ALPHA_MAX - a);
+                disp_buf_first += disp_w;
+            }
+            LV_UNUSED(x);
+#else
             lv_color_t last_dest_color = LV_COLOR_BLACK;
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -395,6 +477,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 }
                 disp_buf_first += disp_w;
             }
+#endif
         }
     }
     /*Masked*/
@@ -439,13 +522,24 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 }
 
                 uint32_t * mask32 = (uint32_t *) mask_tmp_x;
-                for(; x <= x_end4; x += 4) {
+                while(x <= x_end4) {
                     if(*mask32) {
                         if((*mask32) == 0xFFFFFFFF) {
+#if LV_COLOR_DEPTH == 16
+                            /*Fill the whole run of fully covered pixels at once*/
+                            int32_t run_start = x;
+                            do {
+                                x += 4;
+                                mask32++;
+                            } while(x <= x_end4 && *mask32 == 0xFFFFFFFF);
+                            fill_row_16(&disp_buf_first[run_start], color, x - run_start);
+                            continue;
+#else
                             disp_buf_first[x] = color;
                             disp_buf_first[x + 1] = color;
                             disp_buf_first[x + 2] = color;
                             disp_buf_first[x + 3] = color;
+#endif
                         }
                         else {
                             mask_tmp_x = (const lv_opa_t *)mask32;
@@ -462,6 +556,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
 #endif
                         }
                     }
+                    x += 4;
                     mask32++;
                 }
 
@@ -497,7 +592,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
 #endif
                             {
                                 if(opa_tmp == LV_OPA_COVER) last_res_color = color;
-                                else last_res_color = lv_color_mix(color, disp_buf_first[x], opa_tmp);
+                                else last_res_color = blend_px(color, disp_buf_first[x], opa_tmp);
                             }
                             last_mask = *mask_tmp_x;
                             last_dest_color.full = disp_buf_first[x].full;
@@ -558,7 +653,7 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
     /*Simple fill (maybe with opacity), no masking*/
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         lv_color_t last_dest_color = LV_COLOR_BLACK;
-        lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+        lv_color_t last_res_color = blend_px(color, last_dest_color, opa);
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
                 if(last_dest_color.full != disp_buf_tmp[x].full) {
@@ -721,7 +816,11 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
 
             /*Software rendering*/
             for(y = 0; y < draw_area_h; y++) {
+#if LV_COLOR_DEPTH == 16
+                copy_row_16(disp_buf_first, map_buf_first, draw_area_w);
+#else
                 _lv_memcpy(disp_buf_first, map_buf_first, draw_area_w * sizeof(lv_color_t));
+#endif
                 disp_buf_first += disp_w;
                 map_buf_first += map_w;
             }
@@ -737,6 +836,9 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
             /*Software rendering*/
 
             for(y = 0; y < draw_area_h; y++) {
+#if BLEND_RGB565_SWAR
+                map_row_opa_16(disp_buf_first, map_buf_first, draw_area_w, opa);
+#else
                 for(x = 0; x < draw_area_w; x++) {
 #if LV_COLOR_SCREEN_TRANSP
                     if(disp->driver.screen_transp) {
@@ -749,6 +851,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
                         disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], opa);
                     }
                 }
+#endif
                 disp_buf_first += disp_w;
                 map_buf_first += map_w;
             }
@@ -778,13 +881,24 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
                 }
 
                 uint32_t * mask32 = (uint32_t *) mask_tmp_x;
-                for(; x < x_end4; x += 4) {
+                while(x < x_end4) {
                     if(*mask32) {
                         if((*mask32) == 0xFFFFFFFF) {
+#if LV_COLOR_DEPTH == 16
+                            /*Copy the whole run of fully covered pixels at once*/
+                            int32_t run_start = x;
+                            do {
+                                x += 4;
+                                mask32++;
+                            } while(x < x_end4 && *mask32 == 0xFFFFFFFF);
+                            copy_row_16(&disp_buf_first[run_start], &map_buf_first[run_start], x - run_start);
+                            continue;
+#else
                             disp_buf_first[x] = map_buf_first[x];
                             disp_buf_first[x + 1] = map_buf_first[x + 1];
                             disp_buf_first[x + 2] = map_buf_first[x + 2];
                             disp_buf_first[x + 3] = map_buf_first[x + 3];
+#endif
                         }
                         else {
                             mask_tmp_x = (const lv_opa_t *)mask32;
@@ -801,6 +915,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
 #endif
                         }
                     }
+                    x += 4;
                     mask32++;
                 }
 
@@ -832,7 +947,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
                         else
 #endif
                         {
-                            disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], opa_tmp);
+                            disp_buf_first[x] = blend_px(map_buf_first[x], disp_buf_first[x], opa_tmp);
                         }
                     }
                 }
@@ -965,7 +1080,7 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 
     if(opa == LV_OPA_COVER) return fg;
 
-    return lv_color_mix(fg, bg, opa);
+    return blend_px(fg, bg, opa);
 }
 
 static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_color_t bg, lv_opa_t opa)
@@ -992,5 +1107,198 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 
     if(opa == LV_OPA_COVER) return fg;
 
+    return blend_px(fg, bg, opa);
+}
+
+/**
+ * Mix a pixel into the background in the blend paths.
+ * With RGB565 it uses the SWAR kernel, else `lv_color_mix`.
+ * @param fg foreground color
+ * @param bg background color
+ * @param opa opacity of `fg`
+ * @return the mixed color
+ */
+static inline lv_color_t blend_px(lv_color_t fg, lv_color_t bg, lv_opa_t opa)
+{
+#if BLEND_RGB565_SWAR
+    lv_color_t ret;
+    ret.full = rgb565_blend(fg.full, bg.full, rgb565_alpha(opa));
+    return ret;
+#else
     return lv_color_mix(fg, bg, opa);
+#endif
+}
+
+#if LV_COLOR_DEPTH == 16
+/**
+ * Fill a row of 16 bit pixels with a color, two pixels with one 32 bit store.
+ * @param dest pointer to the first pixel to fill
+ * @param color fill color
+ * @param px_num number of pixels to fill
+ */
+static inline void fill_row_16(lv_color_t * dest, lv_color_t color, int32_t px_num)
+{
+    if(px_num > 0 && ((lv_uintptr_t)dest & 0x3)) {
+        *dest = color;
+        dest++;
+        px_num--;
+    }
+
+    uint32_t c32 = (uint32_t)color.full | ((uint32_t)color.full << 16);
+    uint32_t * d32 = (uint32_t *)dest;
+    while(px_num >= 8) {
+        d32[0] = c32;
+        d32[1] = c32;
+        d32[2] = c32;
+        d32[3] = c32;
+        d32 += 4;
+        px_num -= 8;
+    }
+
+    while(px_num >= 2) {
+        *d32 = c32;
+        d32++;
+        px_num -= 2;
+    }
+
+    if(px_num > 0) *((lv_color_t *)d32) = color;
 }
+
+/**
+ * Copy a row of 16 bit pixels, two pixels with one 32 bit load and store.
+ * Unlike `_lv_memcpy` it doesn't fall back to byte copy if only one of the buffers is word aligned.
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param px_num number of pixels to copy
+ */
+static inline void copy_row_16(lv_color_t * dest, const lv_color_t * src, int32_t px_num)
+{
+    if(px_num > 0 && ((lv_uintptr_t)dest & 0x3)) {
+        *dest = *src;
+        dest++;
+        src++;
+        px_num--;
+    }
+
+    uint32_t * d32 = (uint32_t *)dest;
+    if(((lv_uintptr_t)src & 0x3) == 0) {
+        const uint32_t * s32 = (const uint32_t *)src;
+        while(px_num >= 8) {
+            d32[0] = s32[0];
+            d32[1] = s32[1];
+            d32[2] = s32[2];
+            d32[3] = s32[3];
+            d32 += 4;
+            s32 += 4;
+            px_num -= 8;
+        }
+
+        while(px_num >= 2) {
+            *d32 = *s32;
+            d32++;
+            s32++;
+            px_num -= 2;
+        }
+        src = (const lv_color_t *)s32;
+    }
+#if BLEND_LITTLE_ENDIAN
+    else if(px_num >= 3) {
+        /* `src` is 2 bytes off: build every destination word from the upper half of the previous
+         * source word and the lower half of the next one. Never read past the last pixel.*/
+        const uint32_t * s32 = (const uint32_t *)(src + 1);
+        uint32_t prev = src[0].full;
+        int32_t pairs = (px_num - 1) >> 1;
+        src += pairs * 2;
+        px_num -= pairs * 2;
+        while(pairs) {
+            uint32_t next = *s32;
+            *d32 = prev | (next << 16);
+            prev = next >> 16;
+            d32++;
+            s32++;
+            pairs--;
+        }
+    }
+#endif
+
+    dest = (lv_color_t *)d32;
+    while(px_num > 0) {
+        *dest = *src;
+        dest++;
+        src++;
+        px_num--;
+    }
+}
+#endif
+
+#if BLEND_RGB565_SWAR
+/**
+ * Blend a row of 16 bit pixels with a pre-multiplied color, two pixels with one 32 bit operation.
+ * @param dest pointer to the first pixel
+ * @param px_num number of pixels
+ * @param pre_a lane A of the color from `rgb565_premult2`
+ * @param pre_b lane B of the color from `rgb565_premult2`
+ * @param a_inv `RGB565_ALPHA_MAX` - alpha of the color
+ */
+static inline void fill_row_opa_16(lv_color_t * dest, int32_t px_num, uint32_t pre_a, uint32_t pre_b, uint32_t a_inv)
+{
+    /*A single pixel is blended in the lower half of the word*/
+    if(px_num > 0 && ((lv_uintptr_t)dest & 0x3)) {
+        dest->full = (uint16_t)rgb565_blend2_premult(pre_a, pre_b, dest->full, a_inv);
+        dest++;
+        px_num--;
+    }
+
+    uint32_t * d32 = (uint32_t *)dest;
+    while(px_num >= 2) {
+        *d32 = rgb565_blend2_premult(pre_a, pre_b, *d32, a_inv);
+        d32++;
+        px_num -= 2;
+    }
+
+    if(px_num > 0) {
+        dest = (lv_color_t *)d32;
+        dest->full = (uint16_t)rgb565_blend2_premult(pre_a, pre_b, dest->full, a_inv);
+    }
+}
+
+/**
+ * Blend a row of 16 bit pixels onto the destination with a given opacity.
+ * Two pixels are blended at once if the buffers have the same alignment.
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param px_num number of pixels
+ * @param opa opacity of `src`
+ */
+static inline void map_row_opa_16(lv_color_t * dest, const lv_color_t * src, int32_t px_num, lv_opa_t opa)
+{
+    uint32_t a = rgb565_alpha(opa);
+
+    if((((lv_uintptr_t)dest ^ (lv_uintptr_t)src) & 0x3) == 0) {
+        if(px_num > 0 && ((lv_uintptr_t)dest & 0x3)) {
+            dest->full = rgb565_blend(src->full, dest->full, a);
+            dest++;
+            src++;
+            px_num--;
+        }
+
+        uint32_t * d32 = (uint32_t *)dest;
+        const uint32_t * s32 = (const uint32_t *)src;
+        while(px_num >= 2) {
+            *d32 = rgb565_blend2(*s32, *d32, a);
+            d32++;
+            s32++;
+            px_num -= 2;
+        }
+        dest = (lv_color_t *)d32;
+        src = (const lv_color_t *)s32;
+    }
+
+    while(px_num > 0) {
+        dest->full = rgb565_blend(src->full, dest->full, a);
+        dest++;
+        src++;
+        px_num--;
+    }
+}
+#endif
@@ -40,6 +40,9 @@ typedef uint8_t lv_blend_mode_t;
 LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_area_t * fill_area, lv_color_t color,
                                           lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_opa_t opa, lv_blend_mode_t mode);
 
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill_spans(const lv_area_t * clip_area, const lv_area_t * fill_area,
+                                                lv_color_t color, lv_opa_t * mask, const lv_draw_mask_span_t * spans,
+                                                uint8_t span_cnt, lv_opa_t opa, lv_blend_mode_t mode);
 
 LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_area_t * map_area,
                                          const lv_color_t * map_buf,
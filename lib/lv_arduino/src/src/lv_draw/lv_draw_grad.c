@@ -0,0 +1,224 @@
+/**
+ * @file lv_draw_grad.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_grad.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+    #include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Don't let a single huge gradient take a significant part of the work memory*/
+#if LV_MEM_CUSTOM == 0
+#define GRAD_CACHE_MAX_SIZE   (LV_MEM_SIZE / 16)
+#else
+#define GRAD_CACHE_MAX_SIZE   UINT32_MAX
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static _lv_draw_grad_dsc_t * grad_cache_get(lv_color_t main_color, lv_opa_t main_stop, lv_color_t grad_color,
+                                            lv_opa_t grad_stop, lv_coord_t size, bool opa);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t grad_cache_use_cnt;
+static uint32_t grad_cache_hit_cnt;
+static uint32_t grad_cache_miss_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the colors of a gradient from the cache. Calculate them if they aren't cached yet.
+ * The table is valid until the next `_lv_draw_grad_color_get` or `_lv_draw_grad_opa_get`.
+ * @param main_color color on the start
+ * @param main_stop where the gradient starts [0..255] (0: on the start, 255: on the end)
+ * @param grad_color color on the end
+ * @param grad_stop where the gradient ends [0..255]
+ * @param size length of the gradient (height of a vertical, width of a horizontal gradient)
+ * @return `size` colors or NULL if the gradient can't be cached
+ */
+const lv_color_t * _lv_draw_grad_color_get(lv_color_t main_color, lv_opa_t main_stop, lv_color_t grad_color,
+                                           lv_opa_t grad_stop, lv_coord_t size)
+{
+    _lv_draw_grad_dsc_t * g = grad_cache_get(main_color, main_stop, grad_color, grad_stop, size, false);
+    return g ? g->buf : NULL;
+}
+
+/**
+ * Get the opacities of a fade from the cache. Calculate them if they aren't cached yet.
+ * The entry might be reused by an other gradient later, so check that its `id` is unchanged before using it again.
+ * @param opa_top opacity on the top
+ * @param opa_bottom opacity on the bottom
+ * @param size number of rows from the top to the bottom of the fade
+ * @return the cache entry with `size` opacities in its `buf` or NULL if the fade can't be cached
+ */
+const _lv_draw_grad_dsc_t * _lv_draw_grad_opa_get(lv_opa_t opa_top, lv_opa_t opa_bottom, lv_coord_t size)
+{
+    return grad_cache_get(LV_COLOR_BLACK, opa_top, LV_COLOR_BLACK, opa_bottom, size, true);
+}
+
+/**
+ * Calculate a single color of a gradient
+ * @param main_color color on the start
+ * @param main_stop where the gradient starts [0..255]
+ * @param grad_color color on the end
+ * @param grad_stop where the gradient ends [0..255]
+ * @param size length of the gradient
+ * @param i index of the row or column in the gradient
+ * @return the color
+ */
+lv_color_t _lv_draw_grad_color_calc(lv_color_t main_color, lv_opa_t main_stop, lv_color_t grad_color,
+                                    lv_opa_t grad_stop, lv_coord_t size, lv_coord_t i)
+{
+    int32_t min = (main_stop * size) >> 8;
+    if(i <= min) return main_color;
+
+    int32_t max = (grad_stop * size) >> 8;
+    if(i >= max) return grad_color;
+
+    int32_t d = grad_stop - main_stop;
+    d = (size * d) >> 8;
+    i -= min;
+    lv_opa_t mix = (i * 255) / d;
+    return lv_color_mix(grad_color, main_color, mix);
+}
+
+/**
+ * Calculate a single opacity of a fade
+ * @param opa_top opacity on the top
+ * @param opa_bottom opacity on the bottom
+ * @param size number of rows from the top to the bottom of the fade
+ * @param i index of the row in the fade
+ * @return the opacity
+ */
+lv_opa_t _lv_draw_grad_opa_calc(lv_opa_t opa_top, lv_opa_t opa_bottom, lv_coord_t size, lv_coord_t i)
+{
+    if(i <= 0) return opa_top;
+    if(i >= size - 1) return opa_bottom;
+
+    /*Calculate the opa proportionally*/
+    int16_t opa_diff = opa_bottom - opa_top;
+    lv_opa_t opa_act = (int32_t)((int32_t)i * opa_diff) / size;
+    return opa_act + opa_top;
+}
+
+/**
+ * Get the statistics of the gradient cache
+ * @param stat store the statistics here
+ */
+void lv_draw_grad_cache_get_stat(lv_draw_grad_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_draw_grad_cache_stat_t));
+    stat->hit_cnt = grad_cache_hit_cnt;
+    stat->miss_cnt = grad_cache_miss_cnt;
+
+    uint8_t i;
+    for(i = 0; i < LV_GRAD_CACHE_SIZE; i++) {
+        _lv_draw_grad_dsc_t * g = &LV_GC_ROOT(_lv_grad_cache[i]);
+        if(g->size == 0) continue;
+        stat->entry_cnt++;
+        stat->used_size += g->size * (g->opa ? sizeof(lv_opa_t) : sizeof(lv_color_t));
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get a cached gradient. Calculate it if it's not cached yet,
+ * replacing the least recently used gradient if there is no free entry.
+ * @param main_color color on the start (unused for fades)
+ * @param main_stop color stop on the start or the opacity on the top
+ * @param grad_color color on the end (unused for fades)
+ * @param grad_stop color stop on the end or the opacity on the bottom
+ * @param size length of the gradient
+ * @param opa true: opacities of a fade; false: colors of a gradient
+ * @return the cached gradient or NULL if it can't be cached
+ */
+static _lv_draw_grad_dsc_t * grad_cache_get(lv_color_t main_color, lv_opa_t main_stop, lv_color_t grad_color,
+                                            lv_opa_t grad_stop, lv_coord_t size, bool opa)
+{
+    if(size <= 0) return NULL;
+
+    _lv_draw_grad_dsc_t * lru = NULL;
+    grad_cache_use_cnt++;
+
+    uint8_t i;
+    for(i = 0; i < LV_GRAD_CACHE_SIZE; i++) {
+        _lv_draw_grad_dsc_t * g = &LV_GC_ROOT(_lv_grad_cache[i]);
+        if(g->size == size && g->opa == opa && g->main_stop == main_stop && g->grad_stop == grad_stop &&
+           g->main_color.full == main_color.full && g->grad_color.full == grad_color.full) {
+            g->last_used = grad_cache_use_cnt;
+            grad_cache_hit_cnt++;
+            return g;
+        }
+
+        /*Prefer the free entries, else the least recently used one*/
+        if(lru == NULL) lru = g;
+        else if(lru->size != 0 && (g->size == 0 || g->last_used < lru->last_used)) lru = g;
+    }
+
+    grad_cache_miss_cnt++;
+
+    if(lru->size != 0) {
+        lv_mem_free(lru->buf);
+        _lv_memset_00(lru, sizeof(_lv_draw_grad_dsc_t));
+    }
+
+    uint32_t buf_size = size * (opa ? sizeof(lv_opa_t) : sizeof(lv_color_t));
+    if(buf_size > GRAD_CACHE_MAX_SIZE) return NULL;
+
+    lru->buf = lv_mem_alloc(buf_size);
+    if(lru->buf == NULL) {
+        LV_LOG_WARN("grad_cache_get: couldn't allocate memory. The gradient is calculated on every draw.");
+        return NULL;
+    }
+
+    lv_coord_t j;
+    if(opa) {
+        lv_opa_t * opa_buf = lru->buf;
+        for(j = 0; j < size; j++) {
+            opa_buf[j] = _lv_draw_grad_opa_calc(main_stop, grad_stop, size, j);
+        }
+    }
+    else {
+        lv_color_t * color_buf = lru->buf;
+        for(j = 0; j < size; j++) {
+            color_buf[j] = _lv_draw_grad_color_calc(main_color, main_stop, grad_color, grad_stop, size, j);
+        }
+    }
+
+    lru->main_color = main_color;
+    lru->grad_color = grad_color;
+    lru->main_stop = main_stop;
+    lru->grad_stop = grad_stop;
+    lru->size = size;
+    lru->opa = opa ? 1 : 0;
+    lru->id = grad_cache_miss_cnt;
+    lru->last_used = grad_cache_use_cnt;
+    return lru;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file lv_draw_grad.h
+ *
+ */
+
+#ifndef LV_DRAW_GRAD_H
+#define LV_DRAW_GRAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../lv_misc/lv_color.h"
+#include "../lv_misc/lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A gradient calculated once for every row (or column) of its size.
+ * The same table is used by every rectangle or fade mask with the same stops and size, even in later frames.
+ */
+typedef struct {
+    void * buf;                 /*`lv_color_t` or `lv_opa_t` for every row of the gradient*/
+    uint32_t last_used;         /*The least recently used entry is replaced first*/
+    uint32_t id;                /*Changes every time the entry is calculated again*/
+    lv_color_t main_color;
+    lv_color_t grad_color;
+    lv_coord_t size;            /*0: unused entry*/
+    lv_opa_t main_stop;         /*Color stop, or the opacity on the top of a fade*/
+    lv_opa_t grad_stop;         /*Color stop, or the opacity on the bottom of a fade*/
+    uint8_t opa : 1;            /*1: opacities of a fade mask; 0: colors of a gradient*/
+} _lv_draw_grad_dsc_t;
+
+typedef _lv_draw_grad_dsc_t _lv_draw_grad_dsc_arr_t[LV_GRAD_CACHE_SIZE];
+
+typedef struct {
+    uint32_t hit_cnt;       /*Gradients found in the cache*/
+    uint32_t miss_cnt;      /*Gradients which had to be calculated*/
+    uint32_t used_size;     /*Bytes taken from the work memory by the cached gradients*/
+    uint8_t entry_cnt;      /*Number of cached gradients*/
+} lv_draw_grad_cache_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the colors of a gradient from the cache. Calculate them if they aren't cached yet.
+ * The table is valid until the next `_lv_draw_grad_color_get` or `_lv_draw_grad_opa_get`.
+ * @param main_color color on the start
+ * @param main_stop where the gradient starts [0..255] (0: on the start, 255: on the end)
+ * @param grad_color color on the end
+ * @param grad_stop where the gradient ends [0..255]
+ * @param size length of the gradient (height of a vertical, width of a horizontal gradient)
+ * @return `size` colors or NULL if the gradient can't be cached
+ */
+const lv_color_t * _lv_draw_grad_color_get(lv_color_t main_color, lv_opa_t main_stop, lv_color_t grad_color,
+                                           lv_opa_t grad_stop, lv_coord_t size);
+
+/**
+ * Get the opacities of a fade from the cache. Calculate them if they aren't cached yet.
+ * The entry might be reused by an other gradient later, so check that its `id` is unchanged before using it again.
+ * @param opa_top opacity on the top
+ * @param opa_bottom opacity on the bottom
+ * @param size number of rows from the top to the bottom of the fade
+ * @return the cache entry with `size` opacities in its `buf` or NULL if the fade can't be cached
+ */
+const _lv_draw_grad_dsc_t * _lv_draw_grad_opa_get(lv_opa_t opa_top, lv_opa_t opa_bottom, lv_coord_t size);
+
+/**
+ * Calculate a single color of a gradient
+ * @param main_color color on the start
+ * @param main_stop where the gradient starts [0..255]
+ * @param grad_color color on the end
+ * @param grad_stop where the gradient ends [0..255]
+ * @param size length of the gradient
+ * @param i index of the row or column in the gradient
+ * @return the color
+ */
+lv_color_t _lv_draw_grad_color_calc(lv_color_t main_color, lv_opa_t main_stop, lv_color_t grad_color,
+                                    lv_opa_t grad_stop, lv_coord_t size, lv_coord_t i);
+
+/**
+ * Calculate a single opacity of a fade
+ * @param opa_top opacity on the top
+ * @param opa_bottom opacity on the bottom
+ * @param size number of rows from the top to the bottom of the fade
+ * @param i index of the row in the fade
+ * @return the opacity
+ */
+lv_opa_t _lv_draw_grad_opa_calc(lv_opa_t opa_top, lv_opa_t opa_bottom, lv_coord_t size, lv_coord_t i);
+
+/**
+ * Get the statistics of the gradient cache
+ * @param stat store the statistics here
+ */
+void lv_draw_grad_cache_get_stat(lv_draw_grad_cache_stat_t * stat);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_GRAD_H*/
@@ -12,6 +12,7 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_bidi.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_font/lv_font_atlas.h"
 
 /*********************
  *      DEFINES
@@ -40,7 +41,20 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
                                                      const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
                               const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+#if LV_USE_FONT_ATLAS
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_atlas(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                    const lv_area_t * clip_area,
+                                                    const lv_opa_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_atlas_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                          const lv_area_t * clip_area,
+                                                          const lv_opa_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+#endif
 
+static bool layout_is_valid(const lv_area_t * coords, const lv_draw_label_dsc_t * dsc, const char * txt);
+LV_ATTRIBUTE_FAST_MEM static void draw_label_layout(const lv_area_t * coords, const lv_area_t * mask,
+                                                    const lv_draw_label_dsc_t * dsc, const char * txt);
+LV_ATTRIBUTE_FAST_MEM static void draw_label_cells(const lv_area_t * coords, const lv_area_t * mask,
+                                                   const lv_draw_label_dsc_t * dsc, const char * txt);
 
 static uint8_t hex_char_to_num(char hex);
 
@@ -126,6 +140,15 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, mask);
     if(!clip_ok) return;
 
+    if(dsc->layout && layout_is_valid(coords, dsc, txt)) {
+        draw_label_layout(coords, mask, dsc, txt);
+        return;
+    }
+
+    if(dsc->cell_w > 0) {
+        draw_label_cells(coords, mask, dsc, txt);
+        return;
+    }
 
     if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
@@ -385,6 +408,118 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Tell whether the layout of a label descriptor can be used to draw a text
+ * @param coords coordinates of the label
+ * @param dsc pointer to draw descriptor with a layout
+ * @param txt the text to draw
+ * @return true: the text can be drawn with `draw_label_layout`
+ */
+static bool layout_is_valid(const lv_area_t * coords, const lv_draw_label_dsc_t * dsc, const char * txt)
+{
+#if LV_USE_BIDI
+    /*The letters might be reordered*/
+    LV_UNUSED(coords);
+    LV_UNUSED(dsc);
+    LV_UNUSED(txt);
+    return false;
+#else
+    const lv_txt_layout_t * layout = dsc->layout;
+    if(layout->font != dsc->font || layout->letter_space != dsc->letter_space) return false;
+
+    /*The alignment is applied when drawing*/
+    lv_txt_flag_t flag_mask = LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT;
+    if((layout->flag & flag_mask) != (dsc->flag & flag_mask)) return false;
+    if((dsc->flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) == 0 &&
+       layout->max_width != lv_area_get_width(coords)) return false;
+
+    /*Selection and decoration need the positions of the line ends too*/
+    if(dsc->sel_start != LV_DRAW_LABEL_NO_TXT_SEL && dsc->sel_end != LV_DRAW_LABEL_NO_TXT_SEL) return false;
+    if(dsc->decor != LV_TEXT_DECOR_NONE) return false;
+
+    return strlen(txt) == layout->len;
+#endif
+}
+
+/**
+ * Write a text with its lines and letter positions from a layout.
+ * The same result as the other steps of `lv_draw_label`.
+ * @param coords coordinates of the label
+ * @param mask the label will be drawn only in this area
+ * @param dsc pointer to draw descriptor with a valid layout
+ * @param txt `\0` terminated text to write
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_label_layout(const lv_area_t * coords, const lv_area_t * mask,
+                                                    const lv_draw_label_dsc_t * dsc, const char * txt)
+{
+    const lv_txt_layout_t * layout = dsc->layout;
+    const lv_font_t * font = dsc->font;
+    int32_t line_height_font = lv_font_get_line_height(font);
+    int32_t line_height = line_height_font + dsc->line_space;
+
+    lv_point_t pos;
+    pos.y = coords->y1 + dsc->ofs_y;
+
+    /*Go the first visible line*/
+    uint32_t l = 0;
+    while(l < layout->line_cnt && pos.y + line_height_font < mask->y1) {
+        pos.y += line_height;
+        l++;
+    }
+
+    for(; l < layout->line_cnt; l++) {
+        const lv_txt_layout_line_t * line = &layout->lines[l];
+        uint32_t line_end = l + 1 < layout->line_cnt ? layout->lines[l + 1].start : layout->len;
+
+        int32_t line_x = coords->x1 + dsc->ofs_x;
+        if(dsc->flag & LV_TXT_FLAG_CENTER) line_x += (lv_area_get_width(coords) - line->w) / 2;
+        else if(dsc->flag & LV_TXT_FLAG_RIGHT) line_x += lv_area_get_width(coords) - line->w;
+
+        uint32_t i = line->start;
+        while(i < line_end) {
+            pos.x = line_x + layout->letter_x[i];
+            uint32_t letter = _lv_txt_encoded_next(txt, &i);
+            lv_draw_letter(&pos, mask, font, letter, dsc->color, dsc->opa, dsc->blend_mode);
+        }
+
+        pos.y += line_height;
+        if(pos.y > mask->y2) return;
+    }
+}
+
+/**
+ * Write a single line text with tabular digits (see `_lv_txt_get_cell`)
+ * @param coords coordinates of the label
+ * @param mask the label will be drawn only in this area
+ * @param dsc pointer to draw descriptor with `cell_w > 0`
+ * @param txt `\0` terminated text to write
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_label_cells(const lv_area_t * coords, const lv_area_t * mask,
+                                                   const lv_draw_label_dsc_t * dsc, const char * txt)
+{
+    const lv_font_t * font = dsc->font;
+
+    lv_point_t pos;
+    pos.x = coords->x1 + dsc->ofs_x;
+    pos.y = coords->y1 + dsc->ofs_y;
+    if(dsc->flag & (LV_TXT_FLAG_CENTER | LV_TXT_FLAG_RIGHT)) {
+        lv_coord_t txt_w = _lv_txt_get_cells_width(txt, font, dsc->cell_w);
+        if(dsc->flag & LV_TXT_FLAG_CENTER) pos.x += (lv_area_get_width(coords) - txt_w) / 2;
+        else pos.x += lv_area_get_width(coords) - txt_w;
+    }
+
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        lv_coord_t ofs_x;
+        lv_coord_t cell_w = _lv_txt_get_cell(font, letter, dsc->cell_w, &ofs_x);
+
+        lv_point_t letter_pos = {pos.x + ofs_x, pos.y};
+        lv_draw_letter(&letter_pos, mask, font, letter, dsc->color, dsc->opa, dsc->blend_mode);
+        pos.x += cell_w;
+    }
+}
+
 
 /**
  * Draw a letter in the Virtual Display Buffer
@@ -409,14 +544,20 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
     }
 
     lv_font_glyph_dsc_t g;
-    bool g_ret = lv_font_get_glyph_dsc(font_p, &g, letter, '\0');
-    if(g_ret == false)  {
-        /* Add waring if the dsc is not found
-         * but do not print warning for non printable ASCII chars (e.g. '\n')*/
-        if(letter >= 0x20) {
-            LV_LOG_WARN("lv_draw_letter: glyph dsc. not found");
+    const lv_opa_t * atlas_map_p = NULL;
+#if LV_USE_FONT_ATLAS
+    atlas_map_p = _lv_font_atlas_get_glyph(font_p, letter, &g);
+#endif
+    if(atlas_map_p == NULL) {
+        bool g_ret = lv_font_get_glyph_dsc(font_p, &g, letter, '\0');
+        if(g_ret == false)  {
+            /* Add waring if the dsc is not found
+             * but do not print warning for non printable ASCII chars (e.g. '\n')*/
+            if(letter >= 0x20) {
+                LV_LOG_WARN("lv_draw_letter: glyph dsc. not found");
+            }
+            return;
         }
-        return;
     }
 
     /* Don't draw anything if the character is empty. E.g. space */
@@ -433,6 +574,13 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
         return;
     }
 
+#if LV_USE_FONT_ATLAS
+    if(atlas_map_p) {
+        if(font_p->subpx) draw_letter_atlas_subpx(pos_x, pos_y, &g, clip_area, atlas_map_p, color, opa, blend_mode);
+        else draw_letter_atlas(pos_x, pos_y, &g, clip_area, atlas_map_p, color, opa, blend_mode);
+        return;
+    }
+#endif
 
     const uint8_t * map_p = lv_font_get_glyph_bitmap(font_p, letter);
     if(map_p == NULL) {
@@ -605,6 +753,207 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     _lv_mem_buf_release(mask_buf);
 }
 
+#if LV_USE_FONT_ATLAS
+/**
+ * Draw a letter from the 8 bit coverage map of a font atlas
+ * @param pos_x x coordinate of the glyph's box
+ * @param pos_y y coordinate of the glyph's box
+ * @param g descriptor of the glyph
+ * @param clip_area the letter will be drawn only in this area
+ * @param map_p coverage of the glyph, `box_w` bytes per row
+ * @param color color of letter
+ * @param opa opacity of letter (0..255)
+ * @param blend_mode blend mode
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_atlas(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                    const lv_area_t * clip_area,
+                                                    const lv_opa_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+    int32_t box_w = g->box_w;
+    int32_t box_h = g->box_h;
+
+    /* Calculate the col/row start/end on the map*/
+    int32_t col_start = pos_x >= clip_area->x1 ? 0 : clip_area->x1 - pos_x;
+    int32_t col_end   = pos_x + box_w <= clip_area->x2 ? box_w : clip_area->x2 - pos_x + 1;
+    int32_t row_start = pos_y >= clip_area->y1 ? 0 : clip_area->y1 - pos_y;
+    int32_t row_end   = pos_y + box_h <= clip_area->y2 ? box_h : clip_area->y2 - pos_y + 1;
+
+    map_p += row_start * box_w + col_start;
+
+    lv_area_t fill_area;
+    fill_area.x1 = col_start + pos_x;
+    fill_area.x2 = col_end  + pos_x - 1;
+    fill_area.y1 = row_start + pos_y;
+    fill_area.y2 = row_end + pos_y - 1;
+
+    uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
+
+#if LV_ANTIALIAS
+    /* The map is a ready mask if whole rows are drawn.
+     * (Without anti-aliasing the blending would round the mask in place so it can't be used)*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(other_mask_cnt == 0 && col_start == 0 && col_end == box_w && disp->driver.antialiasing) {
+        _lv_blend_fill(clip_area, &fill_area, color, (lv_opa_t *)map_p, LV_DRAW_MASK_RES_CHANGED, opa, blend_mode);
+        return;
+    }
+#endif
+
+    /*Else copy the visible part of the rows one by one and apply the masks on them*/
+    int32_t w = col_end - col_start;
+    lv_opa_t * mask_buf = _lv_mem_buf_get(w);
+    int32_t row;
+    for(row = row_start; row < row_end; row++) {
+        fill_area.y2 = fill_area.y1;
+        _lv_memcpy(mask_buf, map_p, w);
+
+        lv_draw_mask_res_t mask_res = LV_DRAW_MASK_RES_CHANGED;
+        if(other_mask_cnt) {
+            mask_res = lv_draw_mask_apply(mask_buf, fill_area.x1, fill_area.y1, w);
+            if(mask_res != LV_DRAW_MASK_RES_TRANSP) mask_res = LV_DRAW_MASK_RES_CHANGED;
+        }
+
+        _lv_blend_fill(clip_area, &fill_area, color, mask_buf, mask_res, opa, blend_mode);
+
+        fill_area.y1++;
+        map_p += box_w;
+    }
+
+    _lv_mem_buf_release(mask_buf);
+}
+
+/**
+ * Draw a letter with subpixel rendering from the coverage map of a font atlas.
+ * Gives the same result as `draw_letter_subpx` but the pixels without coverage are not mixed.
+ * @param pos_x x coordinate of the glyph's box
+ * @param pos_y y coordinate of the glyph's box
+ * @param g descriptor of the glyph, `box_w` is in subpixels
+ * @param clip_area the letter will be drawn only in this area
+ * @param map_p coverage of the glyph's subpixels, `box_w` bytes per row
+ * @param color color of letter
+ * @param opa opacity of letter (0..255)
+ * @param blend_mode blend mode
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_atlas_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                          const lv_area_t * clip_area,
+                                                          const lv_opa_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+    int32_t box_w = g->box_w;
+    int32_t box_h = g->box_h;
+
+    /* Calculate the col/row start/end on the map*/
+    int32_t col_start = pos_x >= clip_area->x1 ? 0 : (clip_area->x1 - pos_x) * 3;
+    int32_t col_end   = pos_x + box_w / 3 <= clip_area->x2 ? box_w : (clip_area->x2 - pos_x + 1) * 3;
+    int32_t row_start = pos_y >= clip_area->y1 ? 0 : clip_area->y1 - pos_y;
+    int32_t row_end   = pos_y + box_h <= clip_area->y2 ? box_h : clip_area->y2 - pos_y + 1;
+
+    int32_t w = (col_end - col_start) / 3;
+    if(w <= 0) return;
+
+    map_p += row_start * box_w + col_start;
+
+    /*Mix as many rows as fit into a line of the display before blending them*/
+    int32_t batch_rows = LV_HOR_RES_MAX / w;
+    if(batch_rows < 1) batch_rows = 1;
+    lv_opa_t * mask_buf = _lv_mem_buf_get(w * batch_rows);
+    lv_color_t * color_buf = _lv_mem_buf_get(w * batch_rows * sizeof(lv_color_t));
+
+    lv_disp_t * disp    = _lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    int32_t vdb_width   = lv_area_get_width(&vdb->area);
+    const lv_color_t * vdb_buf_tmp = vdb->buf_act;
+    vdb_buf_tmp += ((pos_y + row_start - vdb->area.y1) * vdb_width) + pos_x + col_start / 3 - vdb->area.x1;
+
+    lv_area_t map_area;
+    map_area.x1 = col_start / 3 + pos_x;
+    map_area.x2 = map_area.x1 + w - 1;
+    map_area.y1 = row_start + pos_y;
+    map_area.y2 = map_area.y1;
+
+    uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
+
+#if LV_COLOR_16_SWAP == 0
+    uint8_t txt_rgb[3] = {color.ch.red, color.ch.green, color.ch.blue};
+#else
+    uint8_t txt_rgb[3] = {color.ch.red, (color.ch.green_h << 3) + color.ch.green_l, color.ch.blue};
+#endif
+
+    int32_t mask_p = 0;
+    int32_t row;
+    for(row = row_start; row < row_end; row++) {
+        int32_t mask_p_start = mask_p;
+        const lv_opa_t * px_p = map_p;
+        int32_t x;
+        for(x = 0; x < w; x++, px_p += 3, mask_p++) {
+            uint32_t font_rgb[3] = {px_p[0], px_p[1], px_p[2]};
+            if(opa != LV_OPA_COVER) {
+                font_rgb[0] = (font_rgb[0] * opa) >> 8;
+                font_rgb[1] = (font_rgb[1] * opa) >> 8;
+                font_rgb[2] = (font_rgb[2] * opa) >> 8;
+            }
+
+            if((font_rgb[0] | font_rgb[1] | font_rgb[2]) == 0) {
+                mask_buf[mask_p] = LV_OPA_TRANSP;
+                continue;
+            }
+
+            const lv_color_t * bg = &vdb_buf_tmp[x];
+            lv_color_t res_color;
+#if LV_COLOR_16_SWAP == 0
+            uint8_t bg_rgb[3] = {bg->ch.red, bg->ch.green, bg->ch.blue};
+#else
+            uint8_t bg_rgb[3] = {bg->ch.red, (bg->ch.green_h << 3) + bg->ch.green_l, bg->ch.blue};
+#endif
+
+#if LV_FONT_SUBPX_BGR
+            res_color.ch.blue = (uint32_t)((uint32_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[0] * (255 - font_rgb[0]))) >> 8;
+            res_color.ch.red = (uint32_t)((uint32_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[2] * (255 - font_rgb[2]))) >> 8;
+#else
+            res_color.ch.red = (uint32_t)((uint32_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[0] * (255 - font_rgb[0]))) >> 8;
+            res_color.ch.blue = (uint32_t)((uint32_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[2] * (255 - font_rgb[2]))) >> 8;
+#endif
+
+#if LV_COLOR_16_SWAP == 0
+            res_color.ch.green = (uint32_t)((uint32_t)txt_rgb[1] * font_rgb[1] + (bg_rgb[1] * (255 - font_rgb[1]))) >> 8;
+#else
+            uint8_t green = (uint32_t)((uint32_t)txt_rgb[1] * font_rgb[1] + (bg_rgb[1] * (255 - font_rgb[1]))) >> 8;
+            res_color.ch.green_h = green >> 3;
+            res_color.ch.green_l = green & 0x7;
+#endif
+
+#if LV_COLOR_DEPTH == 32
+            res_color.ch.alpha =  0xff;
+#endif
+            mask_buf[mask_p] = LV_OPA_COVER;
+            color_buf[mask_p] = res_color;
+        }
+
+        /*Apply masks if any*/
+        if(other_mask_cnt) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf + mask_p_start, map_area.x1, map_area.y2, w);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) {
+                _lv_memset_00(mask_buf + mask_p_start, w);
+            }
+        }
+
+        if(mask_p + w <= w * batch_rows && row + 1 < row_end) {
+            map_area.y2++;
+        }
+        else {
+            _lv_blend_map(clip_area, &map_area, color_buf, mask_buf, LV_DRAW_MASK_RES_CHANGED, opa, blend_mode);
+            map_area.y1 = map_area.y2 + 1;
+            map_area.y2 = map_area.y1;
+            mask_p = 0;
+        }
+
+        map_p += box_w;
+        vdb_buf_tmp += vdb_width;
+    }
+
+    _lv_mem_buf_release(mask_buf);
+    _lv_mem_buf_release(color_buf);
+}
+#endif /*LV_USE_FONT_ATLAS*/
+
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
                               const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
 {
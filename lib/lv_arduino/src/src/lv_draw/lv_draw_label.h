@@ -41,6 +41,8 @@ typedef struct {
     lv_txt_flag_t flag;
     lv_text_decor_t decor;
     lv_blend_mode_t blend_mode;
+    const lv_txt_layout_t * layout;     /*Line breaks and letter positions of the text calculated earlier or NULL*/
+    lv_coord_t cell_w;                  /*>0: write a single line with tabular digits of this width*/
 } lv_draw_label_dsc_t;
 
 /** Store some info to speed up drawing of very large texts
@@ -280,6 +280,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_ver(const lv_point_t * point1, const
         lv_style_int_t dash_start = 0;
         if(dashed) {
             dash_start = (vdb->area.y1 + draw_area.y1) % (dsc->dash_gap + dsc->dash_width);
+            /*Wrapping around continues from the end of the gap, so start from there too.
+             *Else the dashes would depend on where the redrawn area starts.*/
+            if(dash_start == 0) dash_start = dsc->dash_gap + dsc->dash_width;
         }
 
         lv_style_int_t dash_cnt = dash_start;
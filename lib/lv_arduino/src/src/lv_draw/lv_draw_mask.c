@@ -23,6 +23,12 @@
 /*********************
  *      DEFINES
  *********************/
+/*Don't let a single huge circle take a significant part of the work memory*/
+#if LV_MEM_CUSTOM == 0
+#define CIRCLE_CACHE_MAX_SIZE   (LV_MEM_SIZE / 16)
+#else
+#define CIRCLE_CACHE_MAX_SIZE   UINT32_MAX
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -37,6 +43,11 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_line(lv_opa_t * mas
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                     lv_coord_t abs_y, lv_coord_t len,
                                                                     lv_draw_mask_radius_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius_cached(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                           lv_coord_t abs_y, lv_coord_t len,
+                                                                           lv_draw_mask_radius_param_t * param);
+static _lv_draw_mask_radius_circle_dsc_t * circle_cache_get(lv_coord_t radius);
+static bool circle_calc(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radius);
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_angle(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                    lv_coord_t abs_y, lv_coord_t len,
                                                                    lv_draw_mask_angle_param_t * param);
@@ -54,12 +65,37 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t line_mask_steep(lv_opa_t * mask_
                                                                 lv_coord_t len,
                                                                 lv_draw_mask_line_param_t * p);
 
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_line_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                              lv_coord_t abs_y, lv_coord_t len,
+                                                              lv_draw_mask_line_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_radius_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                                lv_coord_t abs_y, lv_coord_t len,
+                                                                lv_draw_mask_radius_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_angle_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                               lv_coord_t abs_y, lv_coord_t len,
+                                                               lv_draw_mask_angle_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_fade_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                              lv_coord_t abs_y, lv_coord_t len,
+                                                              lv_draw_mask_fade_param_t * param);
+
+LV_ATTRIBUTE_FAST_MEM static int32_t angle_mask_split(lv_draw_mask_angle_param_t * p, int32_t rel_y);
+LV_ATTRIBUTE_FAST_MEM static inline uint8_t span_add(lv_draw_mask_span_t * spans, uint8_t cnt, int32_t x, int32_t len,
+                                                     lv_opa_t opa, bool changed);
+LV_ATTRIBUTE_FAST_MEM static uint8_t span_split(lv_draw_mask_span_t * spans, int32_t len, int32_t edge_start,
+                                                int32_t edge_end, lv_opa_t opa_left, lv_opa_t opa_right);
+LV_ATTRIBUTE_FAST_MEM static uint8_t span_combine(lv_draw_mask_span_t * out, const lv_draw_mask_span_t * a,
+                                                  uint8_t a_cnt, const lv_draw_mask_span_t * b, uint8_t b_cnt);
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
+LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t fade_opa_get(lv_draw_mask_fade_param_t * p, lv_coord_t abs_y);
 LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_res_t * ref, uint32_t x);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t circle_cache_use_cnt;
+static uint32_t circle_cache_hit_cnt;
+static uint32_t circle_cache_miss_cnt;
 
 /**********************
  *      MACROS
@@ -126,6 +162,92 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
     return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
+/**
+ * Apply the added masks on a line but calculate the pixels only around the edges of the masks.
+ * The fully transparent, fully covered or evenly faded parts are returned as uniform spans.
+ * @param mask_buf store the result mask here. Has to be `len` byte long. Should be initialized with `0xFF`
+ *                 or with the base opacity. Only valid in the spans with `changed == 1`.
+ * @param abs_x absolute X coordinate where the line to calculate start
+ * @param abs_y absolute Y coordinate where the line to calculate start
+ * @param len length of the line to calculate (in pixel count)
+ * @param spans store the spans of the line here. Has to be `LV_DRAW_MASK_SPAN_MAX` long.
+ * @return number of spans. They cover the whole line. A fully transparent line is one span with 0 opacity.
+ */
+LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_apply_spans(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                       lv_coord_t len, lv_draw_mask_span_t * spans)
+{
+    lv_draw_mask_span_t mask_spans[LV_DRAW_MASK_SPAN_MAX];
+    lv_draw_mask_span_t tmp[LV_DRAW_MASK_SPAN_MAX];
+    lv_draw_mask_span_t * res = spans;
+    lv_draw_mask_span_t * res_next = tmp;
+    uint8_t cnt = 0;
+    uint8_t i;
+
+    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+
+    while(m->param) {
+        lv_draw_mask_common_dsc_t * dsc = m->param;
+
+        /*A mask without spans: calculate the whole line*/
+        if(dsc->span_cb == NULL) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, abs_x, abs_y, len);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) return span_add(spans, 0, 0, len, LV_OPA_TRANSP, false);
+            if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) return span_add(spans, 0, 0, len, LV_OPA_COVER, false);
+            return span_add(spans, 0, 0, len, LV_OPA_TRANSP, true);
+        }
+
+        /*The spans of the first mask are the result as they are*/
+        lv_draw_mask_span_t * out = cnt == 0 ? res : mask_spans;
+        uint8_t mask_cnt = dsc->span_cb(out, abs_x, abs_y, len, m->param);
+
+        if(cnt == 0) {
+            cnt = mask_cnt;
+        }
+        else {
+            /*Combine into the other buffer instead of copying the result back*/
+            cnt = span_combine(res_next, res, cnt, mask_spans, mask_cnt);
+            lv_draw_mask_span_t * t = res;
+            res = res_next;
+            res_next = t;
+        }
+
+        /*Nothing to calculate in a fully transparent line*/
+        if(cnt == 1 && res[0].changed == 0 && res[0].opa <= LV_OPA_MIN) {
+            return span_add(spans, 0, 0, len, LV_OPA_TRANSP, false);
+        }
+
+        m++;
+    }
+
+    if(cnt == 0) return span_add(spans, 0, 0, len, LV_OPA_COVER, false);
+
+    for(i = 0; i < cnt; i++) {
+        if(res[i].changed) break;
+    }
+    if(i == cnt) {
+        if(res != spans) _lv_memcpy_small(spans, res, cnt * sizeof(lv_draw_mask_span_t));
+        return cnt;
+    }
+
+    /* Calculate only the pixels of the edges with all the masks. The masks work with absolute coordinates
+     * so a part of the line gets exactly the values `lv_draw_mask_apply` would give for the whole line.*/
+    uint8_t out_cnt = 0;
+    for(i = 0; i < cnt; i++) {
+        lv_draw_mask_span_t * s = &res[i];
+        if(s->changed) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(&mask_buf[s->x], abs_x + s->x, abs_y, s->len);
+            lv_opa_t opa = mask_res == LV_DRAW_MASK_RES_FULL_COVER ? LV_OPA_COVER : LV_OPA_TRANSP;
+            out_cnt = span_add(res_next, out_cnt, s->x, s->len, opa, mask_res == LV_DRAW_MASK_RES_CHANGED);
+        }
+        else {
+            out_cnt = span_add(res_next, out_cnt, s->x, s->len, s->opa, false);
+        }
+    }
+
+    if(res_next != spans) _lv_memcpy_small(spans, res_next, out_cnt * sizeof(lv_draw_mask_span_t));
+    return out_cnt;
+}
+
 /**
  * Remove a mask with a given ID
  * @param id the ID of the mask.  Returned by `lv_draw_mask_add`
@@ -179,6 +301,22 @@ LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void)
     return cnt;
 }
 
+/**
+ * Count the currently added masks of a type
+ * @param type a mask type from `lv_draw_mask_type_t`
+ * @return number of active masks of this type
+ */
+uint8_t lv_draw_mask_get_type_cnt(lv_draw_mask_type_t type)
+{
+    uint8_t cnt = 0;
+    uint8_t i;
+    for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
+        lv_draw_mask_common_dsc_t * dsc = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+        if(dsc && dsc->type == type) cnt++;
+    }
+    return cnt;
+}
+
 /**
  *Initialize a line mask from two points.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
@@ -218,6 +356,7 @@ void lv_draw_mask_line_points_init(lv_draw_mask_line_param_t * param, lv_coord_t
     param->yx_steep = 0;
     param->xy_steep = 0;
     param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_line;
+    param->dsc.span_cb = (lv_draw_mask_span_xcb_t)lv_draw_mask_line_spans;
     param->dsc.type = LV_DRAW_MASK_TYPE_LINE;
 
     int32_t dx = p2x - p1x;
@@ -336,6 +475,7 @@ void lv_draw_mask_angle_init(lv_draw_mask_angle_param_t * param, lv_coord_t vert
     param->cfg.vertex_p.x = vertex_x;
     param->cfg.vertex_p.y = vertex_y;
     param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_angle;
+    param->dsc.span_cb = (lv_draw_mask_span_xcb_t)lv_draw_mask_angle_spans;
     param->dsc.type = LV_DRAW_MASK_TYPE_ANGLE;
 
     if(start_angle >= 0 && start_angle < 180) {
@@ -383,10 +523,31 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     param->cfg.radius = radius;
     param->cfg.outer = inv ? 1 : 0;
     param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_radius;
+    param->dsc.span_cb = (lv_draw_mask_span_xcb_t)lv_draw_mask_radius_spans;
     param->dsc.type = LV_DRAW_MASK_TYPE_RADIUS;
     param->y_prev = INT32_MIN;
     param->y_prev_x.f = 0;
     param->y_prev_x.i = 0;
+    param->circle = radius > 0 ? circle_cache_get(radius) : NULL;
+}
+
+/**
+ * Get the statistics of the circle cache of the radius masks
+ * @param stat store the statistics here
+ */
+void lv_draw_mask_circle_cache_get_stat(lv_draw_mask_circle_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_draw_mask_circle_cache_stat_t));
+    stat->hit_cnt = circle_cache_hit_cnt;
+    stat->miss_cnt = circle_cache_miss_cnt;
+
+    uint8_t i;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
+        _lv_draw_mask_radius_circle_dsc_t * c = &LV_GC_ROOT(_lv_circle_cache[i]);
+        if(c->radius == 0) continue;
+        stat->entry_cnt++;
+        stat->used_size += c->buf_size;
+    }
 }
 
 
@@ -408,7 +569,10 @@ void lv_draw_mask_fade_init(lv_draw_mask_fade_param_t * param, const lv_area_t *
     param->cfg.opa_bottom = opa_bottom;
     param->cfg.y_top = y_top;
     param->cfg.y_bottom = y_bottom;
+    param->lut = y_bottom >= y_top ? _lv_draw_grad_opa_get(opa_top, opa_bottom, y_bottom - y_top + 1) : NULL;
+    param->lut_id = param->lut ? param->lut->id : 0;
     param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_fade;
+    param->dsc.span_cb = (lv_draw_mask_span_xcb_t)lv_draw_mask_fade_spans;
     param->dsc.type = LV_DRAW_MASK_TYPE_FADE;
 }
 
@@ -424,6 +588,7 @@ void lv_draw_mask_map_init(lv_draw_mask_map_param_t * param, const lv_area_t * c
     lv_area_copy(&param->cfg.coords, coords);
     param->cfg.map = map;
     param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_map;
+    param->dsc.span_cb = NULL;
     param->dsc.type = LV_DRAW_MASK_TYPE_MAP;
 }
 
@@ -768,27 +933,10 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_angle(lv_opa_t * ma
             return LV_DRAW_MASK_RES_FULL_COVER;
         }
 
-        /*Start angle mask can work only from the end of end angle mask */
-        int32_t end_angle_first = (rel_y * p->end_line.xy_steep) >> 10;
-        int32_t start_angle_last = ((rel_y + 1) * p->start_line.xy_steep) >> 10;
-
-
-        /*Do not let the line end cross the vertex else it will affect the opposite part*/
-        if(p->cfg.start_angle > 270 && p->cfg.start_angle <= 359 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.start_angle > 0 && p->cfg.start_angle <= 90 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.start_angle > 90 && p->cfg.start_angle < 270 && start_angle_last > 0) start_angle_last = 0;
-
-        if(p->cfg.end_angle > 270 && p->cfg.end_angle <= 359 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.end_angle > 0 &&   p->cfg.end_angle <= 90 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.end_angle > 90 &&  p->cfg.end_angle < 270 && start_angle_last > 0) start_angle_last = 0;
-
-
-        int32_t dist = (end_angle_first - start_angle_last) >> 1;
-
         lv_draw_mask_res_t res1 = LV_DRAW_MASK_RES_FULL_COVER;
         lv_draw_mask_res_t res2 = LV_DRAW_MASK_RES_FULL_COVER;
 
-        int32_t tmp = start_angle_last + dist - rel_x;
+        int32_t tmp = angle_mask_split(p, rel_y) - rel_x;
         if(tmp > len) tmp = len;
         if(tmp > 0) {
             res1 = lv_draw_mask_line(&mask_buf[0], abs_x, abs_y, tmp, &p->start_line);
@@ -812,25 +960,10 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_angle(lv_opa_t * ma
             return LV_DRAW_MASK_RES_FULL_COVER;
         }
 
-        /*Start angle mask can work only from the end of end angle mask */
-        int32_t end_angle_first = (rel_y * p->end_line.xy_steep) >> 10;
-        int32_t start_angle_last = ((rel_y + 1) * p->start_line.xy_steep) >> 10;
-
-        /*Do not let the line end cross the vertex else it will affect the opposite part*/
-        if(p->cfg.start_angle > 270 && p->cfg.start_angle <= 359 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.start_angle > 0 && p->cfg.start_angle <= 90 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.start_angle > 90 && p->cfg.start_angle < 270 && start_angle_last > 0) start_angle_last = 0;
-
-        if(p->cfg.end_angle > 270 && p->cfg.end_angle <= 359 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.end_angle > 0 &&   p->cfg.end_angle <= 90 && start_angle_last < 0) start_angle_last = 0;
-        else if(p->cfg.end_angle > 90 &&  p->cfg.end_angle < 270 && start_angle_last > 0) start_angle_last = 0;
-
-        int32_t dist = (end_angle_first - start_angle_last) >> 1;
-
         lv_draw_mask_res_t res1 = LV_DRAW_MASK_RES_FULL_COVER;
         lv_draw_mask_res_t res2 = LV_DRAW_MASK_RES_FULL_COVER;
 
-        int32_t tmp = start_angle_last + dist - rel_x;
+        int32_t tmp = angle_mask_split(p, rel_y) - rel_x;
         if(tmp > len) tmp = len;
         if(tmp > 0) {
             res1 = lv_draw_mask_line(&mask_buf[0], abs_x, abs_y, tmp, (lv_draw_mask_line_param_t *)&p->end_line);
@@ -944,6 +1077,11 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
         return LV_DRAW_MASK_RES_CHANGED;
     }
 
+    /*The corners are taken from the cached circle if its entry wasn't given to an other radius since the init*/
+    if(p->circle && p->circle->radius == radius) {
+        return lv_draw_mask_radius_cached(mask_buf, abs_x, abs_y, len, p);
+    }
+
     int32_t k = rect.x1 - abs_x; /*First relevant coordinate on the of the mask*/
     int32_t w = lv_area_get_width(&rect);
     int32_t h = lv_area_get_height(&rect);
@@ -1143,6 +1281,170 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
     return LV_DRAW_MASK_RES_CHANGED;
 }
 
+/**
+ * Draw a line of the corners of a radius mask from its cached circle.
+ * The top left quarter of the circle is mirrored to the other corners.
+ * Gives the same mask as the calculation in `lv_draw_mask_radius`.
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius_cached(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                           lv_coord_t abs_y, lv_coord_t len,
+                                                                           lv_draw_mask_radius_param_t * p)
+{
+    const _lv_draw_mask_radius_circle_dsc_t * c = p->circle;
+    const lv_area_t * rect = &p->cfg.rect;
+    bool outer = p->cfg.outer;
+    int32_t radius = p->cfg.radius;
+    int32_t w = lv_area_get_width(rect);
+    int32_t h = lv_area_get_height(rect);
+
+    /*Only the corner lines get here. The bottom corners are the mirror of the top ones.*/
+    int32_t y = abs_y - rect->y1;
+    if(y >= radius) y = h - 1 - y;
+
+    int32_t x_start = c->x_start_on_y[y];
+    const lv_opa_t * cir_opa = &c->cir_opa[c->opa_start_on_y[y]];
+    int32_t opa_cnt = c->opa_start_on_y[y + 1] - c->opa_start_on_y[y];
+
+    /*The outermost crossed pixels on the left and on the right side*/
+    int32_t kl = rect->x1 - abs_x + x_start;
+    int32_t kr = rect->x1 - abs_x + w - 1 - x_start;
+
+    int32_t i;
+    for(i = 0; i < opa_cnt; i++) {
+        lv_opa_t m = outer ? 255 - cir_opa[i] : cir_opa[i];
+        int32_t xl = kl + i;
+        int32_t xr = kr - i;
+        if(xl >= 0 && xl < len) mask_buf[xl] = mask_mix(mask_buf[xl], m);
+        if(xr >= 0 && xr < len) mask_buf[xr] = mask_mix(mask_buf[xr], m);
+    }
+
+    if(outer == false) {
+        /*Clear the parts out of the circle*/
+        if(kl > len) return LV_DRAW_MASK_RES_TRANSP;
+        if(kl >= 0) _lv_memset_00(&mask_buf[0], kl);
+
+        kr++;
+        if(kr < 0) return LV_DRAW_MASK_RES_TRANSP;
+        if(kr < len) _lv_memset_00(&mask_buf[kr], len - kr);
+    }
+    else {
+        /*Clear the parts inside the circle*/
+        int32_t first = LV_MATH_MAX(kl + opa_cnt, 0);
+        int32_t last = LV_MATH_MIN(kr - opa_cnt, len - 1);
+        if(first <= last) _lv_memset_00(&mask_buf[first], last - first + 1);
+    }
+
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * Get the cached circle of a radius. Calculate it if it's not cached yet,
+ * replacing the least recently used circle if there is no free entry.
+ * @param radius radius of the circle
+ * @return the cached circle or NULL if it can't be cached
+ */
+static _lv_draw_mask_radius_circle_dsc_t * circle_cache_get(lv_coord_t radius)
+{
+    _lv_draw_mask_radius_circle_dsc_t * lru = NULL;
+    circle_cache_use_cnt++;
+
+    uint8_t i;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
+        _lv_draw_mask_radius_circle_dsc_t * c = &LV_GC_ROOT(_lv_circle_cache[i]);
+        if(c->radius == radius) {
+            c->last_used = circle_cache_use_cnt;
+            circle_cache_hit_cnt++;
+            return c;
+        }
+
+        /*Prefer the free entries, else the least recently used one*/
+        if(lru == NULL) lru = c;
+        else if(lru->radius != 0 && (c->radius == 0 || c->last_used < lru->last_used)) lru = c;
+    }
+
+    circle_cache_miss_cnt++;
+
+    if(lru->radius != 0) {
+        lv_mem_free(lru->buf);
+        _lv_memset_00(lru, sizeof(_lv_draw_mask_radius_circle_dsc_t));
+    }
+
+    if(circle_calc(lru, radius) == false) return NULL;
+
+    lru->last_used = circle_cache_use_cnt;
+    return lru;
+}
+
+/**
+ * Calculate the coverage of the top left quarter of a circle.
+ * `lv_draw_mask_radius` does the calculation to get exactly the same values as drawing the corners without the cache.
+ * @param c an empty cache entry to fill
+ * @param radius radius of the circle
+ * @return true: the circle is calculated; false: it's too large or out of memory
+ */
+static bool circle_calc(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radius)
+{
+    /*The left half of a circle filling a square is the left side of the corners*/
+    lv_area_t rect = {0, 0, 2 * radius - 1, 2 * radius - 1};
+    lv_draw_mask_radius_param_t p;
+    _lv_memset_00(&p, sizeof(p));
+    lv_area_copy(&p.cfg.rect, &rect);
+    p.cfg.radius = radius;
+
+    lv_opa_t * line = _lv_mem_buf_get(radius);
+
+    /* Calculate the circle twice: first only count the crossed pixels to allocate only the required size.
+     * In every line of the corner the crossed pixels are between the transparent and the covered ones.*/
+    uint32_t opa_cnt = 0;
+    uint8_t pass;
+    for(pass = 0; pass < 2; pass++) {
+        if(pass == 1) {
+            uint32_t size = radius * sizeof(uint16_t) + (radius + 1) * sizeof(uint16_t) + opa_cnt;
+            if(size > CIRCLE_CACHE_MAX_SIZE) break;
+
+            c->buf = lv_mem_alloc(size);
+            if(c->buf == NULL) {
+                LV_LOG_WARN("circle_calc: couldn't allocate memory. The corners are calculated on every draw.");
+                break;
+            }
+
+            /*The 16 bit arrays first to keep them aligned*/
+            c->x_start_on_y = (uint16_t *)c->buf;
+            c->opa_start_on_y = c->x_start_on_y + radius;
+            c->cir_opa = (lv_opa_t *)(c->opa_start_on_y + radius + 1);
+            c->buf_size = size;
+            opa_cnt = 0;
+        }
+
+        p.y_prev = INT32_MIN;
+        int32_t y;
+        for(y = 0; y < radius; y++) {
+            _lv_memset_ff(line, radius);
+            lv_draw_mask_radius(line, 0, y, radius, &p);
+
+            int32_t first = 0;
+            while(first < radius && line[first] == LV_OPA_TRANSP) first++;
+            int32_t last = radius - 1;
+            while(last >= first && line[last] == LV_OPA_COVER) last--;
+
+            if(pass == 1) {
+                c->x_start_on_y[y] = first;
+                c->opa_start_on_y[y] = opa_cnt;
+                _lv_memcpy_small(&c->cir_opa[opa_cnt], &line[first], last - first + 1);
+            }
+            opa_cnt += last - first + 1;
+        }
+
+        if(pass == 1) {
+            c->opa_start_on_y[radius] = opa_cnt;
+            c->radius = radius;
+        }
+    }
+
+    _lv_mem_buf_release(line);
+
+    return c->radius == radius;
+}
 
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                   lv_coord_t abs_y, lv_coord_t len,
@@ -1162,32 +1464,40 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mas
         mask_buf += x_ofs;
     }
 
-    int32_t i;
-
-    if(abs_y <= p->cfg.y_top) {
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_top);
-        }
+    /*`mask_mix` with an opacity which covers or clears everything*/
+    lv_opa_t opa_act = fade_opa_get(p, abs_y);
+    if(opa_act >= LV_OPA_MAX) return LV_DRAW_MASK_RES_FULL_COVER;
+    if(opa_act <= LV_OPA_MIN) {
+        if(len > 0) _lv_memset_00(mask_buf, len);
         return LV_DRAW_MASK_RES_CHANGED;
     }
-    else if(abs_y >= p->cfg.y_bottom) {
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_bottom);
-        }
-        return LV_DRAW_MASK_RES_CHANGED;
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        mask_buf[i] = mask_mix(mask_buf[i], opa_act);
     }
-    else {
-        /*Calculate the opa proportionally*/
-        int16_t opa_diff = p->cfg.opa_bottom - p->cfg.opa_top;
-        int32_t y_diff = p->cfg.y_bottom - p->cfg.y_top + 1;
-        lv_opa_t opa_act = (int32_t)((int32_t)(abs_y - p->cfg.y_top) * opa_diff) / y_diff;
-        opa_act += p->cfg.opa_top;
+    return LV_DRAW_MASK_RES_CHANGED;
+}
 
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], opa_act);
-        }
-        return LV_DRAW_MASK_RES_CHANGED;
+/**
+ * Get the opacity of a row of a fade mask
+ * @param p the fade mask
+ * @param abs_y absolute Y coordinate of the row
+ * @return the opacity of the row
+ */
+LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t fade_opa_get(lv_draw_mask_fade_param_t * p, lv_coord_t abs_y)
+{
+    if(abs_y <= p->cfg.y_top) return p->cfg.opa_top;
+    if(abs_y >= p->cfg.y_bottom) return p->cfg.opa_bottom;
+
+    /*Use the cached opacities unless an other gradient has taken their place since the mask was initialized*/
+    if(p->lut && p->lut->id == p->lut_id) {
+        const lv_opa_t * lut = p->lut->buf;
+        return lut[abs_y - p->cfg.y_top];
     }
+
+    return _lv_draw_grad_opa_calc(p->cfg.opa_top, p->cfg.opa_bottom, p->cfg.y_bottom - p->cfg.y_top + 1,
+                                  abs_y - p->cfg.y_top);
 }
 
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_map(lv_opa_t * mask_buf, lv_coord_t abs_x,
@@ -1225,6 +1535,359 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_map(lv_opa_t * mask
     return LV_DRAW_MASK_RES_CHANGED;
 }
 
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_line_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                              lv_coord_t abs_y, lv_coord_t len,
+                                                              lv_draw_mask_line_param_t * p)
+{
+    /*Make to points relative to the vertex*/
+    int32_t rel_y = abs_y - p->origo.y;
+    int32_t rel_x = abs_x - p->origo.x;
+
+    /*By default the left side is kept*/
+    lv_opa_t opa_left = p->inv ? LV_OPA_TRANSP : LV_OPA_COVER;
+    lv_opa_t opa_right = p->inv ? LV_OPA_COVER : LV_OPA_TRANSP;
+
+    /*Handle special cases the same way `lv_draw_mask_line` does*/
+    if(p->steep == 0) {
+        lv_opa_t opa = LV_OPA_TRANSP;
+        /*Horizontal*/
+        if(p->flat) {
+            if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_LEFT || p->cfg.side == LV_DRAW_MASK_LINE_SIDE_RIGHT) {
+                opa = LV_OPA_COVER;
+            }
+            else if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_TOP && rel_y + 1 < 0) opa = LV_OPA_COVER;
+            else if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_BOTTOM && rel_y > 0) opa = LV_OPA_COVER;
+            return span_add(spans, 0, 0, len, opa, false);
+        }
+        /*Vertical*/
+        else {
+            if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_TOP || p->cfg.side == LV_DRAW_MASK_LINE_SIDE_BOTTOM) {
+                return span_add(spans, 0, 0, len, LV_OPA_COVER, false);
+            }
+            else if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_LEFT) {
+                return span_split(spans, len, -rel_x, -rel_x, LV_OPA_COVER, LV_OPA_TRANSP);
+            }
+            else {
+                return span_split(spans, len, -rel_x, -rel_x, LV_OPA_TRANSP, LV_OPA_COVER);
+            }
+        }
+    }
+
+    /*The line is out of the row on the left or right (the same checks as in `line_mask_flat/steep`)*/
+    if(p->flat) {
+        int32_t y_at_x = (int32_t)((int32_t)p->yx_steep * rel_x) >> 10;
+        if(p->yx_steep > 0 ? y_at_x > rel_y : y_at_x < rel_y) return span_add(spans, 0, 0, len, opa_right, false);
+
+        y_at_x = (int32_t)((int32_t)p->yx_steep * (rel_x + len)) >> 10;
+        if(p->yx_steep > 0 ? y_at_x < rel_y : y_at_x > rel_y) return span_add(spans, 0, 0, len, opa_left, false);
+    }
+    else {
+        int32_t x_at_y = (int32_t)((int32_t)p->xy_steep * rel_y) >> 10;
+        if(x_at_y + (p->xy_steep > 0 ? 1 : 0) < rel_x) return span_add(spans, 0, 0, len, opa_right, false);
+        if(x_at_y > rel_x + len) return span_add(spans, 0, 0, len, opa_left, false);
+    }
+
+    /*Get the pixels the line crosses in this row with 1 px margin*/
+    int32_t edge_first;
+    int32_t edge_last;
+    if(p->flat) {
+        int32_t xe;
+        if(p->yx_steep > 0) xe = ((rel_y << 8) * p->xy_steep) >> 10;
+        else xe = (((rel_y + 1) << 8) * p->xy_steep) >> 10;
+
+        /*`spx` is the height change on 1 px so the line is on `255 / spx` pixels in a row*/
+        edge_first = (xe >> 8) - 1;
+        if(p->spx == 0) edge_last = rel_x + len;
+        else edge_last = (xe >> 8) + 255 / p->spx + 3;
+    }
+    else {
+        int32_t xsi = (((rel_y << 8) * p->xy_steep) >> 10) >> 8;
+        int32_t xei = ((((rel_y + 1) << 8) * p->xy_steep) >> 10) >> 8;
+        edge_first = LV_MATH_MIN(xsi, xei) - 1;
+        edge_last = LV_MATH_MAX(xsi, xei) + 1;
+    }
+
+    return span_split(spans, len, edge_first - rel_x, edge_last - rel_x + 1, opa_left, opa_right);
+}
+
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_radius_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                                lv_coord_t abs_y, lv_coord_t len,
+                                                                lv_draw_mask_radius_param_t * p)
+{
+    lv_opa_t opa_in = p->cfg.outer ? LV_OPA_TRANSP : LV_OPA_COVER;
+    lv_opa_t opa_out = p->cfg.outer ? LV_OPA_COVER : LV_OPA_TRANSP;
+    const lv_area_t * rect = &p->cfg.rect;
+    int32_t radius = p->cfg.radius;
+
+    if(abs_y < rect->y1 || abs_y > rect->y2) {
+        return span_add(spans, 0, 0, len, opa_out, false);
+    }
+
+    /*Relative to the start of the line*/
+    int32_t x1 = rect->x1 - abs_x;
+    int32_t x2 = rect->x2 - abs_x + 1;
+
+    /*The straight part of the rectangle has no edges (the same condition as in `lv_draw_mask_radius`)*/
+    if((abs_x >= rect->x1 + radius && abs_x + len <= rect->x2 - radius) ||
+       (abs_y >= rect->y1 + radius && abs_y <= rect->y2 - radius)) {
+        x1 = LV_MATH_MIN(LV_MATH_MAX(x1, 0), len);
+        x2 = LV_MATH_MIN(LV_MATH_MAX(x2, x1), len);
+        uint8_t cnt = span_add(spans, 0, 0, x1, opa_out, false);
+        cnt = span_add(spans, cnt, x1, x2 - x1, opa_in, false);
+        return span_add(spans, cnt, x2, len - x2, opa_out, false);
+    }
+
+    /*Corner rows: the anti-aliased edges can be only in the `radius` wide corners*/
+    int32_t c1 = x1 + radius;
+    int32_t c2 = x2 - radius;
+    x1 = LV_MATH_MIN(LV_MATH_MAX(x1, 0), len);
+    x2 = LV_MATH_MIN(LV_MATH_MAX(x2, 0), len);
+    c1 = LV_MATH_MIN(LV_MATH_MAX(c1, x1), x2);
+    c2 = LV_MATH_MIN(LV_MATH_MAX(c2, c1), x2);
+
+    uint8_t cnt = span_add(spans, 0, 0, x1, opa_out, false);
+    cnt = span_add(spans, cnt, x1, c1 - x1, LV_OPA_TRANSP, true);
+    cnt = span_add(spans, cnt, c1, c2 - c1, opa_in, false);
+    cnt = span_add(spans, cnt, c2, x2 - c2, LV_OPA_TRANSP, true);
+    return span_add(spans, cnt, x2, len - x2, opa_out, false);
+}
+
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_angle_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                               lv_coord_t abs_y, lv_coord_t len,
+                                                               lv_draw_mask_angle_param_t * p)
+{
+    int32_t rel_y = abs_y - p->cfg.vertex_p.y;
+    int32_t rel_x = abs_x - p->cfg.vertex_p.x;
+    lv_draw_mask_span_t part[LV_DRAW_MASK_SPAN_MAX];
+    uint8_t part_cnt;
+    uint8_t cnt = 0;
+    uint8_t i;
+
+    bool bottom = p->cfg.start_angle < 180 && p->cfg.end_angle < 180 &&
+                  p->cfg.start_angle != 0  && p->cfg.end_angle != 0 &&
+                  p->cfg.start_angle > p->cfg.end_angle;
+    bool top = p->cfg.start_angle > 180 && p->cfg.end_angle > 180 && p->cfg.start_angle > p->cfg.end_angle;
+
+    /*A line mask is used on both sides of the vertex (see `lv_draw_mask_angle`)*/
+    if(bottom || top) {
+        if((bottom && abs_y < p->cfg.vertex_p.y) || (top && abs_y > p->cfg.vertex_p.y)) {
+            return span_add(spans, 0, 0, len, LV_OPA_COVER, false);
+        }
+
+        lv_draw_mask_line_param_t * left = bottom ? &p->start_line : &p->end_line;
+        lv_draw_mask_line_param_t * right = bottom ? &p->end_line : &p->start_line;
+
+        int32_t tmp = angle_mask_split(p, rel_y) - rel_x;
+        if(tmp > len) tmp = len;
+        if(tmp > 0) {
+            part_cnt = lv_draw_mask_line_spans(part, abs_x, abs_y, tmp, left);
+            for(i = 0; i < part_cnt; i++) {
+                cnt = span_add(spans, cnt, part[i].x, part[i].len, part[i].opa, part[i].changed);
+            }
+        }
+        if(tmp < 0) tmp = 0;
+
+        part_cnt = lv_draw_mask_line_spans(part, abs_x + tmp, abs_y, len - tmp, right);
+        for(i = 0; i < part_cnt; i++) {
+            cnt = span_add(spans, cnt, part[i].x + tmp, part[i].len, part[i].opa, part[i].changed);
+        }
+        return cnt;
+    }
+
+    /*Both line masks are used and the result is their intersection.
+     *A line not used on this side of the vertex has no spans.*/
+    uint8_t start_cnt = 0;
+    if(p->cfg.start_angle == 180) {
+        if(abs_y < p->cfg.vertex_p.y) start_cnt = span_add(spans, 0, 0, len, LV_OPA_COVER, false);
+    }
+    else if(p->cfg.start_angle == 0) {
+        if(abs_y >= p->cfg.vertex_p.y) start_cnt = span_add(spans, 0, 0, len, LV_OPA_COVER, false);
+    }
+    else if((p->cfg.start_angle < 180 && abs_y < p->cfg.vertex_p.y) ||
+            (p->cfg.start_angle > 180 && abs_y >= p->cfg.vertex_p.y)) {
+        start_cnt = 0;
+    }
+    else {
+        start_cnt = lv_draw_mask_line_spans(spans, abs_x, abs_y, len, &p->start_line);
+    }
+
+    uint8_t end_cnt = 0;
+    if(p->cfg.end_angle == 180) {
+        if(abs_y >= p->cfg.vertex_p.y) end_cnt = span_add(part, 0, 0, len, LV_OPA_COVER, false);
+    }
+    else if(p->cfg.end_angle == 0) {
+        if(abs_y < p->cfg.vertex_p.y) end_cnt = span_add(part, 0, 0, len, LV_OPA_COVER, false);
+    }
+    else if((p->cfg.end_angle < 180 && abs_y < p->cfg.vertex_p.y) ||
+            (p->cfg.end_angle > 180 && abs_y >= p->cfg.vertex_p.y)) {
+        end_cnt = 0;
+    }
+    else {
+        end_cnt = lv_draw_mask_line_spans(part, abs_x, abs_y, len, &p->end_line);
+    }
+
+    if(start_cnt == 0 && end_cnt == 0) return span_add(spans, 0, 0, len, LV_OPA_TRANSP, false);
+    if(end_cnt == 0) return start_cnt;
+    if(start_cnt == 0) {
+        _lv_memcpy_small(spans, part, end_cnt * sizeof(lv_draw_mask_span_t));
+        return end_cnt;
+    }
+
+    lv_draw_mask_span_t start_spans[LV_DRAW_MASK_SPAN_MAX];
+    _lv_memcpy_small(start_spans, spans, start_cnt * sizeof(lv_draw_mask_span_t));
+    return span_combine(spans, start_spans, start_cnt, part, end_cnt);
+}
+
+LV_ATTRIBUTE_FAST_MEM static uint8_t lv_draw_mask_fade_spans(lv_draw_mask_span_t * spans, lv_coord_t abs_x,
+                                                              lv_coord_t abs_y, lv_coord_t len,
+                                                              lv_draw_mask_fade_param_t * p)
+{
+    if(abs_y < p->cfg.coords.y1 || abs_y > p->cfg.coords.y2) {
+        return span_add(spans, 0, 0, len, LV_OPA_COVER, false);
+    }
+
+    /*A row of the fade has the same opacity everywhere*/
+    lv_opa_t opa_act = fade_opa_get(p, abs_y);
+
+    /*Round it the same way `mask_mix` does*/
+    if(opa_act >= LV_OPA_MAX) opa_act = LV_OPA_COVER;
+    else if(opa_act <= LV_OPA_MIN) opa_act = LV_OPA_TRANSP;
+
+    int32_t x1 = LV_MATH_MIN(LV_MATH_MAX(p->cfg.coords.x1 - abs_x, 0), len);
+    int32_t x2 = LV_MATH_MIN(LV_MATH_MAX(p->cfg.coords.x2 - abs_x + 1, x1), len);
+    uint8_t cnt = span_add(spans, 0, 0, x1, LV_OPA_COVER, false);
+    cnt = span_add(spans, cnt, x1, x2 - x1, opa_act, false);
+    return span_add(spans, cnt, x2, len - x2, LV_OPA_COVER, false);
+}
+
+/**
+ * Get where the angle mask switches from one line mask to the other in a row
+ * @param p pointer to an angle mask parameter
+ * @param rel_y Y coordinate relative to the vertex
+ * @return the X coordinate of the switch relative to the vertex
+ */
+LV_ATTRIBUTE_FAST_MEM static int32_t angle_mask_split(lv_draw_mask_angle_param_t * p, int32_t rel_y)
+{
+    /*Start angle mask can work only from the end of end angle mask */
+    int32_t end_angle_first = (rel_y * p->end_line.xy_steep) >> 10;
+    int32_t start_angle_last = ((rel_y + 1) * p->start_line.xy_steep) >> 10;
+
+    /*Do not let the line end cross the vertex else it will affect the opposite part*/
+    if(p->cfg.start_angle > 270 && p->cfg.start_angle <= 359 && start_angle_last < 0) start_angle_last = 0;
+    else if(p->cfg.start_angle > 0 && p->cfg.start_angle <= 90 && start_angle_last < 0) start_angle_last = 0;
+    else if(p->cfg.start_angle > 90 && p->cfg.start_angle < 270 && start_angle_last > 0) start_angle_last = 0;
+
+    if(p->cfg.end_angle > 270 && p->cfg.end_angle <= 359 && start_angle_last < 0) start_angle_last = 0;
+    else if(p->cfg.end_angle > 0 &&   p->cfg.end_angle <= 90 && start_angle_last < 0) start_angle_last = 0;
+    else if(p->cfg.end_angle > 90 &&  p->cfg.end_angle < 270 && start_angle_last > 0) start_angle_last = 0;
+
+    int32_t dist = (end_angle_first - start_angle_last) >> 1;
+
+    return start_angle_last + dist;
+}
+
+/**
+ * Append a span to a span list. Merge it into the last span if they are the same kind.
+ * If the list is full the rest of the line is calculated pixel by pixel.
+ * @param spans the span list
+ * @param cnt number of spans in the list
+ * @param x start of the new span
+ * @param len length of the new span. Nothing is added if it's not positive.
+ * @param opa opacity of a uniform span
+ * @param changed true: the span has to be calculated pixel by pixel
+ * @return the new number of spans
+ */
+LV_ATTRIBUTE_FAST_MEM static inline uint8_t span_add(lv_draw_mask_span_t * spans, uint8_t cnt, int32_t x, int32_t len,
+                                                     lv_opa_t opa, bool changed)
+{
+    if(len <= 0) return cnt;
+    if(changed) opa = LV_OPA_TRANSP;
+
+    if(cnt > 0) {
+        lv_draw_mask_span_t * last = &spans[cnt - 1];
+        if(last->changed == changed && last->opa == opa) {
+            last->len += len;
+            return cnt;
+        }
+
+        if(cnt >= LV_DRAW_MASK_SPAN_MAX) {
+            last->changed = 1;
+            last->opa = LV_OPA_TRANSP;
+            last->len += len;
+            return cnt;
+        }
+    }
+
+    spans[cnt].x = x;
+    spans[cnt].len = len;
+    spans[cnt].opa = opa;
+    spans[cnt].changed = changed ? 1 : 0;
+    return cnt + 1;
+}
+
+/**
+ * Create the spans of a line with an edge: uniform opacity on the left, per pixel opacity in the edge
+ * and uniform opacity on the right
+ * @param spans store the spans here
+ * @param len length of the line
+ * @param edge_start first pixel of the edge relative to the start of the line
+ * @param edge_end the first pixel after the edge relative to the start of the line
+ * @param opa_left opacity on the left of the edge
+ * @param opa_right opacity on the right of the edge
+ * @return number of spans
+ */
+LV_ATTRIBUTE_FAST_MEM static uint8_t span_split(lv_draw_mask_span_t * spans, int32_t len, int32_t edge_start,
+                                                int32_t edge_end, lv_opa_t opa_left, lv_opa_t opa_right)
+{
+    edge_start = LV_MATH_MIN(LV_MATH_MAX(edge_start, 0), len);
+    edge_end = LV_MATH_MIN(LV_MATH_MAX(edge_end, edge_start), len);
+
+    uint8_t cnt = span_add(spans, 0, 0, edge_start, opa_left, false);
+    cnt = span_add(spans, cnt, edge_start, edge_end - edge_start, LV_OPA_TRANSP, true);
+    return span_add(spans, cnt, edge_end, len - edge_end, opa_right, false);
+}
+
+/**
+ * Intersect two span lists of the same line. Transparency wins, uniform opacities are mixed.
+ * If a per pixel span meets a not transparent one the result is per pixel too.
+ * @param out store the result here
+ * @param a a span list
+ * @param a_cnt number of spans in `a`
+ * @param b an other span list
+ * @param b_cnt number of spans in `b`
+ * @return number of spans in `out`
+ */
+LV_ATTRIBUTE_FAST_MEM static uint8_t span_combine(lv_draw_mask_span_t * out, const lv_draw_mask_span_t * a,
+                                                  uint8_t a_cnt, const lv_draw_mask_span_t * b, uint8_t b_cnt)
+{
+    uint8_t cnt = 0;
+    uint8_t i = 0;
+    uint8_t j = 0;
+    int32_t x = 0;
+
+    while(i < a_cnt && j < b_cnt) {
+        int32_t a_end = a[i].x + a[i].len;
+        int32_t b_end = b[j].x + b[j].len;
+        int32_t end = LV_MATH_MIN(a_end, b_end);
+        int32_t len = end - x;
+
+        if((a[i].changed == 0 && a[i].opa <= LV_OPA_MIN) || (b[j].changed == 0 && b[j].opa <= LV_OPA_MIN)) {
+            cnt = span_add(out, cnt, x, len, LV_OPA_TRANSP, false);
+        }
+        else if(a[i].changed || b[j].changed) {
+            cnt = span_add(out, cnt, x, len, LV_OPA_TRANSP, true);
+        }
+        else {
+            cnt = span_add(out, cnt, x, len, mask_mix(a[i].opa, b[j].opa), false);
+        }
+
+        x = end;
+        if(a_end == end) i++;
+        if(b_end == end) j++;
+    }
+
+    return cnt;
+}
 
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new)
 {
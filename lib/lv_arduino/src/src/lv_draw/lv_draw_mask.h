@@ -16,6 +16,7 @@ extern "C" {
 #include <stdbool.h>
 #include "../lv_misc/lv_area.h"
 #include "../lv_misc/lv_color.h"
+#include "lv_draw_grad.h"
 
 /*********************
  *      DEFINES
@@ -23,6 +24,10 @@ extern "C" {
 #define LV_MASK_ID_INV  (-1)
 #define _LV_MASK_MAX_NUM     16
 
+/*Max. number of spans a row of the mask stack is classified into.
+ *More spans are merged into a per-pixel span, so it's only a performance limit.*/
+#define LV_DRAW_MASK_SPAN_MAX   12
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -64,8 +69,28 @@ typedef lv_draw_mask_res_t (*lv_draw_mask_xcb_t)(lv_opa_t * mask_buf, lv_coord_t
 
 typedef uint8_t lv_draw_mask_line_side_t;
 
+/**
+ * A horizontal span of a row with a uniform or per pixel opacity
+ */
+typedef struct {
+    lv_coord_t x;       /*First pixel of the span, relative to the start of the row*/
+    lv_coord_t len;
+    lv_opa_t opa;       /*Opacity of every pixel of the span. Only valid if `changed == 0`*/
+    uint8_t changed : 1; /*1: the opacity differs pixel by pixel, read it from the mask buffer*/
+} lv_draw_mask_span_t;
+
+/**
+ * Classify a row of a mask into spans without calculating any pixels.
+ * The spans have to cover the row from left to right without gaps.
+ * Used internally by the library.
+ * @return number of spans written to `spans`. Up to `LV_DRAW_MASK_SPAN_MAX`.
+ */
+typedef uint8_t (*lv_draw_mask_span_xcb_t)(lv_draw_mask_span_t * spans, lv_coord_t abs_x, lv_coord_t abs_y,
+                                           lv_coord_t len, void * p);
+
 typedef struct {
     lv_draw_mask_xcb_t cb;
+    lv_draw_mask_span_xcb_t span_cb;   /*Optional, NULL: every pixel has to be calculated with `cb`*/
     lv_draw_mask_type_t type;
 } lv_draw_mask_common_dsc_t;
 
@@ -123,6 +148,29 @@ typedef struct {
     uint16_t delta_deg;
 } lv_draw_mask_angle_param_t;
 
+/**
+ * The coverage of the pixels on the top left quarter of a circle, calculated once per radius.
+ * The other corners and any rectangle with the same radius are drawn by mirroring it.
+ */
+typedef struct {
+    uint8_t * buf;              /*The single allocation all the arrays below are in*/
+    lv_opa_t * cir_opa;         /*Coverage of the pixels crossed by the circle, row by row, from outside to inside*/
+    uint16_t * x_start_on_y;    /*First not transparent pixel in each row of the corner*/
+    uint16_t * opa_start_on_y;  /*Index of the first coverage of each row in `cir_opa`. Has `radius + 1` elements*/
+    uint32_t buf_size;
+    uint32_t last_used;         /*The least recently used entry is replaced first*/
+    lv_coord_t radius;          /*0: unused entry*/
+} _lv_draw_mask_radius_circle_dsc_t;
+
+typedef _lv_draw_mask_radius_circle_dsc_t _lv_draw_mask_radius_circle_dsc_arr_t[LV_CIRCLE_CACHE_SIZE];
+
+typedef struct {
+    uint32_t hit_cnt;       /*Radius masks which found their circle in the cache*/
+    uint32_t miss_cnt;      /*Radius masks which had to calculate their circle*/
+    uint32_t used_size;     /*Bytes taken from the work memory by the cached circles*/
+    uint8_t entry_cnt;      /*Number of cached circles*/
+} lv_draw_mask_circle_cache_stat_t;
+
 typedef struct {
     /*The first element must be the common descriptor*/
     lv_draw_mask_common_dsc_t dsc;
@@ -136,6 +184,8 @@ typedef struct {
     int32_t y_prev;
     lv_sqrt_res_t y_prev_x;
 
+    /*The cached circle of the radius. Used only while the entry still has this radius.*/
+    _lv_draw_mask_radius_circle_dsc_t * circle;
 } lv_draw_mask_radius_param_t;
 
 typedef struct {
@@ -150,6 +200,9 @@ typedef struct {
         lv_opa_t opa_bottom;
     } cfg;
 
+    /*The cached opacity of every row. Used only while the entry still has `lut_id`.*/
+    const _lv_draw_grad_dsc_t * lut;
+    uint32_t lut_id;
 } lv_draw_mask_fade_param_t;
 
 typedef struct _lv_draw_mask_map_param_t {
@@ -198,6 +251,20 @@ int16_t lv_draw_mask_add(void * param, void * custom_id);
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
                                                             lv_coord_t len);
 
+/**
+ * Apply the added masks on a line but calculate the pixels only around the edges of the masks.
+ * The fully transparent, fully covered or evenly faded parts are returned as uniform spans.
+ * @param mask_buf store the result mask here. Has to be `len` byte long. Should be initialized with `0xFF`
+ *                 or with the base opacity. Only valid in the spans with `changed == 1`.
+ * @param abs_x absolute X coordinate where the line to calculate start
+ * @param abs_y absolute Y coordinate where the line to calculate start
+ * @param len length of the line to calculate (in pixel count)
+ * @param spans store the spans of the line here. Has to be `LV_DRAW_MASK_SPAN_MAX` long.
+ * @return number of spans. They cover the whole line. A fully transparent line is one span with 0 opacity.
+ */
+LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_apply_spans(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                       lv_coord_t len, lv_draw_mask_span_t * spans);
+
 
 //! @endcond
 
@@ -225,6 +292,13 @@ void * lv_draw_mask_remove_custom(void * custom_id);
  */
 LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void);
 
+/**
+ * Count the currently added masks of a type
+ * @param type a mask type from `lv_draw_mask_type_t`
+ * @return number of active masks of this type
+ */
+uint8_t lv_draw_mask_get_type_cnt(lv_draw_mask_type_t type);
+
 
 //! @endcond
 
@@ -275,6 +349,12 @@ void lv_draw_mask_angle_init(lv_draw_mask_angle_param_t * param, lv_coord_t vert
  */
 void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area_t * rect, lv_coord_t radius, bool inv);
 
+/**
+ * Get the statistics of the circle cache of the radius masks
+ * @param stat store the statistics here
+ */
+void lv_draw_mask_circle_cache_get_stat(lv_draw_mask_circle_cache_stat_t * stat);
+
 /**
  * Initialize a fade mask.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
@@ -9,6 +9,7 @@
 #include "lv_draw_rect.h"
 #include "lv_draw_blend.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_grad.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
@@ -19,6 +20,7 @@
 #define SHADOW_UPSACALE_SHIFT   6
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
+#define SPAN_LIMIT              32
 
 /**********************
  *      TYPEDEFS
@@ -223,20 +225,44 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
         lv_color_t grad_color = dsc->bg_color;
 
 
+        /*Get the colors of every row (vertical) or column (horizontal) from the gradient cache*/
+        const lv_color_t * grad_lut = NULL;
+        if(grad_dir == LV_GRAD_DIR_VER) {
+            grad_lut = _lv_draw_grad_color_get(dsc->bg_color, dsc->bg_main_color_stop, dsc->bg_grad_color,
+                                               dsc->bg_grad_color_stop, coords_h);
+        }
+
         lv_color_t * grad_map = NULL;
-        /*In case of horizontal gradient pre-compute a line with a gradient*/
+        /*In case of horizontal gradient pre-compute a line with a gradient if it's not cached*/
         if(grad_dir == LV_GRAD_DIR_HOR) {
-            grad_map = _lv_mem_buf_get(coords_w * sizeof(lv_color_t));
-
-            int32_t i;
-            for(i = 0; i < coords_w; i++) {
-                grad_map[i] = grad_get(dsc, coords_w, i);
+            grad_lut = _lv_draw_grad_color_get(dsc->bg_color, dsc->bg_main_color_stop, dsc->bg_grad_color,
+                                               dsc->bg_grad_color_stop, coords_w);
+            if(grad_lut == NULL) {
+                grad_map = _lv_mem_buf_get(coords_w * sizeof(lv_color_t));
+
+                int32_t i;
+                for(i = 0; i < coords_w; i++) {
+                    grad_map[i] = grad_get(dsc, coords_w, i);
+                }
+                grad_lut = grad_map;
             }
         }
 
         bool split = false;
         if(lv_area_get_width(&coords_bg) - 2 * rout > SPLIT_LIMIT) split = true;
 
+        /* With other masks let them tell the fully transparent, covered or evenly faded parts of the lines and
+         * calculate only the edges pixel by pixel. Radius masks already skip their straight parts, so with only
+         * radius masks (e.g. a bar's indicator) finding the spans costs more than it saves, like on short lines.
+         * A horizontal gradient needs the whole mask line.*/
+        bool span_mode = other_mask_cnt != 0 && grad_dir != LV_GRAD_DIR_HOR && draw_area_w >= SPAN_LIMIT &&
+                         lv_draw_mask_get_cnt() > lv_draw_mask_get_type_cnt(LV_DRAW_MASK_TYPE_RADIUS);
+        lv_draw_mask_span_t spans[LV_DRAW_MASK_SPAN_MAX];
+        uint8_t span_cnt = 0;
+        lv_area_t span_area;
+        span_area.x1 = vdb->area.x1 + draw_area.x1;
+        span_area.x2 = vdb->area.x1 + draw_area.x2;
+
         lv_opa_t opa2;
 
         lv_area_t fill_area;
@@ -248,6 +274,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
             int32_t y = h + vdb->area.y1;
 
             opa2 = opa;
+            span_cnt = 0;
 
             /*In not corner areas apply the mask only if required*/
             if(y > coords_bg.y1 + rout + 1 &&
@@ -255,13 +282,26 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
                 mask_res = LV_DRAW_MASK_RES_FULL_COVER;
                 if(simple_mode == false) {
                     _lv_memset(mask_buf, opa, draw_area_w);
-                    mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+                    if(span_mode) {
+                        span_cnt = lv_draw_mask_apply_spans(mask_buf, span_area.x1, vdb->area.y1 + h, draw_area_w,
+                                                            spans);
+                        mask_res = LV_DRAW_MASK_RES_CHANGED;
+                    }
+                    else {
+                        mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+                    }
                 }
             }
-            /*In corner areas apply the mask anyway*/
+            /*In corner areas apply the mask anyway. The own radius has edges in these lines, no spans to find.*/
             else {
                 _lv_memset(mask_buf, opa, draw_area_w);
-                mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+                if(span_mode && rout == 0) {
+                    span_cnt = lv_draw_mask_apply_spans(mask_buf, span_area.x1, vdb->area.y1 + h, draw_area_w, spans);
+                    mask_res = LV_DRAW_MASK_RES_CHANGED;
+                }
+                else {
+                    mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+                }
             }
 
             /*If mask will taken into account its base opacity was already set by memset above*/
@@ -271,7 +311,8 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
             /*Get the current line color*/
             if(grad_dir == LV_GRAD_DIR_VER) {
-                grad_color = grad_get(dsc, lv_area_get_height(&coords_bg), y - coords_bg.y1);
+                if(grad_lut) grad_color = grad_lut[y - coords_bg.y1];
+                else grad_color = grad_get(dsc, coords_h, y - coords_bg.y1);
             }
 
             /* If there is not other mask and drawing the corner area split the drawing to corner and middle areas
@@ -310,8 +351,14 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
             }
             else {
-                if(grad_dir == LV_GRAD_DIR_HOR) {
-                    _lv_blend_map(clip, &fill_area, grad_map, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+                if(span_cnt != 0) {
+                    span_area.y1 = fill_area.y1;
+                    span_area.y2 = fill_area.y2;
+                    _lv_blend_fill_spans(clip, &span_area, grad_color, mask_buf, spans, span_cnt, opa,
+                                         dsc->bg_blend_mode);
+                }
+                else if(grad_dir == LV_GRAD_DIR_HOR) {
+                    _lv_blend_map(clip, &fill_area, grad_lut, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
                 }
                 else if(grad_dir == LV_GRAD_DIR_VER) {
                     _lv_blend_fill(clip, &fill_area,
@@ -579,17 +626,8 @@ LV_ATTRIBUTE_FAST_MEM static void draw_border(const lv_area_t * coords, const lv
 
 LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(lv_draw_rect_dsc_t * dsc, lv_coord_t s, lv_coord_t i)
 {
-    int32_t min = (dsc->bg_main_color_stop * s) >> 8;
-    if(i <= min) return dsc->bg_color;
-
-    int32_t max = (dsc->bg_grad_color_stop * s) >> 8;
-    if(i >= max) return dsc->bg_grad_color;
-
-    int32_t d = dsc->bg_grad_color_stop - dsc->bg_main_color_stop;
-    d = (s * d) >> 8;
-    i -= min;
-    lv_opa_t mix = (i * 255) / d;
-    return lv_color_mix(dsc->bg_grad_color, dsc->bg_color, mix);
+    return _lv_draw_grad_color_calc(dsc->bg_color, dsc->bg_main_color_stop, dsc->bg_grad_color,
+                                    dsc->bg_grad_color_stop, s, i);
 }
 
 #if LV_USE_SHADOW
@@ -60,7 +60,7 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
  *  GLYPH DESCRIPTION
  *--------------------*/
 
-static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 256, .box_w = 54, .box_h = 16, .ofs_x = -1, .ofs_y = -2},
     {.bitmap_index = 108, .adv_w = 256, .box_w = 54, .box_h = 16, .ofs_x = -1, .ofs_y = -2}
@@ -70,12 +70,12 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
  *  CHARACTER MAPPING
  *--------------------*/
 
-static const uint16_t unicode_list_0[] = {
+static LV_ATTRIBUTE_LARGE_CONST const uint16_t unicode_list_0[] = {
     0x0, 0x48c
 };
 
 /*Collect the unicode lists and glyph_id offsets*/
-static const lv_font_fmt_txt_cmap_t cmaps[] =
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
         .range_start = 59029, .range_length = 1165, .glyph_id_start = 1,
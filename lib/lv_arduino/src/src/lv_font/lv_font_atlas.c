@@ -0,0 +1,263 @@
+/**
+ * @file lv_font_atlas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font_atlas.h"
+
+#if LV_USE_FONT_ATLAS
+
+#include "../lv_misc/lv_txt.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ATLAS_GLYPH_MAX     255     /*The index stores the glyph IDs + 1 on 8 bit*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t letter_first;
+    uint32_t letter_last;
+    uint32_t glyph_cnt;
+    uint32_t map_size;
+} atlas_layout_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool get_layout(const lv_font_t * font, const char * letters, atlas_layout_t * layout);
+static bool is_new_letter(const char * letters, uint32_t ofs, uint32_t letter);
+static uint32_t get_buf_size(const atlas_layout_t * layout);
+static void rasterize(const lv_font_glyph_dsc_t * g, const uint8_t * bitmap, lv_opa_t * map);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_font_atlas_t * atlas_head;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the size of the buffer an atlas needs
+ * @param font pointer to a font
+ * @param letters UTF-8 string of the letters to pre-rasterize. The letters not in the font are skipped.
+ * @return size of the buffer in bytes, 0 if the letters can't be put into an atlas
+ */
+uint32_t lv_font_atlas_get_buf_size(const lv_font_t * font, const char * letters)
+{
+    atlas_layout_t layout;
+    if(get_layout(font, letters, &layout) == false) return 0;
+
+    return get_buf_size(&layout);
+}
+
+/**
+ * Rasterize the glyphs of some letters of a font into a buffer and use them to draw these letters.
+ * With subpixel rendering the coverage of every subpixel is stored.
+ * @param atlas pointer to an atlas to initialize. Must be kept while it's registered.
+ * @param font pointer to a font
+ * @param letters UTF-8 string of the letters to pre-rasterize. At most 255 different letters.
+ * @param buf buffer for the glyphs with the size returned by `lv_font_atlas_get_buf_size`. Must be kept too.
+ * @param buf_size size of `buf`
+ * @return true: the atlas is registered; false: the buffer is too small or the letters can't be used
+ */
+bool lv_font_atlas_create(lv_font_atlas_t * atlas, const lv_font_t * font, const char * letters, void * buf,
+                          uint32_t buf_size)
+{
+    lv_font_atlas_remove(atlas);
+
+    atlas_layout_t layout;
+    if(get_layout(font, letters, &layout) == false) return false;
+    if(buf_size < get_buf_size(&layout)) {
+        LV_LOG_WARN("lv_font_atlas_create: the buffer is too small");
+        return false;
+    }
+
+    /*The glyphs first to keep them aligned, then the index and the coverage maps*/
+    atlas->font = font;
+    atlas->letter_first = layout.letter_first;
+    atlas->letter_cnt = layout.letter_last - layout.letter_first + 1;
+    atlas->glyphs = buf;
+    atlas->index = (uint8_t *)&atlas->glyphs[layout.glyph_cnt];
+    atlas->map = &atlas->index[atlas->letter_cnt];
+    atlas->glyph_cnt = 0;
+    _lv_memset_00(atlas->index, atlas->letter_cnt);
+
+    uint32_t map_ofs = 0;
+    uint32_t i = 0;
+    while(letters[i] != '\0') {
+        uint32_t ofs = i;
+        uint32_t letter = _lv_txt_encoded_next(letters, &i);
+
+        lv_font_glyph_dsc_t g;
+        if(lv_font_get_glyph_dsc(font, &g, letter, '\0') == false) continue;
+        if(is_new_letter(letters, ofs, letter) == false) continue;
+
+        const uint8_t * bitmap = NULL;
+        if(g.box_w != 0 && g.box_h != 0) {
+            bitmap = lv_font_get_glyph_bitmap(font, letter);
+            if(bitmap == NULL) {
+                g.box_w = 0;
+                g.box_h = 0;
+            }
+        }
+        if(bitmap) rasterize(&g, bitmap, &atlas->map[map_ofs]);
+
+        lv_font_atlas_glyph_t * ag = &atlas->glyphs[atlas->glyph_cnt];
+        ag->dsc = g;
+        ag->dsc.bpp = 8;
+        ag->bitmap_ofs = map_ofs;
+        map_ofs += (uint32_t)g.box_w * g.box_h;
+
+        atlas->glyph_cnt++;
+        atlas->index[letter - atlas->letter_first] = atlas->glyph_cnt;
+    }
+
+    atlas->next = atlas_head;
+    atlas_head = atlas;
+
+    return true;
+}
+
+/**
+ * Stop using an atlas. Then its buffer can be freed.
+ * @param atlas pointer to a registered atlas
+ */
+void lv_font_atlas_remove(lv_font_atlas_t * atlas)
+{
+    lv_font_atlas_t ** a;
+    for(a = &atlas_head; *a != NULL; a = &(*a)->next) {
+        if(*a == atlas) {
+            *a = atlas->next;
+            break;
+        }
+    }
+    atlas->next = NULL;
+}
+
+/**
+ * Get a glyph from the registered atlases
+ * @param font pointer to a font
+ * @param letter an UNICODE letter code
+ * @param dsc_out store the descriptor of the glyph here (without kerning)
+ * @return pointer to the 8 bit coverage of the glyph or NULL if it's not in an atlas
+ */
+const lv_opa_t * _lv_font_atlas_get_glyph(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * dsc_out)
+{
+    lv_font_atlas_t * a;
+    for(a = atlas_head; a != NULL; a = a->next) {
+        if(a->font != font) continue;
+
+        /*Smaller letters wrap around to large indices*/
+        uint32_t i = letter - a->letter_first;
+        if(i >= a->letter_cnt || a->index[i] == 0) continue;
+
+        const lv_font_atlas_glyph_t * g = &a->glyphs[a->index[i] - 1];
+        *dsc_out = g->dsc;
+        return &a->map[g->bitmap_ofs];
+    }
+
+    return NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Find the range of the letters and the size of the glyphs in the atlas
+ * @param font pointer to a font
+ * @param letters UTF-8 string of the letters
+ * @param layout store the result here
+ * @return false: there are no usable letters or too many of them
+ */
+static bool get_layout(const lv_font_t * font, const char * letters, atlas_layout_t * layout)
+{
+    _lv_memset_00(layout, sizeof(atlas_layout_t));
+    layout->letter_first = UINT32_MAX;
+
+    uint32_t i = 0;
+    while(letters[i] != '\0') {
+        uint32_t ofs = i;
+        uint32_t letter = _lv_txt_encoded_next(letters, &i);
+
+        lv_font_glyph_dsc_t g;
+        if(lv_font_get_glyph_dsc(font, &g, letter, '\0') == false) continue;
+        if(is_new_letter(letters, ofs, letter) == false) continue;
+
+        layout->letter_first = LV_MATH_MIN(layout->letter_first, letter);
+        layout->letter_last = LV_MATH_MAX(layout->letter_last, letter);
+        layout->glyph_cnt++;
+        layout->map_size += (uint32_t)g.box_w * g.box_h;
+    }
+
+    if(layout->glyph_cnt == 0) return false;
+    if(layout->glyph_cnt > ATLAS_GLYPH_MAX) {
+        LV_LOG_WARN("lv_font_atlas: too many letters");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Tell whether a letter is the first of its kind in a string
+ * @param letters UTF-8 string
+ * @param ofs byte index of the letter in `letters`
+ * @param letter the letter
+ * @return true: `letter` is not in `letters` before `ofs`
+ */
+static bool is_new_letter(const char * letters, uint32_t ofs, uint32_t letter)
+{
+    uint32_t i = 0;
+    while(i < ofs) {
+        if(_lv_txt_encoded_next(letters, &i) == letter) return false;
+    }
+
+    return true;
+}
+
+static uint32_t get_buf_size(const atlas_layout_t * layout)
+{
+    return layout->glyph_cnt * sizeof(lv_font_atlas_glyph_t) +
+           (layout->letter_last - layout->letter_first + 1) + layout->map_size;
+}
+
+/**
+ * Expand the packed bitmap of a glyph to one coverage byte per pixel.
+ * The same opacities `lv_draw_letter` would use.
+ * @param g descriptor of the glyph
+ * @param bitmap the bitmap from the font: `box_w * box_h` pixels with `bpp` bits, without padding between the rows
+ * @param map store the coverage here
+ */
+static void rasterize(const lv_font_glyph_dsc_t * g, const uint8_t * bitmap, lv_opa_t * map)
+{
+    uint32_t bpp = g->bpp == 3 ? 4 : g->bpp;
+    uint32_t max = (1 << bpp) - 1;
+    uint32_t px_cnt = (uint32_t)g->box_w * g->box_h;
+
+    uint32_t bit_ofs = 0;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t shift = 8 - bpp - (bit_ofs & 0x7);
+        uint32_t px = (bitmap[bit_ofs >> 3] >> shift) & max;
+        map[i] = (px * LV_OPA_COVER) / max;
+        bit_ofs += bpp;
+    }
+}
+
+#endif /*LV_USE_FONT_ATLAS*/
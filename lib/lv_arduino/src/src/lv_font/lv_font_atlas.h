@@ -0,0 +1,104 @@
+/**
+ * @file lv_font_atlas.h
+ * Pre-rasterized glyphs of a font for a fixed set of letters
+ */
+
+#ifndef LV_FONT_ATLAS_H
+#define LV_FONT_ATLAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_FONT_ATLAS
+
+#include "lv_font.h"
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A glyph in an atlas*/
+typedef struct {
+    lv_font_glyph_dsc_t dsc;    /**< The descriptor without kerning, `bpp` is 8*/
+    uint32_t bitmap_ofs;        /**< Index of the glyph's first pixel in the coverage map*/
+} lv_font_atlas_glyph_t;
+
+/**
+ * The glyphs of some letters of a font expanded to 8 bit coverage (`box_w` bytes per row).
+ * The letters are indexed directly with their code, so drawing them needs no search in the font
+ * and no unpacking of the bitmap.
+ * The atlas and its buffer are allocated by the application and used while the atlas is registered.
+ */
+typedef struct _lv_font_atlas_t {
+    struct _lv_font_atlas_t * next;     /**< The next registered atlas*/
+    const lv_font_t * font;
+    uint32_t letter_first;              /**< Code of the first letter of the index*/
+    uint32_t letter_cnt;                /**< Number of codes in the index from `letter_first`*/
+    uint8_t * index;                    /**< Glyph ID + 1 of every code, 0: not in the atlas*/
+    lv_font_atlas_glyph_t * glyphs;
+    lv_opa_t * map;                     /**< Coverage of all the glyphs*/
+    uint16_t glyph_cnt;
+} lv_font_atlas_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the size of the buffer an atlas needs
+ * @param font pointer to a font
+ * @param letters UTF-8 string of the letters to pre-rasterize. The letters not in the font are skipped.
+ * @return size of the buffer in bytes, 0 if the letters can't be put into an atlas
+ */
+uint32_t lv_font_atlas_get_buf_size(const lv_font_t * font, const char * letters);
+
+/**
+ * Rasterize the glyphs of some letters of a font into a buffer and use them to draw these letters.
+ * With subpixel rendering the coverage of every subpixel is stored.
+ * @param atlas pointer to an atlas to initialize. Must be kept while it's registered.
+ * @param font pointer to a font
+ * @param letters UTF-8 string of the letters to pre-rasterize. At most 255 different letters.
+ * @param buf buffer for the glyphs with the size returned by `lv_font_atlas_get_buf_size`. Must be kept too.
+ * @param buf_size size of `buf`
+ * @return true: the atlas is registered; false: the buffer is too small or the letters can't be used
+ */
+bool lv_font_atlas_create(lv_font_atlas_t * atlas, const lv_font_t * font, const char * letters, void * buf,
+                          uint32_t buf_size);
+
+/**
+ * Stop using an atlas. Then its buffer can be freed.
+ * @param atlas pointer to a registered atlas
+ */
+void lv_font_atlas_remove(lv_font_atlas_t * atlas);
+
+/**
+ * Get a glyph from the registered atlases
+ * @param font pointer to a font
+ * @param letter an UNICODE letter code
+ * @param dsc_out store the descriptor of the glyph here (without kerning)
+ * @return pointer to the 8 bit coverage of the glyph or NULL if it's not in an atlas
+ */
+const lv_opa_t * _lv_font_atlas_get_glyph(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * dsc_out);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FONT_ATLAS*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FONT_ATLAS_H*/
@@ -18,6 +18,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define ASCII_GLYPH_ID_SEARCH   0xFF    /*The glyph ID doesn't fit into the ASCII table*/
 
 /**********************
  *      TYPEDEFS
@@ -28,11 +29,23 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/*A cached bitmap, the bitmap is stored right after the entry*/
+typedef struct _glyph_cache_entry_t {
+    struct _glyph_cache_entry_t * next;     /*The next less recently used entry*/
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t gid;
+    uint32_t size;                          /*Size of the bitmap*/
+} glyph_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static int8_t search_kern_value(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
@@ -43,7 +56,20 @@ static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len
 static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
 static inline void rle_init(const uint8_t * in,  uint8_t bpp);
 static inline uint8_t rle_next(void);
+static uint8_t * get_glyph_buf(uint32_t size);
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+static const uint8_t * glyph_cache_find(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid);
+static uint8_t * glyph_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t size);
+static void glyph_cache_drop_lru(void);
+#endif
 
+#if LV_FONT_FMT_TXT_ALIGNED_READ
+static inline uint32_t read_word(const void * p);
+static inline uint8_t read_u8(const void * p);
+static inline uint16_t read_u16(const void * p);
+static void read_copy(void * dst, const void * src, uint32_t len);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -56,6 +82,13 @@ static uint8_t rle_prev_v;
 static uint8_t rle_cnt;
 static rle_state_t rle_state;
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+static glyph_cache_entry_t * glyph_cache_head;     /*The most recently used entry*/
+static uint32_t glyph_cache_used_size;
+static uint32_t glyph_cache_hit_cnt;
+static uint32_t glyph_cache_miss_cnt;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -63,6 +96,16 @@ static rle_state_t rle_state;
 /**********************
  *      MACROS
  **********************/
+/*Read the tables of the font (`LV_ATTRIBUTE_LARGE_CONST`)*/
+#if LV_FONT_FMT_TXT_ALIGNED_READ
+#define FONT_READ_U8(p)         read_u8(p)
+#define FONT_READ_U16(p)        read_u16(p)
+#define FONT_READ(dst, src)     read_copy(dst, src, sizeof(*(dst)))
+#else
+#define FONT_READ_U8(p)         (*(const uint8_t *)(p))
+#define FONT_READ_U16(p)        (*(const uint16_t *)(p))
+#define FONT_READ(dst, src)     (*(dst) = *(src))
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -82,16 +125,36 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return NULL;
 
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    lv_font_fmt_txt_glyph_dsc_t gdsc;
+    FONT_READ(&gdsc, &fdsc->glyph_dsc[gid]);
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        if(gdsc) return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+#if LV_FONT_FMT_TXT_ALIGNED_READ
+        /*The drawing reads the bitmap by byte so copy it to RAM. (3 bpp is stored on 4 bit)*/
+        uint32_t bpp = fdsc->bpp == 3 ? 4 : fdsc->bpp;
+        uint32_t gsize = ((uint32_t)gdsc.box_w * gdsc.box_h * bpp + 7) >> 3;
+        if(gsize == 0) return NULL;
+
+        uint8_t * buf = get_glyph_buf(gsize);
+        if(buf == NULL) return NULL;
+
+        read_copy(buf, &fdsc->glyph_bitmap[gdsc.bitmap_index], gsize);
+        return buf;
+#else
+        return &fdsc->glyph_bitmap[gdsc.bitmap_index];
+#endif
     }
     /*Handle compressed bitmap*/
     else {
-        uint32_t gsize = gdsc->box_w * gdsc->box_h;
+        uint32_t gsize = gdsc.box_w * gdsc.box_h;
         if(gsize == 0) return NULL;
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+        /*The decompressed bitmaps are kept across the frames*/
+        const uint8_t * cached = glyph_cache_find(fdsc, gid);
+        if(cached) return cached;
+#endif
+
         uint32_t buf_size = gsize;
         /*Compute memory size needed to hold decompressed glyph, rounding up*/
         switch(fdsc->bpp) {
@@ -109,14 +172,15 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
-        if(_lv_mem_get_size(decompr_buf) < buf_size) {
-            decompr_buf = lv_mem_realloc(decompr_buf, buf_size);
-            LV_ASSERT_MEM(decompr_buf);
-            if(decompr_buf == NULL) return NULL;
-        }
+        uint8_t * buf = NULL;
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+        buf = glyph_cache_add(fdsc, gid, buf_size);
+#endif
+        if(buf == NULL) buf = get_glyph_buf(buf_size);
+        if(buf == NULL) return NULL;
 
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], decompr_buf, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp);
-        return decompr_buf;
+        decompress(&fdsc->glyph_bitmap[gdsc.bitmap_index], buf, gdsc.box_w, gdsc.box_h, (uint8_t)fdsc->bpp);
+        return buf;
     }
 
     /*If not returned earlier then the letter is not found in this font*/
@@ -152,21 +216,22 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     }
 
     /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    lv_font_fmt_txt_glyph_dsc_t gdsc;
+    FONT_READ(&gdsc, &fdsc->glyph_dsc[gid]);
 
     int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
 
-    uint32_t adv_w = gdsc->adv_w;
+    uint32_t adv_w = gdsc.adv_w;
     if(is_tab) adv_w *= 2;
 
     adv_w += kv;
     adv_w  = (adv_w + (1 << 3)) >> 4;
 
     dsc_out->adv_w = adv_w;
-    dsc_out->box_h = gdsc->box_h;
-    dsc_out->box_w = gdsc->box_w;
-    dsc_out->ofs_x = gdsc->ofs_x;
-    dsc_out->ofs_y = gdsc->ofs_y;
+    dsc_out->box_h = gdsc.box_h;
+    dsc_out->box_w = gdsc.box_w;
+    dsc_out->ofs_x = gdsc.ofs_x;
+    dsc_out->ofs_y = gdsc.ofs_y;
     dsc_out->bpp   = (uint8_t)fdsc->bpp;
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
@@ -176,6 +241,7 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
 
 /**
  * Free the allocated memories.
+ * The bitmaps in the glyph cache are kept for the next frames.
  */
 void _lv_font_clean_up_fmt_txt(void)
 {
@@ -185,6 +251,59 @@ void _lv_font_clean_up_fmt_txt(void)
     }
 }
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/**
+ * Free the bitmaps kept by the glyph cache.
+ * Required before freeing or changing a font whose glyphs might be cached.
+ */
+void lv_font_fmt_txt_glyph_cache_clear(void)
+{
+    while(glyph_cache_head) glyph_cache_drop_lru();
+}
+
+/**
+ * Get the statistics of the glyph cache
+ * @param stat store the statistics here
+ */
+void lv_font_fmt_txt_glyph_cache_get_stat(lv_font_fmt_txt_glyph_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_font_fmt_txt_glyph_cache_stat_t));
+    stat->hit_cnt = glyph_cache_hit_cnt;
+    stat->miss_cnt = glyph_cache_miss_cnt;
+    stat->used_size = glyph_cache_used_size;
+
+    glyph_cache_entry_t * e;
+    for(e = glyph_cache_head; e != NULL; e = e->next) stat->entry_cnt++;
+}
+
+/**
+ * Free the cached glyph bitmaps to make room in the work memory if an allocation fails.
+ * Registered with `lv_mem_add_reclaim_cb` when the first bitmap is cached.
+ * The most recently used bitmap is kept as it might be being drawn.
+ * @return true: some memory was freed
+ */
+bool _lv_font_fmt_txt_glyph_cache_release(void)
+{
+    if(glyph_cache_head == NULL || glyph_cache_head->next == NULL) return false;
+
+    while(glyph_cache_head->next) glyph_cache_drop_lru();
+    return true;
+}
+#endif
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+/**
+ * Get the hits and misses of the glyph ID and kerning caches of a font
+ * @param font pointer to a font in LittlevGL's native format
+ * @param stat store the statistics here
+ */
+void lv_font_fmt_txt_get_cache_stat(const lv_font_t * font, lv_font_fmt_txt_cache_stat_t * stat)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+    *stat = fdsc->cache_stat;
+}
+#endif
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -196,92 +315,161 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    uint32_t ascii_i = letter - LV_FONT_FMT_TXT_ASCII_FIRST;
+    if(ascii_i < LV_FONT_FMT_TXT_ASCII_CNT) {
+        if(fdsc->ascii_ready == 0) {
+            uint32_t i;
+            for(i = 0; i < LV_FONT_FMT_TXT_ASCII_CNT; i++) {
+                uint32_t gid = search_glyph_dsc_id(fdsc, LV_FONT_FMT_TXT_ASCII_FIRST + i);
+                fdsc->ascii_glyph_id[i] = gid < ASCII_GLYPH_ID_SEARCH ? gid : ASCII_GLYPH_ID_SEARCH;
+            }
+            fdsc->ascii_ready = 1;
+        }
+
+        if(fdsc->ascii_glyph_id[ascii_i] != ASCII_GLYPH_ID_SEARCH) {
+            fdsc->cache_stat.glyph_hit_cnt++;
+            return fdsc->ascii_glyph_id[ascii_i];
+        }
+    }
+
+    uint32_t cache_i = letter & (LV_FONT_FMT_TXT_CACHE_SIZE - 1);
+    if(fdsc->cache_letter[cache_i] == letter) {
+        fdsc->cache_stat.glyph_hit_cnt++;
+        return fdsc->cache_glyph_id[cache_i];
+    }
+
+    uint32_t glyph_id = search_glyph_dsc_id(fdsc, letter);
+    fdsc->cache_letter[cache_i] = letter;
+    fdsc->cache_glyph_id[cache_i] = glyph_id;
+    fdsc->cache_stat.glyph_miss_cnt++;
+#else
     /*Check the cache first*/
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
 
+    uint32_t glyph_id = search_glyph_dsc_id(fdsc, letter);
+    fdsc->last_letter = letter;
+    fdsc->last_glyph_id = glyph_id;
+#endif
+
+    return glyph_id;
+}
+
+/**
+ * Find the glyph ID of a letter in the cmaps of a font
+ * @param fdsc descriptor of the font
+ * @param letter an UNICODE letter code, not 0
+ * @return the glyph ID or 0 if the letter is not in the font
+ */
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
+        lv_font_fmt_txt_cmap_t cmap;
+        FONT_READ(&cmap, &fdsc->cmaps[i]);
 
         /*Relative code point*/
-        uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        uint32_t rcp = letter - cmap.range_start;
+        if(rcp >= cmap.range_length) continue;
         uint32_t glyph_id = 0;
-        if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
-            glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
+        if(cmap.type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            glyph_id = cmap.glyph_id_start + rcp;
         }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
-            const uint8_t * gid_ofs_8 = fdsc->cmaps[i].glyph_id_ofs_list;
-            glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
+        else if(cmap.type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * gid_ofs_8 = cmap.glyph_id_ofs_list;
+            glyph_id = cmap.glyph_id_start + FONT_READ_U8(&gid_ofs_8[rcp]);
         }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
-            uint8_t * p = _lv_utils_bsearch(&rcp, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
+        else if(cmap.type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+            uint8_t * p = _lv_utils_bsearch(&rcp, cmap.unicode_list, cmap.list_length,
+                                            sizeof(cmap.unicode_list[0]), unicode_list_compare);
 
             if(p) {
-                lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) fdsc->cmaps[i].unicode_list);
+                lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) cmap.unicode_list);
                 ofs = ofs >> 1;     /*The list stores `uint16_t` so the get the index divide by 2*/
-                glyph_id = fdsc->cmaps[i].glyph_id_start + ofs;
+                glyph_id = cmap.glyph_id_start + ofs;
             }
         }
-        else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
-            uint8_t * p = _lv_utils_bsearch(&rcp, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
+        else if(cmap.type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            uint8_t * p = _lv_utils_bsearch(&rcp, cmap.unicode_list, cmap.list_length,
+                                            sizeof(cmap.unicode_list[0]), unicode_list_compare);
 
             if(p) {
-                lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) fdsc->cmaps[i].unicode_list);
+                lv_uintptr_t ofs = (lv_uintptr_t)(p - (uint8_t *) cmap.unicode_list);
                 ofs = ofs >> 1;     /*The list stores `uint16_t` so the get the index divide by 2*/
-                const uint8_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
-                glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_16[ofs];
+                const uint8_t * gid_ofs_16 = cmap.glyph_id_ofs_list;
+                glyph_id = cmap.glyph_id_start + FONT_READ_U8(&gid_ofs_16[ofs]);
             }
         }
 
-        /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
     return 0;
-
 }
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    uint32_t ids = (gid_left << 16) + gid_right;
+    uint32_t cache_i = (gid_left * 31 + gid_right) & (LV_FONT_FMT_TXT_CACHE_SIZE - 1);
+    if(fdsc->cache_kern_ids[cache_i] == ids) {
+        fdsc->cache_stat.kern_hit_cnt++;
+        return fdsc->cache_kern_value[cache_i];
+    }
+
+    int8_t value = search_kern_value(fdsc, gid_left, gid_right);
+    fdsc->cache_kern_ids[cache_i] = ids;
+    fdsc->cache_kern_value[cache_i] = value;
+    fdsc->cache_stat.kern_miss_cnt++;
+    return value;
+#else
+    return search_kern_value(fdsc, gid_left, gid_right);
+#endif
+}
+
+/**
+ * Find the kerning value of two glyphs in the kerning tables of a font
+ * @param fdsc descriptor of the font with kerning
+ * @param gid_left glyph ID of the left letter
+ * @param gid_right glyph ID of the right letter
+ * @return the kerning value
+ */
+static int8_t search_kern_value(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t gid_right)
+{
     int8_t value = 0;
 
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
-        const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
-        if(kdsc->glyph_ids_size == 0) {
+        lv_font_fmt_txt_kern_pair_t kdsc;
+        FONT_READ(&kdsc, (const lv_font_fmt_txt_kern_pair_t *)fdsc->kern_dsc);
+        if(kdsc.glyph_ids_size == 0) {
             /* Use binary search to find the kern value.
              * The pairs are ordered left_id first, then right_id secondly. */
-            const uint8_t * g_ids = kdsc->glyph_ids;
+            const uint8_t * g_ids = kdsc.glyph_ids;
             uint16_t g_id_both = (gid_right << 8) + gid_left; /*Create one number from the ids*/
-            uint8_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
+            uint8_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc.pair_cnt, 2, kern_pair_8_compare);
 
             /*If the `g_id_both` were found get its index from the pointer*/
             if(kid_p) {
                 lv_uintptr_t ofs = (lv_uintptr_t)(kid_p - g_ids);
                 ofs = ofs >> 1;     /*ofs is for pair, divide by 2 to refer as a single value*/
-                value = kdsc->values[ofs];
+                value = (int8_t)FONT_READ_U8(&kdsc.values[ofs]);
             }
         }
-        else if(kdsc->glyph_ids_size == 1) {
+        else if(kdsc.glyph_ids_size == 1) {
             /* Use binary search to find the kern value.
              * The pairs are ordered left_id first, then right_id secondly. */
-            const uint16_t * g_ids = kdsc->glyph_ids;
+            const uint16_t * g_ids = kdsc.glyph_ids;
             lv_uintptr_t g_id_both = (uint32_t)((uint32_t)gid_right << 8) + gid_left; /*Create one number from the ids*/
-            uint8_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
+            uint8_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc.pair_cnt, 4, kern_pair_16_compare);
 
             /*If the `g_id_both` were found get its index from the pointer*/
             if(kid_p) {
                 lv_uintptr_t ofs = (lv_uintptr_t)(kid_p - (const uint8_t *)g_ids);
                 ofs = ofs >> 4;     /*ofs is 4 byte pairs, divide by 4 to refer as a single value*/
-                value = kdsc->values[ofs];
+                value = (int8_t)FONT_READ_U8(&kdsc.values[ofs]);
             }
 
         }
@@ -291,14 +479,15 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     }
     else {
         /*Kern classes*/
-        const lv_font_fmt_txt_kern_classes_t * kdsc = fdsc->kern_dsc;
-        uint8_t left_class = kdsc->left_class_mapping[gid_left];
-        uint8_t right_class = kdsc->right_class_mapping[gid_right];
+        lv_font_fmt_txt_kern_classes_t kdsc;
+        FONT_READ(&kdsc, (const lv_font_fmt_txt_kern_classes_t *)fdsc->kern_dsc);
+        uint8_t left_class = FONT_READ_U8(&kdsc.left_class_mapping[gid_left]);
+        uint8_t right_class = FONT_READ_U8(&kdsc.right_class_mapping[gid_right]);
 
         /* If class = 0, kerning not exist for that glyph
          * else got the value form `class_pair_values` 2D array*/
         if(left_class > 0 && right_class > 0) {
-            value = kdsc->class_pair_values[(left_class - 1) * kdsc->right_class_cnt + (right_class - 1)];
+            value = (int8_t)FONT_READ_U8(&kdsc.class_pair_values[(left_class - 1) * kdsc.right_class_cnt + (right_class - 1)]);
         }
 
     }
@@ -311,8 +500,9 @@ static int32_t kern_pair_8_compare(const void * ref, const void * element)
     const uint8_t * element8_p = element;
 
     /*If the MSB is different it will matter. If not return the diff. of the LSB*/
-    if(ref8_p[0] != element8_p[0]) return (int32_t)ref8_p[0] - element8_p[0];
-    else return (int32_t) ref8_p[1] - element8_p[1];
+    uint8_t element0 = FONT_READ_U8(&element8_p[0]);
+    if(ref8_p[0] != element0) return (int32_t)ref8_p[0] - element0;
+    else return (int32_t) ref8_p[1] - FONT_READ_U8(&element8_p[1]);
 
 }
 
@@ -322,8 +512,9 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
     const uint16_t * element16_p = element;
 
     /*If the MSB is different it will matter. If not return the diff. of the LSB*/
-    if(ref16_p[0] != element16_p[0]) return (int32_t)ref16_p[0] - element16_p[0];
-    else return (int32_t) ref16_p[1] - element16_p[1];
+    uint16_t element0 = FONT_READ_U16(&element16_p[0]);
+    if(ref16_p[0] != element0) return (int32_t)ref16_p[0] - element0;
+    else return (int32_t) ref16_p[1] - FONT_READ_U16(&element16_p[1]);
 }
 
 /**
@@ -415,11 +606,11 @@ static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len
     bit_pos = bit_pos & 0x7;
 
     if(bit_pos + len >= 8) {
-        uint16_t in16 = (in[byte_pos] << 8) + in[byte_pos + 1];
+        uint16_t in16 = (FONT_READ_U8(&in[byte_pos]) << 8) + FONT_READ_U8(&in[byte_pos + 1]);
         return (in16 >> (16 - bit_pos - len)) & bit_mask;
     }
     else {
-        return (in[byte_pos] >> (8 - bit_pos - len)) & bit_mask;
+        return (FONT_READ_U8(&in[byte_pos]) >> (8 - bit_pos - len)) & bit_mask;
     }
 }
 
@@ -555,5 +746,164 @@ static inline uint8_t rle_next(void)
  */
 static int32_t unicode_list_compare(const void * ref, const void * element)
 {
-    return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)(*(uint16_t *)element));
+    return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)FONT_READ_U16(element));
+}
+
+/**
+ * Get the buffer for the bitmap of a glyph. It's freed by `_lv_font_clean_up_fmt_txt`.
+ * @param size required size in bytes
+ * @return pointer to the buffer or NULL if out of memory
+ */
+static uint8_t * get_glyph_buf(uint32_t size)
+{
+    if(_lv_mem_get_size(decompr_buf) < size) {
+        decompr_buf = lv_mem_realloc(decompr_buf, size);
+        LV_ASSERT_MEM(decompr_buf);
+    }
+
+    return decompr_buf;
+}
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/**
+ * Look up the bitmap of a glyph in the glyph cache and make it the most recently used one.
+ * @param fdsc the font's descriptor
+ * @param gid ID of the glyph
+ * @return the cached bitmap or NULL if it's not cached
+ */
+static const uint8_t * glyph_cache_find(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid)
+{
+    glyph_cache_entry_t ** prev_next = &glyph_cache_head;
+    glyph_cache_entry_t * e;
+    for(e = glyph_cache_head; e != NULL; e = e->next) {
+        if(e->gid == gid && e->fdsc == fdsc) {
+            *prev_next = e->next;
+            e->next = glyph_cache_head;
+            glyph_cache_head = e;
+            glyph_cache_hit_cnt++;
+            return (const uint8_t *)(e + 1);
+        }
+        prev_next = &e->next;
+    }
+
+    glyph_cache_miss_cnt++;
+    return NULL;
+}
+
+/**
+ * Add a bitmap to the glyph cache, dropping the least recently used ones
+ * if the cache is full or the work memory can't hold the new one.
+ * @param fdsc the font's descriptor
+ * @param gid ID of the glyph
+ * @param size size of the bitmap in bytes
+ * @return buffer for the bitmap in the new entry or NULL if it can't be cached
+ */
+static uint8_t * glyph_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t size)
+{
+    uint32_t entry_size = sizeof(glyph_cache_entry_t) + size;
+    if(entry_size > LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE) return NULL;
+
+    while(glyph_cache_used_size + entry_size > LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE) glyph_cache_drop_lru();
+
+    /*`lv_mem_alloc` can free the cached bitmaps if the work memory is full*/
+    if(glyph_cache_head == NULL) lv_mem_add_reclaim_cb(_lv_font_fmt_txt_glyph_cache_release);
+
+    glyph_cache_entry_t * e = lv_mem_alloc(entry_size);
+    while(e == NULL && glyph_cache_head != NULL) {
+        glyph_cache_drop_lru();
+        e = lv_mem_alloc(entry_size);
+    }
+    if(e == NULL) return NULL;
+
+    e->fdsc = fdsc;
+    e->gid = gid;
+    e->size = size;
+    e->next = glyph_cache_head;
+    glyph_cache_head = e;
+    glyph_cache_used_size += entry_size;
+
+    return (uint8_t *)(e + 1);
+}
+
+/**
+ * Free the least recently used entry of the glyph cache
+ */
+static void glyph_cache_drop_lru(void)
+{
+    glyph_cache_entry_t ** lru = &glyph_cache_head;
+    if(*lru == NULL) return;
+
+    while((*lru)->next != NULL) lru = &(*lru)->next;
+
+    glyph_cache_used_size -= sizeof(glyph_cache_entry_t) + (*lru)->size;
+    lv_mem_free(*lru);
+    *lru = NULL;
+}
+#endif
+
+#if LV_FONT_FMT_TXT_ALIGNED_READ
+/**
+ * Read the aligned 32 bit word containing an address.
+ * @param p an address in the font's tables
+ * @return the word
+ */
+static inline uint32_t read_word(const void * p)
+{
+    return *(const uint32_t *)((lv_uintptr_t)p & ~(lv_uintptr_t)0x3);
+}
+
+/**
+ * Read a byte with an aligned 32 bit load (little endian)
+ * @param p address of the byte
+ * @return the byte
+ */
+static inline uint8_t read_u8(const void * p)
+{
+    return (uint8_t)(read_word(p) >> (((lv_uintptr_t)p & 0x3) << 3));
+}
+
+/**
+ * Read an `uint16_t` with an aligned 32 bit load (little endian). Being 2 byte aligned it never crosses a word.
+ * @param p address of the value
+ * @return the value
+ */
+static inline uint16_t read_u16(const void * p)
+{
+    return (uint16_t)(read_word(p) >> (((lv_uintptr_t)p & 0x2) << 3));
+}
+
+/**
+ * Copy data from the font's tables to RAM with aligned 32 bit loads
+ * @param dst destination in RAM
+ * @param src source in the font's tables
+ * @param len number of bytes to copy
+ */
+static void read_copy(void * dst, const void * src, uint32_t len)
+{
+    uint8_t * d8 = dst;
+    const uint8_t * s8 = src;
+
+    /*The bytes before the first whole word*/
+    while(len > 0 && ((lv_uintptr_t)s8 & 0x3)) {
+        *d8 = read_u8(s8);
+        d8++;
+        s8++;
+        len--;
+    }
+
+    while(len >= 4) {
+        uint32_t w = *(const uint32_t *)s8;
+        _lv_memcpy_small(d8, &w, 4);
+        d8 += 4;
+        s8 += 4;
+        len -= 4;
+    }
+
+    while(len > 0) {
+        *d8 = read_u8(s8);
+        d8++;
+        s8++;
+        len--;
+    }
 }
+#endif /*LV_FONT_FMT_TXT_ALIGNED_READ*/
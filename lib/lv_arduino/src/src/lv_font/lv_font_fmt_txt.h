@@ -21,6 +21,13 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*The printable ASCII letters (0x20..0x7F) have their glyph IDs in a table*/
+#define LV_FONT_FMT_TXT_ASCII_FIRST     0x20
+#define LV_FONT_FMT_TXT_ASCII_CNT       96
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE & (LV_FONT_FMT_TXT_CACHE_SIZE - 1)
+#error "LV_FONT_FMT_TXT_CACHE_SIZE must be a power of 2"
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -153,6 +160,22 @@ typedef enum {
 } lv_font_fmt_txt_bitmap_format_t;
 
 
+/*Lookups of a font since it's first used*/
+typedef struct {
+    uint32_t glyph_hit_cnt;     /*Glyph IDs found in the ASCII table or in the cache*/
+    uint32_t glyph_miss_cnt;    /*Glyph IDs searched in the cmaps*/
+    uint32_t kern_hit_cnt;      /*Kerning values found in the cache*/
+    uint32_t kern_miss_cnt;     /*Kerning values searched in the kerning tables*/
+} lv_font_fmt_txt_cache_stat_t;
+
+/*The bitmaps kept by the glyph cache since the start*/
+typedef struct {
+    uint32_t hit_cnt;       /*Bitmaps found in the cache*/
+    uint32_t miss_cnt;      /*Bitmaps which had to be decompressed or copied*/
+    uint32_t used_size;     /*Bytes taken from the work memory by the cached bitmaps*/
+    uint16_t entry_cnt;     /*Number of cached bitmaps*/
+} lv_font_fmt_txt_glyph_cache_stat_t;
+
 /*Describe store additional data for fonts */
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -189,9 +212,26 @@ typedef struct {
      */
     uint16_t bitmap_format  : 2;
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    /* Glyph IDs of the printable ASCII letters, filled on the first lookup.
+     * 0: not in the font, 0xFF: not in the table, use the cache*/
+    uint8_t ascii_glyph_id[LV_FONT_FMT_TXT_ASCII_CNT];
+    uint8_t ascii_ready;
+
+    /*Direct mapped cache of the other letters (`letter % LV_FONT_FMT_TXT_CACHE_SIZE`), 0: empty*/
+    uint32_t cache_letter[LV_FONT_FMT_TXT_CACHE_SIZE];
+    uint16_t cache_glyph_id[LV_FONT_FMT_TXT_CACHE_SIZE];
+
+    /*Direct mapped cache of the kerning values, the key is `(left glyph ID << 16) + right glyph ID`, 0: empty*/
+    uint32_t cache_kern_ids[LV_FONT_FMT_TXT_CACHE_SIZE];
+    int8_t cache_kern_value[LV_FONT_FMT_TXT_CACHE_SIZE];
+
+    lv_font_fmt_txt_cache_stat_t cache_stat;
+#else
     /*Cache the last letter and is glyph id*/
     uint32_t last_letter;
     uint32_t last_glyph_id;
+#endif
 
 } lv_font_fmt_txt_dsc_t;
 
@@ -223,6 +263,37 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+/**
+ * Get the hits and misses of the glyph ID and kerning caches of a font
+ * @param font pointer to a font in LittlevGL's native format
+ * @param stat store the statistics here
+ */
+void lv_font_fmt_txt_get_cache_stat(const lv_font_t * font, lv_font_fmt_txt_cache_stat_t * stat);
+#endif
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/**
+ * Free the bitmaps kept by the glyph cache.
+ * Required before freeing or changing a font whose glyphs might be cached.
+ */
+void lv_font_fmt_txt_glyph_cache_clear(void);
+
+/**
+ * Get the statistics of the glyph cache
+ * @param stat store the statistics here
+ */
+void lv_font_fmt_txt_glyph_cache_get_stat(lv_font_fmt_txt_glyph_cache_stat_t * stat);
+
+/**
+ * Free the cached glyph bitmaps to make room in the work memory if an allocation fails.
+ * Registered with `lv_mem_add_reclaim_cb` when the first bitmap is cached.
+ * The most recently used bitmap is kept as it might be being drawn.
+ * @return true: some memory was freed
+ */
+bool _lv_font_fmt_txt_glyph_cache_release(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
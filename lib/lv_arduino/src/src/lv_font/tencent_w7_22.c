@@ -391,7 +391,7 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
  *  GLYPH DESCRIPTION
  *--------------------*/
 
-static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 289, .box_w = 51, .box_h = 17, .ofs_x = 1, .ofs_y = -1},
     {.bitmap_index = 109, .adv_w = 97, .box_w = 18, .box_h = 4, .ofs_x = -1, .ofs_y = -1},
@@ -427,7 +427,7 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
  *  CHARACTER MAPPING
  *--------------------*/
 
-static const uint16_t unicode_list_0[] = {
+static LV_ATTRIBUTE_LARGE_CONST const uint16_t unicode_list_0[] = {
     0x0, 0x9, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x1e, 0x26, 0x28,
     0x2b, 0x2e, 0x30, 0x40, 0x46, 0x48, 0x4a, 0x4d,
@@ -435,7 +435,7 @@ static const uint16_t unicode_list_0[] = {
 };
 
 /*Collect the unicode lists and glyph_id offsets*/
-static const lv_font_fmt_txt_cmap_t cmaps[] =
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
         .range_start = 37, .range_length = 8415, .glyph_id_start = 1,
@@ -449,7 +449,7 @@ static const lv_font_fmt_txt_cmap_t cmaps[] =
 
 
 /*Map glyph_ids to kern left classes*/
-static const uint8_t kern_left_class_mapping[] =
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t kern_left_class_mapping[] =
 {
     0, 0, 1, 2, 3, 4, 5, 6,
     7, 8, 9, 10, 11, 3, 12, 13,
@@ -458,7 +458,7 @@ static const uint8_t kern_left_class_mapping[] =
 };
 
 /*Map glyph_ids to kern right classes*/
-static const uint8_t kern_right_class_mapping[] =
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t kern_right_class_mapping[] =
 {
     0, 1, 2, 3, 4, 5, 6, 7,
     8, 9, 4, 10, 11, 12, 13, 14,
@@ -467,7 +467,7 @@ static const uint8_t kern_right_class_mapping[] =
 };
 
 /*Kern values between classes*/
-static const int8_t kern_class_values[] =
+static LV_ATTRIBUTE_LARGE_CONST const int8_t kern_class_values[] =
 {
     0, 0, 0, 0, -28, 0, 0, -14,
     0, 0, 0, 0, 0, 0, 0, 0,
@@ -542,7 +542,7 @@ static const int8_t kern_class_values[] =
 
 
 /*Collect the kern class' data in one place*/
-static const lv_font_fmt_txt_kern_classes_t kern_classes =
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_kern_classes_t kern_classes =
 {
     .class_pair_values   = kern_class_values,
     .left_class_mapping  = kern_left_class_mapping,
@@ -227,7 +227,7 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
  *  GLYPH DESCRIPTION
  *--------------------*/
 
-static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 106, .box_w = 18, .box_h = 4, .ofs_x = -1, .ofs_y = -1},
     {.bitmap_index = 9, .adv_w = 253, .box_w = 48, .box_h = 19, .ofs_x = 0, .ofs_y = -1},
@@ -249,13 +249,13 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
  *  CHARACTER MAPPING
  *--------------------*/
 
-static const uint16_t unicode_list_0[] = {
+static LV_ATTRIBUTE_LARGE_CONST const uint16_t unicode_list_0[] = {
     0x0, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8,
     0x9, 0xa, 0xb, 0x15, 0x82, 0x20d5
 };
 
 /*Collect the unicode lists and glyph_id offsets*/
-static const lv_font_fmt_txt_cmap_t cmaps[] =
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
         .range_start = 46, .range_length = 8406, .glyph_id_start = 1,
@@ -269,21 +269,21 @@ static const lv_font_fmt_txt_cmap_t cmaps[] =
 
 
 /*Map glyph_ids to kern left classes*/
-static const uint8_t kern_left_class_mapping[] =
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t kern_left_class_mapping[] =
 {
     0, 1, 2, 0, 3, 4, 5, 6,
     7, 8, 9, 2, 10, 11, 10
 };
 
 /*Map glyph_ids to kern right classes*/
-static const uint8_t kern_right_class_mapping[] =
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t kern_right_class_mapping[] =
 {
     0, 1, 2, 3, 4, 5, 6, 7,
     2, 8, 9, 10, 11, 12, 12
 };
 
 /*Kern values between classes*/
-static const int8_t kern_class_values[] =
+static LV_ATTRIBUTE_LARGE_CONST const int8_t kern_class_values[] =
 {
     0, 0, -31, 0, 0, -15, 0, 0,
     0, 0, 0, 0, 0, 0, 0, -1,
@@ -306,7 +306,7 @@ static const int8_t kern_class_values[] =
 
 
 /*Collect the kern class' data in one place*/
-static const lv_font_fmt_txt_kern_classes_t kern_classes =
+static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_kern_classes_t kern_classes =
 {
     .class_pair_values   = kern_class_values,
     .left_class_mapping  = kern_left_class_mapping,
@@ -20,6 +20,7 @@ extern "C" {
 #include "lv_task.h"
 #include "../lv_draw/lv_img_cache.h"
 #include "../lv_draw/lv_draw_mask.h"
+#include "../lv_draw/lv_draw_grad.h"
 
 /*********************
  *      DEFINES
@@ -39,6 +40,8 @@ extern "C" {
     f(lv_task_t*, _lv_task_act)                                    \
     f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
     f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
+    f(_lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache)    \
+    f(_lv_draw_grad_dsc_arr_t , _lv_grad_cache)                    \
     f(void * , _lv_theme_material_styles)                          \
     f(void * , _lv_theme_template_styles)                          \
     f(void * , _lv_theme_mono_styles)                              \
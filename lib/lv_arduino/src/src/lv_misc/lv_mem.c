@@ -10,6 +10,7 @@
 #include "lv_mem.h"
 #include "lv_math.h"
 #include "lv_gc.h"
+#include "lv_debug.h"
 #include <string.h>
 
 #if LV_MEM_CUSTOM != 0
@@ -38,6 +39,54 @@
     #define MEM_UNIT uint32_t
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/*Two-level segregated fit: the free blocks are in lists by size.
+ *The first level is the power of 2 range of the size, the second level divides it linearly.
+ *The blocks smaller than `TLSF_SMALL_SIZE` are in the lists of the first level 0 with exact sizes.*/
+#define TLSF_SL_LOG2        3
+#define TLSF_SL_CNT         (1 << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT       (TLSF_SL_LOG2 + 2)
+#define TLSF_SMALL_SIZE     (1 << TLSF_FL_SHIFT)
+
+/*The lists link the blocks by their offset in 4 bytes units*/
+#define TLSF_UNIT           4
+#define TLSF_NIL            0xFFFF
+
+/*A free block needs room for the links and for the offset of the block at its end*/
+#define TLSF_MIN_SIZE       8
+
+#if LV_MEM_SIZE > (256UL * 1024UL)
+#error "LV_MEM_TLSF: LV_MEM_SIZE can be at most 256 kB"
+#elif LV_MEM_SIZE >= (128UL * 1024UL)
+#define TLSF_SIZE_BITS      18
+#elif LV_MEM_SIZE >= (64UL * 1024UL)
+#define TLSF_SIZE_BITS      17
+#elif LV_MEM_SIZE >= (32UL * 1024UL)
+#define TLSF_SIZE_BITS      16
+#elif LV_MEM_SIZE >= (16UL * 1024UL)
+#define TLSF_SIZE_BITS      15
+#elif LV_MEM_SIZE >= (8UL * 1024UL)
+#define TLSF_SIZE_BITS      14
+#else
+#define TLSF_SIZE_BITS      13
+#endif
+
+/*Number of first level lists to cover every block size in the work memory*/
+#define TLSF_FL_CNT         (TLSF_SIZE_BITS - TLSF_FL_SHIFT + 1)
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+#define SLAB_NIL            0xFFFF
+#endif
+
+#if LV_MEM_TRACE
+#if defined(__GNUC__)
+    #define TRACE_CALLER()  __builtin_return_address(0)
+#else
+    #define TRACE_CALLER()  NULL
+#endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -48,7 +97,12 @@
 typedef union {
     struct {
         MEM_UNIT used : 1;    /* 1: if the entry is used*/
+#if LV_MEM_TLSF
+        MEM_UNIT prev_free : 1; /* 1: if the previous entry is free*/
+        MEM_UNIT d_size : 30; /* Size off the data (1 means 4 bytes)*/
+#else
         MEM_UNIT d_size : 31; /* Size off the data (1 means 4 bytes)*/
+#endif
     } s;
     MEM_UNIT header; /* The header (used + d_size)*/
 } lv_mem_header_t;
@@ -58,6 +112,35 @@ typedef struct {
     uint8_t first_data; /*First data byte in the allocated data (Just for easily create a pointer)*/
 } lv_mem_ent_t;
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+typedef struct {
+    uint16_t size;
+    uint16_t cnt;
+} mem_slab_cfg_t;
+
+/*A pool of fixed size blocks without headers at the beginning of the work memory*/
+typedef struct {
+    uint8_t * start;        /*The first block*/
+    uint8_t * used_map;     /*Bit `i` is set if the block `i` is used. After the blocks.*/
+    uint32_t size_recip;    /*`ceil(65536 / size)` to get the index of a block without division*/
+    uint16_t size;
+    uint16_t cnt;
+    uint16_t free;          /*Index of the first free block. The free blocks store the index of the next one.*/
+    uint16_t used_cnt;
+    uint16_t max_used_cnt;
+    uint32_t alloc_cnt;
+    uint32_t miss_cnt;
+} mem_slab_t;
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/*Stored in the first bytes of the free blocks*/
+typedef struct {
+    uint16_t next;
+    uint16_t prev;
+} tlsf_links_t;
+#endif
+
 #endif /* LV_ENABLE_GC */
 
 #ifdef LV_ARCH_64
@@ -71,21 +154,70 @@ typedef struct {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+    static void * mem_alloc(size_t size);
+    static void mem_free(const void * data);
+    static void * mem_realloc(void * data_p, size_t new_size);
 #if LV_MEM_CUSTOM == 0
+    static void double_free(const void * data);
     static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
+#if LV_MEM_TLSF == 0
     static void * ent_alloc(lv_mem_ent_t * e, size_t size);
     static void ent_trunc(lv_mem_ent_t * e, size_t size);
 #endif
+#endif
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    static void * tlsf_alloc(size_t size);
+    static void tlsf_trunc(lv_mem_ent_t * e, size_t size);
+    static void tlsf_release(lv_mem_ent_t * e);
+    static lv_mem_ent_t * tlsf_find(size_t size);
+    static void tlsf_insert(lv_mem_ent_t * e);
+    static void tlsf_remove(lv_mem_ent_t * e);
+    static void tlsf_mapping(uint32_t size, uint32_t * fl, uint32_t * sl);
+    static void tlsf_init(void);
+    static bool tlsf_test(lv_mem_ent_t * e);
+#endif
+#if LV_ENABLE_GC == 0
+    static bool is_used(const void * data);
+#endif
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    static uint32_t slab_init(void);
+    static void * slab_alloc(size_t size);
+    static bool slab_free(const void * data);
+    static mem_slab_t * slab_of_ptr(const void * data, uint32_t * id);
+    static bool slab_test(void);
+#endif
+static bool reclaim(void);
+#if LV_MEM_CUSTOM == 0
+    static void used_add(uint32_t size);
+#endif
+#if LV_MEM_TRACE
+    void LV_MEM_TRACE_CB(void * old_p, void * new_p, size_t size, void * caller); /*Implemented by the application*/
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_MEM_CUSTOM == 0
     static uint8_t * work_mem;
+    static uint32_t mem_used_size; /*The size of the allocated blocks, in the heap and in the pools*/
+    static uint32_t mem_max_size;  /*The peak of `mem_used_size`*/
+    static uint8_t * heap_mem;    /*The entries with headers, after the pools of `LV_MEM_SLAB`*/
+#endif
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    static const mem_slab_cfg_t slab_cfg[] = LV_MEM_SLAB_CLASSES;
+    #define SLAB_CNT    (sizeof(slab_cfg) / sizeof(slab_cfg[0]))
+    static mem_slab_t slabs[SLAB_CNT];
+#endif
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    static uint32_t tlsf_fl_map;                            /*Bit `fl` is set if `tlsf_sl_map[fl]` is not empty*/
+    static uint8_t tlsf_sl_map[TLSF_FL_CNT];                /*Bit `sl` is set if the list is not empty*/
+    static uint16_t tlsf_heads[TLSF_FL_CNT][TLSF_SL_CNT];   /*The first free block of the lists*/
 #endif
 
 static uint32_t zero_mem; /*Give the address of this variable if 0 byte should be allocated*/
 
+static lv_mem_reclaim_cb_t reclaim_cbs[LV_MEM_RECLAIM_CB_MAX_NUM];
+
 
 static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
 static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
@@ -122,10 +254,20 @@ void _lv_mem_init(void)
     work_mem = (uint8_t *)LV_MEM_ADR;
 #endif
 
-    lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
+#if LV_MEM_SLAB
+    heap_mem = work_mem + slab_init();
+#else
+    heap_mem = work_mem;
+#endif
+    lv_mem_ent_t * full = (lv_mem_ent_t *)heap_mem;
     full->header.s.used = 0;
-    /*The total mem size id reduced by the first header and the close patterns */
-    full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+    /*The total mem size id reduced by the pools, the first header and the close patterns */
+    full->header.s.d_size = LV_MEM_SIZE - (heap_mem - work_mem) - sizeof(lv_mem_header_t);
+    mem_used_size = 0;
+    mem_max_size = 0;
+#if LV_MEM_TLSF
+    tlsf_init();
+#endif
 #endif
 }
 
@@ -137,10 +279,20 @@ void _lv_mem_deinit(void)
 {
 #if LV_MEM_CUSTOM == 0
     _lv_memset_00(work_mem, (LV_MEM_SIZE / sizeof(MEM_UNIT)) * sizeof(MEM_UNIT));
-    lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
+#if LV_MEM_SLAB
+    heap_mem = work_mem + slab_init();
+#else
+    heap_mem = work_mem;
+#endif
+    lv_mem_ent_t * full = (lv_mem_ent_t *)heap_mem;
     full->header.s.used = 0;
-    /*The total mem size id reduced by the first header and the close patterns */
-    full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+    /*The total mem size id reduced by the pools, the first header and the close patterns */
+    full->header.s.d_size = LV_MEM_SIZE - (heap_mem - work_mem) - sizeof(lv_mem_header_t);
+    mem_used_size = 0;
+    mem_max_size = 0;
+#if LV_MEM_TLSF
+    tlsf_init();
+#endif
 #endif
 }
 
@@ -151,57 +303,10 @@ void _lv_mem_deinit(void)
  */
 void * lv_mem_alloc(size_t size)
 {
-    if(size == 0) {
-        return &zero_mem;
-    }
-
-#ifdef LV_ARCH_64
-    /*Round the size up to 8*/
-    size = (size + 7) & (~0x7);
-#else
-    /*Round the size up to 4*/
-    size = (size + 3) & (~0x3);
-#endif
-    void * alloc = NULL;
-
-#if LV_MEM_CUSTOM == 0
-    /*Use the built-in allocators*/
-    lv_mem_ent_t * e = NULL;
-
-    /* Search for a appropriate entry*/
-    do {
-        /* Get the next entry*/
-        e = ent_get_next(e);
-
-        /*If there is next entry then try to allocate there*/
-        if(e != NULL) {
-            alloc = ent_alloc(e, size);
-        }
-        /* End if there is not next entry OR the alloc. is successful*/
-    } while(e != NULL && alloc == NULL);
-
-#else
-    /*Use custom, user defined malloc function*/
-#if LV_ENABLE_GC == 1 /*gc must not include header*/
-    alloc = LV_MEM_CUSTOM_ALLOC(size);
-#else                 /* LV_ENABLE_GC */
-    /*Allocate a header too to store the size*/
-    alloc = LV_MEM_CUSTOM_ALLOC(size + sizeof(lv_mem_header_t));
-    if(alloc != NULL) {
-        ((lv_mem_ent_t *)alloc)->header.s.d_size = size;
-        ((lv_mem_ent_t *)alloc)->header.s.used   = 1;
-
-        alloc = &((lv_mem_ent_t *)alloc)->first_data;
-    }
-#endif                /* LV_ENABLE_GC */
-#endif                /* LV_MEM_CUSTOM */
-
-#if LV_MEM_ADD_JUNK
-    if(alloc != NULL) _lv_memset(alloc, 0xaa, size);
+    void * alloc = mem_alloc(size);
+#if LV_MEM_TRACE
+    if(alloc != &zero_mem) LV_MEM_TRACE_CB(NULL, alloc, size, TRACE_CALLER());
 #endif
-
-    if(alloc == NULL) LV_LOG_WARN("Couldn't allocate memory");
-
     return alloc;
 }
 
@@ -214,50 +319,10 @@ void lv_mem_free(const void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
-#if LV_MEM_ADD_JUNK
-    _lv_memset((void *)data, 0xbb, _lv_mem_get_size(data));
-#endif
-
-#if LV_ENABLE_GC == 0
-    /*e points to the header*/
-    lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
-    e->header.s.used = 0;
-#endif
-
-#if LV_MEM_CUSTOM == 0
-#if LV_MEM_AUTO_DEFRAG
-    static uint16_t full_defrag_cnt = 0;
-    full_defrag_cnt++;
-    if(full_defrag_cnt < LV_MEM_FULL_DEFRAG_CNT) {
-        /* Make a simple defrag.
-         * Join the following free entries after this*/
-        lv_mem_ent_t * e_next;
-        e_next = ent_get_next(e);
-        while(e_next != NULL) {
-            if(e_next->header.s.used == 0) {
-                e->header.s.d_size += e_next->header.s.d_size + sizeof(e->header);
-            }
-            else {
-                break;
-            }
-            e_next = ent_get_next(e_next);
-        }
-    }
-    else {
-        full_defrag_cnt = 0;
-        lv_mem_defrag();
-
-    }
-
-
-#endif /*LV_MEM_AUTO_DEFRAG*/
-#else /*Use custom, user defined free function*/
-#if LV_ENABLE_GC == 0
-    LV_MEM_CUSTOM_FREE(e);
-#else
-    LV_MEM_CUSTOM_FREE((void *)data);
-#endif /*LV_ENABLE_GC*/
+#if LV_MEM_TRACE
+    LV_MEM_TRACE_CB((void *)data, NULL, 0, TRACE_CALLER());
 #endif
+    mem_free(data);
 }
 
 /**
@@ -267,76 +332,21 @@ void lv_mem_free(const void * data)
  * @param new_size the desired new size in byte
  * @return pointer to the new memory
  */
-
-#if LV_ENABLE_GC == 0
-
 void * lv_mem_realloc(void * data_p, size_t new_size)
 {
-
-#ifdef LV_ARCH_64
-    /*Round the size up to 8*/
-    new_size = (new_size + 7) & (~0x7);
-#else
-    /*Round the size up to 4*/
-    new_size = (new_size + 3) & (~0x3);
-#endif
-
-    /*data_p could be previously freed pointer (in this case it is invalid)*/
-    if(data_p != NULL) {
-        lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
-        if(e->header.s.used == 0) {
-            data_p = NULL;
-        }
-    }
-
-    uint32_t old_size = _lv_mem_get_size(data_p);
-    if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
-
-#if LV_MEM_CUSTOM == 0
-    /* Truncate the memory if the new size is smaller. */
-    if(new_size < old_size) {
-        lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
-        ent_trunc(e, new_size);
-        return &e->first_data;
-    }
+    void * new_p = mem_realloc(data_p, new_size);
+#if LV_MEM_TRACE
+    LV_MEM_TRACE_CB(data_p == &zero_mem ? NULL : data_p, new_p, new_size, TRACE_CALLER());
 #endif
-
-    void * new_p;
-    new_p = lv_mem_alloc(new_size);
-    if(new_p == NULL) {
-        LV_LOG_WARN("Couldn't allocate memory");
-        return NULL;
-    }
-
-    if(data_p != NULL) {
-        /*Copy the old data to the new. Use the smaller size*/
-        if(old_size != 0) {
-            _lv_memcpy(new_p, data_p, LV_MATH_MIN(new_size, old_size));
-            lv_mem_free(data_p);
-        }
-    }
-
-
-    return new_p;
-}
-
-#else /* LV_ENABLE_GC */
-
-void * lv_mem_realloc(void * data_p, size_t new_size)
-{
-    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
-    if(new_p == NULL) LV_LOG_WARN("Couldn't allocate memory");
     return new_p;
 }
 
-#endif /* lv_enable_gc */
-
 /**
  * Join the adjacent free memory blocks
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
     lv_mem_ent_t * e_free;
     lv_mem_ent_t * e_next;
     e_free = ent_get_next(NULL);
@@ -378,6 +388,9 @@ void lv_mem_defrag(void)
 lv_res_t lv_mem_test(void)
 {
 #if LV_MEM_CUSTOM == 0
+#if LV_MEM_SLAB
+    if(slab_test() == false) return LV_RES_INV;
+#endif
     lv_mem_ent_t * e;
     e = ent_get_next(NULL);
     while(e) {
@@ -388,6 +401,9 @@ lv_res_t lv_mem_test(void)
         if(e8 + e->header.s.d_size > work_mem + LV_MEM_SIZE) {
             return LV_RES_INV;
         }
+#if LV_MEM_TLSF
+        if(tlsf_test(e) == false) return LV_RES_INV;
+#endif
         e = ent_get_next(e);
     }
 #endif
@@ -423,8 +439,19 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 
         e = ent_get_next(e);
     }
+
+    /*The free blocks of the pools can't serve other sizes, so they are counted apart from the heap*/
+#if LV_MEM_SLAB
+    uint32_t i;
+    for(i = 0; i < SLAB_CNT; i++) {
+        mon_p->used_cnt += slabs[i].used_cnt;
+        mon_p->slab_free_size += (uint32_t)(slabs[i].cnt - slabs[i].used_cnt) * slabs[i].size;
+    }
+#endif
+
     mon_p->total_size = LV_MEM_SIZE;
-    mon_p->used_pct   = 100 - (100U * mon_p->free_size) / mon_p->total_size;
+    mon_p->max_used   = mem_max_size;
+    mon_p->used_pct   = 100 - (100U * (mon_p->free_size + mon_p->slab_free_size)) / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct   = (uint32_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
         mon_p->frag_pct   = 100 - mon_p->frag_pct;
@@ -435,6 +462,75 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #endif
 }
 
+/**
+ * Get the number of the pools of fixed size blocks
+ * @return number of pools, 0 if `LV_MEM_SLAB` is disabled
+ */
+uint32_t lv_mem_slab_get_class_cnt(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    return SLAB_CNT;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Get the statistics of a pool of fixed size blocks
+ * @param id index of the pool, `0 ... lv_mem_slab_get_class_cnt() - 1`
+ * @param stat store the statistics here
+ */
+void lv_mem_slab_get_stat(uint32_t id, lv_mem_slab_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_mem_slab_stat_t));
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    if(id >= SLAB_CNT) return;
+
+    stat->size = slabs[id].size;
+    stat->cnt = slabs[id].cnt;
+    stat->used_cnt = slabs[id].used_cnt;
+    stat->max_used_cnt = slabs[id].max_used_cnt;
+    stat->alloc_cnt = slabs[id].alloc_cnt;
+    stat->miss_cnt = slabs[id].miss_cnt;
+#else
+    LV_UNUSED(id);
+#endif
+}
+
+/**
+ * Register a function which frees the memory of a cache if an allocation fails.
+ * A function is registered only once.
+ * @param cb the function, called from `lv_mem_alloc` before it gives up
+ * @return LV_RES_OK: registered; LV_RES_INV: `LV_MEM_RECLAIM_CB_MAX_NUM` functions are registered already
+ */
+lv_res_t lv_mem_add_reclaim_cb(lv_mem_reclaim_cb_t cb)
+{
+    uint32_t i;
+    for(i = 0; i < LV_MEM_RECLAIM_CB_MAX_NUM; i++) {
+        if(reclaim_cbs[i] == cb) return LV_RES_OK;
+        if(reclaim_cbs[i] == NULL) {
+            reclaim_cbs[i] = cb;
+            return LV_RES_OK;
+        }
+    }
+
+    LV_LOG_WARN("lv_mem_add_reclaim_cb: no free slot, increase LV_MEM_RECLAIM_CB_MAX_NUM");
+    return LV_RES_INV;
+}
+
+/**
+ * Get the work memory of the built-in allocator, e.g. to locate the traced allocations (`LV_MEM_TRACE`)
+ * @return pointer to the `LV_MEM_SIZE` bytes of the work memory, NULL with `LV_MEM_CUSTOM`
+ */
+void * _lv_mem_get_work_mem(void)
+{
+#if LV_MEM_CUSTOM == 0
+    return work_mem;
+#else
+    return NULL;
+#endif
+}
+
 /**
  * Give the size of an allocated memory
  * @param data pointer to an allocated memory
@@ -448,6 +544,11 @@ uint32_t _lv_mem_get_size(const void * data)
     if(data == NULL) return 0;
     if(data == &zero_mem) return 0;
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    mem_slab_t * slab = slab_of_ptr(data, NULL);
+    if(slab) return slab->size;
+#endif
+
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
 
     return e->header.s.d_size;
@@ -793,29 +894,330 @@ LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
  *   STATIC FUNCTIONS
  **********************/
 
-#if LV_MEM_CUSTOM == 0
 /**
- * Give the next entry after 'act_e'
- * @param act_e pointer to an entry
- * @return pointer to an entry after 'act_e'
+ * The allocation of `lv_mem_alloc`
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory
  */
-static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e)
+static void * mem_alloc(size_t size)
 {
-    lv_mem_ent_t * next_e = NULL;
-
-    if(act_e == NULL) { /*NULL means: get the first entry*/
-        next_e = (lv_mem_ent_t *)work_mem;
+    if(size == 0) {
+        return &zero_mem;
     }
-    else {   /*Get the next entry */
-        uint8_t * data = &act_e->first_data;
-        next_e         = (lv_mem_ent_t *)&data[act_e->header.s.d_size];
 
-        if(&next_e->first_data >= &work_mem[LV_MEM_SIZE]) next_e = NULL;
+#ifdef LV_ARCH_64
+    /*Round the size up to 8*/
+    size = (size + 7) & (~0x7);
+#else
+    /*Round the size up to 4*/
+    size = (size + 3) & (~0x3);
+#endif
+    void * alloc = NULL;
+
+#if LV_MEM_CUSTOM == 0
+    /*Use the built-in allocators*/
+#if LV_MEM_SLAB
+    /*The frequent small sizes from their pools*/
+    alloc = slab_alloc(size);
+    if(alloc != NULL) {
+#if LV_MEM_ADD_JUNK
+        _lv_memset(alloc, 0xaa, size);
+#endif
+        return alloc;
     }
+#endif
 
-    return next_e;
+#if LV_MEM_TLSF
+    alloc = tlsf_alloc(size);
+#else
+    lv_mem_ent_t * e = NULL;
+
+    /* Search for a appropriate entry*/
+    do {
+        /* Get the next entry*/
+        e = ent_get_next(e);
+
+        /*If there is next entry then try to allocate there*/
+        if(e != NULL) {
+            alloc = ent_alloc(e, size);
+        }
+        /* End if there is not next entry OR the alloc. is successful*/
+    } while(e != NULL && alloc == NULL);
+#endif
+
+#else
+    /*Use custom, user defined malloc function*/
+#if LV_ENABLE_GC == 1 /*gc must not include header*/
+    alloc = LV_MEM_CUSTOM_ALLOC(size);
+#else                 /* LV_ENABLE_GC */
+    /*Allocate a header too to store the size*/
+    alloc = LV_MEM_CUSTOM_ALLOC(size + sizeof(lv_mem_header_t));
+    if(alloc != NULL) {
+        ((lv_mem_ent_t *)alloc)->header.s.d_size = size;
+        ((lv_mem_ent_t *)alloc)->header.s.used   = 1;
+
+        alloc = &((lv_mem_ent_t *)alloc)->first_data;
+    }
+#endif                /* LV_ENABLE_GC */
+#endif                /* LV_MEM_CUSTOM */
+
+#if LV_MEM_ADD_JUNK
+    if(alloc != NULL) _lv_memset(alloc, 0xaa, size);
+#endif
+
+    /*Try again when the caches have freed some memory*/
+    if(alloc == NULL && reclaim()) return mem_alloc(size);
+
+    if(alloc == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory");
+    }
+#if LV_MEM_CUSTOM == 0
+    else {
+        /*The entry can be a bit larger than `size` if the rest was too small to split*/
+        used_add(_lv_mem_get_size(alloc));
+    }
+#endif
+
+    return alloc;
+}
+
+#if LV_MEM_CUSTOM == 0
+/**
+ * Report a memory freed twice, a bug of the caller. It's found only while the header of the
+ * entry (or the bit of the pool) still says free: after the entry was joined with a free
+ * neighbour or allocated again the second free can't be told from a valid one.
+ * @param data the freed memory
+ */
+static void double_free(const void * data)
+{
+    LV_LOG_WARN("lv_mem_free: the memory is already free");
+#if LV_USE_DEBUG && LV_USE_ASSERT_MEM_INTEGRITY
+    /*Halt like the other memory checks*/
+    LV_DEBUG_ASSERT(false, "Memory freed twice", data);
+#else
+    LV_UNUSED(data);
+#endif
+}
+#endif
+
+#if LV_MEM_CUSTOM == 0
+/**
+ * Count an allocated block in the used size and its peak
+ * @param size size of the block (of the entry or of the blocks of its pool)
+ */
+static void used_add(uint32_t size)
+{
+    mem_used_size += size;
+    if(mem_used_size > mem_max_size) mem_max_size = mem_used_size;
+}
+#endif
+
+/**
+ * Let the registered caches free their memory
+ * @return true: one of them has freed some memory
+ */
+static bool reclaim(void)
+{
+    bool freed = false;
+    uint32_t i;
+    for(i = 0; i < LV_MEM_RECLAIM_CB_MAX_NUM && reclaim_cbs[i]; i++) {
+        if(reclaim_cbs[i]()) freed = true;
+    }
+    return freed;
+}
+
+/**
+ * The freeing of `lv_mem_free`
+ * @param data pointer to an allocated memory, not NULL
+ */
+static void mem_free(const void * data)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    if(slab_free(data)) return;
+#endif
+
+#if LV_ENABLE_GC == 0
+    /*e points to the header*/
+    lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
+#if LV_MEM_CUSTOM == 0
+    /*Freed twice. Joining it again would corrupt the lists of the free entries.*/
+    if(e->header.s.used == 0) {
+        double_free(data);
+        return;
+    }
+    mem_used_size -= e->header.s.d_size;
+#endif
+#endif
+
+    /*Only after the check: the junk would overwrite the links of a free entry*/
+#if LV_MEM_ADD_JUNK
+    _lv_memset((void *)data, 0xbb, _lv_mem_get_size(data));
+#endif
+
+#if LV_ENABLE_GC == 0
+    e->header.s.used = 0;
+#endif
+
+#if LV_MEM_CUSTOM == 0
+#if LV_MEM_TLSF
+    /*Always joined with the free neighbours*/
+    tlsf_release(e);
+#elif LV_MEM_AUTO_DEFRAG
+    static uint16_t full_defrag_cnt = 0;
+    full_defrag_cnt++;
+    if(full_defrag_cnt < LV_MEM_FULL_DEFRAG_CNT) {
+        /* Make a simple defrag.
+         * Join the following free entries after this*/
+        lv_mem_ent_t * e_next;
+        e_next = ent_get_next(e);
+        while(e_next != NULL) {
+            if(e_next->header.s.used == 0) {
+                e->header.s.d_size += e_next->header.s.d_size + sizeof(e->header);
+            }
+            else {
+                break;
+            }
+            e_next = ent_get_next(e_next);
+        }
+    }
+    else {
+        full_defrag_cnt = 0;
+        lv_mem_defrag();
+
+    }
+
+
+#endif /*LV_MEM_AUTO_DEFRAG*/
+#else /*Use custom, user defined free function*/
+#if LV_ENABLE_GC == 0
+    LV_MEM_CUSTOM_FREE(e);
+#else
+    LV_MEM_CUSTOM_FREE((void *)data);
+#endif /*LV_ENABLE_GC*/
+#endif
+}
+
+/**
+ * The reallocation of `lv_mem_realloc`
+ * @param data pointer to an allocated memory or NULL
+ * @param new_size the desired new size in byte
+ * @return pointer to the new memory
+ */
+#if LV_ENABLE_GC == 0
+
+static void * mem_realloc(void * data_p, size_t new_size)
+{
+
+#ifdef LV_ARCH_64
+    /*Round the size up to 8*/
+    new_size = (new_size + 7) & (~0x7);
+#else
+    /*Round the size up to 4*/
+    new_size = (new_size + 3) & (~0x3);
+#endif
+
+    /*data_p could be previously freed pointer (in this case it is invalid)*/
+    if(data_p != NULL && is_used(data_p) == false) {
+        data_p = NULL;
+    }
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    /*The blocks of the pools keep their size while the new size fits*/
+    mem_slab_t * slab = slab_of_ptr(data_p, NULL);
+    if(slab && new_size <= slab->size) return data_p;
+#endif
+
+    uint32_t old_size = _lv_mem_get_size(data_p);
+    if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
+
+#if LV_MEM_CUSTOM == 0
+    /* Truncate the memory if the new size is smaller. */
+    if(new_size < old_size) {
+        lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
+#if LV_MEM_TLSF
+        tlsf_trunc(e, new_size);
+#else
+        ent_trunc(e, new_size);
+#endif
+        /*The rest is split only if it's large enough for an entry*/
+        mem_used_size -= old_size - e->header.s.d_size;
+        return &e->first_data;
+    }
+#endif
+
+    void * new_p;
+    new_p = mem_alloc(new_size);
+    if(new_p == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory");
+        return NULL;
+    }
+
+    if(data_p != NULL) {
+        /*Copy the old data to the new. Use the smaller size*/
+        if(old_size != 0) {
+            _lv_memcpy(new_p, data_p, LV_MATH_MIN(new_size, old_size));
+            mem_free(data_p);
+        }
+    }
+
+
+    return new_p;
+}
+
+#else /* LV_ENABLE_GC */
+
+static void * mem_realloc(void * data_p, size_t new_size)
+{
+    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
+    if(new_p == NULL) LV_LOG_WARN("Couldn't allocate memory");
+    return new_p;
 }
 
+#endif /* lv_enable_gc */
+
+#if LV_ENABLE_GC == 0
+/**
+ * Tell whether a memory is allocated and not freed yet
+ * @param data pointer to an allocated memory
+ * @return true: `data` is in use
+ */
+static bool is_used(const void * data)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    uint32_t id;
+    mem_slab_t * slab = slab_of_ptr(data, &id);
+    if(slab) return (slab->used_map[id >> 3] & (1 << (id & 0x7))) != 0;
+#endif
+
+    lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
+    return e->header.s.used != 0;
+}
+#endif
+
+#if LV_MEM_CUSTOM == 0
+/**
+ * Give the next entry after 'act_e'
+ * @param act_e pointer to an entry
+ * @return pointer to an entry after 'act_e'
+ */
+static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e)
+{
+    lv_mem_ent_t * next_e = NULL;
+
+    if(act_e == NULL) { /*NULL means: get the first entry*/
+        next_e = (lv_mem_ent_t *)heap_mem;
+    }
+    else {   /*Get the next entry */
+        uint8_t * data = &act_e->first_data;
+        next_e         = (lv_mem_ent_t *)&data[act_e->header.s.d_size];
+
+        if(&next_e->first_data >= &work_mem[LV_MEM_SIZE]) next_e = NULL;
+    }
+
+    return next_e;
+}
+
+#if LV_MEM_TLSF == 0
 /**
  * Try to do the real allocation with a given size
  * @param e try to allocate to this entry
@@ -870,5 +1272,408 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
     /* Set the new size for the original entry */
     e->header.s.d_size = (uint32_t)size;
 }
+#endif /*LV_MEM_TLSF == 0*/
+
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+
+#if defined(__GNUC__)
+    #define TLSF_FLS(x) (31 - __builtin_clz(x))
+    #define TLSF_FFS(x) __builtin_ctz(x)
+#else
+static uint32_t tlsf_fls(uint32_t x)
+{
+    uint32_t b = 0;
+    while(x >>= 1) b++;
+    return b;
+}
+
+static uint32_t tlsf_ffs(uint32_t x)
+{
+    uint32_t b = 0;
+    while((x & 1) == 0) {
+        x >>= 1;
+        b++;
+    }
+    return b;
+}
+    #define TLSF_FLS(x) tlsf_fls(x)
+    #define TLSF_FFS(x) tlsf_ffs(x)
+#endif
+
+#define TLSF_ENT(ofs)   ((lv_mem_ent_t *)&work_mem[(uint32_t)(ofs) * TLSF_UNIT])
+#define TLSF_OFS(e)     ((uint16_t)(((uint8_t *)(e) - work_mem) / TLSF_UNIT))
+#define TLSF_LINKS(e)   ((tlsf_links_t *)&(e)->first_data)
+#define TLSF_TAG(e)     ((uint32_t *)((uint8_t *)(e) + sizeof(lv_mem_header_t) + (e)->header.s.d_size - sizeof(uint32_t)))
+
+/**
+ * Allocate from the smallest list with large enough blocks and give back the rest of the block
+ * @param size size of the new memory in bytes, rounded up to 4
+ * @return pointer to the allocated memory or NULL if there is no large enough free block
+ */
+static void * tlsf_alloc(size_t size)
+{
+    if(size < TLSF_MIN_SIZE) size = TLSF_MIN_SIZE;
+
+    lv_mem_ent_t * e = tlsf_find(size);
+    if(e == NULL) return NULL;
+
+    tlsf_remove(e);
+    e->header.s.used = 1;
+    tlsf_trunc(e, size);
+
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next) next->header.s.prev_free = 0;
+
+    return &e->first_data;
+}
+
+/**
+ * Give back the end of a used entry if it's large enough for a free entry
+ * @param e pointer to a used entry
+ * @param size new size in bytes, rounded up to 4
+ */
+static void tlsf_trunc(lv_mem_ent_t * e, size_t size)
+{
+    if(size < TLSF_MIN_SIZE) size = TLSF_MIN_SIZE;
+    if(e->header.s.d_size < size + sizeof(lv_mem_header_t) + TLSF_MIN_SIZE) return;
+
+    lv_mem_ent_t * rest = (lv_mem_ent_t *)(&e->first_data + size);
+    rest->header.s.used = 0;
+    rest->header.s.prev_free = 0;
+    rest->header.s.d_size = (uint32_t)(e->header.s.d_size - size - sizeof(lv_mem_header_t));
+    e->header.s.d_size = (uint32_t)size;
+
+    tlsf_release(rest);
+}
+
+/**
+ * Join an entry with the free entries before and after it and put the result into its list
+ * @param e pointer to an entry which is not in a list
+ */
+static void tlsf_release(lv_mem_ent_t * e)
+{
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next && next->header.s.used == 0) {
+        tlsf_remove(next);
+        e->header.s.d_size += sizeof(lv_mem_header_t) + next->header.s.d_size;
+    }
+
+    if(e->header.s.prev_free) {
+        /*The free entry before stores its offset in its last bytes*/
+        lv_mem_ent_t * prev = TLSF_ENT(*((uint32_t *)e - 1));
+        tlsf_remove(prev);
+        prev->header.s.d_size += sizeof(lv_mem_header_t) + e->header.s.d_size;
+        e = prev;
+    }
+
+    e->header.s.used = 0;
+    *TLSF_TAG(e) = TLSF_OFS(e);
+
+    next = ent_get_next(e);
+    if(next) next->header.s.prev_free = 1;
+
+    tlsf_insert(e);
+}
+
+/**
+ * Find a free entry which is large enough.
+ * Take the first entry of the first list with surely large enough blocks.
+ * If there is no such list, search in the list of `size` too, its blocks can be smaller or larger.
+ * @param size the required size in bytes
+ * @return a large enough free entry or NULL if there is no such entry
+ */
+static lv_mem_ent_t * tlsf_find(size_t size)
+{
+    uint32_t fl;
+    uint32_t sl;
+
+    /*Round up to the next list, its every block is large enough*/
+    size_t size_up = size;
+    if(size >= TLSF_SMALL_SIZE) size_up += (1U << (TLSF_FLS(size) - TLSF_SL_LOG2)) - 1;
+    tlsf_mapping(size_up, &fl, &sl);
+
+    if(fl < TLSF_FL_CNT) {
+        uint32_t sl_map = tlsf_sl_map[fl] & (~0U << sl);
+        if(sl_map == 0) {
+            uint32_t fl_map = tlsf_fl_map & (~0U << (fl + 1));
+            if(fl_map) {
+                fl = TLSF_FFS(fl_map);
+                sl_map = tlsf_sl_map[fl];
+            }
+        }
+        if(sl_map) return TLSF_ENT(tlsf_heads[fl][TLSF_FFS(sl_map)]);
+    }
+
+    tlsf_mapping(size, &fl, &sl);
+    if(fl >= TLSF_FL_CNT) return NULL;
+
+    uint16_t ofs = tlsf_heads[fl][sl];
+    while(ofs != TLSF_NIL) {
+        lv_mem_ent_t * e = TLSF_ENT(ofs);
+        if(e->header.s.d_size >= size) return e;
+        ofs = TLSF_LINKS(e)->next;
+    }
+
+    return NULL;
+}
+
+static void tlsf_insert(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    uint16_t ofs = TLSF_OFS(e);
+    tlsf_links_t * links = TLSF_LINKS(e);
+    links->next = tlsf_heads[fl][sl];
+    links->prev = TLSF_NIL;
+    if(links->next != TLSF_NIL) TLSF_LINKS(TLSF_ENT(links->next))->prev = ofs;
+
+    tlsf_heads[fl][sl] = ofs;
+    tlsf_sl_map[fl] |= 1U << sl;
+    tlsf_fl_map |= 1U << fl;
+}
+
+static void tlsf_remove(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    tlsf_links_t * links = TLSF_LINKS(e);
+    if(links->next != TLSF_NIL) TLSF_LINKS(TLSF_ENT(links->next))->prev = links->prev;
+    if(links->prev != TLSF_NIL) TLSF_LINKS(TLSF_ENT(links->prev))->next = links->next;
+    else {
+        tlsf_heads[fl][sl] = links->next;
+        if(links->next == TLSF_NIL) {
+            tlsf_sl_map[fl] &= ~(1U << sl);
+            if(tlsf_sl_map[fl] == 0) tlsf_fl_map &= ~(1U << fl);
+        }
+    }
+}
+
+/**
+ * Get the list of a block size
+ * @param size size of the block in bytes
+ * @param fl store the first level index here
+ * @param sl store the second level index here
+ */
+static void tlsf_mapping(uint32_t size, uint32_t * fl, uint32_t * sl)
+{
+    if(size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size / (TLSF_SMALL_SIZE / TLSF_SL_CNT);
+    }
+    else {
+        uint32_t b = TLSF_FLS(size);
+        *fl = b - TLSF_FL_SHIFT + 1;
+        *sl = (size >> (b - TLSF_SL_LOG2)) ^ TLSF_SL_CNT;
+    }
+}
+
+/**
+ * Empty the lists and add the only block of the initialized work memory
+ */
+static void tlsf_init(void)
+{
+    tlsf_fl_map = 0;
+    _lv_memset_00(tlsf_sl_map, sizeof(tlsf_sl_map));
+    _lv_memset_ff(tlsf_heads, sizeof(tlsf_heads));
+
+    lv_mem_ent_t * full = (lv_mem_ent_t *)heap_mem;
+    full->header.s.prev_free = 0;
+    tlsf_release(full);
+}
+
+/**
+ * Check the flags and the list of an entry
+ * @param e pointer to an entry
+ * @return false: the entry is not consistent with its neighbours or its list
+ */
+static bool tlsf_test(lv_mem_ent_t * e)
+{
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next && next->header.s.prev_free != !e->header.s.used) return false;
+    if(e->header.s.used) return true;
+
+    /*Free entries are always joined*/
+    if(e->header.s.prev_free || (next && next->header.s.used == 0)) return false;
+    if(*TLSF_TAG(e) != TLSF_OFS(e)) return false;
+
+    /*Linked in both directions*/
+    tlsf_links_t * links = TLSF_LINKS(e);
+    if(links->next != TLSF_NIL && TLSF_LINKS(TLSF_ENT(links->next))->prev != TLSF_OFS(e)) return false;
+    if(links->prev != TLSF_NIL && TLSF_LINKS(TLSF_ENT(links->prev))->next != TLSF_OFS(e)) return false;
+
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+    if(links->prev == TLSF_NIL && tlsf_heads[fl][sl] != TLSF_OFS(e)) return false;
+
+    return true;
+}
+
+#endif /*LV_MEM_TLSF*/
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+/**
+ * Carve the pools of `LV_MEM_SLAB_CLASSES` from the beginning of the work memory
+ * and chain all their blocks to the free lists
+ * @return the bytes used by the pools and their bitmaps
+ */
+static uint32_t slab_init(void)
+{
+    uint8_t * p = work_mem;
+    uint32_t i;
+    for(i = 0; i < SLAB_CNT; i++) {
+        mem_slab_t * slab = &slabs[i];
+        _lv_memset_00(slab, sizeof(mem_slab_t));
+        slab->size = slab_cfg[i].size;
+        slab->cnt = slab_cfg[i].cnt;
+        slab->size_recip = (0x10000 + slab->size - 1) / slab->size;
+        slab->start = p;
+
+        /*The index of the blocks is exact below 64 kB and leave at least the half of the memory to the heap*/
+        uint32_t used = (uint32_t)(p - work_mem);
+        uint32_t room = used < LV_MEM_SIZE / 2 ? LV_MEM_SIZE / 2 - used : 0;
+        uint32_t max_cnt = LV_MATH_MIN(0xFFFFU, room) / slab->size;
+        if(slab->cnt > max_cnt) {
+            LV_LOG_WARN("LV_MEM_SLAB_CLASSES: a pool is too large");
+            slab->cnt = max_cnt;
+        }
+
+        uint32_t b;
+        for(b = 0; b < slab->cnt; b++) {
+            *((uint16_t *)&p[b * slab->size]) = b + 1 < slab->cnt ? b + 1 : SLAB_NIL;
+        }
+        slab->free = slab->cnt > 0 ? 0 : SLAB_NIL;
+        p += (uint32_t)slab->size * slab->cnt;
+
+        /*Keep the next blocks aligned*/
+        uint32_t map_size = ((slab->cnt + 7) / 8 + 3) & (~0x3);
+        slab->used_map = p;
+        _lv_memset_00(p, map_size);
+        p += map_size;
+    }
+
+    return (uint32_t)(p - work_mem);
+}
+
+/**
+ * Allocate a block from the pool of a size
+ * @param size the rounded size to allocate
+ * @return pointer to the block or NULL if no pool has this size or the pool is full
+ */
+static void * slab_alloc(size_t size)
+{
+    uint32_t i;
+    for(i = 0; i < SLAB_CNT; i++) {
+        if(slabs[i].size >= size) break;
+    }
+    if(i == SLAB_CNT) return NULL;
+
+    /*Don't waste more than the eighth of a block, the heap is better for such sizes*/
+    mem_slab_t * slab = &slabs[i];
+    if(size * 8 <= (uint32_t)slab->size * 7) return NULL;
+
+    if(slab->free == SLAB_NIL) {
+        slab->miss_cnt++;
+        return NULL;
+    }
+
+    uint32_t id = slab->free;
+    uint8_t * block = &slab->start[id * slab->size];
+    slab->free = *((uint16_t *)block);
+    slab->used_map[id >> 3] |= 1 << (id & 0x7);
+    slab->used_cnt++;
+    if(slab->used_cnt > slab->max_used_cnt) slab->max_used_cnt = slab->used_cnt;
+    slab->alloc_cnt++;
+
+    used_add(slab->size);
+
+    return block;
+}
+
+/**
+ * Give back a block to its pool
+ * @param data pointer to an allocated memory
+ * @return false: `data` is not in a pool
+ */
+static bool slab_free(const void * data)
+{
+    uint32_t id;
+    mem_slab_t * slab = slab_of_ptr(data, &id);
+    if(slab == NULL) return false;
+
+    if((slab->used_map[id >> 3] & (1 << (id & 0x7))) == 0) {
+        double_free(data);
+        return true;
+    }
 
+#if LV_MEM_ADD_JUNK
+    /*Before the link to the next free block is written*/
+    _lv_memset((void *)data, 0xbb, slab->size);
 #endif
+
+    slab->used_map[id >> 3] &= ~(1 << (id & 0x7));
+    *((uint16_t *)&slab->start[id * slab->size]) = slab->free;
+    slab->free = id;
+    slab->used_cnt--;
+    mem_used_size -= slab->size;
+
+    return true;
+}
+
+/**
+ * Find the pool of a memory
+ * @param data pointer to a memory
+ * @param id store the index of the block here (can be NULL)
+ * @return the pool or NULL if `data` is not a block of a pool
+ */
+static mem_slab_t * slab_of_ptr(const void * data, uint32_t * id)
+{
+    const uint8_t * p = data;
+    if(p < work_mem || p >= heap_mem) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < SLAB_CNT; i++) {
+        mem_slab_t * slab = &slabs[i];
+        if(p < slab->start) break;
+
+        uint32_t ofs = (uint32_t)(p - slab->start);
+        if(ofs >= (uint32_t)slab->size * slab->cnt) continue;
+        if(id) *id = (ofs * slab->size_recip) >> 16;
+        return slab;
+    }
+
+    return NULL;
+}
+
+/**
+ * Check the free lists of the pools against their bitmaps
+ * @return false: a pool is corrupted
+ */
+static bool slab_test(void)
+{
+    uint32_t i;
+    for(i = 0; i < SLAB_CNT; i++) {
+        mem_slab_t * slab = &slabs[i];
+        uint32_t free_cnt = 0;
+        uint32_t id = slab->free;
+        while(id != SLAB_NIL) {
+            if(id >= slab->cnt || free_cnt >= slab->cnt) return false;
+            if(slab->used_map[id >> 3] & (1 << (id & 0x7))) return false;
+            free_cnt++;
+            id = *((uint16_t *)&slab->start[id * slab->size]);
+        }
+
+        if(free_cnt + slab->used_cnt != slab->cnt) return false;
+    }
+
+    return true;
+}
+
+#endif /*LV_MEM_SLAB*/
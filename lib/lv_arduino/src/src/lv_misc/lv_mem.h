@@ -17,6 +17,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "lv_log.h"
 #include "lv_types.h"
 
@@ -28,6 +29,11 @@ extern "C" {
 #define LV_MEM_BUF_MAX_NUM    16
 #endif
 
+/*Max. number of the functions freeing cached memory (`lv_mem_add_reclaim_cb`)*/
+#ifndef LV_MEM_RECLAIM_CB_MAX_NUM
+#define LV_MEM_RECLAIM_CB_MAX_NUM    2
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -36,15 +42,35 @@ extern "C" {
  * Heap information structure.
  */
 typedef struct {
-    uint32_t total_size; /**< Total heap size */
+    uint32_t total_size; /**< Size of the work memory, the pools of `LV_MEM_SLAB` included */
     uint32_t free_cnt;
-    uint32_t free_size; /**< Size of available memory */
+    uint32_t free_size; /**< Free bytes of the heap. The free blocks of the pools are only in `slab_free_size`*/
+    uint32_t slab_free_size; /**< Free bytes in the pools, usable only for their sizes (see `lv_mem_slab_get_stat`)*/
     uint32_t free_biggest_size;
     uint32_t used_cnt;
-    uint8_t used_pct; /**< Percentage used */
-    uint8_t frag_pct; /**< Amount of fragmentation */
+    uint32_t max_used; /**< Peak of the bytes allocated at the same time (sizes of the blocks, headers not included)*/
+    uint8_t used_pct; /**< Percentage of the work memory which isn't free (the free blocks of the heap and of the pools) */
+    uint8_t frag_pct; /**< Amount of fragmentation of the heap */
 } lv_mem_monitor_t;
 
+/**
+ * Statistics of a pool of fixed size blocks (`LV_MEM_SLAB_CLASSES`)
+ */
+typedef struct {
+    uint32_t size;          /**< Size of the blocks*/
+    uint32_t cnt;           /**< Number of blocks*/
+    uint32_t used_cnt;      /**< Blocks in use*/
+    uint32_t max_used_cnt;  /**< Most blocks in use at the same time*/
+    uint32_t alloc_cnt;     /**< Allocations from the pool*/
+    uint32_t miss_cnt;      /**< Allocations of this size from the heap because the pool was full*/
+} lv_mem_slab_stat_t;
+
+/**
+ * Frees memory kept by a cache when an allocation fails
+ * @return true: some memory was freed, the allocation is tried again
+ */
+typedef bool (*lv_mem_reclaim_cb_t)(void);
+
 typedef struct {
     void * p;
     uint16_t size;
@@ -109,6 +135,33 @@ lv_res_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Get the number of the pools of fixed size blocks
+ * @return number of pools, 0 if `LV_MEM_SLAB` is disabled
+ */
+uint32_t lv_mem_slab_get_class_cnt(void);
+
+/**
+ * Get the statistics of a pool of fixed size blocks
+ * @param id index of the pool, `0 ... lv_mem_slab_get_class_cnt() - 1`
+ * @param stat store the statistics here
+ */
+void lv_mem_slab_get_stat(uint32_t id, lv_mem_slab_stat_t * stat);
+
+/**
+ * Register a function which frees the memory of a cache if an allocation fails.
+ * A function is registered only once.
+ * @param cb the function, called from `lv_mem_alloc` before it gives up
+ * @return LV_RES_OK: registered; LV_RES_INV: `LV_MEM_RECLAIM_CB_MAX_NUM` functions are registered already
+ */
+lv_res_t lv_mem_add_reclaim_cb(lv_mem_reclaim_cb_t cb);
+
+/**
+ * Get the work memory of the built-in allocator, e.g. to locate the traced allocations (`LV_MEM_TRACE`)
+ * @return pointer to the `LV_MEM_SIZE` bytes of the work memory, NULL with `LV_MEM_CUSTOM`
+ */
+void * _lv_mem_get_work_mem(void);
+
 /**
  * Give the size of an allocated memory
  * @param data pointer to an allocated memory
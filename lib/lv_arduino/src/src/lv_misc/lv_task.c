@@ -146,9 +146,11 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
                 }
             }
 
-            /*If a task was created or deleted then this or the next item might be corrupted*/
+            /*If a task was created or deleted then this or the next item might be corrupted.
+             *Start again from the first task to run the remaining ones, e.g. the refresh after a one shot task*/
             if(task_created || task_deleted) {
                 task_interrupter = NULL;
+                end_flag = false;
                 break;
             }
 
@@ -167,7 +169,8 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
     if(idle_period_time >= IDLE_MEAS_PERIOD) {
 
-        idle_last         = (uint32_t)((uint32_t)busy_time * 100) / IDLE_MEAS_PERIOD; /*Calculate the busy percentage*/
+        /*Use the real length of the period: if the caller sleeps between the calls it can be longer*/
+        idle_last         = (uint32_t)((uint32_t)busy_time * 100) / idle_period_time; /*Calculate the busy percentage*/
         idle_last         = idle_last > 100 ? 0 : 100 - idle_last;                    /*But we need idle time*/
         busy_time         = 0;
         idle_period_start = lv_tick_get();
@@ -9,6 +9,7 @@
 #include "lv_txt.h"
 #include "lv_math.h"
 #include "lv_log.h"
+#include "lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -138,6 +139,108 @@ void _lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t
         size_res->y -= line_space;
 }
 
+/**
+ * Break a text into lines and get the position of every letter. Free the result with `lv_mem_free`.
+ * @param text a '\0' terminated string without recolor commands
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param line_space line space
+ * @param max_width max with of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum, `LV_TXT_FLAG_RECOLOR` isn't supported
+ * @return the layout or NULL if the text is too long or out of memory
+ */
+lv_txt_layout_t * _lv_txt_layout_create(const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                                        lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    if(text == NULL || font == NULL) return NULL;
+    if(flag & LV_TXT_FLAG_RECOLOR) return NULL;
+
+    size_t len = strlen(text);
+    if(len > UINT16_MAX) return NULL;
+
+    /*Every line has at least one byte. The unused lines are truncated at the end.*/
+    uint32_t letter_x_size = LV_MATH_MAX(len, 1) * sizeof(lv_coord_t);
+    uint32_t size = sizeof(lv_txt_layout_t) + letter_x_size + len * sizeof(lv_txt_layout_line_t);
+    lv_txt_layout_t * layout = lv_mem_alloc(size);
+    if(layout == NULL) return NULL;
+
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_width = max_width;
+    layout->flag = flag;
+    layout->len = len;
+    layout->line_cnt = 0;
+    layout->letter_x = (lv_coord_t *)(layout + 1);
+    layout->lines = (lv_txt_layout_line_t *)((uint8_t *)layout->letter_x + letter_x_size);
+
+    if(flag & LV_TXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+
+    /*The same steps as `_lv_txt_get_size` and `_lv_txt_get_width`*/
+    lv_point_t * size_res = &layout->size;
+    size_res->x = 0;
+    size_res->y = 0;
+
+    uint32_t line_start     = 0;
+    uint32_t new_line_start = 0;
+    uint16_t letter_height = lv_font_get_line_height(font);
+
+    while(text[line_start] != '\0') {
+        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, flag);
+
+        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
+            LV_LOG_WARN("lv_txt_layout_create: integer overflow while calculating text height");
+            lv_mem_free(layout);
+            return NULL;
+        }
+        size_res->y += letter_height;
+        size_res->y += line_space;
+
+        lv_coord_t width = 0;
+        uint32_t i = line_start;
+        while(i < new_line_start) {
+            layout->letter_x[i] = width;
+            uint32_t letter      = _lv_txt_encoded_next(text, &i);
+            uint32_t letter_next = _lv_txt_encoded_next(&text[i], NULL);
+
+            lv_coord_t char_width = lv_font_get_glyph_width(font, letter, letter_next);
+            if(char_width > 0) {
+                width += char_width;
+                width += letter_space;
+            }
+        }
+        if(width > 0) width -= letter_space;
+
+        lv_txt_layout_line_t * line = &layout->lines[layout->line_cnt];
+        line->start = line_start;
+        line->w = width;
+        layout->line_cnt++;
+
+        size_res->x = LV_MATH_MAX(width, size_res->x);
+        line_start  = new_line_start;
+    }
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0)
+        size_res->y = letter_height;
+    else
+        size_res->y -= line_space;
+
+    lv_txt_layout_t * layout_trunc = lv_mem_realloc(layout, size - (len - layout->line_cnt) * sizeof(lv_txt_layout_line_t));
+    if(layout_trunc == NULL) {
+        lv_mem_free(layout);
+        return NULL;
+    }
+    layout_trunc->letter_x = (lv_coord_t *)(layout_trunc + 1);
+    layout_trunc->lines = (lv_txt_layout_line_t *)((uint8_t *)layout_trunc->letter_x + letter_x_size);
+
+    return layout_trunc;
+}
+
 /**
  * Get the next word of text. A word is delimited by break characters.
  *
@@ -386,6 +489,47 @@ lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t
     return width;
 }
 
+/**
+ * Get the cell of a letter in a text with tabular digits: every digit is centered in a cell of the same width,
+ * the other letters keep their own width. Kerning and letter space are not used.
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @param cell_w width of the cells of the digits
+ * @param ofs_x store the position of the letter in its cell here
+ * @return width of the letter's cell
+ */
+lv_coord_t _lv_txt_get_cell(const lv_font_t * font, uint32_t letter, lv_coord_t cell_w, lv_coord_t * ofs_x)
+{
+    lv_coord_t letter_w = lv_font_get_glyph_width(font, letter, '\0');
+    if(letter >= '0' && letter <= '9') {
+        *ofs_x = (cell_w - letter_w) / 2;
+        return cell_w;
+    }
+
+    *ofs_x = 0;
+    return letter_w;
+}
+
+/**
+ * Give the width of a text with tabular digits (see `_lv_txt_get_cell`)
+ * @param txt a '\0' terminated single line string
+ * @param font pointer to a font
+ * @param cell_w width of the cells of the digits
+ * @return the sum of the cells of the letters
+ */
+lv_coord_t _lv_txt_get_cells_width(const char * txt, const lv_font_t * font, lv_coord_t cell_w)
+{
+    lv_coord_t width = 0;
+    lv_coord_t ofs_x;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        width += _lv_txt_get_cell(font, letter, cell_w, &ofs_x);
+    }
+
+    return width;
+}
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
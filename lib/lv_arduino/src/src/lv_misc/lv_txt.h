@@ -55,6 +55,28 @@ enum {
 };
 typedef uint8_t lv_txt_cmd_state_t;
 
+/** A line of a text layout*/
+typedef struct {
+    uint16_t start;     /**< Byte index of the first letter of the line*/
+    lv_coord_t w;       /**< Width of the line as `_lv_txt_get_width` gives it*/
+} lv_txt_layout_line_t;
+
+/**
+ * The line breaks and the letter positions of a text, calculated once to get its size and to draw it.
+ * Valid only for the same text, font, letter space and flags, and for the same width if the lines are wrapped.
+ */
+typedef struct {
+    const lv_font_t * font;
+    lv_coord_t letter_space;
+    lv_coord_t max_width;           /**< The width to wrap the lines (unused with `LV_TXT_FLAG_EXPAND/FIT`)*/
+    lv_point_t size;                /**< Size of the text as `_lv_txt_get_size` gives it*/
+    uint16_t len;                   /**< Length of the text in bytes*/
+    uint16_t line_cnt;              /**< Number of lines to draw*/
+    lv_txt_flag_t flag;
+    lv_txt_layout_line_t * lines;
+    lv_coord_t * letter_x;          /**< x of every letter from the start of its line, indexed with its byte index*/
+} lv_txt_layout_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -100,6 +122,39 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                              lv_txt_flag_t flag);
 
+/**
+ * Get the cell of a letter in a text with tabular digits: every digit is centered in a cell of the same width,
+ * the other letters keep their own width. Kerning and letter space are not used.
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @param cell_w width of the cells of the digits
+ * @param ofs_x store the position of the letter in its cell here
+ * @return width of the letter's cell
+ */
+lv_coord_t _lv_txt_get_cell(const lv_font_t * font, uint32_t letter, lv_coord_t cell_w, lv_coord_t * ofs_x);
+
+/**
+ * Give the width of a text with tabular digits (see `_lv_txt_get_cell`)
+ * @param txt a '\0' terminated single line string
+ * @param font pointer to a font
+ * @param cell_w width of the cells of the digits
+ * @return the sum of the cells of the letters
+ */
+lv_coord_t _lv_txt_get_cells_width(const char * txt, const lv_font_t * font, lv_coord_t cell_w);
+
+/**
+ * Break a text into lines and get the position of every letter. Free the result with `lv_mem_free`.
+ * @param text a '\0' terminated string without recolor commands
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param line_space line space
+ * @param max_width max with of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum, `LV_TXT_FLAG_RECOLOR` isn't supported
+ * @return the layout or NULL if the text is too long or out of memory
+ */
+lv_txt_layout_t * _lv_txt_layout_create(const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                                        lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag);
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
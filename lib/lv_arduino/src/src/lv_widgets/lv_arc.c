@@ -29,7 +29,10 @@
 static lv_design_res_t lv_arc_design(lv_obj_t * arc, const lv_area_t * clip_area, lv_design_mode_t mode);
 static lv_res_t lv_arc_signal(lv_obj_t * arc, lv_signal_t sign, void * param);
 static lv_style_list_t * lv_arc_get_style(lv_obj_t * arc, uint8_t part);
-static void inv_arc_area(lv_obj_t * arc, uint16_t start_angle, uint16_t end_angle);
+static void inv_arc_area(lv_obj_t * arc, uint16_t start_angle, uint16_t end_angle, uint8_t part);
+static void get_sector_area(lv_coord_t x, lv_coord_t y, lv_coord_t r, lv_coord_t w, uint16_t start_angle,
+                            uint16_t end_angle, lv_area_t * res_area);
+static void add_cap_area(lv_coord_t x, lv_coord_t y, lv_coord_t r, lv_coord_t w, uint16_t angle, lv_area_t * res_area);
 
 /**********************
  *  STATIC VARIABLES
@@ -133,6 +136,7 @@ void lv_arc_set_start_angle(lv_obj_t * arc, uint16_t start)
     lv_arc_ext_t * ext = lv_obj_get_ext_attr(arc);
 
     if(start > 360) start -= 360;
+    if(start == ext->arc_angle_start) return;
 
     /*Too large move, the whole arc need to be invalidated anyway*/
     if(LV_MATH_ABS(start - ext->arc_angle_start) >= 180) {
@@ -140,11 +144,13 @@ void lv_arc_set_start_angle(lv_obj_t * arc, uint16_t start)
     }
     /*Only a smaller incremental move*/
     else if(ext->arc_angle_start > ext->arc_angle_end && start > ext->arc_angle_end) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_start, start), LV_MATH_MAX(ext->arc_angle_start, start));
+        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_start, start), LV_MATH_MAX(ext->arc_angle_start, start),
+                     LV_ARC_PART_INDIC);
     }
     /*Only a smaller incremental move*/
     else  if(ext->arc_angle_start < ext->arc_angle_end && start < ext->arc_angle_end) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_start, start), LV_MATH_MAX(ext->arc_angle_start, start));
+        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_start, start), LV_MATH_MAX(ext->arc_angle_start, start),
+                     LV_ARC_PART_INDIC);
     }
     /*Crossing the start angle makes the whole arc change*/
     else {
@@ -166,6 +172,7 @@ void lv_arc_set_end_angle(lv_obj_t * arc, uint16_t end)
     lv_arc_ext_t * ext = lv_obj_get_ext_attr(arc);
 
     if(end > (ext->arc_angle_start + 360)) end = ext->arc_angle_start + 360;
+    if(end == ext->arc_angle_end) return;
 
     /*Too large move, the whole arc need to be invalidated anyway*/
     if(LV_MATH_ABS(end - ext->arc_angle_end) >= 180) {
@@ -173,11 +180,13 @@ void lv_arc_set_end_angle(lv_obj_t * arc, uint16_t end)
     }
     /*Only a smaller incremental move*/
     else if(ext->arc_angle_end > ext->arc_angle_start && end > ext->arc_angle_start) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_end, end), LV_MATH_MAX(ext->arc_angle_end, end));
+        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_end, end), LV_MATH_MAX(ext->arc_angle_end, end),
+                     LV_ARC_PART_INDIC);
     }
     /*Only a smaller incremental move*/
     else  if(ext->arc_angle_end < ext->arc_angle_start && end < ext->arc_angle_start) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_end, end), LV_MATH_MAX(ext->arc_angle_end, end));
+        inv_arc_area(arc, LV_MATH_MIN(ext->arc_angle_end, end), LV_MATH_MAX(ext->arc_angle_end, end),
+                     LV_ARC_PART_INDIC);
     }
     /*Crossing the end angle makes the whole arc change*/
     else {
@@ -203,12 +212,12 @@ void lv_arc_set_angles(lv_obj_t * arc, uint16_t start, uint16_t end)
     if(start > 360) start -= 360;
     if(end > (start + 360)) end = start + 360;
 
-    inv_arc_area(arc, ext->arc_angle_start, ext->arc_angle_end);
+    inv_arc_area(arc, ext->arc_angle_start, ext->arc_angle_end, LV_ARC_PART_INDIC);
 
     ext->arc_angle_start = start;
     ext->arc_angle_end = end;
 
-    inv_arc_area(arc, ext->arc_angle_start, ext->arc_angle_end);
+    inv_arc_area(arc, ext->arc_angle_start, ext->arc_angle_end, LV_ARC_PART_INDIC);
 }
 
 /**
@@ -223,6 +232,7 @@ void lv_arc_set_bg_start_angle(lv_obj_t * arc, uint16_t start)
     lv_arc_ext_t * ext = lv_obj_get_ext_attr(arc);
 
     if(start > 360) start -= 360;
+    if(start == ext->bg_angle_start) return;
 
     /*Too large move, the whole arc need to be invalidated anyway*/
     if(LV_MATH_ABS(start - ext->bg_angle_start) >= 180) {
@@ -230,11 +240,13 @@ void lv_arc_set_bg_start_angle(lv_obj_t * arc, uint16_t start)
     }
     /*Only a smaller incremental move*/
     else if(ext->bg_angle_start > ext->bg_angle_end && start > ext->bg_angle_end) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_start, start), LV_MATH_MAX(ext->bg_angle_start, start));
+        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_start, start), LV_MATH_MAX(ext->bg_angle_start, start),
+                     LV_ARC_PART_BG);
     }
     /*Only a smaller incremental move*/
     else  if(ext->bg_angle_start < ext->bg_angle_end && start < ext->bg_angle_end) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_start, start), LV_MATH_MAX(ext->bg_angle_start, start));
+        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_start, start), LV_MATH_MAX(ext->bg_angle_start, start),
+                     LV_ARC_PART_BG);
     }
     /*Crossing the start angle makes the whole arc change*/
     else {
@@ -256,6 +268,7 @@ void lv_arc_set_bg_end_angle(lv_obj_t * arc, uint16_t end)
     lv_arc_ext_t * ext = lv_obj_get_ext_attr(arc);
 
     if(end > (ext->bg_angle_start + 360)) end = ext->bg_angle_start + 360;
+    if(end == ext->bg_angle_end) return;
 
     /*Too large move, the whole arc need to be invalidated anyway*/
     if(LV_MATH_ABS(end - ext->bg_angle_end) >= 180) {
@@ -263,11 +276,13 @@ void lv_arc_set_bg_end_angle(lv_obj_t * arc, uint16_t end)
     }
     /*Only a smaller incremental move*/
     else if(ext->bg_angle_end > ext->bg_angle_start && end > ext->bg_angle_start) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_end, end), LV_MATH_MAX(ext->bg_angle_end, end));
+        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_end, end), LV_MATH_MAX(ext->bg_angle_end, end),
+                     LV_ARC_PART_BG);
     }
     /*Only a smaller incremental move*/
     else  if(ext->bg_angle_end < ext->bg_angle_start && end < ext->bg_angle_start) {
-        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_end, end), LV_MATH_MAX(ext->bg_angle_end, end));
+        inv_arc_area(arc, LV_MATH_MIN(ext->bg_angle_end, end), LV_MATH_MAX(ext->bg_angle_end, end),
+                     LV_ARC_PART_BG);
     }
     /*Crossing the end angle makes the whole arc change*/
     else {
@@ -292,12 +307,12 @@ void lv_arc_set_bg_angles(lv_obj_t * arc, uint16_t start, uint16_t end)
     if(start > 360) start -= 360;
     if(end > (start + 360)) end = start + 360;
 
-    inv_arc_area(arc, ext->bg_angle_start, ext->bg_angle_end);
+    inv_arc_area(arc, ext->bg_angle_start, ext->bg_angle_end, LV_ARC_PART_BG);
 
     ext->bg_angle_start = start;
     ext->bg_angle_end = end;
 
-    inv_arc_area(arc, ext->bg_angle_start, ext->bg_angle_end);
+    inv_arc_area(arc, ext->bg_angle_start, ext->bg_angle_end, LV_ARC_PART_BG);
 }
 
 /**
@@ -513,108 +528,121 @@ static lv_style_list_t * lv_arc_get_style(lv_obj_t * arc, uint8_t part)
     return style_dsc_p;
 }
 
-static void inv_arc_area(lv_obj_t * arc, uint16_t start_angle, uint16_t end_angle)
+/**
+ * Invalidate the sector of an arc between two angles.
+ * The sector is split at the quarters: inside a quarter its ends on the inner and outer circle span its
+ * bounding box, so a few small areas are invalidated instead of one box around the whole sector.
+ * @param arc pointer to an arc object
+ * @param start_angle start angle of the sector
+ * @param end_angle end angle of the sector
+ * @param part `LV_ARC_PART_BG` or `LV_ARC_PART_INDIC`: the arc whose width, caps and radius are used
+ */
+static void inv_arc_area(lv_obj_t * arc, uint16_t start_angle, uint16_t end_angle, uint8_t part)
 {
     lv_arc_ext_t * ext = lv_obj_get_ext_attr(arc);
 
-    start_angle += ext->rotation_angle;
-    end_angle += ext->rotation_angle;
-
-    if(start_angle >= 360) start_angle -= 360;
-    if(end_angle >= 360) end_angle -= 360;
-
-    uint8_t start_quarter = start_angle / 90;
-    uint8_t end_quarter = end_angle / 90;
-
+    /*The same radius and center as in the design function*/
     lv_coord_t left = lv_obj_get_style_pad_left(arc, LV_ARC_PART_BG);
     lv_coord_t right = lv_obj_get_style_pad_right(arc, LV_ARC_PART_BG);
     lv_coord_t top = lv_obj_get_style_pad_top(arc, LV_ARC_PART_BG);
     lv_coord_t bottom = lv_obj_get_style_pad_bottom(arc, LV_ARC_PART_BG);
-    lv_coord_t rout       = (LV_MATH_MIN(lv_obj_get_width(arc) - left - right, lv_obj_get_height(arc) - top - bottom)) / 2;
-    lv_coord_t x       = arc->coords.x1 + rout + left;
-    lv_coord_t y       = arc->coords.y1 + rout + top;
-    lv_style_int_t w = lv_obj_get_style_line_width(arc, LV_ARC_PART_INDIC);
-    lv_style_int_t rounded = lv_obj_get_style_line_rounded(arc, LV_ARC_PART_INDIC);
-    lv_coord_t rin       = rout - w;
-    lv_coord_t extra_area = rounded ? w / 2 + 2 : 0;
-
-    lv_area_t inv_area;
-
-    if(start_quarter == end_quarter && start_angle <= end_angle) {
-        if(start_quarter == 0) {
-            inv_area.y1 = y + ((_lv_trigo_sin(start_angle) * rin) >> LV_TRIGO_SHIFT) - extra_area;
-            inv_area.x2 = x + ((_lv_trigo_sin(start_angle + 90) * rout) >> LV_TRIGO_SHIFT) + extra_area;
-
-            inv_area.y2 = y + ((_lv_trigo_sin(end_angle) * rout) >> LV_TRIGO_SHIFT) + extra_area;
-            inv_area.x1 = x + ((_lv_trigo_sin(end_angle + 90) * rin) >> LV_TRIGO_SHIFT) - extra_area;
-
-            lv_obj_invalidate_area(arc, &inv_area);
-        }
-        else if(start_quarter == 1) {
-            inv_area.y2 = y + ((_lv_trigo_sin(start_angle) * rout) >> LV_TRIGO_SHIFT) + extra_area;
-            inv_area.x2 = x + ((_lv_trigo_sin(start_angle + 90) * rin) >> LV_TRIGO_SHIFT) + extra_area;
+    lv_coord_t r = (LV_MATH_MIN(lv_obj_get_width(arc) - left - right, lv_obj_get_height(arc) - top - bottom)) / 2;
+    lv_coord_t x = arc->coords.x1 + r + left;
+    lv_coord_t y = arc->coords.y1 + r + top;
 
-            inv_area.y1 = y + ((_lv_trigo_sin(end_angle) * rin) >> LV_TRIGO_SHIFT) - extra_area;
-            inv_area.x1 = x + ((_lv_trigo_sin(end_angle + 90) * rout) >> LV_TRIGO_SHIFT) - extra_area;
-
-            lv_obj_invalidate_area(arc, &inv_area);
-        }
-        else if(start_quarter == 2) {
-            inv_area.x1 = x + ((_lv_trigo_sin(start_angle + 90) * rout) >> LV_TRIGO_SHIFT) - extra_area;
-            inv_area.y2 = y + ((_lv_trigo_sin(start_angle) * rin) >> LV_TRIGO_SHIFT) + extra_area;
-
-            inv_area.y1 = y + ((_lv_trigo_sin(end_angle) * rout) >> LV_TRIGO_SHIFT) - extra_area;
-            inv_area.x2 = x + ((_lv_trigo_sin(end_angle + 90) * rin) >> LV_TRIGO_SHIFT) + extra_area;
+    if(part == LV_ARC_PART_INDIC) {
+        lv_coord_t left_indic = lv_obj_get_style_pad_left(arc, LV_ARC_PART_INDIC);
+        lv_coord_t right_indic = lv_obj_get_style_pad_right(arc, LV_ARC_PART_INDIC);
+        lv_coord_t top_indic = lv_obj_get_style_pad_top(arc, LV_ARC_PART_INDIC);
+        lv_coord_t bottom_indic = lv_obj_get_style_pad_bottom(arc, LV_ARC_PART_INDIC);
+        r -= LV_MATH_MAX4(left_indic, right_indic, top_indic, bottom_indic);
+    }
+    if(r <= 0) return;
 
-            lv_obj_invalidate_area(arc, &inv_area);
-        }
-        else if(start_quarter == 3) {
-            /*Small arc here*/
-            inv_area.x1 = x + ((_lv_trigo_sin(start_angle + 90) * rin) >> LV_TRIGO_SHIFT) - extra_area;
-            inv_area.y1 = y + ((_lv_trigo_sin(start_angle) * rout) >> LV_TRIGO_SHIFT) - extra_area;
+    lv_coord_t w = lv_obj_get_style_line_width(arc, part);
+    if(w > r) w = r;
+    bool rounded = lv_obj_get_style_line_rounded(arc, part);
 
-            inv_area.x2 = x + ((_lv_trigo_sin(end_angle + 90) * rout) >> LV_TRIGO_SHIFT) + extra_area;
-            inv_area.y2 = y + ((_lv_trigo_sin(end_angle) * rin) >> LV_TRIGO_SHIFT) + extra_area;
+    uint16_t span = end_angle >= start_angle ? end_angle - start_angle : end_angle + 360 - start_angle;
+    if(span >= 360) {
+        lv_obj_invalidate(arc);
+        return;
+    }
 
-            lv_obj_invalidate_area(arc, &inv_area);
+    uint16_t angle = (start_angle + ext->rotation_angle) % 360;
+    uint16_t last_angle = angle + span;
+    do {
+        uint16_t quarter_end = (angle / 90 + 1) * 90;
+        uint16_t sector_end = LV_MATH_MIN(last_angle, quarter_end);
+
+        lv_area_t inv_area;
+        get_sector_area(x, y, r, w, angle, sector_end, &inv_area);
+        if(rounded) {
+            if(angle == (start_angle + ext->rotation_angle) % 360) add_cap_area(x, y, r, w, angle, &inv_area);
+            if(sector_end == last_angle) add_cap_area(x, y, r, w, sector_end, &inv_area);
         }
 
-    }
-    else if(start_quarter == 0 && end_quarter == 1) {
-        inv_area.x1 = x + ((_lv_trigo_sin(end_angle + 90) * rout) >> LV_TRIGO_SHIFT) - extra_area;
-        inv_area.y1 = y + ((LV_MATH_MIN(_lv_trigo_sin(end_angle),
-                                        _lv_trigo_sin(start_angle))  * rin) >> LV_TRIGO_SHIFT) - extra_area;
-        inv_area.x2 = x + ((_lv_trigo_sin(start_angle + 90) * rout) >> LV_TRIGO_SHIFT) + extra_area;
-        inv_area.y2 = y + rout + extra_area;
-        lv_obj_invalidate_area(arc, &inv_area);
-    }
-    else if(start_quarter == 1 && end_quarter == 2) {
-        inv_area.x1 = x - rout - extra_area;
-        inv_area.y1 = y + ((_lv_trigo_sin(end_angle) * rout) >> LV_TRIGO_SHIFT) - extra_area;
-        inv_area.x2 = x + ((LV_MATH_MAX(_lv_trigo_sin(start_angle + 90),
-                                        _lv_trigo_sin(end_angle + 90)) * rin) >> LV_TRIGO_SHIFT) + extra_area;
-        inv_area.y2 = y + ((_lv_trigo_sin(start_angle) * rout) >> LV_TRIGO_SHIFT) + extra_area;
-        lv_obj_invalidate_area(arc, &inv_area);
-    }
-    else if(start_quarter == 2 && end_quarter == 3) {
-        inv_area.x1 = x + ((_lv_trigo_sin(start_angle + 90) * rout) >> LV_TRIGO_SHIFT) - extra_area;
-        inv_area.y1 = y - rout - extra_area;
-        inv_area.x2 = x + ((_lv_trigo_sin(end_angle + 90) * rout) >> LV_TRIGO_SHIFT) + extra_area;
-        inv_area.y2 = y + (LV_MATH_MAX(_lv_trigo_sin(end_angle) * rin,
-                                       _lv_trigo_sin(start_angle) * rin) >> LV_TRIGO_SHIFT) + extra_area;
         lv_obj_invalidate_area(arc, &inv_area);
-    }
-    else if(start_quarter == 3 && end_quarter == 0) {
-        inv_area.x1 = x + ((LV_MATH_MIN(_lv_trigo_sin(end_angle + 90),
-                                        _lv_trigo_sin(start_angle + 90)) * rin) >> LV_TRIGO_SHIFT) - extra_area;
-        inv_area.y1 = y + ((_lv_trigo_sin(start_angle) * rout) >> LV_TRIGO_SHIFT) - extra_area;
-        inv_area.x2 = x + rout + extra_area;
-        inv_area.y2 = y + ((_lv_trigo_sin(end_angle) * rout) >> LV_TRIGO_SHIFT) + extra_area;
+        angle = sector_end;
+    } while(angle < last_angle);
+}
 
-        lv_obj_invalidate_area(arc, &inv_area);
-    }
-    else {
-        lv_obj_invalidate(arc);
+/**
+ * Get the bounding box of a ring sector which doesn't cross a quarter boundary
+ * @param x center x
+ * @param y center y
+ * @param r outer radius
+ * @param w width of the ring
+ * @param start_angle start angle of the sector
+ * @param end_angle end angle of the sector, in the same quarter as `start_angle`
+ * @param res_area store the result here
+ */
+static void get_sector_area(lv_coord_t x, lv_coord_t y, lv_coord_t r, lv_coord_t w, uint16_t start_angle,
+                            uint16_t end_angle, lv_area_t * res_area)
+{
+    lv_coord_t rads[2] = {r, r - w};
+    uint16_t angles[2] = {start_angle, end_angle};
+
+    res_area->x1 = LV_COORD_MAX;
+    res_area->y1 = LV_COORD_MAX;
+    res_area->x2 = LV_COORD_MIN;
+    res_area->y2 = LV_COORD_MIN;
+
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        lv_coord_t px = (_lv_trigo_sin(angles[i & 1] + 90) * rads[i >> 1]) >> LV_TRIGO_SHIFT;
+        lv_coord_t py = (_lv_trigo_sin(angles[i & 1]) * rads[i >> 1]) >> LV_TRIGO_SHIFT;
+        res_area->x1 = LV_MATH_MIN(res_area->x1, px);
+        res_area->x2 = LV_MATH_MAX(res_area->x2, px);
+        res_area->y1 = LV_MATH_MIN(res_area->y1, py);
+        res_area->y2 = LV_MATH_MAX(res_area->y2, py);
     }
+
+    /*One more pixel for the rounding and the anti-aliased edges*/
+    res_area->x1 += x - 1;
+    res_area->x2 += x + 1;
+    res_area->y1 += y - 1;
+    res_area->y2 += y + 1;
+}
+
+/**
+ * Extend an area with the round cap of the arc at an angle
+ * @param x center x
+ * @param y center y
+ * @param r outer radius
+ * @param w width of the ring (the diameter of the cap)
+ * @param angle the angle of the cap
+ * @param res_area the area to extend
+ */
+static void add_cap_area(lv_coord_t x, lv_coord_t y, lv_coord_t r, lv_coord_t w, uint16_t angle, lv_area_t * res_area)
+{
+    lv_coord_t cap_r = w / 2 + 2;
+    lv_coord_t cx = x + ((_lv_trigo_sin(angle + 90) * (r - w / 2)) >> LV_TRIGO_SHIFT);
+    lv_coord_t cy = y + ((_lv_trigo_sin(angle) * (r - w / 2)) >> LV_TRIGO_SHIFT);
+
+    res_area->x1 = LV_MATH_MIN(res_area->x1, cx - cap_r);
+    res_area->x2 = LV_MATH_MAX(res_area->x2, cx + cap_r);
+    res_area->y1 = LV_MATH_MIN(res_area->y1, cy - cap_r);
+    res_area->y2 = LV_MATH_MAX(res_area->y2, cy + cap_r);
 }
 #endif
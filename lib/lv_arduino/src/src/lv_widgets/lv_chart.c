@@ -11,7 +11,9 @@
 
 #include "../lv_misc/lv_debug.h"
 #include "../lv_core/lv_refr.h"
+#include "../lv_core/lv_disp.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_blend.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_themes/lv_theme.h"
 
@@ -43,6 +45,34 @@ typedef struct {
     uint8_t is_reverse_iter;
 } lv_chart_label_iterator_t;
 
+/*State of the one pass drawing of a line series, see `draw_series_polyline`.
+ *The y coordinates are in 1/256 px units*/
+typedef struct {
+    lv_color_t * buf;           /*The draw buffer*/
+    lv_area_t buf_area;         /*Absolute coordinates of the draw buffer*/
+    lv_coord_t buf_w;
+    lv_area_t clip;             /*Draw only here: the series area on the draw buffer*/
+    lv_coord_t width;           /*Width of the line*/
+    lv_color_t color;
+    lv_opa_t line_opa;
+    lv_opa_t area_opa;          /*Opacity of the area under the line (LV_OPA_TRANSP: no area)*/
+    lv_opa_t fade_top;          /*Opacity of the area on the top and the bottom of the series area if `has_fade`*/
+    lv_opa_t fade_bottom;
+    lv_coord_t fade_y1;
+    lv_coord_t fade_h;
+    const lv_opa_t * fade;      /*The opacity of every row of the fade or NULL to calculate them*/
+    uint8_t has_fade : 1;
+    uint8_t aa : 1;
+    uint8_t col_vertical : 1;   /*A vertical segment is in the column*/
+    lv_coord_t col_x;           /*The column being collected (LV_COORD_MIN: none)*/
+    int32_t col_top;            /*Highest and lowest y of the center of the line in the column*/
+    int32_t col_bottom;
+    int32_t col_slope_min;      /*Range of the slopes of the other segments in the column (-1 max: none)*/
+    int32_t col_slope_max;
+    int32_t last_slope;         /*The last slope given to `polyline_half_height` and its result*/
+    int32_t last_hv;
+} polyline_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -53,10 +83,33 @@ static lv_style_list_t * lv_chart_get_style(lv_obj_t * chart, uint8_t part);
 static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask);
 static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
 static void draw_series_column(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
+static bool polyline_init(polyline_dsc_t * dsc, const lv_area_t * series_area, const lv_area_t * series_mask,
+                          const lv_draw_line_dsc_t * line_dsc, const lv_draw_rect_dsc_t * area_dsc);
+static void draw_series_polyline(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                                 polyline_dsc_t * dsc);
+static void draw_series_points(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                               const lv_area_t * clip_area, lv_draw_rect_dsc_t * point_dsc, lv_coord_t point_radius);
+static void polyline_add_segment(polyline_dsc_t * dsc, lv_coord_t x1, int32_t y1, lv_coord_t x2, int32_t y2);
+static void polyline_add(polyline_dsc_t * dsc, lv_coord_t x, int32_t ya, int32_t yb, int32_t slope);
+static void polyline_flush(polyline_dsc_t * dsc);
+static int32_t polyline_half_height(polyline_dsc_t * dsc, int32_t slope);
+static inline void polyline_px(polyline_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_opa_t opa);
+static void draw_series_envelope(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
+static void draw_envelope_span(const lv_area_t * span, const lv_area_t * clip_area, lv_color_t color, lv_opa_t opa);
 static void draw_axes(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask);
 static void invalidate_lines(lv_obj_t * chart, uint16_t i);
 static void invalidate_columns(lv_obj_t * chart, uint16_t i);
+static void invalidate_envelope(lv_obj_t * chart, uint16_t i);
+static lv_coord_t * resize_env_points(lv_chart_series_t * ser, uint16_t point_cnt_old, uint16_t point_cnt);
+static void reset_start_point(lv_chart_series_t * ser, uint16_t point_cnt);
+static void reverse_env_points(lv_coord_t * env_points, uint16_t first, uint16_t last);
 static void get_series_area(lv_obj_t * chart, lv_area_t * series_area);
+static void get_plot_area(lv_obj_t * chart, lv_area_t * plot_area);
+static void invalidate_plot(lv_obj_t * chart);
+static void shift_invalidate(lv_obj_t * chart, lv_chart_series_t * ser);
+static void scroll_task_cb(lv_task_t * task);
+static bool scroll_plot(lv_obj_t * chart, uint16_t shift_cnt);
+static bool scroll_bg_is_uniform(const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords, lv_coord_t * edge);
 static void get_next_axis_label(lv_chart_label_iterator_t * iterator, char * buf);
 static inline bool is_tick_with_label(uint8_t tick_num, lv_chart_axis_cfg_t * axis);
 static lv_chart_label_iterator_t create_axis_label_iter(const char * list, uint8_t iterator_dir);
@@ -108,6 +161,8 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->point_cnt             = LV_CHART_PNUM_DEF;
     ext->type                  = LV_CHART_TYPE_LINE;
     ext->update_mode           = LV_CHART_UPDATE_MODE_SHIFT;
+    ext->scroll_cb             = NULL;
+    ext->scroll_task           = NULL;
     _lv_memset_00(&ext->x_axis, sizeof(ext->x_axis));
     _lv_memset_00(&ext->y_axis, sizeof(ext->y_axis));
     _lv_memset_00(&ext->secondary_y_axis, sizeof(ext->secondary_y_axis));
@@ -147,6 +202,7 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, const lv_obj_t * copy)
         ext->hdiv_cnt   = ext_copy->hdiv_cnt;
         ext->vdiv_cnt   = ext_copy->vdiv_cnt;
         ext->point_cnt  = ext_copy->point_cnt;
+        ext->scroll_cb  = ext_copy->scroll_cb;
         _lv_memcpy(&ext->x_axis, &ext_copy->x_axis, sizeof(lv_chart_axis_cfg_t));
         _lv_memcpy(&ext->y_axis, &ext_copy->y_axis, sizeof(lv_chart_axis_cfg_t));
         _lv_memcpy(&ext->secondary_y_axis, &ext_copy->secondary_y_axis, sizeof(lv_chart_axis_cfg_t));
@@ -190,7 +246,10 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * chart, lv_color_t color)
         return NULL;
     }
 
+    ser->env_points = NULL;
     ser->start_point = 0;
+    ser->shift_cnt = 0;
+    ser->ext_buf_assigned = 0;
 
     uint16_t i;
     lv_coord_t * p_tmp = ser->points;
@@ -221,6 +280,12 @@ void lv_chart_clear_serie(lv_obj_t * chart, lv_chart_series_t * serie)
         serie->points[i] = LV_CHART_POINT_DEF;
     }
 
+    if(serie->env_points) {
+        for(i = 0; i < ext->point_cnt * 2; i++) {
+            serie->env_points[i] = LV_CHART_POINT_DEF;
+        }
+    }
+
     serie->start_point = 0;
 }
 
@@ -284,7 +349,8 @@ void lv_chart_set_type(lv_obj_t * chart, lv_chart_type_t type)
 }
 
 /**
- * Set the number of points on a data line on a chart
+ * Set the number of points on a data line on a chart.
+ * The points are kept from the oldest one. If an array can't be allocated the chart is left unchanged.
  * @param chart pointer r to chart object
  * @param point_cnt new number of points on the data lines
  */
@@ -293,6 +359,7 @@ void lv_chart_set_point_count(lv_obj_t * chart, uint16_t point_cnt)
     LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
 
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(point_cnt < 1) point_cnt = 1;
     if(ext->point_cnt == point_cnt) return;
 
     lv_chart_series_t * ser;
@@ -300,49 +367,69 @@ void lv_chart_set_point_count(lv_obj_t * chart, uint16_t point_cnt)
     uint16_t i;
     lv_coord_t def = LV_CHART_POINT_DEF;
 
-    if(point_cnt < 1) point_cnt = 1;
+    /*Allocate the new arrays of all series first, so the chart is left unchanged if one fails.
+     *The array of the application can't be resized either, so all series continue in own arrays.*/
+    uint32_t ser_cnt = _lv_ll_get_len(&ext->series_ll);
+    lv_coord_t ** new_arrays = NULL;
+    if(ser_cnt > 0) {
+        new_arrays = _lv_mem_buf_get(sizeof(lv_coord_t *) * 2 * ser_cnt);
+        LV_ASSERT_MEM(new_arrays);
+        if(new_arrays == NULL) return;
+    }
 
+    uint32_t s = 0;
+    bool alloc_ok = true;
     _LV_LL_READ_BACK(ext->series_ll, ser) {
-        if(ser->start_point != 0) {
-            lv_coord_t * new_points = lv_mem_alloc(sizeof(lv_coord_t) * point_cnt);
-            LV_ASSERT_MEM(new_points);
-            if(new_points == NULL) return;
-
-            if(point_cnt >= point_cnt_old) {
-                for(i = 0; i < point_cnt_old; i++) {
-                    new_points[i] =
-                        ser->points[(i + ser->start_point) % point_cnt_old]; /*Copy old contents to new array*/
-                }
-                for(i = point_cnt_old; i < point_cnt; i++) {
-                    new_points[i] = def; /*Fill up the rest with default value*/
-                }
-            }
-            else {
-                for(i = 0; i < point_cnt; i++) {
-                    new_points[i] =
-                        ser->points[(i + ser->start_point) % point_cnt_old]; /*Copy old contents to new array*/
-                }
-            }
+        lv_coord_t * new_points = lv_mem_alloc(sizeof(lv_coord_t) * point_cnt);
+        LV_ASSERT_MEM(new_points);
+        lv_coord_t * new_env_points = NULL;
+        if(ser->env_points && new_points) {
+            new_env_points = resize_env_points(ser, point_cnt_old, point_cnt);
+            LV_ASSERT_MEM(new_env_points);
+        }
 
-            /*Switch over pointer from old to new*/
-            lv_mem_free(ser->points);
-            ser->points = new_points;
+        new_arrays[s * 2] = new_points;
+        new_arrays[s * 2 + 1] = new_env_points;
+        s++;
+
+        if(new_points == NULL || (ser->env_points && new_env_points == NULL)) {
+            alloc_ok = false;
+            break;
         }
-        else {
-            ser->points = lv_mem_realloc(ser->points, sizeof(lv_coord_t) * point_cnt);
-            LV_ASSERT_MEM(ser->points);
-            if(ser->points == NULL) return;
-            /*Initialize the new points*/
-            if(point_cnt > point_cnt_old) {
-                for(i = point_cnt_old - 1; i < point_cnt; i++) {
-                    ser->points[i] = def;
-                }
-            }
+    }
+
+    if(!alloc_ok) {
+        for(i = 0; i < s * 2; i++) lv_mem_free(new_arrays[i]);
+        _lv_mem_buf_release(new_arrays);
+        return;
+    }
+
+    /*Switch all series over to the new arrays*/
+    s = 0;
+    _LV_LL_READ_BACK(ext->series_ll, ser) {
+        lv_coord_t * new_points = new_arrays[s * 2];
+        uint16_t copy_cnt = LV_MATH_MIN(point_cnt, point_cnt_old);
+        for(i = 0; i < copy_cnt; i++) {
+            new_points[i] = ser->points[(i + ser->start_point) % point_cnt_old]; /*Copy old contents to new array*/
+        }
+        for(i = copy_cnt; i < point_cnt; i++) {
+            new_points[i] = def; /*Fill up the rest with default value*/
+        }
+
+        if(!ser->ext_buf_assigned) lv_mem_free(ser->points);
+        ser->points = new_points;
+        ser->ext_buf_assigned = 0;
+
+        if(ser->env_points) {
+            lv_mem_free(ser->env_points);
+            ser->env_points = new_arrays[s * 2 + 1];
         }
 
         ser->start_point = 0;
+        s++;
     }
 
+    if(new_arrays) _lv_mem_buf_release(new_arrays);
     ext->point_cnt = point_cnt;
 
     lv_chart_refresh(chart);
@@ -364,7 +451,7 @@ void lv_chart_init_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t
     for(i = 0; i < ext->point_cnt; i++) {
         ser->points[i] = y;
     }
-    ser->start_point = 0;
+    reset_start_point(ser, ext->point_cnt);
     lv_chart_refresh(chart);
 }
 
@@ -380,8 +467,37 @@ void lv_chart_set_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y
     LV_ASSERT_NULL(ser);
 
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
-    memcpy(ser->points, y_array, ext->point_cnt * (sizeof(lv_coord_t)));
+    if(ser->points != y_array) memcpy(ser->points, y_array, ext->point_cnt * (sizeof(lv_coord_t)));
+    reset_start_point(ser, ext->point_cnt);
+    lv_chart_refresh(chart);
+}
+
+/**
+ * Use an array of the application as the points of a series. The chart reads and writes it in place,
+ * so the application can keep it as a ring buffer and add points with `lv_chart_set_next`.
+ * The array is not freed by the chart and has to be valid while the series is used.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param array array of 'lv_coord_t' points
+ * @param point_cnt number of elements in `array`. Has to be the point count of the chart.
+ */
+void lv_chart_set_ext_array(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t array[], uint16_t point_cnt)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+    LV_ASSERT_NULL(ser);
+    LV_ASSERT_NULL(array);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(point_cnt != ext->point_cnt) {
+        LV_LOG_WARN("lv_chart_set_ext_array: the array has to have as many points as the chart");
+        return;
+    }
+
+    if(!ser->ext_buf_assigned) lv_mem_free(ser->points);
+    ser->points = array;
+    ser->ext_buf_assigned = 1;
     ser->start_point = 0;
+    ser->shift_cnt = 0;
     lv_chart_refresh(chart);
 }
 
@@ -401,18 +517,60 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
         ser->points[ser->start_point] =
             y; /*This was the place of the former left most value, after shifting it is the rightmost*/
         ser->start_point = (ser->start_point + 1) % ext->point_cnt;
-        lv_chart_refresh(chart);
+        shift_invalidate(chart, ser);
     }
     else if(ext->update_mode == LV_CHART_UPDATE_MODE_CIRCULAR) {
         ser->points[ser->start_point] = y;
 
         if(ext->type & LV_CHART_TYPE_LINE) invalidate_lines(chart, ser->start_point);
         if(ext->type & LV_CHART_TYPE_COLUMN) invalidate_columns(chart, ser->start_point);
+        if(ext->type & LV_CHART_TYPE_ENVELOPE) invalidate_envelope(chart, ser->start_point);
 
         ser->start_point = (ser->start_point + 1) % ext->point_cnt; /*update the x for next incoming y*/
     }
 }
 
+/**
+ * Add the next point of an envelope like `lv_chart_set_next` does: the mean is the value of the point,
+ * the band between the min. and max. is drawn by `LV_CHART_TYPE_ENVELOPE`.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param min the smallest value in the period of the point
+ * @param max the largest value in the period of the point
+ * @param mean the average value in the period of the point
+ */
+void lv_chart_set_next_envelope(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t min, lv_coord_t max,
+                                lv_coord_t mean)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+    LV_ASSERT_NULL(ser);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+
+    /*Allocate the band only for the series which have one*/
+    if(ser->env_points == NULL) {
+        ser->env_points = lv_mem_alloc(sizeof(lv_coord_t) * 2 * ext->point_cnt);
+        LV_ASSERT_MEM(ser->env_points);
+        if(ser->env_points == NULL) return;
+
+        uint16_t i;
+        for(i = 0; i < ext->point_cnt * 2; i++) {
+            ser->env_points[i] = LV_CHART_POINT_DEF;
+        }
+    }
+
+    if(min > max) {
+        lv_coord_t tmp = min;
+        min = max;
+        max = tmp;
+    }
+
+    /*`lv_chart_set_next` writes the mean to the same index and invalidates the point*/
+    ser->env_points[ser->start_point * 2] = min;
+    ser->env_points[ser->start_point * 2 + 1] = max;
+    lv_chart_set_next(chart, ser, mean);
+}
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
@@ -429,6 +587,24 @@ void lv_chart_set_update_mode(lv_obj_t * chart, lv_chart_update_mode_t update_mo
     lv_obj_invalidate(chart);
 }
 
+/**
+ * Set a function to scroll the already drawn plot when points are added in shift mode.
+ * Then only the new segments on the right are redrawn.
+ * The plot is redrawn instead if it can't be scrolled exactly, e.g. the points aren't evenly spaced,
+ * the background or the axes would move with the plot, or an other part of the plot is being redrawn too.
+ * The plot is scrolled in the next `lv_task_handler()` before the display is refreshed.
+ * The chart shouldn't be covered by other objects.
+ * @param chart pointer to a chart object
+ * @param scroll_cb the scroll function or NULL to redraw the plot
+ */
+void lv_chart_set_scroll_cb(lv_obj_t * chart, lv_chart_scroll_cb_t scroll_cb)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    ext->scroll_cb = scroll_cb;
+}
+
 /**
  * Set the length of the tick marks on the x axis
  * @param chart pointer to the chart
@@ -570,6 +746,19 @@ uint16_t lv_chart_get_point_count(const lv_obj_t * chart)
     return ext->point_cnt;
 }
 
+/**
+ * Get the index of the leftmost point of a series.
+ * In shift mode the points are `points[start]`, `points[start + 1]`, ... wrapping around the end of the array.
+ * @param ser pointer to a data series
+ * @return index of the leftmost point in the `points` array
+ */
+uint16_t lv_chart_get_x_start_point(const lv_chart_series_t * ser)
+{
+    LV_ASSERT_NULL(ser);
+
+    return ser->start_point;
+}
+
 /*=====================
  * Other functions
  *====================*/
@@ -621,6 +810,7 @@ static lv_design_res_t lv_chart_design(lv_obj_t * chart, const lv_area_t * clip_
         lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
         if(ext->type & LV_CHART_TYPE_LINE) draw_series_line(chart, &series_area, clip_area);
         if(ext->type & LV_CHART_TYPE_COLUMN) draw_series_column(chart, &series_area, clip_area);
+        if(ext->type & LV_CHART_TYPE_ENVELOPE) draw_series_envelope(chart, &series_area, clip_area);
 
     }
     return LV_DESIGN_RES_OK;
@@ -652,11 +842,17 @@ static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param
     if(sign == LV_SIGNAL_CLEANUP) {
         lv_chart_series_t * ser;
         _LV_LL_READ(ext->series_ll, ser) {
-            lv_mem_free(ser->points);
-            lv_mem_free(ser);
+            if(!ser->ext_buf_assigned) lv_mem_free(ser->points);
+            if(ser->env_points) lv_mem_free(ser->env_points);
         }
+        /*Frees the series too*/
         _lv_ll_clear(&ext->series_ll);
 
+        if(ext->scroll_task) {
+            lv_task_del(ext->scroll_task);
+            ext->scroll_task = NULL;
+        }
+
         lv_obj_clean_style_list(chart, LV_CHART_PART_SERIES);
         lv_obj_clean_style_list(chart, LV_CHART_PART_SERIES_BG);
     }
@@ -768,7 +964,8 @@ static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, cons
 }
 
 /**
- * Draw the data lines as lines on a chart
+ * Draw the data lines as lines on a chart.
+ * Without masks they are drawn in one pass by `draw_series_polyline`, else segment by segment with `lv_draw_line`.
  * @param obj pointer to chart object
  */
 static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area)
@@ -823,8 +1020,20 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
     /*Do not bother with line ending is the point will over it*/
     if(point_radius > line_dsc.width / 2) line_dsc.raw_end = 1;
 
+    polyline_dsc_t polyline;
+    bool polyline_ok = polyline_init(&polyline, series_area, &series_mask, &line_dsc, has_area ? &area_dsc : NULL);
+
     /*Go through all data lines*/
     _LV_LL_READ_BACK(ext->series_ll, ser) {
+        if(polyline_ok) {
+            draw_series_polyline(chart, ser, series_area, &polyline);
+            if(point_radius) {
+                point_dsc.bg_color = ser->color;
+                draw_series_points(chart, ser, series_area, clip_area, &point_dsc, point_radius);
+            }
+            continue;
+        }
+
         line_dsc.color = ser->color;
         point_dsc.bg_color = ser->color;
         area_dsc.bg_color = ser->color;
@@ -919,6 +1128,333 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
     }
 }
 
+/**
+ * Prepare drawing the line series in one pass with `draw_series_polyline`.
+ * The pixels are written straight into the draw buffer, so it's possible only without masks and special blending.
+ * @param dsc initialize this descriptor
+ * @param series_area the area of the series
+ * @param series_mask the series area on the clip area
+ * @param line_dsc the line style of the series
+ * @param area_dsc the style of the area under the line or NULL if there is no area
+ * @return true: the series can be drawn by `draw_series_polyline`; false: draw them with `lv_draw_line`
+ */
+static bool polyline_init(polyline_dsc_t * dsc, const lv_area_t * series_area, const lv_area_t * series_mask,
+                          const lv_draw_line_dsc_t * line_dsc, const lv_draw_rect_dsc_t * area_dsc)
+{
+    if(lv_draw_mask_get_cnt() != 0) return false;
+    if(line_dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(line_dsc->dash_width != 0 && line_dsc->dash_gap != 0) return false;
+    if(area_dsc && area_dsc->bg_blend_mode != LV_BLEND_MODE_NORMAL) return false;
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL || disp->driver.set_px_cb) return false;
+#if LV_COLOR_SCREEN_TRANSP
+    if(disp->driver.screen_transp) return false;
+#endif
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    dsc->buf = vdb->buf_act;
+    dsc->buf_area = vdb->area;
+    dsc->buf_w = lv_area_get_width(&vdb->area);
+    if(_lv_area_intersect(&dsc->clip, series_mask, &vdb->area) == false) {
+        dsc->clip.x2 = dsc->clip.x1 - 1;    /*Nothing to draw*/
+    }
+
+#if LV_ANTIALIAS
+    dsc->aa = disp->driver.antialiasing ? 1 : 0;
+#else
+    dsc->aa = 0;
+#endif
+    dsc->width = line_dsc->width;
+    dsc->line_opa = line_dsc->width > 0 ? line_dsc->opa : LV_OPA_TRANSP;
+    dsc->area_opa = area_dsc ? area_dsc->bg_opa : LV_OPA_TRANSP;
+    dsc->has_fade = area_dsc && area_dsc->bg_grad_dir == LV_GRAD_DIR_VER ? 1 : 0;
+    if(dsc->has_fade) {
+        /*The same opacities as the fade mask of `draw_series_line`*/
+        dsc->fade_top = area_dsc->bg_main_color_stop;
+        dsc->fade_bottom = area_dsc->bg_grad_color_stop;
+        dsc->fade_y1 = series_area->y1;
+        dsc->fade_h = lv_area_get_height(series_area);
+    }
+    dsc->fade = NULL;
+    dsc->col_x = LV_COORD_MIN;
+    dsc->last_slope = -1;
+
+    return true;
+}
+
+/**
+ * Draw a line series and the area under it column by column in one pass from left to right.
+ * Every column is covered by the line as much as the line crosses it (like a Wu line with width),
+ * so the line is anti-aliased without masks and the joints aren't drawn twice.
+ * @param chart pointer to chart object
+ * @param ser the series to draw
+ * @param series_area the area of the series
+ * @param dsc initialized by `polyline_init`
+ */
+static void draw_series_polyline(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                                 polyline_dsc_t * dsc)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->point_cnt < 2 || dsc->clip.x1 > dsc->clip.x2) return;
+
+    dsc->color = ser->color;
+    if(dsc->has_fade) {
+        /*Get the opacities for every series: drawing the points might have used the gradient cache*/
+        const _lv_draw_grad_dsc_t * lut = _lv_draw_grad_opa_get(dsc->fade_top, dsc->fade_bottom, dsc->fade_h);
+        dsc->fade = lut ? lut->buf : NULL;
+    }
+
+    lv_coord_t w = lv_area_get_width(series_area);
+    lv_coord_t h = lv_area_get_height(series_area);
+    int32_t range = ext->ymax - ext->ymin;
+    uint16_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+
+    bool prev_valid = false;
+    lv_coord_t x_prev = 0;
+    int32_t y_prev = 0;
+    uint16_t i;
+    for(i = 0; i < ext->point_cnt; i++) {
+        uint16_t p = (start_point + i) % ext->point_cnt;
+        if(ser->points[p] == LV_CHART_POINT_DEF) {
+            prev_valid = false;
+            continue;
+        }
+
+        /*The same position as `draw_series_line` calculates, with the fraction of y kept,
+         *on the center of the pixel*/
+        lv_coord_t x = ((int32_t)w * i) / (ext->point_cnt - 1) + series_area->x1;
+        int32_t q = (int32_t)(ser->points[p] - ext->ymin) * h;
+        int32_t y = (h - q / range + series_area->y1) * 256 - ((q % range) * 256) / range + 128;
+
+        if(prev_valid) {
+            /*Nothing more to draw on the right of the clip area*/
+            if(x_prev > dsc->clip.x2) break;
+            if(x >= dsc->clip.x1) polyline_add_segment(dsc, x_prev, y_prev, x, y);
+        }
+
+        prev_valid = true;
+        x_prev = x;
+        y_prev = y;
+    }
+
+    polyline_flush(dsc);
+}
+
+/**
+ * Draw the points of a line series as circles
+ * @param chart pointer to chart object
+ * @param ser the series to draw
+ * @param series_area the area of the series
+ * @param clip_area mask, inherited from the design function
+ * @param point_dsc the style of the points
+ * @param point_radius radius of the points
+ */
+static void draw_series_points(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * series_area,
+                               const lv_area_t * clip_area, lv_draw_rect_dsc_t * point_dsc, lv_coord_t point_radius)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->point_cnt < 2) return;
+
+    lv_coord_t w = lv_area_get_width(series_area);
+    lv_coord_t h = lv_area_get_height(series_area);
+    uint16_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+
+    uint16_t i;
+    for(i = 0; i < ext->point_cnt; i++) {
+        uint16_t p = (start_point + i) % ext->point_cnt;
+        if(ser->points[p] == LV_CHART_POINT_DEF) continue;
+
+        lv_coord_t x = ((int32_t)w * i) / (ext->point_cnt - 1) + series_area->x1;
+        if(x + point_radius < clip_area->x1) continue;
+        if(x - point_radius > clip_area->x2) break;
+
+        int32_t y_tmp = (int32_t)((int32_t)ser->points[p] - ext->ymin) * h;
+        y_tmp = y_tmp / (ext->ymax - ext->ymin);
+        lv_coord_t y = h - y_tmp + series_area->y1;
+
+        lv_area_t point_area;
+        point_area.x1 = x - point_radius;
+        point_area.x2 = x + point_radius;
+        point_area.y1 = y - point_radius;
+        point_area.y2 = y + point_radius;
+
+        /*Don't limit to the series area to get full circles on the ends*/
+        lv_draw_rect(&point_area, clip_area, point_dsc);
+    }
+}
+
+/**
+ * Add the columns crossed by a segment of the line to the polyline
+ * @param dsc the polyline
+ * @param x1 x of the start point, on the center of a column
+ * @param y1 y of the start point [1/256 px]
+ * @param x2 x of the end point, `x1` or on its right
+ * @param y2 y of the end point [1/256 px]
+ */
+static void polyline_add_segment(polyline_dsc_t * dsc, lv_coord_t x1, int32_t y1, lv_coord_t x2, int32_t y2)
+{
+    /*More points in a column: the segment is vertical*/
+    if(x1 == x2) {
+        if(x1 >= dsc->clip.x1 && x1 <= dsc->clip.x2) polyline_add(dsc, x1, y1, y2, -1);
+        return;
+    }
+
+    int32_t dx = x2 - x1;
+    int32_t dy = y2 - y1;
+    int32_t slope = LV_MATH_ABS(dy) / dx;
+
+    lv_coord_t x_start = LV_MATH_MAX(x1, dsc->clip.x1);
+    lv_coord_t x_end = LV_MATH_MIN(x2, dsc->clip.x2);
+
+    /*y where the segment enters and leaves the columns. The first and last columns are crossed only halfway.*/
+    int32_t y_left = x_start == x1 ? y1 : y1 + (dy * (2 * (x_start - x1) - 1)) / (2 * dx);
+    lv_coord_t x;
+    for(x = x_start; x <= x_end; x++) {
+        int32_t y_right = x == x2 ? y2 : y1 + (dy * (2 * (x - x1) + 1)) / (2 * dx);
+        polyline_add(dsc, x, y_left, y_right, slope);
+        y_left = y_right;
+    }
+}
+
+/**
+ * Add a part of the line to a column. The column is drawn when an other column is started.
+ * @param dsc the polyline
+ * @param x the column
+ * @param ya y of the center of the line where it enters the column [1/256 px]
+ * @param yb y of the center of the line where it leaves the column [1/256 px]
+ * @param slope the change of y in one column [1/256 px] or -1 if the segment is vertical
+ */
+static void polyline_add(polyline_dsc_t * dsc, lv_coord_t x, int32_t ya, int32_t yb, int32_t slope)
+{
+    if(x != dsc->col_x) {
+        polyline_flush(dsc);
+        dsc->col_x = x;
+        dsc->col_top = INT32_MAX;
+        dsc->col_bottom = INT32_MIN;
+        dsc->col_slope_min = INT32_MAX;
+        dsc->col_slope_max = -1;
+        dsc->col_vertical = 0;
+    }
+
+    dsc->col_top = LV_MATH_MIN(dsc->col_top, LV_MATH_MIN(ya, yb));
+    dsc->col_bottom = LV_MATH_MAX(dsc->col_bottom, LV_MATH_MAX(ya, yb));
+    if(slope < 0) {
+        dsc->col_vertical = 1;
+    }
+    else {
+        dsc->col_slope_min = LV_MATH_MIN(dsc->col_slope_min, slope);
+        dsc->col_slope_max = LV_MATH_MAX(dsc->col_slope_max, slope);
+    }
+}
+
+/**
+ * Draw the collected column of the polyline: the area under the center of the line and the line on it.
+ * The rows on the edges are covered partially.
+ * @param dsc the polyline
+ */
+static void polyline_flush(polyline_dsc_t * dsc)
+{
+    if(dsc->col_x == LV_COORD_MIN) return;
+
+    lv_coord_t x = dsc->col_x;
+    dsc->col_x = LV_COORD_MIN;
+
+    lv_coord_t y;
+    if(dsc->area_opa > LV_OPA_MIN) {
+        int32_t area_top = (dsc->col_top + dsc->col_bottom) / 2;
+        if(!dsc->aa) area_top = ((area_top + 128) >> 8) * 256;
+
+        lv_coord_t y_first = area_top >> 8;
+        lv_coord_t y_end = dsc->clip.y2;
+        for(y = LV_MATH_MAX(y_first, dsc->clip.y1); y <= y_end; y++) {
+            lv_opa_t opa = dsc->area_opa;
+            if(dsc->has_fade) {
+                lv_coord_t fade_y = y - dsc->fade_y1;
+                lv_opa_t fade = dsc->fade ? dsc->fade[fade_y] :
+                                _lv_draw_grad_opa_calc(dsc->fade_top, dsc->fade_bottom, dsc->fade_h, fade_y);
+                opa = ((uint16_t)opa * fade) >> 8;
+            }
+            if(y == y_first) opa = ((uint16_t)opa * (256 - (area_top & 0xFF))) >> 8;
+            polyline_px(dsc, x, y, opa);
+        }
+    }
+
+    if(dsc->line_opa <= LV_OPA_MIN) return;
+
+    /*The line is at most `width * (1 + slope)` high: skip the sqrt if it can't reach the clip area.
+     *It matters because the whole line is walked again for every strip of the draw buffer.*/
+    int32_t hv = dsc->width * (256 + LV_MATH_MAX(dsc->col_slope_max, 0)) / 2;
+    if(dsc->col_top - hv >= (dsc->clip.y2 + 1) * 256 || dsc->col_bottom + hv <= dsc->clip.y1 * 256) return;
+
+    /*The half height is convex in the slope, so it's the largest on one of the ends of the range*/
+    hv = dsc->col_vertical ? dsc->width * 128 : 0;
+    if(dsc->col_slope_max >= 0) {
+        hv = LV_MATH_MAX(hv, polyline_half_height(dsc, dsc->col_slope_min));
+        if(dsc->col_slope_max != dsc->col_slope_min) {
+            hv = LV_MATH_MAX(hv, polyline_half_height(dsc, dsc->col_slope_max));
+        }
+    }
+
+    int32_t top = dsc->col_top - hv;
+    int32_t bottom = dsc->col_bottom + hv;
+    if(!dsc->aa) {
+        top = ((top + 128) >> 8) * 256;
+        bottom = ((bottom + 128) >> 8) * 256;
+    }
+
+    lv_coord_t y_end = LV_MATH_MIN((bottom - 1) >> 8, dsc->clip.y2);
+    for(y = LV_MATH_MAX(top >> 8, dsc->clip.y1); y <= y_end; y++) {
+        int32_t cov = LV_MATH_MIN(bottom, (y + 1) * 256) - LV_MATH_MAX(top, y * 256);
+        polyline_px(dsc, x, y, cov >= 256 ? dsc->line_opa : ((uint16_t)dsc->line_opa * cov) >> 8);
+    }
+}
+
+/**
+ * Get how much a line covers above and below its center in a column, beyond the part the center crosses.
+ * A line of `width` is `width * sqrt(1 + slope^2)` high, the center crosses `slope` of it in a column.
+ * The columns of a segment have the same slope, so the last result is reused.
+ * @param dsc the polyline
+ * @param slope the change of y in one column [1/256 px]
+ * @return the half of the remaining height [1/256 px]
+ */
+static int32_t polyline_half_height(polyline_dsc_t * dsc, int32_t slope)
+{
+    if(slope == dsc->last_slope) return dsc->last_hv;
+
+    int32_t len;    /*sqrt(1 + slope^2) [1/256]*/
+    if(slope >= 64 * 256) {
+        len = slope;
+    }
+    else {
+        /*sqrt(256 + (slope/16)^2) = 16 * sqrt(1 + slope^2)*/
+        lv_sqrt_res_t q;
+        uint32_t s = slope >> 4;
+        _lv_sqrt(256 + s * s, &q, 0x8000);
+        len = (((int32_t)q.i << 8) + q.f) >> 4;
+    }
+
+    int32_t hv = (dsc->width * len - slope) / 2;
+    dsc->last_slope = slope;
+    dsc->last_hv = LV_MATH_MAX(hv, 0);
+    return dsc->last_hv;
+}
+
+/**
+ * Blend the color of the polyline on a pixel of the draw buffer
+ * @param dsc the polyline
+ * @param x x coordinate of the pixel, inside the clip area
+ * @param y y coordinate of the pixel, inside the clip area
+ * @param opa opacity of the color
+ */
+static inline void polyline_px(polyline_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_opa_t opa)
+{
+    if(opa <= LV_OPA_MIN) return;
+
+    lv_color_t * px = &dsc->buf[(int32_t)(y - dsc->buf_area.y1) * dsc->buf_w + (x - dsc->buf_area.x1)];
+    *px = opa >= LV_OPA_MAX ? dsc->color : lv_color_mix(dsc->color, *px, opa);
+}
+
 /**
  * Draw the data lines as columns on a chart
  * @param chart pointer to chart object
@@ -984,6 +1520,143 @@ static void draw_series_column(lv_obj_t * chart, const lv_area_t * series_area,
     }
 }
 
+/**
+ * Draw the data lines as envelopes on a chart: the band from the min. to the max. of the points and their mean.
+ * Every column of pixels is filled with vertical spans straight into the draw buffer, without line masks.
+ * @param chart pointer to chart object
+ * @param series_area the area of the series
+ * @param clip_area mask, inherited from the design function
+ */
+static void draw_series_envelope(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area)
+{
+    lv_area_t series_mask;
+    if(_lv_area_intersect(&series_mask, series_area, clip_area) == false) return;
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+
+    lv_coord_t w     = lv_area_get_width(series_area);
+    lv_coord_t h     = lv_area_get_height(series_area);
+    lv_coord_t y_ofs = series_area->y1;
+    int32_t y_range  = ext->ymax - ext->ymin;
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    lv_obj_init_draw_line_dsc(chart, LV_CHART_PART_SERIES, &line_dsc);
+
+    /*The band has the opacity of the series area, or it's half transparent if there is no area*/
+    lv_opa_t band_opa = lv_obj_get_style_bg_opa(chart, LV_CHART_PART_SERIES);
+    if(band_opa <= LV_OPA_MIN) band_opa = LV_OPA_50;
+    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(chart, LV_CHART_PART_SERIES);
+    if(opa_scale < LV_OPA_MAX) band_opa = (uint16_t)((uint16_t)band_opa * opa_scale) >> 8;
+
+    /*The mean is `width` thick around its value*/
+    bool has_mean = line_dsc.width > 0 && line_dsc.opa > LV_OPA_MIN;
+    lv_coord_t mean_up = (line_dsc.width - 1) / 2;
+    lv_coord_t mean_down = line_dsc.width / 2;
+
+    lv_chart_series_t * ser;
+    _LV_LL_READ_BACK(ext->series_ll, ser) {
+        uint16_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+
+        /*The points of the current column*/
+        lv_coord_t col_x1 = series_area->x1;
+        lv_coord_t col_min = LV_COORD_MAX;
+        lv_coord_t col_max = LV_COORD_MIN;
+        int32_t mean_sum = 0;
+        uint16_t mean_cnt = 0;
+
+        bool has_prev = false;
+        lv_coord_t prev_mean_y = 0;
+
+        uint16_t i;
+        for(i = 0; i < ext->point_cnt; i++) {
+            uint16_t p = (start_point + i) % ext->point_cnt;
+            if(ser->points[p] != LV_CHART_POINT_DEF) {
+                lv_coord_t min = ser->points[p];
+                lv_coord_t max = ser->points[p];
+                if(ser->env_points && ser->env_points[p * 2] != LV_CHART_POINT_DEF) {
+                    min = ser->env_points[p * 2];
+                    max = ser->env_points[p * 2 + 1];
+                }
+                col_min = LV_MATH_MIN(col_min, min);
+                col_max = LV_MATH_MAX(col_max, max);
+                mean_sum += ser->points[p];
+                mean_cnt++;
+            }
+
+            /*Merge the points while they fall into the same column*/
+            lv_coord_t x_next = series_area->x1 + ((int32_t)w * (i + 1)) / ext->point_cnt;
+            if(x_next <= col_x1) continue;
+
+            if(col_x1 > series_mask.x2) break;
+
+            if(mean_cnt == 0) {
+                has_prev = false;
+            }
+            else {
+                lv_coord_t mean_y = h - ((mean_sum / mean_cnt - ext->ymin) * h) / y_range + y_ofs;
+
+                if(x_next > series_mask.x1) {
+                    lv_area_t span;
+                    span.x1 = col_x1;
+                    span.x2 = x_next - 1;
+
+                    if(ser->env_points) {
+                        span.y1 = h - (((int32_t)col_max - ext->ymin) * h) / y_range + y_ofs;
+                        span.y2 = h - (((int32_t)col_min - ext->ymin) * h) / y_range + y_ofs;
+                        draw_envelope_span(&span, &series_mask, ser->color, band_opa);
+                    }
+
+                    if(has_mean) {
+                        /*The mean of the column and the step from the previous one on its first pixel*/
+                        span.y1 = mean_y - mean_up;
+                        span.y2 = mean_y + mean_down;
+                        draw_envelope_span(&span, &series_mask, ser->color, line_dsc.opa);
+
+                        if(has_prev && prev_mean_y != mean_y) {
+                            span.x2 = span.x1;
+                            span.y1 = LV_MATH_MIN(prev_mean_y, mean_y) - mean_up;
+                            span.y2 = LV_MATH_MAX(prev_mean_y, mean_y) + mean_down;
+                            draw_envelope_span(&span, &series_mask, ser->color, line_dsc.opa);
+                        }
+                    }
+                }
+
+                has_prev = true;
+                prev_mean_y = mean_y;
+            }
+
+            col_x1 = x_next;
+            col_min = LV_COORD_MAX;
+            col_max = LV_COORD_MIN;
+            mean_sum = 0;
+            mean_cnt = 0;
+        }
+    }
+}
+
+/**
+ * Fill a span of an envelope.
+ * Without masks it's blended straight into the draw buffer, else it's drawn as a rectangle to apply the masks.
+ * @param span the area to fill
+ * @param clip_area clip the span to this area
+ * @param color color of the span
+ * @param opa opacity of the span
+ */
+static void draw_envelope_span(const lv_area_t * span, const lv_area_t * clip_area, lv_color_t color, lv_opa_t opa)
+{
+    if(lv_draw_mask_get_cnt() == 0) {
+        _lv_blend_fill(clip_area, span, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, LV_BLEND_MODE_NORMAL);
+        return;
+    }
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = color;
+    dsc.bg_opa = opa;
+    lv_draw_rect(span, clip_area, &dsc);
+}
+
 /**
  * Create iterator for newline-separated list
  * @param list pointer to newline-separated labels list
@@ -1413,6 +2086,93 @@ static void invalidate_columns(lv_obj_t * chart, uint16_t i)
     _lv_inv_area(lv_obj_get_disp(chart), &col_a);
 }
 
+/**
+ * Invalidate the column of a point of an envelope and the step of the mean to the next column
+ * @param chart pointer to chart object
+ * @param i index of the point
+ */
+static void invalidate_envelope(lv_obj_t * chart, uint16_t i)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(i >= ext->point_cnt) return;
+
+    lv_area_t series_area;
+    get_series_area(chart, &series_area);
+    lv_coord_t w = lv_area_get_width(&series_area);
+
+    lv_area_t coords;
+    get_plot_area(chart, &coords);
+    coords.x1 = series_area.x1 + ((int32_t)w * i) / ext->point_cnt;
+    coords.x2 = series_area.x1 + ((int32_t)w * (i + 1)) / ext->point_cnt;
+    coords.x2 = LV_MATH_MAX(coords.x2, coords.x1 + 1);
+    coords.x2 = LV_MATH_MIN(coords.x2, series_area.x2);
+
+    lv_obj_invalidate_area(chart, &coords);
+}
+
+/**
+ * Copy the min. and max. of the points of a series into a new array of an other point count.
+ * The oldest point becomes the first, like `lv_chart_set_point_count` reorders the points.
+ * @param ser pointer to a data series with `env_points`
+ * @param point_cnt_old the current point count
+ * @param point_cnt the new point count
+ * @return the new array (the old one is not freed) or NULL if it can't be allocated
+ */
+static lv_coord_t * resize_env_points(lv_chart_series_t * ser, uint16_t point_cnt_old, uint16_t point_cnt)
+{
+    lv_coord_t * env_points = lv_mem_alloc(sizeof(lv_coord_t) * 2 * point_cnt);
+    if(env_points == NULL) return NULL;
+
+    uint16_t i;
+    for(i = 0; i < point_cnt; i++) {
+        if(i < point_cnt_old) {
+            uint16_t p = (i + ser->start_point) % point_cnt_old;
+            env_points[i * 2] = ser->env_points[p * 2];
+            env_points[i * 2 + 1] = ser->env_points[p * 2 + 1];
+        }
+        else {
+            env_points[i * 2] = LV_CHART_POINT_DEF;
+            env_points[i * 2 + 1] = LV_CHART_POINT_DEF;
+        }
+    }
+
+    return env_points;
+}
+
+/**
+ * Make the first point the oldest one. The min. and max. of the points are rotated, so they stay
+ * with the same (oldest to newest) index like the points set in order by the caller.
+ * @param ser pointer to a data series
+ * @param point_cnt the point count of the chart
+ */
+static void reset_start_point(lv_chart_series_t * ser, uint16_t point_cnt)
+{
+    if(ser->env_points && ser->start_point != 0) {
+        /*Rotate left by start_point with three reversals, in place*/
+        reverse_env_points(ser->env_points, 0, ser->start_point - 1);
+        reverse_env_points(ser->env_points, ser->start_point, point_cnt - 1);
+        reverse_env_points(ser->env_points, 0, point_cnt - 1);
+    }
+    ser->start_point = 0;
+}
+
+/**
+ * Reverse the order of the min./max. pairs from `first` to `last` (inclusive)
+ */
+static void reverse_env_points(lv_coord_t * env_points, uint16_t first, uint16_t last)
+{
+    while(first < last) {
+        lv_coord_t min = env_points[first * 2];
+        lv_coord_t max = env_points[first * 2 + 1];
+        env_points[first * 2] = env_points[last * 2];
+        env_points[first * 2 + 1] = env_points[last * 2 + 1];
+        env_points[last * 2] = min;
+        env_points[last * 2 + 1] = max;
+        first++;
+        last--;
+    }
+}
+
 static void get_series_area(lv_obj_t * chart, lv_area_t * series_area)
 {
     lv_area_copy(series_area, &chart->coords);
@@ -1422,4 +2182,255 @@ static void get_series_area(lv_obj_t * chart, lv_area_t * series_area)
     series_area->y2 -= lv_obj_get_style_pad_bottom(chart, LV_CHART_PART_BG);
 }
 
+/**
+ * Get the area the series can draw to: the series area with the overflow of the lines and points
+ * @param chart pointer to chart object
+ * @param plot_area store the area here
+ */
+static void get_plot_area(lv_obj_t * chart, lv_area_t * plot_area)
+{
+    get_series_area(chart, plot_area);
+
+    lv_style_int_t line_width = lv_obj_get_style_line_width(chart, LV_CHART_PART_SERIES);
+    lv_style_int_t point_radius = lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
+    lv_coord_t ov = line_width + point_radius;
+
+    plot_area->x1 -= ov;
+    plot_area->x2 += ov;
+    plot_area->y1 -= ov;
+    plot_area->y2 += ov;
+}
+
+/**
+ * Invalidate only the series of a chart. The axes and their labels are unchanged.
+ * @param chart pointer to chart object
+ */
+static void invalidate_plot(lv_obj_t * chart)
+{
+    lv_area_t plot_area;
+    get_plot_area(chart, &plot_area);
+    lv_obj_invalidate_area(chart, &plot_area);
+}
+
+/**
+ * Refresh the chart after a point was shifted into a series.
+ * With a scroll callback the plot is scrolled once for all the series in the next `lv_task_handler()`,
+ * else the plot is redrawn.
+ * @param chart pointer to chart object
+ * @param ser the series with the new point
+ */
+static void shift_invalidate(lv_obj_t * chart, lv_chart_series_t * ser)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->scroll_cb == NULL || ext->type != LV_CHART_TYPE_LINE) {
+        invalidate_plot(chart);
+        return;
+    }
+
+    ser->shift_cnt++;
+
+    if(ext->scroll_task == NULL) {
+        ext->scroll_task = lv_task_create(scroll_task_cb, 0, LV_TASK_PRIO_HIGHEST, chart);
+        if(ext->scroll_task == NULL) {
+            invalidate_plot(chart);
+            return;
+        }
+        lv_task_set_repeat_count(ext->scroll_task, 1);
+    }
+}
+
+/**
+ * Scroll the plot by the points shifted in since the last call. Runs before the refresh of the display.
+ * @param task the scroll task of a chart
+ */
+static void scroll_task_cb(lv_task_t * task)
+{
+    lv_obj_t * chart = task->user_data;
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    ext->scroll_task = NULL;    /*The task is deleted after this single run*/
+
+    /*The series can be scrolled together only if all of them are shifted by the same points*/
+    lv_chart_series_t * ser;
+    uint16_t shift_cnt = 0;
+    bool same = true;
+    bool first = true;
+    _LV_LL_READ(ext->series_ll, ser) {
+        if(first) shift_cnt = ser->shift_cnt;
+        else if(ser->shift_cnt != shift_cnt) same = false;
+        first = false;
+        ser->shift_cnt = 0;
+    }
+
+    if(same && shift_cnt == 0) return;
+
+    if(!same || !scroll_plot(chart, shift_cnt)) invalidate_plot(chart);
+}
+
+/**
+ * Move the drawn plot to the left by the points shifted in and invalidate only what the move hasn't fixed:
+ * the new segments on the right, the left edge and the division lines.
+ * @param chart pointer to chart object
+ * @param shift_cnt number of points shifted into every series
+ * @return true: the plot is scrolled; false: the plot has to be redrawn
+ */
+static bool scroll_plot(lv_obj_t * chart, uint16_t shift_cnt)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->scroll_cb == NULL || ext->type != LV_CHART_TYPE_LINE) return false;
+    if(ext->point_cnt < 2 || shift_cnt >= ext->point_cnt - 1) return false;
+
+    /*The tick marks and labels of the x axis would move with the plot*/
+    if(ext->x_axis.list_of_values != NULL || ext->x_axis.num_tick_marks != 0) return false;
+
+    lv_area_t series_area;
+    get_series_area(chart, &series_area);
+    lv_coord_t w = lv_area_get_width(&series_area);
+
+    /*Every point has to move by the same pixels*/
+    if(w % (ext->point_cnt - 1) != 0) return false;
+    lv_coord_t dx = (w / (ext->point_cnt - 1)) * shift_cnt;
+
+    /*The display shows the pixels of the chart only if it's on a visible screen and nothing is being flushed*/
+    lv_disp_t * disp = lv_obj_get_disp(chart);
+    lv_obj_t * scr = lv_obj_get_screen(chart);
+    if(scr != lv_disp_get_scr_act(disp) && scr != lv_disp_get_layer_top(disp) &&
+       scr != lv_disp_get_layer_sys(disp)) return false;
+    if(disp->driver.buffer == NULL || disp->driver.buffer->flushing) return false;
+    if(lv_obj_get_style_opa_scale(chart, LV_CHART_PART_BG) < LV_OPA_MAX) return false;
+
+    /*The backgrounds have to be the same in every column of a row, except on their rounded or bordered edges*/
+    lv_draw_rect_dsc_t bg_dsc;
+    lv_draw_rect_dsc_init(&bg_dsc);
+    lv_obj_init_draw_rect_dsc(chart, LV_CHART_PART_BG, &bg_dsc);
+    if(bg_dsc.bg_opa < LV_OPA_MAX) return false;
+    lv_coord_t bg_edge;
+    if(!scroll_bg_is_uniform(&bg_dsc, &chart->coords, &bg_edge)) return false;
+
+    lv_draw_rect_dsc_init(&bg_dsc);
+    lv_obj_init_draw_rect_dsc(chart, LV_CHART_PART_SERIES_BG, &bg_dsc);
+    lv_coord_t series_edge;
+    if(!scroll_bg_is_uniform(&bg_dsc, &series_area, &series_edge)) return false;
+
+    /*Drawn around the series area, so on the rows of the plot*/
+    if(bg_dsc.shadow_width && bg_dsc.shadow_opa > LV_OPA_MIN) return false;
+    if(bg_dsc.outline_width && bg_dsc.outline_opa > LV_OPA_MIN) return false;
+
+    lv_style_int_t line_width = lv_obj_get_style_line_width(chart, LV_CHART_PART_SERIES);
+    lv_style_int_t point_radius = lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
+    lv_coord_t ov = line_width + point_radius;
+
+    lv_area_t plot_area;
+    get_plot_area(chart, &plot_area);
+
+    /*Keep the columns where nothing but the series changes. On the left the segment shifted out
+     *would be still visible in the moved pixels.*/
+    lv_area_t scroll_area;
+    scroll_area.x1 = LV_MATH_MAX(series_area.x1 + ov, series_area.x1 + series_edge);
+    scroll_area.x1 = LV_MATH_MAX(scroll_area.x1, chart->coords.x1 + bg_edge);
+    scroll_area.x2 = LV_MATH_MIN(series_area.x2 - series_edge, chart->coords.x2 - bg_edge);
+    scroll_area.y1 = plot_area.y1;
+    scroll_area.y2 = plot_area.y2;
+
+    /*Only the visible part of the chart is on the display*/
+    lv_obj_t * par = chart;
+    while(par) {
+        if(lv_obj_get_hidden(par)) return false;
+        if(!_lv_area_intersect(&scroll_area, &scroll_area, &par->coords)) return false;
+        par = lv_obj_get_parent(par);
+    }
+
+    lv_area_t disp_area;
+    lv_area_set(&disp_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+    if(!_lv_area_intersect(&scroll_area, &scroll_area, &disp_area)) return false;
+    if(lv_area_get_width(&scroll_area) <= dx) return false;
+
+    /*Pixels which will be redrawn anyway might be outdated*/
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t com;
+        if(_lv_area_intersect(&com, &scroll_area, &disp->inv_areas[i])) return false;
+    }
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    lv_obj_init_draw_line_dsc(chart, LV_CHART_PART_SERIES_BG, &line_dsc);
+    lv_coord_t dash_period = line_dsc.dash_width && line_dsc.dash_gap ? line_dsc.dash_width + line_dsc.dash_gap : 0;
+    bool hdiv_inv = dash_period != 0 && dx % dash_period != 0;
+
+    /*Don't let the invalidated areas overflow into a refresh of the whole screen*/
+    uint16_t area_cnt = 2 + 2 * (ext->vdiv_cnt + 2);
+    if(hdiv_inv) area_cnt += ext->hdiv_cnt + 2;
+    if(disp->inv_p + area_cnt > LV_INV_BUF_SIZE) return false;
+
+    if(!ext->scroll_cb(chart, &scroll_area, -dx)) return false;
+
+    /*The left edge where the series is clipped*/
+    lv_area_t a;
+    a.y1 = plot_area.y1;
+    a.y2 = plot_area.y2;
+    a.x1 = plot_area.x1;
+    a.x2 = scroll_area.x1;
+    lv_obj_invalidate_area(chart, &a);
+
+    /*The new segments and the uncovered pixels on the right. The last point is on `series_area.x1 + w`.*/
+    a.x1 = LV_MATH_MIN(scroll_area.x2 - dx + 1, series_area.x1 + w - dx - ov);
+    a.x2 = plot_area.x2;
+    lv_obj_invalidate_area(chart, &a);
+
+    /*The vertical division lines stay while the pixels around them moved*/
+    lv_coord_t lw = line_dsc.width;
+    uint8_t div_i;
+    if(ext->vdiv_cnt != 0) {
+        for(div_i = 0; div_i <= ext->vdiv_cnt + 1; div_i++) {
+            lv_coord_t x = (int32_t)((int32_t)(w - lw) * div_i) / (ext->vdiv_cnt + 1);
+            x += series_area.x1;
+            a.x1 = x - lw;
+            a.x2 = x + lw;
+            lv_obj_invalidate_area(chart, &a);
+            a.x1 -= dx;
+            a.x2 -= dx;
+            lv_obj_invalidate_area(chart, &a);
+        }
+    }
+
+    /*The dashes of the horizontal division lines are on fixed columns*/
+    if(hdiv_inv && ext->hdiv_cnt != 0) {
+        lv_coord_t h = lv_area_get_height(&series_area);
+        a.x1 = scroll_area.x1;
+        a.x2 = scroll_area.x2;
+        for(div_i = 0; div_i <= ext->hdiv_cnt + 1; div_i++) {
+            lv_coord_t y = (int32_t)((int32_t)(h - lw) * div_i) / (ext->hdiv_cnt + 1);
+            y += series_area.y1;
+            a.y1 = y - lw;
+            a.y2 = y + lw;
+            lv_obj_invalidate_area(chart, &a);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Check if a background looks the same in every column of a row apart from its edges.
+ * Only the inside of `coords` is checked.
+ * @param dsc the draw descriptor of the background
+ * @param coords the area of the background
+ * @param edge store the width of the rounded or bordered edges here
+ * @return true: the rows can be scrolled horizontally between the edges
+ */
+static bool scroll_bg_is_uniform(const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords, lv_coord_t * edge)
+{
+    if(dsc->bg_opa > LV_OPA_MIN && dsc->bg_grad_dir == LV_GRAD_DIR_HOR &&
+       dsc->bg_color.full != dsc->bg_grad_color.full) return false;
+    if(dsc->pattern_image && dsc->pattern_opa > LV_OPA_MIN) return false;
+    if(dsc->value_str && dsc->value_opa > LV_OPA_MIN) return false;
+
+    lv_coord_t short_side = LV_MATH_MIN(lv_area_get_width(coords), lv_area_get_height(coords));
+    lv_coord_t radius = LV_MATH_MIN(dsc->radius, short_side / 2);
+    lv_coord_t border = dsc->border_opa > LV_OPA_MIN ? dsc->border_width : 0;
+    *edge = LV_MATH_MAX(radius, border);
+
+    return true;
+}
+
 #endif
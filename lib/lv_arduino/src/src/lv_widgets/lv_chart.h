@@ -42,6 +42,8 @@ enum {
     LV_CHART_TYPE_NONE     = 0x00, /**< Don't draw the series*/
     LV_CHART_TYPE_LINE     = 0x01, /**< Connect the points with lines*/
     LV_CHART_TYPE_COLUMN   = 0x02, /**< Draw columns*/
+    LV_CHART_TYPE_ENVELOPE = 0x04, /**< Fill the band between the min. and max. of every point and draw the mean
+                                        on it. The points share the width evenly, more points in a pixel are merged*/
 };
 typedef uint8_t lv_chart_type_t;
 
@@ -54,10 +56,24 @@ typedef uint8_t lv_chart_update_mode_t;
 
 typedef struct {
     lv_coord_t * points;
+    lv_coord_t * env_points;        /*Min. and max. of every point for `LV_CHART_TYPE_ENVELOPE` (NULL: no band)*/
     lv_color_t color;
     uint16_t start_point;
+    uint16_t shift_cnt;             /*Points added in shift mode since the plot was scrolled last time*/
+    uint8_t ext_buf_assigned : 1;   /*1: `points` is an array of the application, not freed by the chart*/
 } lv_chart_series_t;
 
+/**
+ * Move the already drawn pixels inside an area of the display horizontally.
+ * Used to scroll the plot of a chart in shift mode instead of redrawing it.
+ * @param chart pointer to the chart
+ * @param area the area to scroll (absolute coordinates)
+ * @param dx move the pixels by this much (negative: to the left). The pixels moved out of `area` are dropped,
+ *           the uncovered ones will be redrawn.
+ * @return true: the pixels are moved; false: the area should be redrawn instead
+ */
+typedef bool (*lv_chart_scroll_cb_t)(lv_obj_t * chart, const lv_area_t * area, lv_coord_t dx);
+
 /** Data of axis */
 enum {
     LV_CHART_AXIS_SKIP_LAST_TICK = 0x00,            /**< don't draw the last tick */
@@ -90,6 +106,8 @@ typedef struct {
     lv_chart_axis_cfg_t y_axis;
     lv_chart_axis_cfg_t x_axis;
     lv_chart_axis_cfg_t secondary_y_axis;
+    lv_chart_scroll_cb_t scroll_cb; /*Scroll the plot when new points are shifted in (NULL: redraw the plot)*/
+    lv_task_t * scroll_task;        /*Scrolls the plot once for the points added to all the series*/
     uint8_t update_mode : 1;
 } lv_chart_ext_t;
 
@@ -160,7 +178,8 @@ void lv_chart_set_range(lv_obj_t * chart, lv_coord_t ymin, lv_coord_t ymax);
 void lv_chart_set_type(lv_obj_t * chart, lv_chart_type_t type);
 
 /**
- * Set the number of points on a data line on a chart
+ * Set the number of points on a data line on a chart.
+ * The points are kept from the oldest one. If an array can't be allocated the chart is left unchanged.
  * @param chart pointer r to chart object
  * @param point_cnt new number of points on the data lines
  */
@@ -182,6 +201,17 @@ void lv_chart_init_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t
  */
 void lv_chart_set_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y_array[]);
 
+/**
+ * Use an array of the application as the points of a series. The chart reads and writes it in place,
+ * so the application can keep it as a ring buffer and add points with `lv_chart_set_next`.
+ * The array is not freed by the chart and has to be valid while the series is used.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param array array of 'lv_coord_t' points
+ * @param point_cnt number of elements in `array`. Has to be the point count of the chart.
+ */
+void lv_chart_set_ext_array(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t array[], uint16_t point_cnt);
+
 /**
  * Shift all data right and set the most right data on a data line
  * @param chart pointer to chart object
@@ -190,6 +220,18 @@ void lv_chart_set_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y
  */
 void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y);
 
+/**
+ * Add the next point of an envelope like `lv_chart_set_next` does: the mean is the value of the point,
+ * the band between the min. and max. is drawn by `LV_CHART_TYPE_ENVELOPE`.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param min the smallest value in the period of the point
+ * @param max the largest value in the period of the point
+ * @param mean the average value in the period of the point
+ */
+void lv_chart_set_next_envelope(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t min, lv_coord_t max,
+                                lv_coord_t mean);
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
@@ -197,6 +239,18 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y);
  */
 void lv_chart_set_update_mode(lv_obj_t * chart, lv_chart_update_mode_t update_mode);
 
+/**
+ * Set a function to scroll the already drawn plot when points are added in shift mode.
+ * Then only the new segments on the right are redrawn.
+ * The plot is redrawn instead if it can't be scrolled exactly, e.g. the points aren't evenly spaced,
+ * the background or the axes would move with the plot, or an other part of the plot is being redrawn too.
+ * The plot is scrolled in the next `lv_task_handler()` before the display is refreshed.
+ * The chart shouldn't be covered by other objects.
+ * @param chart pointer to a chart object
+ * @param scroll_cb the scroll function or NULL to redraw the plot
+ */
+void lv_chart_set_scroll_cb(lv_obj_t * chart, lv_chart_scroll_cb_t scroll_cb);
+
 /**
  * Set the length of the tick marks on the x axis
  * @param chart pointer to the chart
@@ -278,6 +332,14 @@ lv_chart_type_t lv_chart_get_type(const lv_obj_t * chart);
  */
 uint16_t lv_chart_get_point_count(const lv_obj_t * chart);
 
+/**
+ * Get the index of the leftmost point of a series.
+ * In shift mode the points are `points[start]`, `points[start + 1]`, ... wrapping around the end of the array.
+ * @param ser pointer to a data series
+ * @return index of the leftmost point in the `points` array
+ */
+uint16_t lv_chart_get_x_start_point(const lv_chart_series_t * ser);
+
 /*=====================
  * Other functions
  *====================*/
@@ -44,6 +44,13 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
 static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_area, lv_design_mode_t mode);
 static void lv_label_refr_text(lv_obj_t * label);
 static void lv_label_revert_dots(lv_obj_t * label);
+static void lv_label_invalidate_txt(lv_obj_t * label);
+#if LV_LABEL_CELLS
+    static void lv_label_refr_cells(lv_obj_t * label);
+    static void invalidate_cells(lv_obj_t * label, const char * old_txt, const char * new_txt);
+    static void invalidate_cell(lv_obj_t * label, uint32_t letter, lv_coord_t x, lv_coord_t cell_w);
+    static lv_coord_t get_cells_x(const lv_obj_t * label, const char * txt);
+#endif
 
 #if LV_USE_ANIMATION
     static void lv_label_set_offset_x(lv_obj_t * label, lv_coord_t x);
@@ -119,6 +126,14 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
 #endif
     ext->dot.tmp_ptr   = NULL;
     ext->dot_tmp_alloc = 0;
+#if LV_LABEL_LAYOUT_CACHE_LEN
+    ext->layout = NULL;
+#endif
+#if LV_LABEL_CELLS
+    ext->cell_txt = NULL;
+    ext->cell_w   = 0;
+    ext->cell_cnt = 0;
+#endif
 
 
     lv_obj_set_design_cb(new_label, lv_label_design);
@@ -137,6 +152,7 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
         lv_label_set_long_mode(new_label, lv_label_get_long_mode(copy));
         lv_label_set_recolor(new_label, lv_label_get_recolor(copy));
         lv_label_set_align(new_label, lv_label_get_align(copy));
+        lv_label_set_cells(new_label, lv_label_get_cell_cnt(copy), lv_label_get_cell_width(copy));
         if(copy_ext->static_txt == 0)
             lv_label_set_text(new_label, lv_label_get_text(copy));
         else
@@ -182,7 +198,7 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
 {
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
 
-    lv_obj_invalidate(label);
+    lv_label_invalidate_txt(label);
 
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
 
@@ -256,7 +272,7 @@ void lv_label_set_text_fmt(lv_obj_t * label, const char * fmt, ...)
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
     LV_ASSERT_STR(fmt);
 
-    lv_obj_invalidate(label);
+    lv_label_invalidate_txt(label);
 
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
 
@@ -469,6 +485,38 @@ void lv_label_set_text_sel_end(lv_obj_t * label, uint32_t index)
 #endif
 }
 
+/**
+ * Write the text into cells: the digits are centered in cells of the same width (tabular digits),
+ * the other letters keep their own width. The size of the label is fixed to `cell_cnt` cells and a line,
+ * so it doesn't change with the text and only the letters which differ are redrawn when a new text is set.
+ * The text is written in one line without kerning, letter space, recoloring, selection and decoration.
+ * @param label pointer to a label object
+ * @param cell_cnt width of the label in cells. 0: don't use cells.
+ * @param cell_w width of a cell, e.g. the width of the widest digit of the font
+ */
+void lv_label_set_cells(lv_obj_t * label, uint8_t cell_cnt, lv_coord_t cell_w)
+{
+    LV_ASSERT_OBJ(label, LV_OBJX_NAME);
+
+#if LV_LABEL_CELLS
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(cell_w <= 0) cell_cnt = 0;
+    if(ext->cell_cnt == cell_cnt && ext->cell_w == cell_w) return;
+
+    lv_obj_invalidate(label);
+    ext->cell_cnt = cell_cnt;
+    ext->cell_w   = cell_w;
+    lv_mem_free(ext->cell_txt);
+    ext->cell_txt = NULL;
+
+    lv_label_refr_text(label);
+#else
+    (void)label;    /*Unused*/
+    (void)cell_cnt; /*Unused*/
+    (void)cell_w;   /*Unused*/
+#endif
+}
+
 /*=====================
  * Getter functions
  *====================*/
@@ -836,6 +884,42 @@ uint32_t lv_label_get_text_sel_end(const lv_obj_t * label)
 #endif
 }
 
+/**
+ * Get the width of a label in cells
+ * @param label pointer to a label object
+ * @return width of the label in cells, 0: cells are not used
+ */
+uint8_t lv_label_get_cell_cnt(const lv_obj_t * label)
+{
+    LV_ASSERT_OBJ(label, LV_OBJX_NAME);
+
+#if LV_LABEL_CELLS
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    return ext->cell_cnt;
+#else
+    (void)label; /*Unused*/
+    return 0;
+#endif
+}
+
+/**
+ * Get the width of the cells of a label
+ * @param label pointer to a label object
+ * @return width of a cell
+ */
+lv_coord_t lv_label_get_cell_width(const lv_obj_t * label)
+{
+    LV_ASSERT_OBJ(label, LV_OBJX_NAME);
+
+#if LV_LABEL_CELLS
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    return ext->cell_w;
+#else
+    (void)label; /*Unused*/
+    return 0;
+#endif
+}
+
 /**
  * Check if a character is drawn under a point.
  * @param label Label object
@@ -1092,6 +1176,12 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
                 label_draw_dsc.flag &= ~LV_TXT_FLAG_CENTER;
             }
         }
+#if LV_LABEL_LAYOUT_CACHE_LEN
+        label_draw_dsc.layout = ext->layout;
+#endif
+#if LV_LABEL_CELLS
+        if(ext->cell_cnt != 0) label_draw_dsc.cell_w = ext->cell_w;
+#endif
 #if LV_LABEL_LONG_TXT_HINT
         lv_draw_label_hint_t * hint = &ext->hint;
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
@@ -1161,6 +1251,14 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_LABEL_LAYOUT_CACHE_LEN
+        lv_mem_free(ext->layout);
+        ext->layout = NULL;
+#endif
+#if LV_LABEL_CELLS
+        lv_mem_free(ext->cell_txt);
+        ext->cell_txt = NULL;
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
@@ -1203,6 +1301,16 @@ static void lv_label_refr_text(lv_obj_t * label)
 #if LV_LABEL_LONG_TXT_HINT
     ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+#if LV_LABEL_LAYOUT_CACHE_LEN
+    lv_mem_free(ext->layout);
+    ext->layout = NULL;
+#endif
+#if LV_LABEL_CELLS
+    if(ext->cell_cnt != 0) {
+        lv_label_refr_cells(label);
+        return;
+    }
+#endif
 
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
@@ -1217,7 +1325,17 @@ static void lv_label_refr_text(lv_obj_t * label)
     if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
     if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
+#if LV_LABEL_LAYOUT_CACHE_LEN
+    /*Measure the letters once for the size and the drawing. In dot mode the text is changed after this.*/
+    if(ext->long_mode != LV_LABEL_LONG_DOT && ext->recolor == 0 &&
+       strlen(ext->text) <= LV_LABEL_LAYOUT_CACHE_LEN) {
+        ext->layout = _lv_txt_layout_create(ext->text, font, letter_space, line_space, max_w, flag);
+    }
+    if(ext->layout) size = ext->layout->size;
+    else _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+#else
     _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+#endif
 
     /*Set the full size in expand mode*/
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) {
@@ -1417,6 +1535,143 @@ static void lv_label_refr_text(lv_obj_t * label)
     lv_obj_invalidate(label);
 }
 
+/**
+ * Invalidate a label before its text is changed.
+ * With cells only the changed letters are invalidated, by `lv_label_refr_cells`.
+ * @param label pointer to a label object
+ */
+static void lv_label_invalidate_txt(lv_obj_t * label)
+{
+#if LV_LABEL_CELLS
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(ext->cell_cnt != 0) return;
+#endif
+
+    lv_obj_invalidate(label);
+}
+
+#if LV_LABEL_CELLS
+/**
+ * Keep the size of a label with cells and invalidate the letters which changed since the last refresh
+ * @param label pointer to a label object with cells
+ */
+static void lv_label_refr_cells(lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+
+    lv_coord_t w = ext->cell_cnt * ext->cell_w;
+    w += lv_obj_get_style_pad_left(label, LV_LABEL_PART_MAIN) + lv_obj_get_style_pad_right(label, LV_LABEL_PART_MAIN);
+    lv_coord_t h = lv_font_get_line_height(font);
+    h += lv_obj_get_style_pad_top(label, LV_LABEL_PART_MAIN) + lv_obj_get_style_pad_bottom(label, LV_LABEL_PART_MAIN);
+    bool resize = lv_obj_get_width(label) != w || lv_obj_get_height(label) != h;
+
+    /*The old letters are needed only if the label keeps its size*/
+    if(resize == false) invalidate_cells(label, ext->cell_txt ? ext->cell_txt : "", ext->text);
+
+    size_t len = strlen(ext->text) + 1;
+    char * cell_txt = lv_mem_realloc(ext->cell_txt, len);
+    LV_ASSERT_MEM(cell_txt);
+    if(cell_txt) _lv_memcpy(cell_txt, ext->text, len);
+    ext->cell_txt = cell_txt;
+
+    /*Invalidates the old and the new area*/
+    if(resize) lv_obj_set_size(label, w, h);
+}
+
+/**
+ * Invalidate the letters which are different or at an other place in two texts written into cells
+ * @param label pointer to a label object with cells
+ * @param old_txt the text written into the cells
+ * @param new_txt the new text
+ */
+static void invalidate_cells(lv_obj_t * label, const char * old_txt, const char * new_txt)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t ofs_x;
+
+    /*Walk the letters of both texts from left to right*/
+    uint32_t old_i = 0;
+    uint32_t new_i = 0;
+    lv_coord_t old_x = get_cells_x(label, old_txt);
+    lv_coord_t new_x = get_cells_x(label, new_txt);
+    uint32_t old_letter = old_txt[0] != '\0' ? _lv_txt_encoded_next(old_txt, &old_i) : 0;
+    uint32_t new_letter = new_txt[0] != '\0' ? _lv_txt_encoded_next(new_txt, &new_i) : 0;
+    while(old_letter != 0 || new_letter != 0) {
+        bool old_next = false;
+        bool new_next = false;
+        if(old_letter == new_letter && old_x == new_x) {
+            old_next = true;
+            new_next = true;
+        }
+        else if(new_letter != 0 && (old_letter == 0 || new_x <= old_x)) {
+            invalidate_cell(label, new_letter, new_x, ext->cell_w);
+            new_next = true;
+        }
+        else {
+            invalidate_cell(label, old_letter, old_x, ext->cell_w);
+            old_next = true;
+        }
+
+        if(old_next) {
+            old_x += _lv_txt_get_cell(font, old_letter, ext->cell_w, &ofs_x);
+            old_letter = old_txt[old_i] != '\0' ? _lv_txt_encoded_next(old_txt, &old_i) : 0;
+        }
+        if(new_next) {
+            new_x += _lv_txt_get_cell(font, new_letter, ext->cell_w, &ofs_x);
+            new_letter = new_txt[new_i] != '\0' ? _lv_txt_encoded_next(new_txt, &new_i) : 0;
+        }
+    }
+}
+
+/**
+ * Invalidate the cell of a letter and the part of the glyph which is out of the cell
+ * @param label pointer to a label object with cells
+ * @param letter the letter in the cell
+ * @param x position of the cell relative to the text area of the label
+ * @param cell_w width of the digit cells
+ */
+static void invalidate_cell(lv_obj_t * label, uint32_t letter, lv_coord_t x, lv_coord_t cell_w)
+{
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t ofs_x;
+    lv_coord_t w = _lv_txt_get_cell(font, letter, cell_w, &ofs_x);
+
+    lv_area_t area;
+    get_txt_coords(label, &area);
+    area.x1 += x;
+    area.x2 = area.x1 + w - 1;
+
+    lv_font_glyph_dsc_t g;
+    if(lv_font_get_glyph_dsc(font, &g, letter, '\0') && g.box_w != 0) {
+        lv_coord_t box_w = font->subpx ? (g.box_w + 2) / 3 : g.box_w;
+        lv_coord_t box_x1 = area.x1 + ofs_x + g.ofs_x;
+        area.x2 = LV_MATH_MAX(area.x2, box_x1 + box_w - 1);
+        area.x1 = LV_MATH_MIN(area.x1, box_x1);
+    }
+
+    lv_obj_invalidate_area(label, &area);
+}
+
+/**
+ * Get where the first letter of a text written into the cells of a label starts
+ * @param label pointer to a label object with cells
+ * @param txt the text
+ * @return x coordinate relative to the text area of the label, like `draw_label_cells` aligns the text
+ */
+static lv_coord_t get_cells_x(const lv_obj_t * label, const char * txt)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_label_align_t align = lv_label_get_align(label);
+    if(align != LV_LABEL_ALIGN_CENTER && align != LV_LABEL_ALIGN_RIGHT) return 0;
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t w = ext->cell_cnt * ext->cell_w - _lv_txt_get_cells_width(txt, font, ext->cell_w);
+    return align == LV_LABEL_ALIGN_CENTER ? w / 2 : w;
+}
+#endif
+
 static void lv_label_revert_dots(lv_obj_t * label)
 {
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
@@ -89,6 +89,16 @@ typedef struct {
     uint32_t sel_end;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE_LEN
+    lv_txt_layout_t * layout; /*Layout of the text calculated by `lv_label_refr_text` or NULL*/
+#endif
+
+#if LV_LABEL_CELLS
+    char * cell_txt;    /*Copy of the text written into the cells to find the changed letters*/
+    lv_coord_t cell_w;  /*Width of a digit cell*/
+    uint8_t cell_cnt;   /*Width of the label in cells, 0: cells are not used*/
+#endif
+
     lv_label_long_mode_t long_mode : 3; /*Determinate what to do with the long texts*/
     uint8_t static_txt : 1;             /*Flag to indicate the text is static*/
     uint8_t align : 2;                  /*Align type from 'lv_label_align_t'*/
@@ -187,6 +197,17 @@ void lv_label_set_text_sel_start(lv_obj_t * label, uint32_t index);
  */
 void lv_label_set_text_sel_end(lv_obj_t * label, uint32_t index);
 
+/**
+ * Write the text into cells: the digits are centered in cells of the same width (tabular digits),
+ * the other letters keep their own width. The size of the label is fixed to `cell_cnt` cells and a line,
+ * so it doesn't change with the text and only the letters which differ are redrawn when a new text is set.
+ * The text is written in one line without kerning, letter space, recoloring, selection and decoration.
+ * @param label pointer to a label object
+ * @param cell_cnt width of the label in cells. 0: don't use cells.
+ * @param cell_w width of a cell, e.g. the width of the widest digit of the font
+ */
+void lv_label_set_cells(lv_obj_t * label, uint8_t cell_cnt, lv_coord_t cell_w);
+
 /*=====================
  * Getter functions
  *====================*/
@@ -266,6 +287,20 @@ uint32_t lv_label_get_text_sel_start(const lv_obj_t * label);
  */
 uint32_t lv_label_get_text_sel_end(const lv_obj_t * label);
 
+/**
+ * Get the width of a label in cells
+ * @param label pointer to a label object
+ * @return width of the label in cells, 0: cells are not used
+ */
+uint8_t lv_label_get_cell_cnt(const lv_obj_t * label);
+
+/**
+ * Get the width of the cells of a label
+ * @param label pointer to a label object
+ * @return width of a cell
+ */
+lv_coord_t lv_label_get_cell_width(const lv_obj_t * label);
+
 
 lv_style_list_t * lv_label_get_style(lv_obj_t * label, uint8_t type);
 
@@ -10,7 +10,7 @@ base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUI
 optimization = '"-O3 -g0"'
 
 
-def build(name, defines):
+def build(name, defines, make_args = ""):
   global base_defines, optimization
 
   print("=============================")
@@ -23,7 +23,7 @@ def build(name, defines):
     d_all += " -D" + d + "=" + str(defines[d])
   
   d_all += '"'
-  cmd = "make -j8 BIN=test.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+  cmd = "make -j8 BIN=test.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization + " " + make_args
   
   print("---------------------------")
   print("Clean")
@@ -93,6 +93,7 @@ minimal_monochrome = {
   "LV_FONT_MONTSERRAT_12_SUBPX":0,
   "LV_FONT_MONTSERRAT_28_COMPRESSED":0,
   "LV_FONT_UNSCII_8":1,
+  "LV_FONT_FMT_TXT_CACHE_SIZE":0,
   "LV_USE_BIDI": 0,
   "LV_USE_OBJ_REALIGN": 0,
   "LV_USE_ARC":0,
@@ -133,6 +134,8 @@ minimal_monochrome = {
 all_obj_minimal_features = {
   "LV_DPI":60,
   "LV_MEM_SIZE":12*1024,
+  "LV_MEM_SLAB":1,
+  "LV_MEM_ADD_JUNK":1,
   "LV_HOR_RES_MAX":320,
   "LV_VER_RES_MAX":240,
   "LV_COLOR_DEPTH":8,
@@ -209,6 +212,8 @@ all_obj_minimal_features = {
 all_obj_all_features = {
   "LV_DPI":100,
   "LV_MEM_SIZE":32*1024,
+  "LV_MEM_TRACE":1,
+  "LV_MEM_TRACE_CB":"lv_test_mem_trace_cb",
   "LV_HOR_RES_MAX":480,
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
@@ -265,6 +270,8 @@ all_obj_all_features = {
   "LV_USE_IMGBTN":1,
   "LV_USE_KEYBOARD":1,
   "LV_USE_LABEL":1,
+  "LV_LABEL_LAYOUT_CACHE_LEN":64,
+  "LV_LABEL_CELLS":1,
   "LV_USE_LED":1,
   "LV_USE_LINE":1,
   "LV_USE_LIST":1,
@@ -337,6 +344,8 @@ advanced_features = {
   "LV_USE_OBJ_REALIGN": 1,
   "LV_FONT_FMT_TXT_LARGE":1,
   "LV_FONT_SUBPX_BGR":1,
+  "LV_FONT_FMT_TXT_ALIGNED_READ":1,
+  "LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE":512,
   "LV_USE_BIDI": 1,
   "LV_USE_OBJ_REALIGN": 1,
   "LV_USE_EXT_CLICK_AREA":"LV_EXT_CLICK_AREA_FULL",
@@ -376,9 +385,79 @@ advanced_features = {
 }
 
 
+# Same settings as the firmware's lv_conf.h. The rendered scenes are compared
+# with the reference images in lv_test_ref_imgs (LV_TEST_REF_UPDATE=1 regenerates them)
+firmware_golden = {
+  "LV_TEST_DRAW":1,
+  "LV_DPI":130,
+  "LV_MEM_SIZE":32*1024,
+  "LV_HOR_RES_MAX":240,
+  "LV_VER_RES_MAX":240,
+  "LV_COLOR_DEPTH":16,
+  "LV_COLOR_16_SWAP":0,
+  "LV_ANTIALIAS":1,
+  "LV_USE_ANIMATION":1,
+  "LV_USE_SHADOW":1,
+  "LV_USE_BLEND_MODES":1,
+  "LV_USE_OPA_SCALE":1,
+  "LV_USE_IMG_TRANSFORM":1,
+  "LV_USE_GROUP":1,
+  "LV_USE_GPU":1,
+  "LV_USE_FILESYSTEM":1,
+  "LV_USE_USER_DATA":0,
+  "LV_USE_LOG":0,
+  "LV_USE_THEME_MATERIAL":1,
+  "LV_THEME_DEFAULT_INIT": "\\\"lv_theme_material_init\\\"",
+  "LV_THEME_DEFAULT_COLOR_PRIMARY":      "\\\"LV_COLOR_RED\\\"",
+  "LV_THEME_DEFAULT_COLOR_SECONDARY":    "\\\"LV_COLOR_BLUE\\\"",
+  "LV_THEME_DEFAULT_FLAG"         :     "\\\"LV_THEME_MATERIAL_FLAG_LIGHT\\\"",
+  "LV_THEME_DEFAULT_FONT_SMALL"    :     "\\\"&tencent_w7_16\\\"",
+  "LV_THEME_DEFAULT_FONT_NORMAL"   :     "\\\"&tencent_w7_16\\\"",
+  "LV_THEME_DEFAULT_FONT_SUBTITLE" :     "\\\"&tencent_w7_16\\\"",
+  "LV_THEME_DEFAULT_FONT_TITLE"    :     "\\\"&tencent_w7_16\\\"",
+  "LV_USE_DEBUG":0,
+  "LV_USE_ASSERT_NULL":0,
+  "LV_USE_ASSERT_MEM":0,
+  "LV_USE_ASSERT_STR":0,
+  "LV_USE_ASSERT_OBJ":0,
+  "LV_USE_ASSERT_STYLE":0,
+  "LV_FONT_MONTSERRAT_12":0,
+  "LV_FONT_MONTSERRAT_16":0,
+  "LV_FONT_MONTSERRAT_22":0,
+  "LV_FONT_MONTSERRAT_28":0,
+  "LV_FONT_MONTSERRAT_12_SUBPX":0,
+  "LV_FONT_MONTSERRAT_28_COMPRESSED":1,
+  "LV_FONT_UNSCII_8":1,
+  "TENCENT_W7_16":1,
+  "TENCENT_W7_22":1,
+  "TENCENT_W7_24":1,
+  "ICONFONT_SYMBOL":1,
+  "LV_FONT_FMT_TXT_ALIGNED_READ":1,
+  "LV_FONT_FMT_TXT_CACHE_SIZE":16,
+  "LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE":1024,
+  "LV_USE_BIDI": 0,
+  "LV_USE_OBJ_REALIGN": 1,
+  "LV_USE_EXT_CLICK_AREA":"LV_EXT_CLICK_AREA_TINY",
+  "LV_USE_ARC":1,
+  "LV_USE_BAR":1,
+  "LV_USE_BTN":1,
+  "LV_USE_CHART":1,
+  "LV_USE_CONT":1,
+  "LV_USE_IMG":1,
+  "LV_USE_LABEL":1,
+  "LV_LABEL_LAYOUT_CACHE_LEN":32,
+  "LV_LABEL_CELLS":1,
+  "LV_USE_LINE":1,
+  "LV_USE_SPINNER":1,
+  "LV_MEM_TLSF":1,
+  "LV_MEM_SLAB":1,
+}
+
+
 build("Minimal monochrome", minimal_monochrome)
 build("All objects, minimal features", all_obj_minimal_features)
 build("All objects, all features", all_obj_all_features)
+build("Firmware, reference images", firmware_golden, "APP_DIR=" + os.path.abspath("../../../../src"))
   
 
 
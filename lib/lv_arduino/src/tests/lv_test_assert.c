@@ -28,7 +28,10 @@
 /*********************
  *      DEFINES
  *********************/
-#define REF_IMGS_PATH "lvgl/tests/lv_test_ref_imgs/"
+#define REF_IMGS_PATH "lv_test_ref_imgs/"
+
+/*Set this environment variable to (re)generate the reference images instead of comparing them*/
+#define REF_IMGS_UPDATE_ENV "LV_TEST_REF_UPDATE"
 
 /**********************
  *      TYPEDEFS
@@ -48,8 +51,9 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void read_png_file(png_img_t * p, const char* file_name);
-//static void write_png_file(png_img_t * p, const char* file_name);
+static void write_png_file(png_img_t * p, const char* file_name);
 static void png_release(png_img_t * p);
+static void screen_to_png(png_img_t * p);
 //static void process_file(png_img_t * p);
 
 /**********************
@@ -197,6 +201,75 @@ void lv_test_assert_img_eq(const char * fn_ref, const char * s)
     }
 }
 
+/**
+ * Compare the whole screen with a reference image allowing a small difference per color channel.
+ * If the `LV_TEST_REF_UPDATE` environment variable is set the reference image is written instead.
+ * On failure the actual screen is saved next to the reference with `.fail.png` suffix.
+ * @param fn_ref file name of the reference image in `REF_IMGS_PATH`
+ * @param tolerance max. allowed difference of the R, G and B channels (0..255)
+ * @param s description of the test
+ */
+void lv_test_assert_img_similar(const char * fn_ref, uint8_t tolerance, const char * s)
+{
+    char fn_ref_full[512];
+    sprintf(fn_ref_full, "%s%s", REF_IMGS_PATH, fn_ref);
+
+    /*Redraw the whole screen so the draw buffer holds the full frame*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+
+    png_img_t p_act;
+    screen_to_png(&p_act);
+
+    if(getenv(REF_IMGS_UPDATE_ENV)) {
+        write_png_file(&p_act, fn_ref_full);
+        png_release(&p_act);
+        lv_test_print("   UPDATE: %s. (Written: %s)", s, fn_ref);
+        return;
+    }
+
+    png_img_t p;
+    read_png_file(&p, fn_ref_full);
+
+    if(p.width != p_act.width || p.height != p_act.height ||
+       p.color_type != PNG_COLOR_TYPE_RGB || p.bit_depth != 8) {
+        lv_test_error("   FAIL: %s. (Reference image %s has different format)", s, fn_ref);
+    }
+
+    uint32_t diff_cnt = 0;
+    int diff_max = 0;
+    int x, y, c;
+    for(y = 0; y < p.height; y++) {
+        png_byte * row_ref = p.row_pointers[y];
+        png_byte * row_act = p_act.row_pointers[y];
+        for(x = 0; x < p.width * 3; x += 3) {
+            int px_diff = 0;
+            for(c = 0; c < 3; c++) {
+                int d = abs((int)row_ref[x + c] - (int)row_act[x + c]);
+                if(d > px_diff) px_diff = d;
+            }
+            if(px_diff > tolerance) diff_cnt++;
+            if(px_diff > diff_max) diff_max = px_diff;
+        }
+    }
+
+    if(diff_cnt) {
+        char fn_fail[sizeof(fn_ref_full) + 16];
+        sprintf(fn_fail, "%s.fail.png", fn_ref_full);
+        write_png_file(&p_act, fn_fail);
+    }
+
+    png_release(&p);
+    png_release(&p_act);
+
+    if(diff_cnt) {
+        lv_test_error("   FAIL: %s. (Expected: %s, %d px differ, max. difference: %d)", s, fn_ref, diff_cnt, diff_max);
+    } else {
+        lv_test_print("   PASS: %s. (Expected: %s, max. difference: %d)", s, fn_ref, diff_max);
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -254,59 +327,81 @@ static void read_png_file(png_img_t * p, const char* file_name)
 
     fclose(fp);
 }
-//
-//
-//static void write_png_file(png_img_t * p, const char* file_name)
-//{
-//    /* create file */
-//    FILE *fp = fopen(file_name, "wb");
-//    if (!fp)
-//        lv_test_exit("[write_png_file] File %s could not be opened for writing", file_name);
-//
-//
-//    /* initialize stuff */
-//    p->png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-//
-//    if (!p->png_ptr)
-//        lv_test_exit("[write_png_file] png_create_write_struct failed");
-//
-//    p->info_ptr = png_create_info_struct(p->png_ptr);
-//    if (!p->info_ptr)
-//        lv_test_exit("[write_png_file] png_create_info_struct failed");
-//
-//    if (setjmp(png_jmpbuf(p->png_ptr)))
-//        lv_test_exit("[write_png_file] Error during init_io");
-//
-//    png_init_io(p->png_ptr, fp);
-//
-//
-//    /* write header */
-//    if (setjmp(png_jmpbuf(p->png_ptr)))
-//        lv_test_exit("[write_png_file] Error during writing header");
-//
-//    png_set_IHDR(p->png_ptr, p->info_ptr, p->width, p->height,
-//            p->bit_depth, p->color_type, PNG_INTERLACE_NONE,
-//            PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
-//
-//    png_write_info(p->png_ptr, p->info_ptr);
-//
-//
-//    /* write bytes */
-//    if (setjmp(png_jmpbuf(p->png_ptr)))
-//        lv_test_exit("[write_png_file] Error during writing bytes");
-//
-//    png_write_image(p->png_ptr, p->row_pointers);
-//
-//
-//    /* end write */
-//    if (setjmp(png_jmpbuf(p->png_ptr)))
-//        lv_test_exit("[write_png_file] Error during end of write");
-//
-//    png_write_end(p->png_ptr, NULL);
-//
-//    fclose(fp);
-//}
-//
+static void write_png_file(png_img_t * p, const char* file_name)
+{
+    /* create file */
+    FILE *fp = fopen(file_name, "wb");
+    if (!fp)
+        lv_test_exit("[write_png_file] File %s could not be opened for writing", file_name);
+
+
+    /* initialize stuff */
+    p->png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+
+    if (!p->png_ptr)
+        lv_test_exit("[write_png_file] png_create_write_struct failed");
+
+    p->info_ptr = png_create_info_struct(p->png_ptr);
+    if (!p->info_ptr)
+        lv_test_exit("[write_png_file] png_create_info_struct failed");
+
+    if (setjmp(png_jmpbuf(p->png_ptr)))
+        lv_test_exit("[write_png_file] Error during init_io");
+
+    png_init_io(p->png_ptr, fp);
+
+
+    /* write header */
+    if (setjmp(png_jmpbuf(p->png_ptr)))
+        lv_test_exit("[write_png_file] Error during writing header");
+
+    png_set_IHDR(p->png_ptr, p->info_ptr, p->width, p->height,
+            p->bit_depth, p->color_type, PNG_INTERLACE_NONE,
+            PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+
+    png_write_info(p->png_ptr, p->info_ptr);
+
+
+    /* write bytes */
+    if (setjmp(png_jmpbuf(p->png_ptr)))
+        lv_test_exit("[write_png_file] Error during writing bytes");
+
+    png_write_image(p->png_ptr, p->row_pointers);
+
+
+    /* end write */
+    if (setjmp(png_jmpbuf(p->png_ptr)))
+        lv_test_exit("[write_png_file] Error during end of write");
+
+    png_write_end(p->png_ptr, NULL);
+
+    fclose(fp);
+}
+
+static void screen_to_png(png_img_t * p)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_color_t * screen_buf = disp->driver.buffer->buf1;
+
+    p->width = lv_disp_get_hor_res(disp);
+    p->height = lv_disp_get_ver_res(disp);
+    p->color_type = PNG_COLOR_TYPE_RGB;
+    p->bit_depth = 8;
+    p->row_pointers = (png_bytep*) malloc(sizeof(png_bytep) * p->height);
+
+    int x, y;
+    for (y=0; y<p->height; y++) {
+        p->row_pointers[y] = (png_byte*) malloc(p->width * 3);
+        for (x=0; x<p->width; x++) {
+            lv_color32_t c;
+            c.full = lv_color_to32(screen_buf[y * p->width + x]);
+            p->row_pointers[y][x * 3] = c.ch.red;
+            p->row_pointers[y][x * 3 + 1] = c.ch.green;
+            p->row_pointers[y][x * 3 + 2] = c.ch.blue;
+        }
+    }
+}
+
 static void png_release(png_img_t * p)
 {
     int y;
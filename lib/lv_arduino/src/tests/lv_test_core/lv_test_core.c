@@ -12,6 +12,7 @@
 #include "lv_test_core.h"
 #include "lv_test_obj.h"
 #include "lv_test_style.h"
+#include "lv_test_mem.h"
 
 /*********************
  *      DEFINES
@@ -46,6 +47,7 @@ void lv_test_core(void)
 
     lv_test_obj();
     lv_test_style();
+    lv_test_mem();
 }
 
 
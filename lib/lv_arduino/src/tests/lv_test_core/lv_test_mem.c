@@ -0,0 +1,445 @@
+/**
+ * @file lv_test_mem.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_mem.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BLOCK_CNT   64
+#define BLOCK_SIZE(i)   (1 + ((i) * 37) % (LV_MEM_SIZE / 128))   /*Up to a 1/4 of the work memory in total*/
+
+/*The warnings of lv_mem can be counted*/
+#define TEST_LOG_WARN   (LV_USE_LOG && LV_LOG_PRINTF == 0 && LV_LOG_LEVEL <= LV_LOG_LEVEL_WARN)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_MEM_TRACE
+typedef struct {
+    void * old_p;
+    void * new_p;
+    size_t size;
+    void * caller;
+} trace_event_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void alloc_free_join(void);
+static void realloc_keep(void);
+static void free_twice(void);
+static void fill(void);
+static void slab_pools(void);
+static void reclaim(void);
+static bool reclaim_cb(void);
+static void trace(void);
+#if TEST_LOG_WARN
+static void log_cb(lv_log_level_t level, const char * file, uint32_t line, const char * func, const char * dsc);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t * blocks[BLOCK_CNT];
+#if TEST_LOG_WARN
+static uint32_t warn_cnt;
+#endif
+#if LV_MEM_CUSTOM == 0
+static uint8_t * reclaim_block;
+static uint32_t reclaim_cnt;
+#endif
+#if LV_MEM_TRACE
+static bool trace_on;
+static uint32_t trace_cnt;
+static trace_event_t trace_last;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_mem(void)
+{
+    lv_test_print("");
+    lv_test_print("==================");
+    lv_test_print("Start lv_mem tests");
+    lv_test_print("==================");
+
+#if TEST_LOG_WARN
+    lv_log_register_print_cb(log_cb);
+#endif
+
+#if LV_MEM_CUSTOM == 0
+    alloc_free_join();
+    realloc_keep();
+    free_twice();
+    fill();
+    slab_pools();
+    reclaim();
+#endif
+    trace();
+
+#if TEST_LOG_WARN
+    lv_log_register_print_cb(NULL);
+#endif
+}
+
+#if LV_MEM_TRACE
+void lv_test_mem_trace_cb(void * old_p, void * new_p, size_t size, void * caller)
+{
+    if(trace_on == false) return;
+
+    trace_cnt++;
+    trace_last.old_p = old_p;
+    trace_last.new_p = new_p;
+    trace_last.size = size;
+    trace_last.caller = caller;
+}
+#endif
+
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_MEM_CUSTOM == 0
+
+static void alloc_free_join(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocate and free blocks of different sizes:");
+    lv_test_print("--------------------------------------------");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint32_t i;
+    for(i = 0; i < BLOCK_CNT; i++) {
+        uint32_t size = BLOCK_SIZE(i);
+        blocks[i] = lv_mem_alloc(size);
+        lv_test_assert_int_eq(1, blocks[i] != NULL, "Allocate a block");
+        _lv_memset(blocks[i], i, size);
+        lv_test_assert_int_gt(size - 1, _lv_mem_get_size(blocks[i]), "Size of the block");
+    }
+
+    lv_test_print("Free every second block and allocate smaller ones into the gaps");
+    for(i = 0; i < BLOCK_CNT; i += 2) {
+        lv_mem_free(blocks[i]);
+    }
+    for(i = 0; i < BLOCK_CNT; i += 2) {
+        blocks[i] = lv_mem_alloc(1 + i % 13);
+        lv_test_assert_int_eq(1, blocks[i] != NULL, "Allocate a small block");
+    }
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    for(i = 1; i < BLOCK_CNT; i += 2) {
+        uint32_t size = BLOCK_SIZE(i);
+        lv_test_assert_int_eq(i & 0xFF, blocks[i][size - 1], "Content of the kept blocks");
+    }
+
+    lv_test_print("Free all the blocks in mixed order");
+    for(i = 0; i < BLOCK_CNT; i++) {
+        lv_mem_free(blocks[(i * 7) % BLOCK_CNT]);
+    }
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing all");
+    lv_test_assert_int_eq(mon_start.free_biggest_size, mon_end.free_biggest_size, "The freed blocks are joined");
+    lv_test_assert_int_eq(mon_start.free_cnt, mon_end.free_cnt, "Free block count after freeing all");
+}
+
+static void realloc_keep(void)
+{
+    lv_test_print("");
+    lv_test_print("Reallocate blocks:");
+    lv_test_print("------------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint8_t * a = lv_mem_alloc(100);
+    uint8_t * b = lv_mem_alloc(20);
+    uint32_t i;
+    for(i = 0; i < 100; i++) a[i] = i;
+
+    lv_test_print("Shrink in place");
+    uint8_t * a2 = lv_mem_realloc(a, 40);
+    lv_test_assert_ptr_eq(a, a2, "Shrunk block in place");
+    lv_test_assert_int_eq(39, a2[39], "Content after shrinking");
+
+    lv_test_print("Grow over the next block");
+    a2 = lv_mem_realloc(a2, 300);
+    lv_test_assert_int_eq(1, a2 != NULL, "Grown block");
+    for(i = 0; i < 40; i++) {
+        if(a2[i] != i) break;
+    }
+    lv_test_assert_int_eq(40, i, "Content after growing");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_mem_free(a2);
+    lv_mem_free(b);
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing all");
+}
+
+static void free_twice(void)
+{
+    lv_test_print("");
+    lv_test_print("Free a block twice:");
+    lv_test_print("-------------------");
+
+    /*Bigger than the blocks of the pools, between used blocks so it isn't joined*/
+    uint8_t * a = lv_mem_alloc(200);
+    uint8_t * b = lv_mem_alloc(200);
+    uint8_t * c = lv_mem_alloc(200);
+    lv_test_assert_int_eq(1, a != NULL && b != NULL && c != NULL, "Allocate the blocks");
+
+    lv_mem_free(b);
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+#if TEST_LOG_WARN
+    uint32_t warn_start = warn_cnt;
+#endif
+
+    lv_mem_free(b);
+#if TEST_LOG_WARN
+    lv_test_assert_int_eq(warn_start + 1, warn_cnt, "The second free is reported");
+#endif
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after the second free");
+    lv_test_assert_int_eq(mon_start.free_cnt, mon_end.free_cnt, "Free block count after the second free");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_mem_free(a);
+    lv_mem_free(c);
+}
+
+static void fill(void)
+{
+    lv_test_print("");
+    lv_test_print("Fill the work memory:");
+    lv_test_print("---------------------");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint32_t cnt = 0;
+    while(cnt < BLOCK_CNT) {
+        blocks[cnt] = lv_mem_alloc(mon_start.total_size / (BLOCK_CNT / 2));
+        if(blocks[cnt] == NULL) break;
+        cnt++;
+    }
+    lv_test_assert_int_lt(BLOCK_CNT, cnt, "Allocation fails when the memory is full");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    /*The memory was never fuller, so the peak is the size in use now. It's less than the part which isn't free
+     *because the entries have headers too (at least 4 bytes).*/
+    lv_mem_monitor_t mon_full;
+    lv_mem_monitor(&mon_full);
+    lv_test_assert_int_gt(cnt * (mon_start.total_size / (BLOCK_CNT / 2)) - 1, mon_full.max_used,
+                          "The peak counts the blocks in use");
+    lv_test_assert_int_lt(mon_full.total_size - mon_full.free_size - mon_full.slab_free_size - cnt * 4 + 1,
+                          mon_full.max_used, "The peak is a size in use, not an address");
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) lv_mem_free(blocks[i]);
+
+    lv_test_print("Allocate the biggest free block");
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_biggest_size, mon_end.free_biggest_size, "The freed blocks are joined");
+    void * big = lv_mem_alloc(mon_end.free_biggest_size - 8);
+    lv_test_assert_int_eq(1, big != NULL, "Allocate almost all the biggest block");
+    lv_mem_free(big);
+}
+
+static void slab_pools(void)
+{
+#if LV_MEM_SLAB
+    lv_test_print("");
+    lv_test_print("Pools of fixed size blocks:");
+    lv_test_print("---------------------------");
+
+    lv_test_assert_int_gt(0, lv_mem_slab_get_class_cnt(), "There are pools");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+    lv_mem_slab_stat_t stat_start;
+    lv_mem_slab_get_stat(0, &stat_start);
+    uint32_t size = stat_start.size;
+    uint32_t free_cnt = stat_start.cnt - stat_start.used_cnt;
+
+    lv_test_print("Fill the first pool and allocate one more block from the heap");
+    uint32_t i;
+    for(i = 0; i < free_cnt + 1 && i < BLOCK_CNT; i++) {
+        blocks[i] = lv_mem_alloc(size);
+        lv_test_assert_int_eq(1, blocks[i] != NULL, "Allocate a block");
+        _lv_memset(blocks[i], i, size);
+    }
+    uint32_t cnt = i;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.slab_free_size - (cnt - 1) * size, mon.slab_free_size, "Free size of the pools");
+    lv_test_assert_int_gt(mon.free_size, mon_start.free_size, "The block from the heap");
+    lv_test_assert_int_gt(mon_start.used_pct + (100 * (cnt - 1) * size) / mon.total_size - 1, mon.used_pct,
+                          "The free blocks of the pools aren't counted as used");
+
+    lv_mem_slab_stat_t stat;
+    lv_mem_slab_get_stat(0, &stat);
+    lv_test_assert_int_eq(stat_start.alloc_cnt + cnt - 1, stat.alloc_cnt, "Allocations from the pool");
+    lv_test_assert_int_eq(stat.cnt, stat.used_cnt, "The pool is full");
+    lv_test_assert_int_eq(stat_start.miss_cnt + 1, stat.miss_cnt, "The last block is from the heap");
+    lv_test_assert_int_eq(size, _lv_mem_get_size(blocks[0]), "Size of a block of the pool");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_test_print("Reallocate the blocks of the pool");
+    uint8_t * p = lv_mem_realloc(blocks[0], size - 1);
+    lv_test_assert_ptr_eq(blocks[0], p, "Smaller size in place");
+    p = lv_mem_realloc(blocks[0], size * 4);
+    lv_test_assert_int_eq(1, p != NULL, "Grown block");
+    lv_test_assert_int_eq(0, p[size - 1], "Content after growing");
+    blocks[0] = p;
+    lv_mem_slab_get_stat(0, &stat);
+    lv_test_assert_int_eq(stat.cnt - 1, stat.used_cnt, "The grown block left the pool");
+
+    lv_test_print("Free the blocks twice");
+    for(i = 0; i < cnt; i++) lv_mem_free(blocks[i]);
+#if TEST_LOG_WARN
+    uint32_t warn_start = warn_cnt;
+#endif
+    lv_mem_free(blocks[1]);
+#if TEST_LOG_WARN
+    lv_test_assert_int_eq(warn_start + 1, warn_cnt, "The second free is reported");
+#endif
+    lv_mem_slab_get_stat(0, &stat);
+    lv_test_assert_int_eq(stat_start.used_cnt, stat.used_cnt, "The blocks are back in the pool");
+    lv_test_assert_int_eq(stat.cnt, stat.max_used_cnt, "Most blocks used");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing all");
+    lv_test_assert_int_eq(mon_start.slab_free_size, mon_end.slab_free_size, "Free size of the pools after freeing all");
+#endif
+}
+
+static void reclaim(void)
+{
+    lv_test_print("");
+    lv_test_print("Free a cache when the memory is full:");
+    lv_test_print("-------------------------------------");
+
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_add_reclaim_cb(reclaim_cb), "Register a reclaim function");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_add_reclaim_cb(reclaim_cb), "Register the same function again");
+
+    /*The cache takes the biggest free block, so a block of the same size fits only without it*/
+    lv_mem_defrag();
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t size = mon.free_biggest_size - 16;
+    reclaim_block = lv_mem_alloc(size);
+    lv_test_assert_int_eq(1, reclaim_block != NULL, "Block of the cache");
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_lt(size, mon.free_biggest_size, "No other free block is big enough");
+
+    reclaim_cnt = 0;
+    uint8_t * p = lv_mem_alloc(size);
+    lv_test_assert_int_eq(1, p != NULL, "Allocation after freeing the cache");
+    lv_test_assert_int_eq(1, reclaim_cnt, "The cache was asked once");
+    lv_test_assert_ptr_eq(NULL, reclaim_block, "The cache was freed");
+    lv_mem_free(p);
+
+    lv_test_print("An empty cache can't help");
+    reclaim_cnt = 0;
+    p = lv_mem_alloc(mon.total_size);
+    lv_test_assert_ptr_eq(NULL, p, "Too big allocation");
+    lv_test_assert_int_eq(1, reclaim_cnt, "The cache was asked once");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+}
+
+static bool reclaim_cb(void)
+{
+    reclaim_cnt++;
+    if(reclaim_block == NULL) return false;
+
+    lv_mem_free(reclaim_block);
+    reclaim_block = NULL;
+    return true;
+}
+
+#endif /*LV_MEM_CUSTOM == 0*/
+
+#if TEST_LOG_WARN
+static void log_cb(lv_log_level_t level, const char * file, uint32_t line, const char * func, const char * dsc)
+{
+    LV_UNUSED(file);
+    LV_UNUSED(line);
+    LV_UNUSED(func);
+    LV_UNUSED(dsc);
+    if(level == LV_LOG_LEVEL_WARN) warn_cnt++;
+}
+#endif
+
+static void trace(void)
+{
+#if LV_MEM_TRACE
+    lv_test_print("");
+    lv_test_print("Trace the allocations:");
+    lv_test_print("----------------------");
+
+    trace_on = true;
+    trace_cnt = 0;
+
+    uint8_t * p = lv_mem_alloc(10);
+    lv_test_assert_int_eq(1, trace_cnt, "Allocation reported");
+    lv_test_assert_ptr_eq(NULL, trace_last.old_p, "No old memory of an allocation");
+    lv_test_assert_ptr_eq(p, trace_last.new_p, "The allocated memory");
+    lv_test_assert_int_eq(10, trace_last.size, "The requested size");
+    lv_test_assert_int_eq(1, trace_last.caller != NULL, "The caller is known");
+
+    lv_test_print("A reallocation is one event");
+    uint8_t * p2 = lv_mem_realloc(p, 200);
+    lv_test_assert_int_eq(2, trace_cnt, "Reallocation reported once");
+    lv_test_assert_ptr_eq(p, trace_last.old_p, "The old memory");
+    lv_test_assert_ptr_eq(p2, trace_last.new_p, "The new memory");
+    lv_test_assert_int_eq(200, trace_last.size, "The new size");
+
+    lv_mem_free(p2);
+    lv_test_assert_int_eq(3, trace_cnt, "Free reported");
+    lv_test_assert_ptr_eq(p2, trace_last.old_p, "The freed memory");
+    lv_test_assert_ptr_eq(NULL, trace_last.new_p, "No new memory of a free");
+
+    lv_mem_free(NULL);
+    lv_test_assert_int_eq(3, trace_cnt, "Freeing NULL is not reported");
+
+    trace_on = false;
+#endif
+}
+
+#endif /*LV_BUILD_TEST*/
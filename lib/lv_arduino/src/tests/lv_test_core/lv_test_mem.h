@@ -0,0 +1,44 @@
+/**
+ * @file lv_test_mem.h
+ *
+ */
+
+#ifndef LV_TEST_MEM_H
+#define LV_TEST_MEM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+void lv_test_mem(void);
+
+#if LV_MEM_TRACE
+/*`LV_MEM_TRACE_CB` of the tests*/
+void lv_test_mem_trace_cb(void * old_p, void * new_p, size_t size, void * caller);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_TEST_MEM_H*/
@@ -465,7 +465,7 @@ static void mem_leak(void)
     lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
     lv_mem_defrag();
     lv_mem_monitor(&mon_end);
-    lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
+    lv_test_assert_int_lt(sizeof(void*) * 8, (mon_start.free_size + mon_start.slab_free_size) - (mon_end.free_size + mon_end.slab_free_size), "Style memory leak");
 
     lv_test_print("Use local style");
     lv_mem_monitor(&mon_start);
@@ -489,7 +489,7 @@ static void mem_leak(void)
     lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
     lv_mem_defrag();
     lv_mem_monitor(&mon_end);
-    lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
+    lv_test_assert_int_lt(sizeof(void*) * 8, (mon_start.free_size + mon_start.slab_free_size) - (mon_end.free_size + mon_end.slab_free_size), "Style memory leak");
 
 
     lv_test_print("Add styles");
@@ -517,7 +517,7 @@ static void mem_leak(void)
     lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
     lv_mem_defrag();
     lv_mem_monitor(&mon_end);
-    lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
+    lv_test_assert_int_lt(sizeof(void*) * 8, (mon_start.free_size + mon_start.slab_free_size) - (mon_end.free_size + mon_end.slab_free_size), "Style memory leak");
 
     lv_test_print("Add styles and use local style");
      lv_mem_monitor(&mon_start);
@@ -549,7 +549,7 @@ static void mem_leak(void)
      lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
      lv_mem_defrag();
      lv_mem_monitor(&mon_end);
-     lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
+     lv_test_assert_int_lt(sizeof(void*) * 8, (mon_start.free_size + mon_start.slab_free_size) - (mon_end.free_size + mon_end.slab_free_size), "Style memory leak");
 
 
 
@@ -632,6 +632,6 @@ static void mem_leak(void)
     lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
     lv_mem_defrag();
     lv_mem_monitor(&mon_end);
-    lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
+    lv_test_assert_int_lt(sizeof(void*) * 8, (mon_start.free_size + mon_start.slab_free_size) - (mon_end.free_size + mon_end.slab_free_size), "Style memory leak");
 }
 #endif
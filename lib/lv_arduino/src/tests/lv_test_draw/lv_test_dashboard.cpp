@@ -0,0 +1,138 @@
+/**
+ * @file lv_test_dashboard.cpp
+ * Render the firmware's monitor page (`src/Dashboard.cpp`) at varied values.
+ * Built only if `APP_DIR` is passed to the Makefile.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_dashboard.h"
+
+#if LV_BUILD_TEST && defined(LV_TEST_DRAW) && defined(LV_TEST_DASHBOARD)
+#include "Dashboard.h"
+#include "ChartScale.h"
+
+#include <stdio.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define IMG_TOLERANCE   8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void chart_scale(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const DashboardMetrics metrics[] = {
+    /*up,   down,     cpu,  mem,  temp, ip*/
+    {-12.5,  56.78,   3.2,  21.0, 31.0, "192.168.8.100"},
+    {-850.0, 5120.0,  47.5, 55.0, 68.0, "10.0.0.2"},
+    {-90.0,  20480.0, 99.9, 88.0, 79.0, "172.16.254.254"},
+    {0.0,    0.0,     0.0,  0.0,  0.0,  "0.0.0.0"},
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_dashboard(void)
+{
+    lv_test_print("");
+    lv_test_print("Dashboard:");
+    lv_test_print("----------");
+
+    dashboardCreate();
+    dashboardShowMonitor();
+
+    /*Called after every fetch: the shown page isn't invalidated again*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_refr_now(disp);
+    dashboardShowMonitor();
+    lv_test_assert_int_eq(0, disp->inv_p, "Areas invalidated by showing the shown page");
+
+    for(size_t i = 0; i < sizeof(metrics) / sizeof(metrics[0]); i++) {
+        /*Fill the chart history so the series have some shape*/
+        for(int p = 0; p < 10; p++) {
+            dashboardPushUpSpeed(metrics[i].up_speed * (p % 3) / 2);
+            dashboardPushDownSpeed(metrics[i].down_speed * ((p * 7) % 10) / 9);
+        }
+        dashboardUpdate(metrics[i]);
+
+        char fn[32];
+        snprintf(fn, sizeof(fn), "dashboard_%d.png", (int)i);
+        lv_test_assert_img_similar(fn, IMG_TOLERANCE, "Monitor page");
+    }
+
+    lv_obj_clean(lv_scr_act());
+
+    chart_scale();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void chart_scale(void)
+{
+    lv_test_print("Chart scale");
+
+    lv_test_assert_int_eq(1, chartScaleNiceCeil(0), "Nice number of 0");
+    lv_test_assert_int_eq(2, chartScaleNiceCeil(1.5), "Nice number of 1.5");
+    lv_test_assert_int_eq(5, chartScaleNiceCeil(3), "Nice number of 3");
+    lv_test_assert_int_eq(10, chartScaleNiceCeil(10), "Nice number of 10");
+    lv_test_assert_int_eq(200, chartScaleNiceCeil(101), "Nice number of 101");
+    lv_test_assert_int_eq(50000, chartScaleNiceCeil(20480), "Nice number of 20480");
+    lv_test_assert_int_eq(2000000000, chartScaleNiceCeil(1.5e9), "Nice number of 1.5e9");
+    lv_test_assert_int_eq(2000000000, chartScaleNiceCeil(3e9), "Nice number saturates");
+
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_chart_ext_t * ext = (lv_chart_ext_t *)lv_obj_get_ext_attr(chart);
+    ChartScale scale;
+    chartScaleInit(scale, chart, false);
+    lv_test_assert_int_eq(CHART_SCALE_MIN_TOP, ext->ymax, "Smallest range on init");
+
+    lv_test_assert_int_eq(true, chartScaleUpdate(scale, 3000), "Grow immediately");
+    lv_test_assert_int_eq(5000, ext->ymax, "Grow to a nice number");
+    lv_test_assert_int_eq(false, chartScaleUpdate(scale, 4000), "Keep the range if the data fits");
+
+    lv_test_assert_int_eq(false, chartScaleUpdate(scale, 100), "Don't shrink immediately");
+    lv_test_assert_int_eq(false, chartScaleUpdate(scale, 120), "Don't shrink during the hold time");
+    scale.shrink_start = lv_tick_get() - CHART_SCALE_HOLD_MS;
+    lv_test_assert_int_eq(true, chartScaleUpdate(scale, 120), "Shrink after the hold time");
+    lv_test_assert_int_eq(200, ext->ymax, "Shrink to the current data");
+
+    lv_test_assert_int_eq(false, chartScaleUpdate(scale, 10), "Restart the hold on shrinking");
+    lv_test_assert_int_eq(false, chartScaleUpdate(scale, 200), "Cancel shrinking if the data grows back");
+    scale.shrink_start = lv_tick_get() - CHART_SCALE_HOLD_MS;
+    lv_test_assert_int_eq(false, chartScaleUpdate(scale, 10), "The hold restarts after a cancel");
+    lv_test_assert_int_eq(3, scale.change_cnt, "Count the range changes");
+
+    /*G/s and K/s fit on the log scale: 1 GB/s is 6 decades*/
+    chartScaleInit(scale, chart, true);
+    lv_test_assert_int_eq(0, chartScaleMap(scale, 0), "Log scale of 0");
+    lv_test_assert_int_eq(200, chartScaleMap(scale, 99), "Log scale of 99");
+    lv_test_assert_int_eq(-200, chartScaleMap(scale, -99), "Log scale of a negative sample");
+    lv_coord_t g = chartScaleMap(scale, 1048576.0);
+    lv_test_assert_int_eq(602, g, "Log scale of 1 G/s");
+    chartScaleUpdate(scale, g);
+    lv_test_assert_int_eq(chartScaleMap(scale, 2000000), ext->ymax, "Log range of 1 G/s");
+
+    lv_obj_del(chart);
+}
+
+#endif
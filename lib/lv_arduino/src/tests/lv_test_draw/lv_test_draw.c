@@ -0,0 +1,1549 @@
+/**
+ * @file lv_test_draw.c
+ * Render a corpus of scenes and compare them with the reference images
+ * in `lv_test_ref_imgs`. Run with `LV_TEST_REF_UPDATE=1` to regenerate them.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_draw.h"
+#include "lv_test_dashboard.h"
+#include <stdlib.h>
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+#include "rgb565_blend.h"
+#define TEST_RGB565_BLEND   1
+#else
+#define TEST_RGB565_BLEND   0
+#endif
+
+#if LV_BUILD_TEST && defined(LV_TEST_DRAW)
+
+/*********************
+ *      DEFINES
+ *********************/
+/*About one step of a 5 bit color channel*/
+#define IMG_TOLERANCE   8
+
+#define LINE_CNT        24
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if TEST_RGB565_BLEND
+static void rgb565_kernels(void);
+#endif
+static void arcs(void);
+static void arc_invalidation(void);
+static uint32_t arc_inv_check(lv_obj_t * arc, uint16_t end, lv_color_t * prev, uint32_t * miss_cnt);
+static void mask_spans(void);
+static void mask_spans_check(const char * name, uint32_t * diff_cnt, uint32_t * edge_lines, uint32_t * all_lines);
+static void circle_cache(void);
+static uint32_t circle_cache_check(const lv_area_t * rect, lv_coord_t radius, bool outer);
+static void gradients(void);
+static void grad_cache(void);
+static void chart_scroll(void);
+static uint32_t chart_scroll_check(lv_obj_t * chart, lv_color_t * scrolled);
+static void chart_scroll_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static bool chart_scroll_cb(lv_obj_t * chart, const lv_area_t * area, lv_coord_t dx);
+static void chart_envelope(void);
+static void chart_polyline(void);
+static void lines(void);
+static void fonts(void);
+static void font_scene(const lv_font_t * font, const char * txt, const char * fn);
+#if LV_USE_FONT_ATLAS
+static void font_atlas(void);
+static void font_atlas_check(const lv_font_t * font, const char * letters, const char * txt);
+#endif
+#if LV_FONT_FMT_TXT_CACHE_SIZE && defined(TENCENT_W7_22)
+static void font_cache(void);
+#endif
+#if LV_LABEL_LAYOUT_CACHE_LEN
+static void label_layout(void);
+static void label_layout_check(const char * txt, lv_label_long_mode_t long_mode, lv_label_align_t align);
+#endif
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE && LV_FONT_MONTSERRAT_28_COMPRESSED
+static void glyph_cache(void);
+static void glyph_cache_check(const lv_font_t * font, const char * txt);
+#endif
+#if LV_LABEL_CELLS
+static void label_cells(void);
+static uint32_t label_cells_check(lv_obj_t * label, const char * txt, lv_color_t * prev, uint32_t * miss_cnt);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*The display for the chart scroll tests: a real frame buffer and what was written to it*/
+static lv_color_t * chart_fb;
+static uint32_t chart_flush_px;
+static uint32_t chart_scroll_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw(void)
+{
+    lv_test_print("");
+    lv_test_print("*******************");
+    lv_test_print("Start lv_draw tests");
+    lv_test_print("*******************");
+
+#if TEST_RGB565_BLEND
+    rgb565_kernels();
+#endif
+    arcs();
+    arc_invalidation();
+    mask_spans();
+    circle_cache();
+    gradients();
+    grad_cache();
+    chart_scroll();
+    chart_envelope();
+    chart_polyline();
+    lines();
+    fonts();
+#if LV_USE_FONT_ATLAS
+    font_atlas();
+#endif
+#if LV_FONT_FMT_TXT_CACHE_SIZE && defined(TENCENT_W7_22)
+    font_cache();
+#endif
+#if LV_LABEL_LAYOUT_CACHE_LEN
+    label_layout();
+#endif
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE && LV_FONT_MONTSERRAT_28_COMPRESSED
+    glyph_cache();
+#endif
+#if LV_LABEL_CELLS
+    label_cells();
+#endif
+
+#ifdef LV_TEST_DASHBOARD
+    lv_test_dashboard();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if TEST_RGB565_BLEND
+static void rgb565_kernels(void)
+{
+    lv_test_print("");
+    lv_test_print("RGB565 SWAR blending:");
+    lv_test_print("---------------------");
+
+    /*Every channel value pair at every opacity, compared with `lv_color_mix`*/
+    int32_t err_max = 0;
+    int32_t pair_diff = 0;
+    uint32_t opa;
+    for(opa = 0; opa <= 255; opa++) {
+        uint32_t a = rgb565_alpha(opa);
+        uint32_t f;
+        uint32_t b;
+        for(f = 0; f < 64; f++) {
+            for(b = 0; b < 64; b++) {
+                /*Green has 6 bits, red and blue only 5*/
+                lv_color_t fg = LV_COLOR_MAKE((f & 0x1F) << 3, f << 2, (f & 0x1F) << 3);
+                lv_color_t bg = LV_COLOR_MAKE((b & 0x1F) << 3, b << 2, (b & 0x1F) << 3);
+
+                lv_color_t ref = lv_color_mix(fg, bg, opa);
+                lv_color_t res;
+                res.full = rgb565_blend(fg.full, bg.full, a);
+
+                int32_t d;
+                d = LV_MATH_ABS((int32_t)res.ch.red - ref.ch.red);
+                err_max = LV_MATH_MAX(err_max, d);
+                d = LV_MATH_ABS((int32_t)res.ch.green - ref.ch.green);
+                err_max = LV_MATH_MAX(err_max, d);
+                d = LV_MATH_ABS((int32_t)res.ch.blue - ref.ch.blue);
+                err_max = LV_MATH_MAX(err_max, d);
+
+                /*The two-pixel kernel must give the same as two single pixels*/
+                uint32_t res2 = rgb565_blend2(fg.full | ((uint32_t)bg.full << 16), bg.full | ((uint32_t)fg.full << 16), a);
+                if((res2 & 0xFFFF) != res.full || (res2 >> 16) != rgb565_blend(bg.full, fg.full, a)) pair_diff++;
+            }
+        }
+    }
+
+    lv_test_assert_int_lt(2, err_max, "Max. difference from lv_color_mix in LSB");
+    lv_test_assert_int_eq(0, pair_diff, "Two-pixel and single-pixel results match");
+
+    lv_color_t fg = lv_color_hex(0x50ff7d);
+    lv_color_t bg = lv_color_hex(0x081418);
+    lv_test_assert_int_eq(fg.full, rgb565_blend(fg.full, bg.full, rgb565_alpha(LV_OPA_COVER)), "Opacity 255 keeps the foreground");
+    lv_test_assert_int_eq(bg.full, rgb565_blend(fg.full, bg.full, rgb565_alpha(LV_OPA_TRANSP)), "Opacity 0 keeps the background");
+}
+#endif
+
+static void arcs(void)
+{
+    lv_test_print("");
+    lv_test_print("Arcs at every 5 degrees:");
+    lv_test_print("------------------------");
+
+    /*Thick with round ending*/
+    lv_obj_t * arc_thick = lv_arc_create(lv_scr_act(), NULL);
+    lv_obj_set_size(arc_thick, 220, 220);
+    lv_obj_align(arc_thick, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_line_width(arc_thick, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, 20);
+    lv_obj_set_style_local_line_rounded(arc_thick, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, true);
+    lv_arc_set_bg_angles(arc_thick, 0, 360);
+    lv_arc_set_start_angle(arc_thick, 90);
+
+    /*Same as the temperature gauge of the dashboard*/
+    lv_obj_t * arc_gauge = lv_arc_create(lv_scr_act(), NULL);
+    lv_obj_set_size(arc_gauge, 125, 125);
+    lv_obj_align(arc_gauge, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_bg_opa(arc_gauge, LV_ARC_PART_BG, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_obj_set_style_local_border_opa(arc_gauge, LV_ARC_PART_BG, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_obj_set_style_local_line_width(arc_gauge, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, 5);
+    lv_obj_set_style_local_line_rounded(arc_gauge, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, false);
+    lv_obj_set_style_local_line_color(arc_gauge, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, lv_color_hex(0xff5d18));
+    lv_arc_set_bg_angles(arc_gauge, 0, 360);
+    lv_arc_set_start_angle(arc_gauge, 120);
+
+    /*Small and thin*/
+    lv_obj_t * arc_small = lv_arc_create(lv_scr_act(), NULL);
+    lv_obj_set_size(arc_small, 50, 50);
+    lv_obj_align(arc_small, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_bg_opa(arc_small, LV_ARC_PART_BG, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_obj_set_style_local_border_opa(arc_small, LV_ARC_PART_BG, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_obj_set_style_local_line_width(arc_small, LV_ARC_PART_BG, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_line_width(arc_small, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, 2);
+    lv_arc_set_bg_angles(arc_small, 0, 360);
+    lv_arc_set_start_angle(arc_small, 0);
+
+    uint16_t a;
+    char fn[32];
+    char desc[64];
+    for(a = 0; a < 360; a += 5) {
+        lv_arc_set_end_angle(arc_thick, 90 + a);
+        lv_arc_set_end_angle(arc_gauge, 120 + a);
+        lv_arc_set_end_angle(arc_small, a);
+
+        lv_snprintf(fn, sizeof(fn), "arc_%03d.png", a);
+        lv_snprintf(desc, sizeof(desc), "Arcs with %d degrees length", a);
+        lv_test_assert_img_similar(fn, IMG_TOLERANCE, desc);
+    }
+
+    lv_obj_clean(lv_scr_act());
+}
+
+static void arc_invalidation(void)
+{
+    lv_test_print("");
+    lv_test_print("Arc invalidation:");
+    lv_test_print("-----------------");
+
+    /*The temperature gauge of the dashboard*/
+    lv_obj_t * arc_gauge = lv_arc_create(lv_scr_act(), NULL);
+    lv_obj_set_size(arc_gauge, 125, 125);
+    lv_obj_align(arc_gauge, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_line_width(arc_gauge, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, 5);
+    lv_obj_set_style_local_pad_left(arc_gauge, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, 5);
+    lv_obj_set_style_local_line_rounded(arc_gauge, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, false);
+    lv_arc_set_bg_angles(arc_gauge, 0, 360);
+    lv_arc_set_start_angle(arc_gauge, 120);
+    lv_arc_set_end_angle(arc_gauge, 120);
+
+    lv_color_t * prev = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    uint32_t miss_cnt = 0;
+
+    /*Small steps, crossing the quarters and the start angle, growing and shrinking*/
+    static const uint16_t gauge_ends[] = {125, 127, 200, 215, 300, 302, 371, 420, 350, 130};
+    uint32_t i;
+    for(i = 0; i < sizeof(gauge_ends) / sizeof(gauge_ends[0]); i++) {
+        arc_inv_check(arc_gauge, gauge_ends[i], prev, &miss_cnt);
+    }
+
+    /*A move of 2 degrees has to be much cheaper than redrawing the gauge*/
+    uint32_t inv_px = arc_inv_check(arc_gauge, 132, prev, &miss_cnt);
+    lv_test_assert_int_lt(125 * 125 / 10, inv_px, "Pixels invalidated by a 2 degrees move");
+
+    /*Thick with round ending*/
+    lv_obj_t * arc_thick = lv_arc_create(lv_scr_act(), NULL);
+    lv_obj_set_size(arc_thick, 220, 220);
+    lv_obj_align(arc_thick, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_line_width(arc_thick, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, 20);
+    lv_obj_set_style_local_line_rounded(arc_thick, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, true);
+    lv_arc_set_bg_angles(arc_thick, 0, 360);
+    lv_arc_set_start_angle(arc_thick, 90);
+    lv_arc_set_end_angle(arc_thick, 90);
+
+    static const uint16_t thick_ends[] = {95, 179, 182, 270, 275, 400, 445, 300};
+    for(i = 0; i < sizeof(thick_ends) / sizeof(thick_ends[0]); i++) {
+        arc_inv_check(arc_thick, thick_ends[i], prev, &miss_cnt);
+    }
+
+    lv_test_assert_int_eq(0, miss_cnt, "Changed pixels outside of the invalidated areas");
+
+    free(prev);
+    lv_obj_clean(lv_scr_act());
+}
+
+/**
+ * Move the end of an arc and check that every pixel which changed was invalidated
+ * @param arc the arc to move
+ * @param end the new end angle
+ * @param prev a screen sized buffer for the previous frame
+ * @param miss_cnt increment with the changed pixels which are not in an invalidated area
+ * @return number of invalidated pixels
+ */
+static uint32_t arc_inv_check(lv_obj_t * arc, uint16_t end, lv_color_t * prev, uint32_t * miss_cnt)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_color_t * screen_buf = disp->driver.buffer->buf1;
+
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+    _lv_memcpy(prev, screen_buf, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_arc_set_end_angle(arc, end);
+
+    uint32_t inv_px = 0;
+    lv_area_t inv_areas[LV_INV_BUF_SIZE];
+    uint16_t inv_cnt = disp->inv_p;
+    uint16_t i;
+    for(i = 0; i < inv_cnt; i++) {
+        inv_areas[i] = disp->inv_areas[i];
+        inv_px += lv_area_get_size(&inv_areas[i]);
+    }
+
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < LV_VER_RES; y++) {
+        for(x = 0; x < LV_HOR_RES; x++) {
+            uint32_t p = (uint32_t)y * LV_HOR_RES + x;
+            if(prev[p].full == screen_buf[p].full) continue;
+
+            lv_point_t point = {x, y};
+            bool inv = false;
+            for(i = 0; i < inv_cnt && !inv; i++) {
+                inv = _lv_area_is_point_on(&inv_areas[i], &point, 0);
+            }
+            if(!inv) (*miss_cnt)++;
+        }
+    }
+
+    return inv_px;
+}
+
+static void mask_spans(void)
+{
+    lv_test_print("");
+    lv_test_print("Mask spans:");
+    lv_test_print("-----------");
+
+    uint32_t diff_cnt = 0;
+    uint32_t edge_lines = 0;
+    uint32_t all_lines = 0;
+
+    /*Rounded bar: background and indicator*/
+    lv_area_t bar_area = {20, 100, 219, 119};
+    lv_area_t indic_area = {24, 104, 150, 115};
+    lv_draw_mask_radius_param_t bar_p;
+    lv_draw_mask_radius_param_t indic_p;
+    lv_draw_mask_radius_init(&bar_p, &bar_area, LV_RADIUS_CIRCLE, false);
+    lv_draw_mask_radius_init(&indic_p, &indic_area, 4, false);
+    int16_t bar_id = lv_draw_mask_add(&bar_p, NULL);
+    mask_spans_check("Bar background", &diff_cnt, &edge_lines, &all_lines);
+    int16_t indic_id = lv_draw_mask_add(&indic_p, NULL);
+    mask_spans_check("Bar indicator", &diff_cnt, &edge_lines, &all_lines);
+
+    /*Every row of the bar has edges but only the pixels of the rounded ends are calculated*/
+    lv_opa_t buf[LV_HOR_RES_MAX];
+    lv_draw_mask_span_t spans[LV_DRAW_MASK_SPAN_MAX];
+    uint32_t edge_px = 0;
+    lv_coord_t y;
+    for(y = bar_area.y1; y <= bar_area.y2; y++) {
+        uint8_t span_cnt = lv_draw_mask_apply_spans(buf, 0, y, LV_HOR_RES_MAX, spans);
+        uint8_t k;
+        for(k = 0; k < span_cnt; k++) {
+            if(spans[k].changed) edge_px += spans[k].len;
+        }
+    }
+    lv_test_assert_int_lt(lv_area_get_size(&bar_area) / 4, edge_px, "Pixels of the bar calculated one by one");
+    lv_draw_mask_remove_id(indic_id);
+    lv_draw_mask_remove_id(bar_id);
+
+    /*Inner side of a rounded border*/
+    lv_area_t border_area = {30, 30, 209, 209};
+    lv_draw_mask_radius_param_t border_p;
+    lv_draw_mask_radius_init(&border_p, &border_area, 40, true);
+    int16_t border_id = lv_draw_mask_add(&border_p, NULL);
+    mask_spans_check("Rounded border", &diff_cnt, &edge_lines, &all_lines);
+    lv_draw_mask_remove_id(border_id);
+
+    /*Faded chart series area under lines of any direction*/
+    static const lv_coord_t line_pts[][4] = {
+        {10, 150, 230, 120}, {10, 100, 230, 180}, {50, 20, 70, 220}, {200, 10, 150, 230},
+        {10, 130, 230, 130}, {120, 10, 120, 230}, {0, 60, 239, 61}, {30, 200, 35, 20},
+    };
+    static const lv_draw_mask_line_side_t sides[] = {
+        LV_DRAW_MASK_LINE_SIDE_BOTTOM, LV_DRAW_MASK_LINE_SIDE_TOP, LV_DRAW_MASK_LINE_SIDE_LEFT,
+        LV_DRAW_MASK_LINE_SIDE_RIGHT
+    };
+    lv_area_t fade_area = {0, 40, 239, 219};
+    lv_draw_mask_fade_param_t fade_p;
+    lv_draw_mask_fade_init(&fade_p, &fade_area, LV_OPA_80, fade_area.y1, LV_OPA_10, fade_area.y2);
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(line_pts) / sizeof(line_pts[0]); i++) {
+        for(j = 0; j < sizeof(sides) / sizeof(sides[0]); j++) {
+            lv_draw_mask_line_param_t line_p;
+            lv_draw_mask_line_points_init(&line_p, line_pts[i][0], line_pts[i][1], line_pts[i][2], line_pts[i][3],
+                                          sides[j]);
+            int16_t line_id = lv_draw_mask_add(&line_p, NULL);
+            int16_t fade_id = lv_draw_mask_add(&fade_p, NULL);
+            mask_spans_check("Line and fade", &diff_cnt, &edge_lines, &all_lines);
+            lv_draw_mask_remove_id(fade_id);
+            lv_draw_mask_remove_id(line_id);
+        }
+    }
+
+    /*Angles in every quarter, with the special horizontal cases*/
+    static const lv_coord_t angles[][2] = {
+        {0, 90}, {30, 150}, {100, 80}, {200, 340}, {300, 210}, {180, 0}, {0, 180}, {45, 300}, {270, 30},
+    };
+    for(i = 0; i < sizeof(angles) / sizeof(angles[0]); i++) {
+        lv_draw_mask_angle_param_t angle_p;
+        lv_draw_mask_angle_init(&angle_p, 120, 120, angles[i][0], angles[i][1]);
+        int16_t angle_id = lv_draw_mask_add(&angle_p, NULL);
+        mask_spans_check("Angle", &diff_cnt, &edge_lines, &all_lines);
+        lv_draw_mask_remove_id(angle_id);
+    }
+
+    /*A map mask has no spans, it has to be calculated everywhere*/
+    static lv_opa_t map[64 * 64];
+    for(i = 0; i < sizeof(map); i++) map[i] = (i * 7) & 0xFF;
+    lv_area_t map_area = {100, 100, 163, 163};
+    lv_draw_mask_map_param_t map_p;
+    lv_draw_mask_map_init(&map_p, &map_area, map);
+    int16_t map_id = lv_draw_mask_add(&map_p, NULL);
+    bar_id = lv_draw_mask_add(&bar_p, NULL);
+    mask_spans_check("Map", &diff_cnt, &edge_lines, &all_lines);
+    lv_draw_mask_remove_id(bar_id);
+    lv_draw_mask_remove_id(map_id);
+
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels where the spans differ from lv_draw_mask_apply");
+    lv_test_assert_int_lt(all_lines / 2, edge_lines, "Lines calculated pixel by pixel");
+}
+
+/**
+ * Compare `lv_draw_mask_apply_spans` with `lv_draw_mask_apply` on every line of the screen
+ * with the currently added masks
+ * @param name name of the case to print on failure
+ * @param diff_cnt increment with the number of different pixels
+ * @param edge_lines increment with the number of lines calculated pixel by pixel
+ * @param all_lines increment with the number of compared lines
+ */
+static void mask_spans_check(const char * name, uint32_t * diff_cnt, uint32_t * edge_lines, uint32_t * all_lines)
+{
+    /*Full lines and lines starting in the middle*/
+    const lv_coord_t starts[][2] = {{0, LV_HOR_RES_MAX}, {37, 150}};
+    lv_opa_t ref_buf[LV_HOR_RES_MAX];
+    lv_opa_t span_buf[LV_HOR_RES_MAX];
+    lv_draw_mask_span_t spans[LV_DRAW_MASK_SPAN_MAX];
+    uint32_t diff_start = *diff_cnt;
+
+    uint32_t s;
+    for(s = 0; s < sizeof(starts) / sizeof(starts[0]); s++) {
+        lv_coord_t x = starts[s][0];
+        lv_coord_t len = starts[s][1];
+        lv_coord_t y;
+        for(y = 0; y < LV_VER_RES; y++) {
+            _lv_memset_ff(ref_buf, len);
+            lv_draw_mask_res_t res = lv_draw_mask_apply(ref_buf, x, y, len);
+            if(res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(ref_buf, len);
+
+            _lv_memset_ff(span_buf, len);
+            uint8_t span_cnt = lv_draw_mask_apply_spans(span_buf, x, y, len, spans);
+
+            lv_coord_t covered = 0;
+            uint8_t i;
+            for(i = 0; i < span_cnt; i++) {
+                lv_coord_t k;
+                for(k = spans[i].x; k < spans[i].x + spans[i].len; k++) {
+                    lv_opa_t v = spans[i].changed ? span_buf[k] : spans[i].opa;
+                    if(v != ref_buf[k]) (*diff_cnt)++;
+                }
+                if(spans[i].changed) (*edge_lines)++;
+                covered += spans[i].len;
+            }
+            if(covered != len) (*diff_cnt) += len;
+            (*all_lines)++;
+        }
+    }
+
+    if(*diff_cnt != diff_start) {
+        char buf[64];
+        lv_snprintf(buf, sizeof(buf), "%s: %d different pixels", name, (int)(*diff_cnt - diff_start));
+        lv_test_print(buf);
+    }
+}
+
+static void circle_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Circle cache of the radius masks:");
+    lv_test_print("---------------------------------");
+
+    /*Cached corners against the calculated ones, in rectangles of many sizes*/
+    static const lv_coord_t radii[] = {1, 2, 3, 4, 5, 8, 10, 13, 20, 31, 40, 57};
+    uint32_t diff_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        lv_coord_t r = radii[i];
+        lv_area_t rects[] = {
+            {10, 10, 10 + 2 * r - 1, 10 + 2 * r - 1},
+            {7, 20, 7 + 2 * r, 20 + 2 * r + 4},
+            {-3, 5, 100 + r, 12 + 3 * r},
+            {120, 100, 260, 100 + 2 * r + 1},
+        };
+        uint32_t j;
+        for(j = 0; j < sizeof(rects) / sizeof(rects[0]); j++) {
+            diff_cnt += circle_cache_check(&rects[j], r, false);
+            diff_cnt += circle_cache_check(&rects[j], r, true);
+        }
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels where the cached corners differ from the calculated ones");
+
+    /*The second mask with the same radius reuses the circle, whatever the size of the rectangle is*/
+    lv_draw_mask_circle_cache_stat_t stat_start;
+    lv_draw_mask_circle_cache_stat_t stat;
+    lv_draw_mask_circle_cache_get_stat(&stat_start);
+    lv_area_t a1 = {0, 0, 99, 49};
+    lv_area_t a2 = {30, 30, 59, 59};
+    lv_draw_mask_radius_param_t p1;
+    lv_draw_mask_radius_param_t p2;
+    lv_draw_mask_radius_init(&p1, &a1, 14, false);
+    lv_draw_mask_radius_init(&p2, &a2, 14, true);
+    lv_draw_mask_circle_cache_get_stat(&stat);
+    lv_test_assert_int_eq(stat_start.miss_cnt + 1, stat.miss_cnt, "Miss on the first use of a radius");
+    lv_test_assert_int_eq(stat_start.hit_cnt + 1, stat.hit_cnt, "Hit on the second use of a radius");
+    lv_test_assert_int_eq(LV_CIRCLE_CACHE_SIZE, stat.entry_cnt, "Cached circles");
+    lv_test_assert_int_gt(0, stat.used_size, "Memory used by the cached circles");
+}
+
+/**
+ * Compare a radius mask using a cached circle with one calculating its corners on every line
+ * @param rect the rectangle of the mask
+ * @param radius radius of the mask
+ * @param outer true: keep the pixels outside of the rectangle
+ * @return number of different pixels
+ */
+static uint32_t circle_cache_check(const lv_area_t * rect, lv_coord_t radius, bool outer)
+{
+    /*Fill the cache with not yet cached radii to make the first mask lose its cached circle*/
+    static lv_coord_t other_r = 0;
+    lv_draw_mask_radius_param_t calc_p;
+    lv_draw_mask_radius_init(&calc_p, rect, radius, outer);
+    uint32_t i;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
+        lv_area_t other_area = {0, 0, 199, 199};
+        lv_draw_mask_radius_param_t other_p;
+        lv_draw_mask_radius_init(&other_p, &other_area, 60 + other_r, false);
+        other_r = (other_r + 1) % 40;
+    }
+
+    lv_draw_mask_radius_param_t cached_p;
+    lv_draw_mask_radius_init(&cached_p, rect, radius, outer);
+
+    /*Full lines and lines starting or ending in the corners*/
+    const lv_coord_t starts[][2] = {{-10, LV_HOR_RES_MAX + 20}, {rect->x1 + 2, 40}, {rect->x2 - 30, 28}};
+    lv_opa_t calc_buf[LV_HOR_RES_MAX + 20];
+    lv_opa_t cached_buf[LV_HOR_RES_MAX + 20];
+    uint32_t diff_cnt = 0;
+
+    uint32_t s;
+    for(s = 0; s < sizeof(starts) / sizeof(starts[0]); s++) {
+        lv_coord_t x = starts[s][0];
+        lv_coord_t len = starts[s][1];
+        lv_coord_t y;
+        for(y = rect->y1 - 2; y <= rect->y2 + 2; y++) {
+            lv_draw_mask_res_t res;
+            lv_draw_mask_res_t cached_res;
+
+            _lv_memset(calc_buf, LV_OPA_70, len);
+            res = calc_p.dsc.cb(calc_buf, x, y, len, &calc_p);
+            if(res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(calc_buf, len);
+
+            _lv_memset(cached_buf, LV_OPA_70, len);
+            cached_res = cached_p.dsc.cb(cached_buf, x, y, len, &cached_p);
+            if(cached_res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(cached_buf, len);
+
+            lv_coord_t k;
+            for(k = 0; k < len; k++) {
+                if(calc_buf[k] != cached_buf[k]) diff_cnt++;
+            }
+        }
+    }
+
+    if(diff_cnt) {
+        char buf[128];
+        lv_snprintf(buf, sizeof(buf), "radius %d %s: %d different pixels", radius, outer ? "outer" : "inner",
+                    (int)diff_cnt);
+        lv_test_print(buf);
+    }
+
+    return diff_cnt;
+}
+
+static void gradients(void)
+{
+    lv_test_print("");
+    lv_test_print("Gradients:");
+    lv_test_print("----------");
+
+    lv_grad_dir_t dirs[] = {LV_GRAD_DIR_VER, LV_GRAD_DIR_HOR};
+    const char * fns[] = {"grad_ver.png", "grad_hor.png"};
+
+    uint8_t d;
+    for(d = 0; d < sizeof(dirs) / sizeof(dirs[0]); d++) {
+        uint8_t i;
+        for(i = 0; i < 4; i++) {
+            lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+            lv_obj_set_size(obj, 100, 100);
+            lv_obj_set_pos(obj, 10 + (i % 2) * 120, 10 + (i / 2) * 120);
+            lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+            lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+            lv_obj_set_style_local_bg_grad_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLUE);
+            lv_obj_set_style_local_bg_grad_dir(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, dirs[d]);
+            lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, i == 1 ? 20 : 0);
+            if(i == 2) {
+                /*Faded like the series area of the chart*/
+                lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+            }
+            if(i == 3) {
+                lv_obj_set_style_local_bg_main_stop(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 64);
+                lv_obj_set_style_local_bg_grad_stop(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 192);
+            }
+        }
+
+        lv_test_assert_img_similar(fns[d], IMG_TOLERANCE, "Gradients with radius, opacity and stops");
+        lv_obj_clean(lv_scr_act());
+    }
+}
+
+static void grad_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Gradient cache:");
+    lv_test_print("---------------");
+
+    /*Cached colors and opacities against the calculated ones*/
+    static const lv_coord_t sizes[] = {1, 2, 3, 17, 70, 100, 240};
+    static const lv_opa_t stops[][2] = {{0, 255}, {255, 0}, {64, 192}, {100, 100}, {LV_OPA_70, LV_OPA_10}};
+    lv_color_t c1 = LV_COLOR_RED;
+    lv_color_t c2 = lv_color_hex(0x1a3c8c);
+    uint32_t diff_cnt = 0;
+    uint32_t uncached_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        uint32_t s;
+        for(s = 0; s < sizeof(stops) / sizeof(stops[0]); s++) {
+            lv_coord_t size = sizes[i];
+            const lv_color_t * colors = _lv_draw_grad_color_get(c1, stops[s][0], c2, stops[s][1], size);
+            if(colors == NULL) uncached_cnt++;
+            lv_coord_t j;
+            for(j = 0; colors && j < size; j++) {
+                lv_color_t c = _lv_draw_grad_color_calc(c1, stops[s][0], c2, stops[s][1], size, j);
+                if(c.full != colors[j].full) diff_cnt++;
+            }
+
+            const _lv_draw_grad_dsc_t * fade = _lv_draw_grad_opa_get(stops[s][0], stops[s][1], size);
+            if(fade == NULL) uncached_cnt++;
+            const lv_opa_t * opas = fade ? fade->buf : NULL;
+            for(j = 0; opas && j < size; j++) {
+                if(_lv_draw_grad_opa_calc(stops[s][0], stops[s][1], size, j) != opas[j]) diff_cnt++;
+            }
+        }
+    }
+    lv_test_assert_int_eq(0, uncached_cnt, "Gradients which couldn't be cached");
+    lv_test_assert_int_eq(0, diff_cnt, "Cached gradient values different from the calculated ones");
+
+    /*A fade mask whose opacities were replaced in the cache calculates them again*/
+    lv_area_t coords = {10, 20, 229, 89};
+    lv_draw_mask_fade_param_t cached_p;
+    lv_draw_mask_fade_param_t stale_p;
+    lv_draw_mask_fade_init(&stale_p, &coords, LV_OPA_COVER, coords.y1, LV_OPA_TRANSP, coords.y2);
+    for(i = 0; i < LV_GRAD_CACHE_SIZE; i++) {
+        _lv_draw_grad_opa_get(LV_OPA_COVER, LV_OPA_TRANSP, 300 + i);
+    }
+    lv_test_assert_int_eq(1, stale_p.lut && stale_p.lut->id != stale_p.lut_id,
+                          "The opacities of the first fade are replaced");
+    lv_draw_mask_fade_init(&cached_p, &coords, LV_OPA_COVER, coords.y1, LV_OPA_TRANSP, coords.y2);
+
+    diff_cnt = 0;
+    lv_coord_t y;
+    for(y = coords.y1 - 2; y <= coords.y2 + 2; y++) {
+        lv_opa_t stale_buf[LV_HOR_RES_MAX];
+        lv_opa_t cached_buf[LV_HOR_RES_MAX];
+        _lv_memset(stale_buf, LV_OPA_70, LV_HOR_RES_MAX);
+        _lv_memset(cached_buf, LV_OPA_70, LV_HOR_RES_MAX);
+        stale_p.dsc.cb(stale_buf, 0, y, LV_HOR_RES_MAX, &stale_p);
+        cached_p.dsc.cb(cached_buf, 0, y, LV_HOR_RES_MAX, &cached_p);
+        lv_coord_t k;
+        for(k = 0; k < LV_HOR_RES_MAX; k++) {
+            if(stale_buf[k] != cached_buf[k]) diff_cnt++;
+        }
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels where the cached fade differs from the calculated one");
+
+    /*The same stops and size hit the cache*/
+    lv_draw_grad_cache_stat_t stat_start;
+    lv_draw_grad_cache_stat_t stat;
+    lv_draw_grad_cache_get_stat(&stat_start);
+    _lv_draw_grad_color_get(c1, 0, c2, 255, 70);
+    _lv_draw_grad_color_get(c1, 0, c2, 255, 70);
+    lv_draw_grad_cache_get_stat(&stat);
+    lv_test_assert_int_eq(stat_start.miss_cnt + 1, stat.miss_cnt, "Miss on the first use of a gradient");
+    lv_test_assert_int_eq(stat_start.hit_cnt + 1, stat.hit_cnt, "Hit on the second use of a gradient");
+    lv_test_assert_int_eq(LV_GRAD_CACHE_SIZE, stat.entry_cnt, "Cached gradients");
+    lv_test_assert_int_gt(0, stat.used_size, "Memory used by the cached gradients");
+}
+
+static void chart_scroll(void)
+{
+    lv_test_print("");
+    lv_test_print("Chart scroll:");
+    lv_test_print("-------------");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver.flush_cb;
+    disp->driver.flush_cb = chart_scroll_flush_cb;
+    chart_fb = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    lv_color_t * scrolled = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    /*12 points on a 220 px wide series area: 20 px between the points*/
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_obj_set_size(chart, 230, 100);
+    lv_obj_align(chart, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_pad_left(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+    lv_obj_set_style_local_pad_right(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+    lv_obj_set_style_local_pad_top(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_pad_bottom(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_radius(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 4);
+    lv_obj_set_style_local_line_width(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 3);
+    lv_obj_set_style_local_size(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 4);
+    lv_obj_set_style_local_bg_opa(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_50);
+    lv_obj_set_style_local_bg_grad_dir(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+    lv_obj_set_style_local_bg_main_stop(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_70);
+    lv_obj_set_style_local_bg_grad_stop(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_10);
+    /*Dashes of 7 px don't repeat after a 20 px move*/
+    lv_obj_set_style_local_line_dash_width(chart, LV_CHART_PART_SERIES_BG, LV_STATE_DEFAULT, 4);
+    lv_obj_set_style_local_line_dash_gap(chart, LV_CHART_PART_SERIES_BG, LV_STATE_DEFAULT, 3);
+    lv_chart_set_point_count(chart, 12);
+    lv_chart_set_range(chart, 0, 100);
+    lv_chart_set_scroll_cb(chart, chart_scroll_cb);
+
+    static lv_coord_t ring[12];
+    lv_chart_series_t * ser1 = lv_chart_add_series(chart, LV_COLOR_RED);
+    lv_chart_series_t * ser2 = lv_chart_add_series(chart, LV_COLOR_BLUE);
+    uint32_t i;
+    for(i = 0; i < 12; i++) ring[i] = (i * 37) % 100;
+    lv_chart_set_ext_array(chart, ser1, ring, 12);
+    lv_chart_init_points(chart, ser2, 50);
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+
+    /*Add points one by one and a few at once*/
+    uint32_t diff_cnt = 0;
+    uint32_t flush_px_max = 0;
+    static const uint8_t steps[] = {1, 1, 2, 1, 3, 1};
+    for(i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        uint32_t j;
+        for(j = 0; j < steps[i]; j++) {
+            lv_chart_set_next(chart, ser1, (i * 53 + j * 29) % 100);
+            lv_chart_set_next(chart, ser2, (i * 17 + j * 71) % 100);
+        }
+        diff_cnt += chart_scroll_check(chart, scrolled);
+        flush_px_max = LV_MATH_MAX(flush_px_max, chart_flush_px);
+    }
+
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels of the scrolled plot different from the redrawn one");
+    lv_test_assert_int_eq(sizeof(steps) / sizeof(steps[0]), chart_scroll_cnt, "Scrolls of the plot");
+
+    /*The points are written to the array of the application*/
+    uint16_t last = (lv_chart_get_x_start_point(ser1) + 11) % 12;
+    lv_test_assert_int_eq(9, lv_chart_get_x_start_point(ser1), "Start point after 9 shifts");
+    lv_test_assert_int_eq((5 * 53 + 0 * 29) % 100, ring[last], "Last point in the external array");
+
+    /*Only one series is shifted: redraw the plot*/
+    chart_scroll_cnt = 0;
+    lv_chart_set_next(chart, ser1, 90);
+    diff_cnt = chart_scroll_check(chart, scrolled);
+    lv_test_assert_int_eq(0, chart_scroll_cnt, "Scrolls with the series shifted differently");
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels of the redrawn plot different from the redrawn chart");
+
+    /*Without the scroll callback only the plot is redrawn*/
+    lv_chart_set_scroll_cb(chart, NULL);
+    lv_chart_set_next(chart, ser1, 10);
+    lv_chart_set_next(chart, ser2, 20);
+    diff_cnt = chart_scroll_check(chart, scrolled);
+    lv_test_assert_int_eq(0, chart_scroll_cnt, "Scrolls without scroll callback");
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels of the redrawn plot different from the redrawn chart");
+    lv_test_assert_int_gt(flush_px_max, chart_flush_px, "Pixels redrawn without scrolling");
+    lv_test_assert_int_lt(230 * 100, chart_flush_px, "Pixels redrawn without scrolling");
+
+    lv_obj_del(chart);
+    free(scrolled);
+    free(chart_fb);
+    chart_fb = NULL;
+    disp->driver.flush_cb = flush_cb_ori;
+}
+
+/**
+ * Refresh the display after points were added to a chart and compare it with a refresh of the whole screen
+ * @param chart the chart with the new points
+ * @param scrolled a screen sized buffer for the partially refreshed frame
+ * @return number of pixels different from the whole refresh
+ */
+static uint32_t chart_scroll_check(lv_obj_t * chart, lv_color_t * scrolled)
+{
+    LV_UNUSED(chart);
+    lv_disp_t * disp = lv_disp_get_default();
+
+    /*The scroll task runs before the display is refreshed*/
+    chart_flush_px = 0;
+    lv_task_handler();
+    lv_refr_now(disp);
+    _lv_memcpy(scrolled, chart_fb, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    uint32_t flush_px = chart_flush_px;
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    chart_flush_px = flush_px;
+
+    uint32_t diff_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < (uint32_t)LV_HOR_RES * LV_VER_RES; i++) {
+        if(scrolled[i].full != chart_fb[i].full) diff_cnt++;
+    }
+
+    return diff_cnt;
+}
+
+static void chart_scroll_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        _lv_memcpy(&chart_fb[y * LV_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    chart_flush_px += lv_area_get_size(area);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static bool chart_scroll_cb(lv_obj_t * chart, const lv_area_t * area, lv_coord_t dx)
+{
+    LV_UNUSED(chart);
+    /*Move the pixels inside the area, the ones moved out of it are dropped*/
+    lv_coord_t w = lv_area_get_width(area) - LV_MATH_ABS(dx);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_color_t * row = &chart_fb[y * LV_HOR_RES];
+        if(dx < 0) memmove(&row[area->x1], &row[area->x1 - dx], w * sizeof(lv_color_t));
+        else memmove(&row[area->x1 + dx], &row[area->x1], w * sizeof(lv_color_t));
+    }
+    chart_scroll_cnt++;
+    return true;
+}
+
+static void chart_envelope(void)
+{
+    lv_test_print("");
+    lv_test_print("Chart envelope:");
+    lv_test_print("---------------");
+
+    /*440 points on a 220 px wide series area: two points in every column*/
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_obj_set_size(chart, 230, 100);
+    lv_obj_align(chart, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_pad_left(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+    lv_obj_set_style_local_pad_right(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+    lv_obj_set_style_local_pad_top(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_pad_bottom(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 10);
+    lv_obj_set_style_local_line_width(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 2);
+    lv_chart_set_type(chart, LV_CHART_TYPE_ENVELOPE);
+    lv_chart_set_point_count(chart, 440);
+    lv_chart_set_range(chart, 0, 100);
+
+    /*Short bursts in single points, a series without band and with missing points*/
+    lv_chart_series_t * ser1 = lv_chart_add_series(chart, LV_COLOR_RED);
+    lv_chart_series_t * ser2 = lv_chart_add_series(chart, LV_COLOR_BLUE);
+    uint32_t i;
+    for(i = 0; i < 440; i++) {
+        lv_coord_t mean = 40 + (i * 7) % 20;
+        lv_coord_t max = i % 97 == 0 ? 100 : mean + 5;
+        lv_chart_set_next_envelope(chart, ser1, mean - 5 - (i % 3) * 4, max, mean);
+        lv_chart_set_next(chart, ser2, i % 150 < 120 ? (lv_coord_t)(15 + (i / 20) % 4 * 3) : LV_CHART_POINT_DEF);
+    }
+
+    lv_test_assert_img_similar("chart_envelope.png", IMG_TOLERANCE, "Envelope with bursts, merged points and gaps");
+
+    /*A new point in circular mode invalidates enough*/
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver.flush_cb;
+    disp->driver.flush_cb = chart_scroll_flush_cb;
+    chart_fb = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    lv_color_t * partial = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_chart_set_point_count(chart, 55);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+
+    uint32_t diff_cnt = 0;
+    for(i = 0; i < 8; i++) {
+        lv_chart_set_next_envelope(chart, ser1, 10 + i * 5, 90 - i * 3, 50 + (i % 2) * 20);
+        lv_chart_set_next(chart, ser2, 80 - i * 7);
+        diff_cnt += chart_scroll_check(chart, partial);
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels of the invalidated points different from the redrawn chart");
+    lv_test_assert_int_gt(0, chart_flush_px, "Pixels redrawn for a new point");
+    lv_test_assert_int_lt(230 * 100 / 4, chart_flush_px, "Pixels redrawn for a new point");
+
+    /*The band is kept with the points when the point count changes*/
+    lv_coord_t oldest_min = ser1->env_points[lv_chart_get_x_start_point(ser1) * 2];
+    lv_chart_set_point_count(chart, 100);
+    lv_test_assert_int_eq(oldest_min, ser1->env_points[0], "Min. of the oldest point after the resize");
+    lv_test_assert_int_eq(LV_CHART_POINT_DEF, ser1->env_points[99 * 2 + 1], "Max. of a new point after the resize");
+
+    /*Setting all points makes the first one the oldest, the band is rotated with them*/
+    for(i = 0; i < 7; i++) lv_chart_set_next_envelope(chart, ser1, 20 + i, 60 + i, 40);
+    uint16_t start = lv_chart_get_x_start_point(ser1);
+    lv_coord_t oldest_max = ser1->env_points[start * 2 + 1];
+    lv_coord_t newest_min = ser1->env_points[((start + 99) % 100) * 2];
+    lv_coord_t y_array[100];
+    for(i = 0; i < 100; i++) y_array[i] = 50;
+    lv_chart_set_points(chart, ser1, y_array);
+    lv_test_assert_int_eq(0, lv_chart_get_x_start_point(ser1), "Start point after setting the points");
+    lv_test_assert_int_eq(oldest_max, ser1->env_points[1], "Max. of the oldest point after setting the points");
+    lv_test_assert_int_eq(newest_min, ser1->env_points[99 * 2], "Min. of the newest point after setting the points");
+
+#if LV_MEM_CUSTOM == 0
+    /*A point count which doesn't fit for all series leaves every series unchanged*/
+    lv_coord_t * points1 = ser1->points;
+    lv_coord_t * env_points1 = ser1->env_points;
+    lv_coord_t * points2 = ser2->points;
+    lv_mem_monitor_t mon_before;
+    lv_mem_monitor_t mon_after;
+    _lv_mem_buf_free_all();
+    lv_mem_monitor(&mon_before);
+    lv_chart_set_point_count(chart, (uint16_t)LV_MATH_MIN(mon_before.free_size / 4, UINT16_MAX));
+    _lv_mem_buf_free_all();
+    lv_mem_monitor(&mon_after);
+    lv_test_assert_int_eq(100, lv_chart_get_point_count(chart), "Point count after a failed resize");
+    lv_test_assert_int_eq(1, points1 == ser1->points && env_points1 == ser1->env_points && points2 == ser2->points,
+                          "Arrays of the series kept after a failed resize");
+    lv_test_assert_int_eq(mon_before.free_size, mon_after.free_size, "Free heap after a failed resize");
+    lv_test_assert_int_eq(mon_before.slab_free_size, mon_after.slab_free_size, "Free pools after a failed resize");
+#endif
+
+    lv_obj_del(chart);
+    free(partial);
+    free(chart_fb);
+    chart_fb = NULL;
+    disp->driver.flush_cb = flush_cb_ori;
+}
+
+static void chart_polyline(void)
+{
+    lv_test_print("");
+    lv_test_print("Chart polyline:");
+    lv_test_print("---------------");
+
+    /*Few points with a faded area, noise and more points than pixels*/
+    const uint16_t point_cnts[] = {10, 220, 1000};
+    const lv_coord_t widths[] = {3, 1, 2};
+    uint32_t k;
+    for(k = 0; k < 3; k++) {
+        lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+        lv_obj_set_size(chart, 230, 74);
+        lv_obj_set_pos(chart, 5, 5 + k * 78);
+        lv_obj_set_style_local_pad_left(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+        lv_obj_set_style_local_pad_right(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+        lv_obj_set_style_local_pad_top(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+        lv_obj_set_style_local_pad_bottom(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 5);
+        lv_obj_set_style_local_line_width(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, widths[k]);
+        lv_obj_set_style_local_size(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);
+        if(k == 0) {
+            lv_obj_set_style_local_bg_opa(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_50);
+            lv_obj_set_style_local_bg_grad_dir(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+            lv_obj_set_style_local_bg_main_stop(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 255);
+            lv_obj_set_style_local_bg_grad_stop(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);
+        }
+        lv_chart_set_point_count(chart, point_cnts[k]);
+        lv_chart_set_range(chart, 0, 100);
+
+        lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_NAVY);
+        uint32_t i;
+        for(i = 0; i < point_cnts[k]; i++) {
+            lv_coord_t v;
+            if(k == 0) v = (i * 37) % 100;
+            else if(k == 1) v = i % 40 < 20 ? 20 + (i % 7) * 5 : 80 - (i % 13) * 3;
+            else v = i % 97 == 0 ? 98 : 30 + (i * 7) % 23 + (i / 100) * 4;
+            lv_chart_set_next(chart, ser, v);
+        }
+    }
+
+    lv_test_assert_img_similar("chart_polyline.png", IMG_TOLERANCE, "Line series with few and many points");
+    lv_obj_clean(lv_scr_act());
+
+    /*A half transparent line is blended only once on every pixel, even on the joints*/
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver.flush_cb;
+    disp->driver.flush_cb = chart_scroll_flush_cb;
+    chart_fb = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_obj_set_size(chart, 230, 100);
+    lv_obj_align(chart, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_local_bg_color(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+    lv_obj_set_style_local_border_width(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_line_width(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 3);
+    lv_obj_set_style_local_line_opa(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_50);
+    lv_obj_set_style_local_size(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);
+    lv_chart_set_div_line_count(chart, 0, 0);
+    lv_chart_set_point_count(chart, 20);
+    lv_chart_set_range(chart, 0, 100);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_BLACK);
+    uint32_t i;
+    for(i = 0; i < 20; i++) lv_chart_set_next(chart, ser, i % 2 ? 80 - i * 2 : 20 + i);
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+
+    uint32_t line_cnt = 0;
+    uint32_t dark_cnt = 0;
+    for(i = 0; i < (uint32_t)LV_HOR_RES * LV_VER_RES; i++) {
+        uint8_t c = lv_color_brightness(chart_fb[i]);
+        if(c < 0xC0) line_cnt++;
+        if(c < 0x60) dark_cnt++;
+    }
+    lv_test_assert_int_gt(1000, line_cnt, "Pixels of the half transparent line");
+    lv_test_assert_int_eq(0, dark_cnt, "Pixels of the half transparent line blended more than once");
+
+    lv_obj_del(chart);
+    free(chart_fb);
+    chart_fb = NULL;
+    disp->driver.flush_cb = flush_cb_ori;
+}
+
+static void lines(void)
+{
+    lv_test_print("");
+    lv_test_print("Anti-aliased lines:");
+    lv_test_print("-------------------");
+
+    /*Lines keep a pointer to their points*/
+    static lv_point_t points[LINE_CNT][2];
+    const lv_coord_t widths[] = {1, 2, 5, 9};
+
+    uint16_t i;
+    for(i = 0; i < LINE_CNT; i++) {
+        int16_t angle = i * (360 / LINE_CNT) + 3;
+        points[i][0].x = 120 + ((int32_t)_lv_trigo_sin(angle + 90) * 20) / LV_TRIGO_SIN_MAX;
+        points[i][0].y = 120 + ((int32_t)_lv_trigo_sin(angle) * 20) / LV_TRIGO_SIN_MAX;
+        points[i][1].x = 120 + ((int32_t)_lv_trigo_sin(angle + 90) * 110) / LV_TRIGO_SIN_MAX;
+        points[i][1].y = 120 + ((int32_t)_lv_trigo_sin(angle) * 110) / LV_TRIGO_SIN_MAX;
+
+        lv_obj_t * line = lv_line_create(lv_scr_act(), NULL);
+        lv_line_set_points(line, points[i], 2);
+        lv_obj_set_style_local_line_width(line, LV_LINE_PART_MAIN, LV_STATE_DEFAULT, widths[i % 4]);
+        lv_obj_set_style_local_line_rounded(line, LV_LINE_PART_MAIN, LV_STATE_DEFAULT, i % 8 >= 4);
+        lv_obj_set_style_local_line_color(line, LV_LINE_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_NAVY);
+    }
+
+    lv_test_assert_img_similar("line_aa.png", IMG_TOLERANCE, "Lines in every direction");
+    lv_obj_clean(lv_scr_act());
+}
+
+static void fonts(void)
+{
+    lv_test_print("");
+    lv_test_print("Fonts:");
+    lv_test_print("------");
+
+#if LV_FONT_UNSCII_8
+    font_scene(&lv_font_unscii_8, "0123456789 192.168.8.100\nCPU Memory Loading ...\nABCDEFGHIJKLMNOPQRSTUVWXYZ\nabcdefghijklmnopqrstuvwxyz",
+               "font_unscii_8.png");
+#endif
+#ifdef TENCENT_W7_16
+    font_scene(&tencent_w7_16, "0123456789.%/\nCEKMOPRSUY cekmopr suy\n12.5°C 72℃ 3.14M/s", "font_tencent_w7_16.png");
+#endif
+#ifdef TENCENT_W7_22
+    font_scene(&tencent_w7_22, "0123456789.%/\nCKMPSU ekmorsy\n56.78 12.34%", "font_tencent_w7_22.png");
+#endif
+#ifdef TENCENT_W7_24
+    font_scene(&tencent_w7_24, "0123456789.\n72°C 30℃", "font_tencent_w7_24.png");
+#endif
+#ifdef ICONFONT_SYMBOL
+    font_scene(&iconfont_symbol, CUSTOM_SYMBOL_UPLOAD " " CUSTOM_SYMBOL_DOWNLOAD, "font_iconfont.png");
+#endif
+}
+
+static void font_scene(const lv_font_t * font, const char * txt, const char * fn)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(label, 5, 5);
+    lv_obj_set_style_local_text_font(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, font);
+    lv_obj_set_style_local_text_color(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+    lv_label_set_text(label, txt);
+
+    /*Light text on dark background too*/
+    lv_obj_t * bg = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(bg, 240, 120);
+    lv_obj_set_pos(bg, 0, 120);
+    lv_obj_set_style_local_radius(bg, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_bg_color(bg, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, lv_color_hex(0x081418));
+    lv_obj_t * label_inv = lv_label_create(bg, label);
+    lv_obj_set_style_local_text_color(label_inv, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+
+    lv_test_assert_img_similar(fn, IMG_TOLERANCE, "Glyphs of the font");
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_USE_FONT_ATLAS
+static void font_atlas(void)
+{
+    lv_test_print("");
+    lv_test_print("Font atlas:");
+    lv_test_print("-----------");
+
+#if LV_FONT_UNSCII_8
+    uint32_t size = lv_font_atlas_get_buf_size(&lv_font_unscii_8, "0");
+    lv_test_assert_int_gt(0, size, "Buffer size of one letter");
+    lv_test_assert_int_eq(size, lv_font_atlas_get_buf_size(&lv_font_unscii_8, "000"), "Buffer size of a repeated letter");
+    lv_test_assert_int_eq(size, lv_font_atlas_get_buf_size(&lv_font_unscii_8, "0\xe4\xb8\x80"),
+                          "Buffer size with a letter not in the font");
+    lv_test_assert_int_eq(0, lv_font_atlas_get_buf_size(&lv_font_unscii_8, ""), "Buffer size without letters");
+
+    lv_font_atlas_t atlas;
+    uint8_t buf[64];
+    lv_test_assert_int_eq(false, lv_font_atlas_create(&atlas, &lv_font_unscii_8, "0123456789", buf, sizeof(buf)),
+                          "Create with a too small buffer");
+
+    /*Bitmaps with 1 bit per pixel*/
+    font_atlas_check(&lv_font_unscii_8, "0123456789.%", "56.78 12.34%\n0.5% 100%");
+#endif
+#ifdef TENCENT_W7_22
+    /*Subpixel rendering*/
+    font_atlas_check(&tencent_w7_22, "0123456789.%", "56.78 12.34%\n0.5% 100%");
+#endif
+}
+
+/**
+ * Draw some text with and without an atlas and compare the results.
+ * The text is drawn normally, with opacity and clipped by a rounded parent.
+ * @param font the font to check
+ * @param letters the letters of the atlas
+ * @param txt the text to draw, can have letters not in the atlas
+ */
+static void font_atlas_check(const lv_font_t * font, const char * letters, const char * txt)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver.flush_cb;
+    disp->driver.flush_cb = chart_scroll_flush_cb;
+    chart_fb = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    lv_color_t * ref = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(label, 5, 5);
+    lv_obj_set_style_local_text_font(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, font);
+    lv_obj_set_style_local_text_color(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+    lv_label_set_text(label, txt);
+
+    lv_obj_t * bg = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(bg, 120, 60);
+    lv_obj_set_pos(bg, 10, 100);
+    lv_obj_set_style_local_radius(bg, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 20);
+    lv_obj_set_style_local_clip_corner(bg, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, true);
+    lv_obj_set_style_local_bg_color(bg, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, lv_color_hex(0x081418));
+    lv_obj_t * label_clip = lv_label_create(bg, label);
+    lv_obj_set_pos(label_clip, -7, 2);
+    lv_obj_set_style_local_text_color(label_clip, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+    lv_obj_set_style_local_text_opa(label_clip, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_70);
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    _lv_memcpy(ref, chart_fb, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_font_atlas_t atlas;
+    uint32_t size = lv_font_atlas_get_buf_size(font, letters);
+    void * buf = malloc(size);
+    lv_test_assert_int_eq(true, lv_font_atlas_create(&atlas, font, letters, buf, size), "Create an atlas");
+
+    lv_font_glyph_dsc_t g;
+    lv_test_assert_int_eq(true, _lv_font_atlas_get_glyph(font, '5', &g) != NULL, "Glyph in the atlas");
+    lv_test_assert_int_eq(8, g.bpp, "Bpp of the atlas");
+    lv_test_assert_int_eq(true, _lv_font_atlas_get_glyph(font, ' ', &g) == NULL, "Glyph not in the atlas");
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+
+    /*The opacity and the masks might be rounded in different order*/
+    int32_t diff_max = 0;
+    uint32_t i;
+    for(i = 0; i < (uint32_t)LV_HOR_RES * LV_VER_RES; i++) {
+        diff_max = LV_MATH_MAX(diff_max, LV_MATH_ABS((int32_t)ref[i].ch.red - chart_fb[i].ch.red));
+        diff_max = LV_MATH_MAX(diff_max, LV_MATH_ABS((int32_t)ref[i].ch.green - chart_fb[i].ch.green));
+        diff_max = LV_MATH_MAX(diff_max, LV_MATH_ABS((int32_t)ref[i].ch.blue - chart_fb[i].ch.blue));
+    }
+    lv_test_assert_int_lt(2, diff_max, "Largest color difference of the text drawn from the atlas");
+
+    lv_font_atlas_remove(&atlas);
+    lv_test_assert_int_eq(true, _lv_font_atlas_get_glyph(font, '5', &g) == NULL, "Glyph of a removed atlas");
+
+    lv_obj_clean(lv_scr_act());
+    free(buf);
+    free(ref);
+    free(chart_fb);
+    chart_fb = NULL;
+    disp->driver.flush_cb = flush_cb_ori;
+}
+#endif /*LV_USE_FONT_ATLAS*/
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE && defined(TENCENT_W7_22)
+static void font_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Glyph ID cache:");
+    lv_test_print("---------------");
+
+    const lv_font_t * font = &tencent_w7_22;
+    lv_font_fmt_txt_cache_stat_t stat1;
+    lv_font_fmt_txt_cache_stat_t stat2;
+    lv_font_glyph_dsc_t g1;
+    lv_font_glyph_dsc_t g2;
+
+    /*The printable ASCII letters are always in the table*/
+    lv_font_get_glyph_dsc(font, &g1, '5', '\0');
+    lv_font_fmt_txt_get_cache_stat(font, &stat1);
+    lv_test_assert_int_eq(true, lv_font_get_glyph_dsc(font, &g2, '5', '\0'), "ASCII letter in the font");
+    lv_test_assert_int_eq(false, lv_font_get_glyph_dsc(font, &g2, 'A', '\0'), "ASCII letter not in the font");
+    lv_font_fmt_txt_get_cache_stat(font, &stat2);
+    lv_test_assert_int_eq(stat1.glyph_hit_cnt + 2, stat2.glyph_hit_cnt, "ASCII letters are hits");
+    lv_test_assert_int_eq(stat1.glyph_miss_cnt, stat2.glyph_miss_cnt, "ASCII letters aren't searched");
+
+    /*"℃" and a letter not in the font in the same cache entry*/
+    uint32_t degree = 0x2103;
+    uint32_t collide = degree + LV_FONT_FMT_TXT_CACHE_SIZE;
+    lv_test_assert_int_eq(true, lv_font_get_glyph_dsc(font, &g1, degree, '\0'), "Letter in the font");
+    lv_test_assert_int_eq(false, lv_font_get_glyph_dsc(font, &g2, collide, '\0'), "Letter not in the font");
+    lv_test_assert_int_eq(true, lv_font_get_glyph_dsc(font, &g2, degree, '\0'), "Letter replaced in the cache");
+    lv_test_assert_int_eq(g1.box_w, g2.box_w, "Width of a letter replaced in the cache");
+    lv_test_assert_int_eq(g1.adv_w, g2.adv_w, "Advance of a letter replaced in the cache");
+    lv_font_fmt_txt_get_cache_stat(font, &stat1);
+    lv_font_get_glyph_dsc(font, &g2, degree, '\0');
+    lv_font_fmt_txt_get_cache_stat(font, &stat2);
+    lv_test_assert_int_eq(stat1.glyph_hit_cnt + 1, stat2.glyph_hit_cnt, "Letter found in the cache");
+    lv_test_assert_int_eq(g1.adv_w, g2.adv_w, "Advance of a cached letter");
+
+    /*Every pair of the numeric labels gives the same kerning from the cache and from the font*/
+    const char * digits = "0123456789.%";
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; digits[i] != '\0'; i++) {
+        for(j = 0; digits[j] != '\0'; j++) {
+            lv_font_get_glyph_dsc(font, &g1, digits[i], digits[j]);
+        }
+    }
+    lv_font_fmt_txt_get_cache_stat(font, &stat1);
+    bool same = true;
+    for(i = 0; digits[i] != '\0'; i++) {
+        for(j = 0; digits[j] != '\0'; j++) {
+            lv_font_get_glyph_dsc(font, &g1, digits[i], digits[j]);
+            lv_font_get_glyph_dsc(font, &g2, digits[i], digits[j]);
+            if(g1.adv_w != g2.adv_w) same = false;
+        }
+    }
+    lv_font_fmt_txt_get_cache_stat(font, &stat2);
+    lv_test_assert_int_eq(true, same, "Kerning from the cache");
+    lv_test_assert_int_gt(stat1.kern_hit_cnt, stat2.kern_hit_cnt, "Kerning found in the cache");
+}
+#endif
+
+#if LV_LABEL_LAYOUT_CACHE_LEN
+static void label_layout(void)
+{
+    lv_test_print("");
+    lv_test_print("Label layout:");
+    lv_test_print("-------------");
+
+    label_layout_check("56.78", LV_LABEL_LONG_EXPAND, LV_LABEL_ALIGN_LEFT);
+    label_layout_check("12.34%\n72\xc2\xb0" "C\n", LV_LABEL_LONG_EXPAND, LV_LABEL_ALIGN_CENTER);
+    label_layout_check("CPU 12.5% MEM 34%", LV_LABEL_LONG_BREAK, LV_LABEL_ALIGN_RIGHT);
+    label_layout_check("1024.8 KB/s", LV_LABEL_LONG_CROP, LV_LABEL_ALIGN_CENTER);
+
+    /*Too long text*/
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    char txt[LV_LABEL_LAYOUT_CACHE_LEN + 2];
+    _lv_memset(txt, '8', sizeof(txt) - 1);
+    txt[sizeof(txt) - 1] = '\0';
+    lv_label_set_text(label, txt);
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_test_assert_int_eq(true, ext->layout == NULL, "No layout of a too long text");
+    lv_obj_del(label);
+}
+
+/**
+ * Draw a label with and without its layout and compare the results
+ * @param txt the text of the label
+ * @param long_mode long mode of the label
+ * @param align alignment of the label
+ */
+static void label_layout_check(const char * txt, lv_label_long_mode_t long_mode, lv_label_align_t align)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver.flush_cb;
+    disp->driver.flush_cb = chart_scroll_flush_cb;
+    chart_fb = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    lv_color_t * ref = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(label, 5, 5);
+    lv_obj_set_style_local_text_letter_space(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, 1);
+    lv_obj_set_style_local_text_line_space(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, 3);
+    lv_label_set_long_mode(label, long_mode);
+    lv_label_set_align(label, align);
+    if(long_mode != LV_LABEL_LONG_EXPAND) lv_obj_set_size(label, 70, 60);
+    lv_label_set_text(label, txt);
+
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_test_assert_int_eq(true, ext->layout != NULL, "Layout of the text");
+    if(ext->layout == NULL) return;
+
+    lv_point_t size;
+    _lv_txt_get_size(&size, txt, ext->layout->font, ext->layout->letter_space, 3, ext->layout->max_width,
+                     ext->layout->flag);
+    lv_test_assert_int_eq(size.x, ext->layout->size.x, "Width of the text from the layout");
+    lv_test_assert_int_eq(size.y, ext->layout->size.y, "Height of the text from the layout");
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    _lv_memcpy(ref, chart_fb, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    /*Measure the letters while drawing*/
+    lv_mem_free(ext->layout);
+    ext->layout = NULL;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    lv_test_assert_int_eq(0, memcmp(ref, chart_fb, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t)),
+                          "Text drawn with the layout");
+
+    lv_obj_del(label);
+    free(ref);
+    free(chart_fb);
+    chart_fb = NULL;
+    disp->driver.flush_cb = flush_cb_ori;
+}
+#endif
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE && LV_FONT_MONTSERRAT_28_COMPRESSED
+static void glyph_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Glyph bitmap cache:");
+    lv_test_print("-------------------");
+
+    glyph_cache_check(&lv_font_montserrat_28_compressed, "56.78");
+    /*More bitmaps than the cache can keep*/
+    glyph_cache_check(&lv_font_montserrat_28_compressed, "ABCDEFGHIJKLM\nNOPQRSTUVWXYZ\nabcdefghijklm");
+}
+
+/**
+ * Draw some text twice and check that the second frame is the same, drawn from the cached bitmaps if they fit.
+ * @param font the font to check
+ * @param txt the text to draw
+ */
+static void glyph_cache_check(const lv_font_t * font, const char * txt)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = disp->driver.flush_cb;
+    disp->driver.flush_cb = chart_scroll_flush_cb;
+    chart_fb = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    lv_color_t * ref = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_font_fmt_txt_glyph_cache_clear();
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(label, 5, 5);
+    lv_obj_set_style_local_text_font(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, font);
+    lv_obj_set_style_local_text_color(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+    lv_label_set_text(label, txt);
+
+    lv_font_fmt_txt_glyph_cache_stat_t stat1;
+    lv_font_fmt_txt_glyph_cache_stat_t stat2;
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat1);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    _lv_memcpy(ref, chart_fb, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat2);
+    lv_test_assert_int_gt(stat1.miss_cnt, stat2.miss_cnt, "Bitmaps unpacked in the first frame");
+    lv_test_assert_int_gt(0, stat2.entry_cnt, "Bitmaps kept after the frame");
+    lv_test_assert_int_lt(LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE + 1, stat2.used_size, "Size of the cached bitmaps");
+
+    bool fit = stat2.miss_cnt - stat1.miss_cnt == stat2.entry_cnt;
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat1);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat2);
+    lv_test_assert_int_eq(0, memcmp(ref, chart_fb, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t)),
+                          "Frame drawn with the cached bitmaps");
+    if(fit) {
+        lv_test_assert_int_eq(stat1.miss_cnt, stat2.miss_cnt, "No bitmap unpacked in the second frame");
+    }
+    else {
+        lv_test_assert_int_lt(LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE + 1, stat2.used_size, "Size of the replaced bitmaps");
+    }
+
+    /*Out of memory only the bitmap drawn last is kept*/
+    lv_test_assert_int_eq(true, _lv_font_fmt_txt_glyph_cache_release(), "Release the cached bitmaps");
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat2);
+    lv_test_assert_int_eq(1, stat2.entry_cnt, "Bitmaps after releasing the cache");
+    lv_test_assert_int_eq(false, _lv_font_fmt_txt_glyph_cache_release(), "Release the last bitmap");
+
+    lv_obj_del(label);
+    lv_font_fmt_txt_glyph_cache_clear();
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat2);
+    lv_test_assert_int_eq(0, stat2.entry_cnt, "Bitmaps after clearing the cache");
+    lv_test_assert_int_eq(0, stat2.used_size, "Size after clearing the cache");
+
+    free(ref);
+    free(chart_fb);
+    chart_fb = NULL;
+    disp->driver.flush_cb = flush_cb_ori;
+}
+#endif
+
+#if LV_LABEL_CELLS
+static void label_cells(void)
+{
+    lv_test_print("");
+    lv_test_print("Label cells:");
+    lv_test_print("------------");
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(label, 20, 20);
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t cell_w = 0;
+    uint32_t d;
+    for(d = '0'; d <= '9'; d++) {
+        cell_w = LV_MATH_MAX(cell_w, lv_font_get_glyph_width(font, d, '\0'));
+    }
+    lv_label_set_align(label, LV_LABEL_ALIGN_RIGHT);
+    lv_label_set_cells(label, 6, cell_w);
+    lv_label_set_text(label, "56.78");
+    lv_coord_t w = lv_obj_get_width(label);
+    lv_coord_t h = lv_obj_get_height(label);
+    lv_test_assert_int_eq(6 * cell_w, w, "Width of a label with cells");
+    lv_test_assert_int_eq(lv_font_get_line_height(font), h, "Height of a label with cells");
+
+    lv_color_t * prev = malloc(LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+    uint32_t miss_cnt = 0;
+
+    /*Growing, shrinking, an empty and a too long text*/
+    static const char * right_values[] = {"56.79", "56.80", "123.4", "9.99", "10.00", "", "1.1", "1234.567", "99.98"};
+    uint32_t i;
+    for(i = 0; i < sizeof(right_values) / sizeof(right_values[0]); i++) {
+        label_cells_check(label, right_values[i], prev, &miss_cnt);
+    }
+    lv_test_assert_int_eq(w, lv_obj_get_width(label), "The width is kept");
+    lv_test_assert_int_eq(h, lv_obj_get_height(label), "The height is kept");
+
+    /*Only the cell of the last digit changes*/
+    uint32_t inv_px = label_cells_check(label, "99.97", prev, &miss_cnt);
+    lv_test_assert_int_lt(2 * cell_w * h, inv_px, "Pixels invalidated by a changed digit");
+
+    lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
+    static const char * center_values[] = {"42%", "7%", "100%", "34.5%", "34.6%"};
+    for(i = 0; i < sizeof(center_values) / sizeof(center_values[0]); i++) {
+        label_cells_check(label, center_values[i], prev, &miss_cnt);
+    }
+
+    lv_test_assert_int_eq(0, miss_cnt, "Changed pixels outside of the invalidated areas");
+
+    /*Back to the normal letters and size*/
+    lv_label_set_cells(label, 0, 0);
+    lv_point_t size;
+    _lv_txt_get_size(&size, lv_label_get_text(label), font, 0, 0, LV_COORD_MAX, LV_TXT_FLAG_FIT);
+    lv_test_assert_int_eq(size.x, lv_obj_get_width(label), "Width without cells");
+
+    free(prev);
+    lv_obj_clean(lv_scr_act());
+}
+
+/**
+ * Set a new text for a label with cells and check that every pixel which changed was invalidated
+ * @param label the label to change
+ * @param txt the new text
+ * @param prev a screen sized buffer for the previous frame
+ * @param miss_cnt increment with the changed pixels which are not in an invalidated area
+ * @return number of invalidated pixels
+ */
+static uint32_t label_cells_check(lv_obj_t * label, const char * txt, lv_color_t * prev, uint32_t * miss_cnt)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_color_t * screen_buf = disp->driver.buffer->buf1;
+
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+    _lv_memcpy(prev, screen_buf, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_label_set_text(label, txt);
+
+    uint32_t inv_px = 0;
+    lv_area_t inv_areas[LV_INV_BUF_SIZE];
+    uint16_t inv_cnt = disp->inv_p;
+    uint16_t i;
+    for(i = 0; i < inv_cnt; i++) {
+        inv_areas[i] = disp->inv_areas[i];
+        inv_px += lv_area_get_size(&inv_areas[i]);
+    }
+
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < LV_VER_RES; y++) {
+        for(x = 0; x < LV_HOR_RES; x++) {
+            uint32_t p = (uint32_t)y * LV_HOR_RES + x;
+            if(prev[p].full == screen_buf[p].full) continue;
+
+            lv_point_t point = {x, y};
+            bool inv = false;
+            for(i = 0; i < inv_cnt && !inv; i++) {
+                inv = _lv_area_is_point_on(&inv_areas[i], &point, 0);
+            }
+            if(!inv) (*miss_cnt)++;
+        }
+    }
+
+    return inv_px;
+}
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <sys/time.h>
 #include "lv_test_core/lv_test_core.h"
+#include "lv_test_draw/lv_test_draw.h"
 
 #if LV_BUILD_TEST
 
@@ -18,6 +19,10 @@ int main(void)
 
     lv_test_core();
 
+#ifdef LV_TEST_DRAW
+    lv_test_draw();
+#endif
+
     printf("Exit with success!\n");
     return 0;
 }
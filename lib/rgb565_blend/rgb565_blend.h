@@ -0,0 +1,119 @@
+/**
+ * @file rgb565_blend.h
+ * Alpha blending of RGB565 pixels with 32 bit SWAR (SIMD within a register) arithmetic.
+ * Shared by the blend paths of LVGL (lv_draw_blend.c) and TFT_eSPI (alphaBlend).
+ *
+ * The red, green and blue fields are spread in a 32 bit word so that every field has
+ * 5 free bits above it. This way all fields can be multiplied by a 0..32 alpha at once.
+ * A 32 bit word holding two pixels is split into two such "lanes":
+ * - lane A: blue and red of the lower pixel, green of the upper pixel (`word & 0x07E0F81F`)
+ * - lane B: green of the lower pixel, blue and red of the upper pixel (`(word >> 5) & 0x07C0F83F`)
+ * so blending two pixels needs 4 multiplications instead of 6 per pixel.
+ * Nothing depends on the byte order.
+ */
+
+#ifndef RGB565_BLEND_H
+#define RGB565_BLEND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RGB565_LANE_A       0x07E0F81FUL
+#define RGB565_LANE_B       0x07C0F83FUL
+/*Half of the alpha step added to every field to round to nearest*/
+#define RGB565_ROUND_A      0x02008010UL
+#define RGB565_ROUND_B      0x04008010UL
+
+#define RGB565_ALPHA_MAX    32
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Convert an 8 bit alpha (0..255) to the 0..32 range used by the kernels.
+ * 0 and 255 are kept exact.
+ * @param alpha 0: background only, 255: foreground only
+ * @return alpha in 0..32
+ */
+static inline uint32_t rgb565_alpha(uint8_t alpha)
+{
+    return ((uint32_t)alpha + 4) >> 3;
+}
+
+/**
+ * Pre-multiply a foreground pixel pair which is blended many times with the same alpha.
+ * @param fg2 two foreground pixels (the same color twice for fills)
+ * @param a alpha in 0..32 (see `rgb565_alpha`)
+ * @param pre_a lane A of the result, to pass to `rgb565_blend2_premult`
+ * @param pre_b lane B of the result, to pass to `rgb565_blend2_premult`
+ */
+static inline void rgb565_premult2(uint32_t fg2, uint32_t a, uint32_t * pre_a, uint32_t * pre_b)
+{
+    *pre_a = (fg2 & RGB565_LANE_A) * a + RGB565_ROUND_A;
+    *pre_b = ((fg2 >> 5) & RGB565_LANE_B) * a + RGB565_ROUND_B;
+}
+
+/**
+ * Blend two background pixels with a pre-multiplied foreground.
+ * @param pre_a lane A from `rgb565_premult2`
+ * @param pre_b lane B from `rgb565_premult2`
+ * @param bg2 two background pixels
+ * @param a_inv `RGB565_ALPHA_MAX - a`
+ * @return the two blended pixels
+ */
+static inline uint32_t rgb565_blend2_premult(uint32_t pre_a, uint32_t pre_b, uint32_t bg2, uint32_t a_inv)
+{
+    uint32_t la = (pre_a + (bg2 & RGB565_LANE_A) * a_inv) >> 5;
+    uint32_t lb = pre_b + ((bg2 >> 5) & RGB565_LANE_B) * a_inv;
+    return (la & RGB565_LANE_A) | (lb & (RGB565_LANE_B << 5));
+}
+
+/**
+ * Blend two pixel pairs with the same alpha.
+ * @param fg2 two foreground pixels
+ * @param bg2 two background pixels
+ * @param a alpha in 0..32 (see `rgb565_alpha`)
+ * @return the two blended pixels
+ */
+static inline uint32_t rgb565_blend2(uint32_t fg2, uint32_t bg2, uint32_t a)
+{
+    uint32_t pre_a;
+    uint32_t pre_b;
+    rgb565_premult2(fg2, a, &pre_a, &pre_b);
+    return rgb565_blend2_premult(pre_a, pre_b, bg2, RGB565_ALPHA_MAX - a);
+}
+
+/**
+ * Blend a single pixel. Lane A of the pixel duplicated to both halves holds all of its fields.
+ * @param fg foreground pixel
+ * @param bg background pixel
+ * @param a alpha in 0..32 (see `rgb565_alpha`)
+ * @return the blended pixel
+ */
+static inline uint16_t rgb565_blend(uint16_t fg, uint16_t bg, uint32_t a)
+{
+    uint32_t f = ((uint32_t)fg | ((uint32_t)fg << 16)) & RGB565_LANE_A;
+    uint32_t b = ((uint32_t)bg | ((uint32_t)bg << 16)) & RGB565_LANE_A;
+    uint32_t r = ((f * a + b * (RGB565_ALPHA_MAX - a) + RGB565_ROUND_A) >> 5) & RGB565_LANE_A;
+    return (uint16_t)(r | (r >> 16));
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*RGB565_BLEND_H*/
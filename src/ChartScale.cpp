@@ -0,0 +1,106 @@
+#include "ChartScale.h"
+
+#include <math.h>
+
+// 图表坐标对应的数值
+static double unmap(const ChartScale &scale, lv_coord_t y)
+{
+    if (!scale.log)
+        return y;
+
+    return pow(10.0, (double)y / CHART_SCALE_LOG_UNIT) - 1.0;
+}
+
+static void applyRange(ChartScale &scale)
+{
+    lv_chart_set_range(scale.chart, 0, chartScaleMap(scale, scale.top));
+    scale.change_cnt++;
+}
+
+void chartScaleInit(ChartScale &scale, lv_obj_t *chart, bool log)
+{
+    scale.chart = chart;
+    scale.log = log;
+    scale.top = CHART_SCALE_MIN_TOP;
+    scale.shrink_start = 0;
+    scale.shrinking = false;
+    scale.change_cnt = 0;
+    applyRange(scale);
+}
+
+lv_coord_t chartScaleMap(const ChartScale &scale, double value)
+{
+    double y = value;
+    if (scale.log)
+    {
+        // log10(1 + x): 0 仍然是 0, 负值与正值对称
+        y = log10(1.0 + fabs(value)) * CHART_SCALE_LOG_UNIT;
+        if (value < 0)
+            y = -y;
+    }
+
+    // 超出坐标范围时饱和, 而不是回绕
+    y = floor(y + 0.5);
+    if (y > LV_COORD_MAX)
+        return LV_COORD_MAX;
+    if (y < LV_COORD_MIN)
+        return LV_COORD_MIN;
+    return (lv_coord_t)y;
+}
+
+bool chartScaleUpdate(ChartScale &scale, lv_coord_t y_max)
+{
+    uint32_t top = chartScaleNiceCeil(unmap(scale, y_max));
+    if (top < CHART_SCALE_MIN_TOP)
+        top = CHART_SCALE_MIN_TOP;
+
+    // 变大时立即生效, 曲线不能超出图表
+    if (top > scale.top)
+    {
+        scale.top = top;
+        scale.shrinking = false;
+        applyRange(scale);
+        return true;
+    }
+
+    if (top == scale.top)
+    {
+        scale.shrinking = false;
+        return false;
+    }
+
+    // 变小时等待一段时间, 短暂的空闲不会让范围来回变化
+    if (!scale.shrinking)
+    {
+        scale.shrinking = true;
+        scale.shrink_start = lv_tick_get();
+        return false;
+    }
+
+    if (lv_tick_elaps(scale.shrink_start) < CHART_SCALE_HOLD_MS)
+        return false;
+
+    scale.top = top;
+    scale.shrinking = false;
+    applyRange(scale);
+    return true;
+}
+
+uint32_t chartScaleNiceCeil(double value)
+{
+    uint32_t decade = 1;
+    while (true)
+    {
+        if (value <= decade)
+            return decade;
+        if (value <= 2 * decade)
+            return 2 * decade;
+
+        // uint32_t 能表示的最大的 1-2-5 数是 2e9, 更大的值返回 2e9
+        if (decade == 1000000000)
+            return 2 * decade;
+        if (value <= 5 * decade)
+            return 5 * decade;
+        decade *= 10;
+    }
+}
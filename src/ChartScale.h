@@ -0,0 +1,42 @@
+#ifndef __CHART_SCALE_H
+#define __CHART_SCALE_H
+
+#include <lvgl.h>
+
+// 范围缩小前, 较小的上限需要保持的时间 [ms]
+#define CHART_SCALE_HOLD_MS 10000
+// 上限的最小值, 与数据的单位相同
+#define CHART_SCALE_MIN_TOP 10
+// 对数刻度下每个数量级占的图表坐标
+#define CHART_SCALE_LOG_UNIT 100
+
+// Auto range of a chart whose samples are all >= 0 (negative samples are drawn below the plot).
+// The top of the range is a 1-2-5 number (10, 20, 50, 100, ...) above the largest sample:
+// it grows as soon as a sample doesn't fit, but shrinks only when a smaller top was enough for CHART_SCALE_HOLD_MS.
+// So lv_chart_set_range(), which redraws the whole chart, is called only when the magnitude of the data changes.
+// With the log scale the samples are stored as log10(1 + value) * CHART_SCALE_LOG_UNIT,
+// so K/s and G/s fit on the same chart and into lv_coord_t.
+struct ChartScale
+{
+    lv_obj_t *chart;
+    bool log;
+    uint32_t top;          // 当前范围的上限, 数据的单位
+    uint32_t shrink_start; // 开始可以缩小的时刻 (lv_tick_get())
+    bool shrinking;
+    uint32_t change_cnt;   // lv_chart_set_range() 的次数
+};
+
+// Sets the smallest range on the chart
+void chartScaleInit(ChartScale &scale, lv_obj_t *chart, bool log);
+
+// Chart coordinate of a sample, pass it to lv_chart_set_next()
+lv_coord_t chartScaleMap(const ChartScale &scale, double value);
+
+// Adjust the range to the largest chart coordinate of the shown samples.
+// Call it when the samples change. Returns true if the range has changed.
+bool chartScaleUpdate(ChartScale &scale, lv_coord_t y_max);
+
+// The smallest 1-2-5 number >= value, at most 2e9 (the largest one in uint32_t) for larger values
+uint32_t chartScaleNiceCeil(double value);
+
+#endif
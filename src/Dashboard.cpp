@@ -0,0 +1,470 @@
+#include "Dashboard.h"
+#include "ChartScale.h"
+
+#include <stdlib.h>
+
+LV_FONT_DECLARE(tencent_w7_22)
+LV_FONT_DECLARE(tencent_w7_24)
+
+// 定义页面
+static lv_obj_t *loading_page = NULL;
+static lv_obj_t *monitor_page = NULL;
+
+static lv_obj_t *ip_label;
+static lv_obj_t *loading_label;
+
+// upload
+static lv_obj_t *up_speed_label;
+static lv_obj_t *up_speed_unit_label;
+
+// download
+static lv_obj_t *down_speed_label;
+static lv_obj_t *down_speed_unit_label;
+
+// cpu
+static lv_obj_t *cpu_bar;
+static lv_obj_t *cpu_value_label;
+
+// memory
+static lv_obj_t *mem_bar;
+static lv_obj_t *mem_value_label;
+
+// temperature
+static lv_obj_t *temp_arc;
+static lv_obj_t *temp_value_label;
+static lv_style_t temp_arc_style;
+static bool temp_arc_hot = true; // 与创建时的颜色一致
+
+// 吞吐量图表的点数
+#define CHART_POINTS 10
+
+static lv_obj_t *chart_network;
+static lv_chart_series_t *up_line;
+static lv_chart_series_t *down_line;
+// 图表直接读写的环形缓冲区, 新的点由 lv_chart_set_next() 写入
+static lv_coord_t up_serise[CHART_POINTS] = {0};
+static lv_coord_t down_serise[CHART_POINTS] = {0};
+
+#if LV_USE_FONT_ATLAS && DASHBOARD_FONT_ATLAS
+// 每秒都会变化的数值标签的字形, 绘制时不再解码字体
+static lv_font_atlas_t atlas_22;
+#endif
+
+static ChartScale chart_scale;
+static lv_coord_t up_speed_max = 0;
+static lv_coord_t down_speed_max = 0;
+
+static void setSpeedLabel(double speed, lv_obj_t *speed_label, lv_obj_t *unit_label)
+{
+    const char *unit;
+    const char *format;
+
+    if (speed < 100.0)
+    {
+        format = "%.2f";
+        unit = "K/s";
+    }
+    else if (speed < 1000.0)
+    {
+        format = "%.1f";
+        unit = "K/s";
+    }
+    else if (speed < 100000.0)
+    {
+        speed /= 1024.0;
+        format = "%.2f";
+        unit = "M/s";
+    }
+    else if (speed < 1000000.0)
+    {
+        speed /= 1024.0;
+        format = "%.1f";
+        unit = "M/s";
+    }
+    else
+    {
+        speed /= (1024.0 * 1024.0);
+        format = "%.2f";
+        unit = "G/s";
+    }
+
+    lv_label_set_text_fmt(speed_label, format, speed);
+    lv_label_set_text(unit_label, unit);
+}
+
+static void updateChartRange()
+{
+    chartScaleUpdate(chart_scale, LV_MATH_MAX(down_speed_max, up_speed_max));
+}
+
+static lv_coord_t getSeriesMax(const lv_coord_t *series)
+{
+    lv_coord_t max = series[0];
+    for (int i = 1; i < CHART_POINTS; i++)
+    {
+        if (max < series[i])
+            max = series[i];
+    }
+    return max;
+}
+
+void dashboardSetChartScrollCb(lv_chart_scroll_cb_t scroll_cb)
+{
+    lv_chart_set_scroll_cb(chart_network, scroll_cb);
+}
+
+void dashboardPushDownSpeed(double speed)
+{
+    lv_chart_set_next(chart_network, down_line, chartScaleMap(chart_scale, speed));
+    down_speed_max = getSeriesMax(down_serise);
+}
+
+void dashboardPushUpSpeed(double speed)
+{
+    lv_chart_set_next(chart_network, up_line, chartScaleMap(chart_scale, speed));
+    up_speed_max = getSeriesMax(up_serise);
+}
+
+uint32_t dashboardGetChartRangeChanges()
+{
+    return chart_scale.change_cnt;
+}
+
+void dashboardShowMonitor()
+{
+    // 每次取到数据都会调用, 已经显示时不能再设置: lv_obj_set_hidden() 会使整个页面重绘
+    if (loading_page == NULL && !lv_obj_get_hidden(monitor_page))
+        return;
+
+    // 加载页面不会再显示, 删除它以停止spinner的动画并释放内存
+    if (loading_page)
+    {
+        lv_obj_del(loading_page);
+        loading_page = NULL;
+        loading_label = NULL;
+    }
+    lv_obj_set_hidden(monitor_page, false);
+}
+
+void dashboardSetLoadingText(const char *text)
+{
+    if (loading_label)
+        lv_label_set_text(loading_label, text);
+}
+
+void dashboardUpdate(const DashboardMetrics &metrics)
+{
+    // 范围不变时不重绘图表, 新的点只重绘曲线区域
+    updateChartRange();
+
+    setSpeedLabel(metrics.up_speed, up_speed_label, up_speed_unit_label);
+    setSpeedLabel(metrics.down_speed, down_speed_label, down_speed_unit_label);
+
+    lv_label_set_text(ip_label, metrics.ip);
+    lv_bar_set_value(cpu_bar, metrics.cpu_usage, LV_ANIM_OFF);
+    lv_label_set_text_fmt(cpu_value_label, "%2.1f%%", metrics.cpu_usage);
+
+    lv_bar_set_value(mem_bar, metrics.mem_usage, LV_ANIM_OFF);
+    lv_label_set_text_fmt(mem_value_label, "%2.0f%%", metrics.mem_usage);
+
+    lv_label_set_text_fmt(temp_value_label, "%2.0f°C", metrics.temp_value);
+    uint16_t end_value = 120 + 300 * metrics.temp_value / 100.0;
+    // 颜色只在越过阈值时更新: 刷新样式会重绘整个圆弧,
+    // 而 lv_arc_set_end_angle() 只重绘变化的扇区
+    bool arc_hot = metrics.temp_value > 75;
+    if (arc_hot != temp_arc_hot)
+    {
+        temp_arc_hot = arc_hot;
+        lv_color_t arc_color = arc_hot ? lv_color_hex(0xff5d18) : lv_color_hex(0x50ff7d);
+        lv_style_set_line_color(&temp_arc_style, LV_STATE_DEFAULT, arc_color);
+        lv_obj_refresh_style(temp_arc, LV_STYLE_LINE_COLOR);
+    }
+    lv_arc_set_end_angle(temp_arc, end_value);
+}
+
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+// 数字的格子与最宽的数字一样宽, 其它字符保持原来的宽度
+static void setDigitCells(lv_obj_t *label, uint8_t cell_cnt)
+{
+    const lv_font_t *font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t cell_w = 0;
+    for (uint32_t digit = '0'; digit <= '9'; digit++)
+        cell_w = LV_MATH_MAX(cell_w, lv_font_get_glyph_width(font, digit, '\0'));
+
+    lv_label_set_cells(label, cell_cnt, cell_w);
+}
+#endif
+
+#if LV_USE_FONT_ATLAS && DASHBOARD_FONT_ATLAS
+static void createFontAtlas(lv_font_atlas_t *atlas, const lv_font_t *font, const char *letters)
+{
+    uint32_t size = lv_font_atlas_get_buf_size(font, letters);
+    if (size == 0)
+        return;
+
+    // LVGL 的内存池太小, 使用堆; 页面一直存在, 不需要释放
+    void *buf = malloc(size);
+    if (buf == NULL)
+        return;
+
+    if (!lv_font_atlas_create(atlas, font, letters, buf, size))
+        free(buf);
+}
+#endif
+
+void dashboardCreate()
+{
+#if LV_USE_FONT_ATLAS && DASHBOARD_FONT_ATLAS
+    // 速度, CPU 和内存的数值; 温度变化较慢, 不使用
+    createFontAtlas(&atlas_22, &tencent_w7_22, "0123456789.%");
+#endif
+
+    // 使用默认字体
+    static lv_style_t font_default;
+    lv_style_init(&font_default);
+    lv_style_set_text_font(&font_default, LV_STATE_DEFAULT, &lv_font_unscii_8);
+
+    static lv_style_t font_22;
+    lv_style_init(&font_22);
+    lv_style_set_text_font(&font_22, LV_STATE_DEFAULT, &tencent_w7_22);
+
+    static lv_style_t font_24;
+    lv_style_init(&font_24);
+    lv_style_set_text_font(&font_24, LV_STATE_DEFAULT, &tencent_w7_24);
+
+    static lv_style_t iconfont;
+    lv_style_init(&iconfont);
+    lv_style_set_text_font(&iconfont, LV_STATE_DEFAULT, &iconfont_symbol);
+
+    // loading
+    loading_page = lv_cont_create(lv_scr_act(), NULL);
+    lv_obj_set_size(loading_page, 240, 240);
+    lv_obj_set_style_local_bg_color(loading_page, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+    lv_obj_set_style_local_border_color(loading_page, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
+    lv_obj_set_style_local_radius(loading_page, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    // spinner
+    lv_obj_t *spinner = lv_spinner_create(loading_page, NULL);
+    lv_obj_set_size(spinner, 100, 100);
+    lv_obj_align(spinner, NULL, LV_ALIGN_CENTER, 0, 0);
+
+    loading_label = lv_label_create(loading_page, NULL);
+    lv_obj_add_style(loading_label, LV_LABEL_PART_MAIN, &font_default);
+    lv_label_set_text(loading_label, "Loading ...");
+    lv_obj_set_width(loading_label, lv_obj_get_width(lv_scr_act()));
+    lv_obj_align(loading_label, NULL, LV_ALIGN_CENTER, 0, 70);
+    lv_obj_set_auto_realign(loading_label, true);
+    lv_obj_set_hidden(loading_page, false);
+
+    // monitor
+    monitor_page = lv_cont_create(lv_scr_act(), NULL);
+    lv_obj_set_size(monitor_page, 240, 240);
+    lv_obj_t *bg = lv_obj_create(monitor_page, NULL);
+    lv_obj_clean_style_list(bg, LV_OBJ_PART_MAIN);
+    lv_obj_set_style_local_bg_opa(bg, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_100);
+    lv_color_t bg_color = lv_color_hex(0x7381a2);
+    lv_obj_set_style_local_bg_color(bg, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, bg_color);
+    lv_obj_set_size(bg, LV_HOR_RES_MAX, LV_VER_RES_MAX);
+    lv_obj_set_hidden(monitor_page, true);
+
+    lv_color_t cont_color = lv_color_hex(0x081418);
+    lv_obj_t *cont = lv_cont_create(monitor_page, NULL);
+    lv_obj_set_auto_realign(cont, true);
+    lv_obj_set_width(cont, 230);
+    lv_obj_set_height(cont, 120);
+    lv_obj_set_pos(cont, 5, 5);
+
+    lv_cont_set_fit(cont, LV_FIT_TIGHT);
+    lv_cont_set_layout(cont, LV_LAYOUT_COLUMN_MID);
+    lv_obj_set_style_local_border_color(cont, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, cont_color);
+    lv_obj_set_style_local_bg_color(cont, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, cont_color);
+
+    ip_label = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(ip_label, 10, 220);
+    lv_label_set_text(ip_label, "0.0.0.0");
+
+    lv_obj_t *up_label = lv_label_create(monitor_page, NULL);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    lv_obj_set_pos(up_label, 8, 18);
+#else
+    lv_obj_set_pos(up_label, 10, 18);
+#endif
+    lv_obj_add_style(up_label, LV_LABEL_PART_MAIN, &iconfont);
+    lv_label_set_text(up_label, CUSTOM_SYMBOL_UPLOAD);
+    lv_color_t speed_label_color = lv_color_hex(0x838a99);
+    lv_obj_set_style_local_text_color(up_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+
+    lv_obj_t *down_label = lv_label_create(monitor_page, NULL);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    lv_obj_set_pos(down_label, 121, 18);
+#else
+    lv_obj_set_pos(down_label, 120, 18);
+#endif
+    lv_obj_add_style(down_label, LV_LABEL_PART_MAIN, &iconfont);
+    lv_label_set_text(down_label, CUSTOM_SYMBOL_DOWNLOAD);
+    speed_label_color = lv_color_hex(0x838a99);
+    lv_obj_set_style_local_text_color(down_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_GREEN);
+
+    // Upload & Download Speed Display
+    up_speed_label = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(up_speed_label, 30, 15);
+    lv_label_set_text(up_speed_label, "56.78");
+    lv_obj_add_style(up_speed_label, LV_LABEL_PART_MAIN, &font_22);
+    lv_obj_set_style_local_text_color(up_speed_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    // 最多 4 位数字和小数点, 右对齐到单位前面
+    lv_label_set_align(up_speed_label, LV_LABEL_ALIGN_RIGHT);
+    setDigitCells(up_speed_label, 5);
+    lv_obj_set_pos(up_speed_label, 94 - lv_obj_get_width(up_speed_label), 15);
+#endif
+
+    up_speed_unit_label = lv_label_create(monitor_page, NULL);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    lv_obj_set_pos(up_speed_unit_label, 94, 18);
+#else
+    lv_obj_set_pos(up_speed_unit_label, 90, 18);
+#endif
+    lv_label_set_text(up_speed_unit_label, "K/S");
+    lv_obj_set_style_local_text_color(up_speed_unit_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, speed_label_color);
+
+    down_speed_label = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(down_speed_label, 142, 15);
+    lv_label_set_text(down_speed_label, "12.34");
+    lv_obj_add_style(down_speed_label, LV_LABEL_PART_MAIN, &font_22);
+    lv_obj_set_style_local_text_color(down_speed_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    lv_label_set_align(down_speed_label, LV_LABEL_ALIGN_RIGHT);
+    setDigitCells(down_speed_label, 5);
+    lv_obj_set_pos(down_speed_label, 207 - lv_obj_get_width(down_speed_label), 15);
+#endif
+
+    down_speed_unit_label = lv_label_create(monitor_page, NULL);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    lv_obj_set_pos(down_speed_unit_label, 207, 18);
+#else
+    lv_obj_set_pos(down_speed_unit_label, 202, 18);
+#endif
+    lv_label_set_text(down_speed_unit_label, "M/S");
+    lv_obj_set_style_local_text_color(down_speed_unit_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, speed_label_color);
+
+    /*Create a chart_network*/
+    chart_network = lv_chart_create(monitor_page, NULL);
+    lv_obj_set_size(chart_network, 220, 70);
+    lv_obj_align(chart_network, NULL, LV_ALIGN_CENTER, 0, -40);
+    lv_chart_set_type(chart_network, LV_CHART_TYPE_LINE);
+    chartScaleInit(chart_scale, chart_network, DASHBOARD_CHART_LOG_SCALE);
+    lv_chart_set_point_count(chart_network, CHART_POINTS);
+    lv_chart_set_update_mode(chart_network, LV_CHART_UPDATE_MODE_SHIFT);
+
+    // 曲线区域的宽度是点间隔的整数倍, 新的点使曲线移动整数像素, 图表才能滚动而不必整个重绘
+    lv_coord_t pad_right = lv_obj_get_style_pad_right(chart_network, LV_CHART_PART_BG);
+    lv_coord_t series_w = lv_obj_get_width(chart_network) - lv_obj_get_style_pad_left(chart_network, LV_CHART_PART_BG) -
+                          pad_right;
+    lv_obj_set_style_local_pad_right(chart_network, LV_CHART_PART_BG, LV_STATE_DEFAULT,
+                                     pad_right + series_w % (CHART_POINTS - 1));
+
+    /*Add a faded are effect*/
+    lv_obj_set_style_local_bg_opa(chart_network, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_50); /*Max. opa.*/
+    lv_obj_set_style_local_bg_grad_dir(chart_network, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+    lv_obj_set_style_local_bg_main_stop(chart_network, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 255); /*Max opa on the top*/
+    lv_obj_set_style_local_bg_grad_stop(chart_network, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);   /*Transparent on the bottom*/
+
+    /*Add two data series*/
+    up_line = lv_chart_add_series(chart_network, LV_COLOR_RED);
+    down_line = lv_chart_add_series(chart_network, LV_COLOR_GREEN);
+
+    lv_chart_set_ext_array(chart_network, up_line, up_serise, CHART_POINTS);
+    lv_chart_set_ext_array(chart_network, down_line, down_serise, CHART_POINTS);
+
+    // 绘制进度条 CPU 占用
+    lv_obj_t *cpu_title = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(cpu_title, 5, 140);
+    lv_label_set_text(cpu_title, "CPU");
+    lv_obj_set_style_local_text_color(cpu_title, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+
+    cpu_value_label = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(cpu_value_label, 85, 135);
+    lv_label_set_text(cpu_value_label, "34%");
+    lv_obj_add_style(cpu_value_label, LV_LABEL_PART_MAIN, &font_22);
+    lv_obj_set_style_local_text_color(cpu_value_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    // "100.0%"
+    setDigitCells(cpu_value_label, 6);
+#endif
+
+    cpu_bar = lv_bar_create(monitor_page, NULL);
+    lv_obj_set_size(cpu_bar, 130, 10);
+    lv_obj_set_pos(cpu_bar, 5, 160);
+
+    lv_color_t cpu_bar_bg_color = lv_color_hex(0x1e3644);
+    lv_color_t cpu_bar_indic_color = lv_color_hex(0x63d0fc);
+    lv_obj_set_style_local_bg_color(cpu_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, cpu_bar_bg_color);
+    lv_obj_set_style_local_bg_color(cpu_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, cpu_bar_indic_color);
+    lv_obj_set_style_local_border_width(cpu_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, 2);
+    lv_obj_set_style_local_border_width(cpu_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, 2);
+
+    lv_obj_set_style_local_border_color(cpu_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, cont_color);
+    lv_obj_set_style_local_border_color(cpu_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, cont_color);
+    lv_obj_set_style_local_border_side(cpu_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, LV_BORDER_SIDE_LEFT | LV_BORDER_SIDE_TOP | LV_BORDER_SIDE_BOTTOM);
+    lv_obj_set_style_local_radius(cpu_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, 2);
+    lv_obj_set_style_local_radius(cpu_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, 0);
+
+    // 绘制内存占用
+    lv_obj_t *men_title = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(men_title, 5, 180);
+    lv_label_set_text(men_title, "Memory");
+    lv_obj_set_style_local_text_color(men_title, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+
+    mem_value_label = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(mem_value_label, 85, 175);
+    lv_label_set_text(mem_value_label, "42%");
+    lv_obj_add_style(mem_value_label, LV_LABEL_PART_MAIN, &font_22);
+    lv_obj_set_style_local_text_color(mem_value_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+#if LV_LABEL_CELLS && DASHBOARD_DIGIT_CELLS
+    // "100%"
+    setDigitCells(mem_value_label, 5);
+#endif
+
+    mem_bar = lv_bar_create(monitor_page, NULL);
+    lv_obj_set_pos(mem_bar, 5, 200);
+    lv_obj_set_size(mem_bar, 130, 10);
+    lv_obj_set_style_local_bg_color(mem_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, cpu_bar_bg_color);
+    lv_obj_set_style_local_bg_color(mem_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, cpu_bar_indic_color);
+    lv_obj_set_style_local_border_width(mem_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, 2);
+    lv_obj_set_style_local_border_color(mem_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, cont_color);
+    lv_obj_set_style_local_border_width(mem_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, 2);
+    lv_obj_set_style_local_border_color(mem_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, cont_color);
+    lv_obj_set_style_local_border_side(mem_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, LV_BORDER_SIDE_LEFT | LV_BORDER_SIDE_TOP | LV_BORDER_SIDE_BOTTOM);
+    lv_obj_set_style_local_radius(mem_bar, LV_BAR_PART_BG, LV_STATE_DEFAULT, 2);
+    lv_obj_set_style_local_radius(mem_bar, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, 0);
+
+    // 绘制温度表盘
+    static lv_style_t arc_style;
+    lv_style_reset(&arc_style);
+    lv_style_init(&arc_style);
+    lv_style_set_bg_opa(&arc_style, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_style_set_border_opa(&arc_style, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_style_set_line_width(&arc_style, LV_STATE_DEFAULT, 100);
+    lv_style_set_line_color(&arc_style, LV_STATE_DEFAULT, lv_color_hex(0x081418));
+    lv_style_set_line_rounded(&arc_style, LV_STATE_DEFAULT, false);
+
+    lv_style_init(&temp_arc_style);
+    lv_style_set_line_width(&temp_arc_style, LV_STATE_DEFAULT, 5);
+    lv_style_set_pad_left(&temp_arc_style, LV_STATE_DEFAULT, 5);
+    lv_style_set_line_color(&temp_arc_style, LV_STATE_DEFAULT, lv_color_hex(0xff5d18));
+    temp_arc_hot = true;
+
+    temp_arc = lv_arc_create(monitor_page, NULL);
+    lv_arc_set_bg_angles(temp_arc, 0, 360);
+    lv_arc_set_start_angle(temp_arc, 120);
+    lv_obj_set_pos(temp_arc, 125, 120);
+    lv_obj_set_size(temp_arc, 125, 125);
+    lv_arc_set_end_angle(temp_arc, 420);
+    lv_obj_add_style(temp_arc, LV_ARC_PART_BG, &arc_style);
+    lv_obj_add_style(temp_arc, LV_ARC_PART_INDIC, &temp_arc_style);
+
+    temp_value_label = lv_label_create(monitor_page, NULL);
+    lv_obj_set_pos(temp_value_label, 160, 170);
+    lv_label_set_text(temp_value_label, "72℃");
+    lv_obj_add_style(temp_value_label, LV_LABEL_PART_MAIN, &font_24);
+    lv_obj_set_style_local_text_color(temp_value_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+}
@@ -0,0 +1,57 @@
+#ifndef __DASHBOARD_H
+#define __DASHBOARD_H
+
+#include <lvgl.h>
+
+// 1: 吞吐量图表使用对数刻度, K/s 到 G/s 的速度都能看清
+#ifndef DASHBOARD_CHART_LOG_SCALE
+#define DASHBOARD_CHART_LOG_SCALE 0
+#endif
+
+// 1: 数值标签的数字从字形图集绘制, 约快一倍, 但一直占用约 8 KB 堆内存;
+// 每秒一次的更新只省约 85 us, 所以默认关闭
+#ifndef DASHBOARD_FONT_ATLAS
+#define DASHBOARD_FONT_ATLAS 0
+#endif
+
+// 1: 数值标签的数字等宽并且标签大小固定, 数值变化时只重绘变化的数字; 速度一栏因此稍宽
+#ifndef DASHBOARD_DIGIT_CELLS
+#define DASHBOARD_DIGIT_CELLS 1
+#endif
+
+// 一次刷新所需的全部监测数值
+struct DashboardMetrics
+{
+    double up_speed;   // K/s, 上传为负值
+    double down_speed; // K/s
+    double cpu_usage;  // %
+    double mem_usage;  // %
+    double temp_value; // °C
+    const char *ip;
+};
+
+// Builds the loading and monitor pages on the active screen.
+// Only LVGL calls are used here so the same layout can be rendered
+// off-device by the host benchmark in bench/.
+void dashboardCreate();
+
+// Switches to the monitor page. The loading page is deleted, so its spinner
+// animation stops and the loop can sleep. Does nothing while the monitor page is
+// shown, so it can be called after every fetch without redrawing the page.
+void dashboardShowMonitor();
+void dashboardSetLoadingText(const char *text);
+
+// Move the drawn throughput plot with this function when a sample is shifted in, see lv_chart_set_scroll_cb()
+void dashboardSetChartScrollCb(lv_chart_scroll_cb_t scroll_cb);
+
+// Shift a new sample into the throughput chart series
+void dashboardPushUpSpeed(double speed);
+void dashboardPushDownSpeed(double speed);
+
+// Apply the latest metrics to labels, bars, chart range and the temperature arc
+void dashboardUpdate(const DashboardMetrics &metrics);
+
+// How many times the range of the throughput chart has changed, each change redraws the whole chart
+uint32_t dashboardGetChartRangeChanges();
+
+#endif
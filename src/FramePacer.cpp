@@ -0,0 +1,60 @@
+#include "FramePacer.h"
+
+static void (*user_monitor_cb)(lv_disp_drv_t *, uint32_t, uint32_t) = NULL;
+
+static uint32_t frame_cnt = 0;
+static uint32_t px_cnt = 0;
+static uint32_t stats_start = 0;
+
+// 每完成一帧 LVGL 调用一次
+static void frameMonitor(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    frame_cnt++;
+    px_cnt += px;
+
+    if (user_monitor_cb)
+        user_monitor_cb(drv, time, px);
+}
+
+void framePacerInit(lv_disp_drv_t *drv)
+{
+    user_monitor_cb = drv->monitor_cb;
+    drv->monitor_cb = frameMonitor;
+
+    frame_cnt = 0;
+    px_cnt = 0;
+    stats_start = lv_tick_get();
+}
+
+uint32_t framePacerHandler(uint32_t max_sleep)
+{
+    // 没有任务就绪时返回 LV_NO_TASK_READY
+    uint32_t time_till_next = lv_task_handler();
+
+    // 刷新任务只在有区域失效时运行, 周期只限制最高帧率:
+    // 动画运行时放开, 否则降低, 避免连续的数据更新每次都单独刷一帧
+    lv_task_t *refr_task = _lv_disp_get_refr_task(NULL);
+    if (refr_task)
+    {
+        uint32_t period = lv_anim_count_running() ? FRAME_PACER_ANIM_PERIOD : FRAME_PACER_IDLE_PERIOD;
+        if (refr_task->period != period)
+            lv_task_set_period(refr_task, period);
+    }
+
+    return LV_MATH_MIN(time_till_next, max_sleep);
+}
+
+void framePacerGetStats(FramePacerStats &stats)
+{
+    uint32_t elaps = lv_tick_elaps(stats_start);
+    if (elaps == 0)
+        elaps = 1;
+
+    stats.fps = frame_cnt * 1000.0f / elaps;
+    stats.px = px_cnt;
+    stats.idle = lv_task_get_idle();
+
+    frame_cnt = 0;
+    px_cnt = 0;
+    stats_start = lv_tick_get();
+}
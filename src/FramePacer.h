@@ -0,0 +1,29 @@
+#ifndef __FRAME_PACER_H
+#define __FRAME_PACER_H
+
+#include <lvgl.h>
+
+// 动画运行时的刷新周期 [ms], 同时也是 LVGL 动画任务的周期
+#define FRAME_PACER_ANIM_PERIOD LV_DISP_DEF_REFR_PERIOD
+// 静止时的刷新周期 [ms], 数据每秒才更新一次, 不需要高帧率
+#define FRAME_PACER_IDLE_PERIOD 50
+
+// 上次调用 framePacerGetStats() 以来的统计
+struct FramePacerStats
+{
+    float fps;     // 实际完成的帧数/秒
+    uint32_t px;   // 刷新的像素数
+    uint8_t idle;  // lv_task_get_idle(), %
+};
+
+// Hooks the refresh monitor of the driver. Call it before lv_disp_drv_register().
+void framePacerInit(lv_disp_drv_t *drv);
+
+// Runs lv_task_handler() and picks the refresh period for the next frame.
+// Returns how many ms the caller may sleep before the next LVGL deadline,
+// but never more than `max_sleep`.
+uint32_t framePacerHandler(uint32_t max_sleep);
+
+void framePacerGetStats(FramePacerStats &stats);
+
+#endif
@@ -0,0 +1,169 @@
+#include "HeapTrace.h"
+
+#if HEAP_TRACE
+
+#include <lvgl.h>
+
+// The DRAM heap of umm_malloc, like umm_malloc_cfg.h
+extern "C" char _heap_start[];
+#define HEAP_TRACE_MALLOC_END 0x3FFFC000
+
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t n, size_t size);
+extern "C" void *__real_realloc(void *p, size_t size);
+extern "C" void __real_free(void *p);
+
+struct HeapEvent
+{
+    uint32_t ptr;    // 块的地址, 标记的 tag
+    uint32_t caller; // 调用者的返回地址, 标记的 millis()
+    uint16_t size;
+    char op;         // 'a': alloc, 'r': realloc (after the 'f' of the old block), 'f': free, 'm': mark
+    uint8_t heap;
+};
+
+static HeapEvent events[HEAP_TRACE_SIZE];
+static uint16_t event_first = 0;
+static uint16_t event_cnt = 0;
+static uint32_t dropped_cnt = 0;
+
+// Also called from the WiFi callbacks, so the interrupts are disabled while the buffer changes
+static void push(char op, uint8_t heap, const void *ptr, size_t size, uint32_t caller)
+{
+    uint32_t ps = xt_rsil(15);
+    if (event_cnt < HEAP_TRACE_SIZE)
+    {
+        HeapEvent &e = events[(event_first + event_cnt) % HEAP_TRACE_SIZE];
+        e.ptr = (uint32_t)ptr;
+        e.caller = caller;
+        e.size = size > 0xFFFF ? 0xFFFF : size;
+        e.op = op;
+        e.heap = heap;
+        event_cnt++;
+    }
+    else
+    {
+        dropped_cnt++;
+    }
+    xt_wsr_ps(ps);
+}
+
+// The calls like LV_MEM_TRACE_CB: the old block is freed before the new one is allocated
+static void record(uint8_t heap, void *old_p, void *new_p, size_t size, void *caller)
+{
+    uint32_t c = (uint32_t)caller;
+    char alloc_op = old_p ? 'r' : 'a';
+
+    // 失败时旧的块保留
+    if (new_p == NULL && size > 0)
+    {
+        push(alloc_op, heap, NULL, size, c);
+        return;
+    }
+
+    if (old_p)
+        push('f', heap, old_p, 0, c);
+    if (new_p)
+        push(alloc_op, heap, new_p, size, c);
+}
+
+extern "C" void *__wrap_malloc(size_t size)
+{
+    void *p = __real_malloc(size);
+    record(HEAP_TRACE_MALLOC, NULL, p, size, __builtin_return_address(0));
+    return p;
+}
+
+extern "C" void *__wrap_calloc(size_t n, size_t size)
+{
+    void *p = __real_calloc(n, size);
+    record(HEAP_TRACE_MALLOC, NULL, p, n * size, __builtin_return_address(0));
+    return p;
+}
+
+extern "C" void *__wrap_realloc(void *p, size_t size)
+{
+    void *new_p = __real_realloc(p, size);
+    record(HEAP_TRACE_MALLOC, p, new_p, size, __builtin_return_address(0));
+    return new_p;
+}
+
+extern "C" void __wrap_free(void *p)
+{
+    if (p)
+        record(HEAP_TRACE_MALLOC, p, NULL, 0, __builtin_return_address(0));
+    __real_free(p);
+}
+
+extern "C" void heapTraceLvMem(void *old_p, void *new_p, size_t size, void *caller)
+{
+    record(HEAP_TRACE_LV_MEM, old_p, new_p, size, caller);
+}
+
+void heapTraceBegin()
+{
+    uint32_t start = (uint32_t)_heap_start;
+    Serial.printf("@h%u %08x %x\n", HEAP_TRACE_MALLOC, start, HEAP_TRACE_MALLOC_END - start);
+    Serial.printf("@h%u %08x %x\n", HEAP_TRACE_LV_MEM, (uint32_t)_lv_mem_get_work_mem(), (uint32_t)LV_MEM_SIZE);
+    heapTraceFlush();
+}
+
+void heapTraceMark(const char *tag)
+{
+    push('m', 0, tag, 0, millis());
+}
+
+void heapTraceFlush()
+{
+    // Printing can allocate too, those events are sent in the next rounds
+    while (true)
+    {
+        uint32_t ps = xt_rsil(15);
+        if (event_cnt == 0)
+        {
+            xt_wsr_ps(ps);
+            break;
+        }
+        HeapEvent e = events[event_first];
+        event_first = (event_first + 1) % HEAP_TRACE_SIZE;
+        event_cnt--;
+        xt_wsr_ps(ps);
+
+        if (e.op == 'm')
+            Serial.printf("@m %u %s\n", e.caller, (const char *)e.ptr);
+        else if (e.op == 'f')
+            Serial.printf("@f%u %08x %08x\n", e.heap, e.ptr, e.caller);
+        else
+            Serial.printf("@%c%u %08x %x %08x\n", e.op, e.heap, e.ptr, e.size, e.caller);
+    }
+
+    uint32_t ps = xt_rsil(15);
+    uint32_t dropped = dropped_cnt;
+    dropped_cnt = 0;
+    xt_wsr_ps(ps);
+    if (dropped)
+        Serial.printf("@d %u\n", dropped);
+}
+
+void heapTraceStatus()
+{
+    heapTraceFlush();
+
+    uint32_t ms = millis();
+    Serial.printf("@s %u %u %u %u %u\n", ms, HEAP_TRACE_MALLOC, ESP.getFreeHeap(), ESP.getMaxFreeBlockSize(),
+                  ESP.getHeapFragmentation());
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    Serial.printf("@s %u %u %u %u %u\n", ms, HEAP_TRACE_LV_MEM, mon.free_size, mon.free_biggest_size, mon.frag_pct);
+}
+
+#else
+
+void heapTraceBegin() {}
+void heapTraceMark(const char *tag) {}
+void heapTraceFlush() {}
+void heapTraceStatus() {}
+extern "C" void heapTraceLvMem(void *old_p, void *new_p, size_t size, void *caller) {}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef __HEAP_TRACE_H
+#define __HEAP_TRACE_H
+
+#include <Arduino.h>
+
+// 1: 记录堆的分配和释放, 由串口输出给 tools/heap_trace.py.
+// The `nodemcuv2_heaptrace` environment of platformio.ini enables it together with `LV_MEM_TRACE`
+// and wraps malloc/realloc/calloc/free (String, ArduinoJson, new) with the linker.
+#ifndef HEAP_TRACE
+#define HEAP_TRACE 0
+#endif
+
+// Events kept until the next heapTraceFlush(), 12 bytes each. The newest ones are dropped if it's full.
+#ifndef HEAP_TRACE_SIZE
+#define HEAP_TRACE_SIZE 256
+#endif
+
+// The heaps in the trace
+#define HEAP_TRACE_MALLOC 0 // umm_malloc of the Arduino core
+#define HEAP_TRACE_LV_MEM 1 // the work memory of LVGL
+
+// Writes the address ranges of the heaps and the events recorded since the boot. Call it after lv_init().
+void heapTraceBegin();
+
+// Marks a point of the trace, e.g. the start of a request. `tag` must be a string literal.
+void heapTraceMark(const char *tag);
+
+// Writes the recorded events to Serial. It blocks until they are sent.
+void heapTraceFlush();
+
+// Writes the free size, the biggest free block and the fragmentation of both heaps, as the device sees them.
+void heapTraceStatus();
+
+// LV_MEM_TRACE_CB of lv_conf.h
+extern "C" void heapTraceLvMem(void *old_p, void *new_p, size_t size, void *caller);
+
+#endif
@@ -5,6 +5,8 @@
 #include <ArduinoJson.h>
 #include <string>
 
+#include "HeapTrace.h"
+
 WiFiManagerParameter netdata_host("host", "NetData Host", "192.168.8.1", 40);
 WiFiManagerParameter netdata_port("port", "NetData Port", "19999", 6);
 
@@ -85,6 +87,7 @@ void parseNetDataResponse(WiFiClient &client, NetDataResponse &data)
  */
 bool getNetDataInfoWithDimension(String chartID, NetDataResponse &data, String dimensions_filter)
 {
+    heapTraceMark("request");
     WiFiClient client;
 
     const char* NETDATA_HOST = netdata_host.getValue();
@@ -125,6 +128,7 @@ bool getNetDataInfoWithDimension(String chartID, NetDataResponse &data, String d
         }
 
         // 利用ArduinoJson库解析NetData返回的信息
+        heapTraceMark("json");
         parseNetDataResponse(client, data);
         ret = true;
     }
@@ -134,6 +138,9 @@ bool getNetDataInfoWithDimension(String chartID, NetDataResponse &data, String d
     }
     // 断开客户端与服务器连接工作
     client.stop();
+    // 每个请求的String和JSON分配很多, 不等到update()结束再输出
+    heapTraceMark("done");
+    heapTraceFlush();
     return ret;
 }
 
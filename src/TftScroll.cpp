@@ -0,0 +1,122 @@
+#include "TftScroll.h"
+
+static TFT_eSPI *scroll_tft = NULL;
+
+#if TFT_SCROLL_SW_COPY
+static uint16_t line_buf[LV_HOR_RES_MAX];
+#endif
+
+// 硬件只能滚动整列, 所以区域必须覆盖屏幕的整个高度
+static bool hwScroll(const lv_area_t *area, lv_coord_t dx)
+{
+    TFT_eSPI &tft = *scroll_tft;
+    if (!tft.scrollAxisX())
+        return false;
+    if (area->y1 != 0 || area->y2 != tft.height() - 1)
+        return false;
+
+    int32_t len = lv_area_get_width(area);
+    if (tft.getScrollLength() == 0)
+    {
+        if (!tft.setScrollArea(area->x1, len))
+            return false;
+    }
+    else if (tft.getScrollStart() != area->x1 || tft.getScrollLength() != len)
+    {
+        // 另一个区域已经被滚动, 显示内存中的像素不在原来的位置
+        return false;
+    }
+
+    tft.scrollBy(dx);
+    return true;
+}
+
+// 逐行读回再写到移动后的位置
+static bool swScroll(const lv_area_t *area, lv_coord_t dx)
+{
+#if TFT_SCROLL_SW_COPY
+    TFT_eSPI &tft = *scroll_tft;
+
+    // 横向的硬件滚动会把一行分成几段, 不值得处理
+    if (tft.getScrollLength() != 0 && tft.scrollAxisX())
+        return false;
+
+    int32_t w = lv_area_get_width(area) - LV_MATH_ABS(dx);
+    if (w <= 0 || w > LV_HOR_RES_MAX)
+        return false;
+
+    int32_t src_x = dx < 0 ? area->x1 - dx : area->x1;
+    int32_t dst_x = src_x + dx;
+    for (int32_t y = area->y1; y <= area->y2; y++)
+    {
+        int32_t ty = tft.scrollMap(y);
+        tft.readRect(src_x, ty, w, 1, line_buf);
+        tft.pushRect(dst_x, ty, w, 1, line_buf);
+    }
+    return true;
+#else
+    LV_UNUSED(area);
+    LV_UNUSED(dx);
+    return false;
+#endif
+}
+
+void tftScrollInit(TFT_eSPI &tft)
+{
+    scroll_tft = &tft;
+}
+
+bool tftScrollChart(lv_obj_t *chart, const lv_area_t *area, lv_coord_t dx)
+{
+    LV_UNUSED(chart);
+    if (scroll_tft == NULL)
+        return false;
+
+    if (hwScroll(area, dx))
+        return true;
+
+    return swScroll(area, dx);
+}
+
+void tftScrollFlush(const lv_area_t *area, lv_color_t *color_p)
+{
+    TFT_eSPI &tft = *scroll_tft;
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+
+    tft.startWrite();
+    if (!tft.scrollAxisX())
+    {
+        // 滚动的是整行: 映射后连续的几行一起写
+        int32_t y = area->y1;
+        while (y <= area->y2)
+        {
+            int32_t ty = tft.scrollMap(y);
+            int32_t n = 1;
+            while (y + n <= area->y2 && tft.scrollMap(y + n) == ty + n)
+                n++;
+
+            tft.setAddrWindow(area->x1, ty, w, n);
+            tft.pushColors(&color_p[(y - area->y1) * w].full, w * n, true);
+            y += n;
+        }
+    }
+    else
+    {
+        // 滚动的是整列: 映射后连续的几列作为一个窗口, 每行写其中的一段
+        int32_t x = area->x1;
+        while (x <= area->x2)
+        {
+            int32_t tx = tft.scrollMap(x);
+            int32_t n = 1;
+            while (x + n <= area->x2 && tft.scrollMap(x + n) == tx + n)
+                n++;
+
+            tft.setAddrWindow(tx, area->y1, n, h);
+            for (int32_t row = 0; row < h; row++)
+                tft.pushColors(&color_p[row * w + (x - area->x1)].full, n, true);
+            x += n;
+        }
+    }
+    tft.endWrite();
+}
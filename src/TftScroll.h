@@ -0,0 +1,30 @@
+#ifndef __TFT_SCROLL_H
+#define __TFT_SCROLL_H
+
+#include <lvgl.h>
+#include <TFT_eSPI.h>
+
+// 软件复制需要能读回显示内存
+#if defined(TFT_SDA_READ) || defined(TFT_PARALLEL_8_BIT) || (defined(TFT_MISO) && (TFT_MISO >= 0))
+#define TFT_SCROLL_SW_COPY 1
+#else
+#define TFT_SCROLL_SW_COPY 0
+#endif
+
+// Moves the already drawn plot of a chart on the TFT, so only the new points are rendered and pushed.
+// The hardware scroll of the controller moves whole lines of the frame memory: screen columns in the
+// landscape rotations. It's used when the plot spans the full height of the screen there.
+// Otherwise the pixels are copied with readRect()/pushRect() if the TFT can be read (TFT_SCROLL_SW_COPY),
+// else the chart redraws the plot. A plot lower than the screen can only be moved by the copy, so
+// register tftScrollChart() only with TFT_SCROLL_SW_COPY for it.
+void tftScrollInit(TFT_eSPI &tft);
+
+// lv_chart_scroll_cb_t for lv_chart_set_scroll_cb()
+bool tftScrollChart(lv_obj_t *chart, const lv_area_t *area, lv_coord_t dx);
+
+// Push the rendered pixels to where they are shown while an area is scrolled by the hardware
+// (TFT_eSPI::getScrollLength() != 0). The flush_cb of the display driver calls it instead of pushing
+// the pixels directly only then.
+void tftScrollFlush(const lv_area_t *area, lv_color_t *color_p);
+
+#endif
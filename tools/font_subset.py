@@ -0,0 +1,912 @@
+#!/usr/bin/env python3
+"""
+Build-time font subsetting for the firmware.
+
+The fonts in `lib/lv_arduino/src/src/lv_font` are complete `lv_font_conv` outputs.
+This script scans the sources of the firmware (`src/`) for the texts which can be shown:
+string literals, the letters `printf` format specifiers can produce and the LVGL symbol macros.
+Then it writes a copy of every configured font with only those letters to `src/font_subset/`,
+optionally with another bpp and with the RLE compression of `lv_font_fmt_txt`,
+and reports the flash and RAM saved.
+
+The fonts are configured in `tools/font_subset.json`:
+
+    scan            directories of the sources to scan
+    exclude         directories not to scan
+    ignore_calls    regexes of the functions whose string arguments are never shown (e.g. `Serial.print`)
+    symbol_headers  headers with `#define NAME "..."` symbols, used when `NAME` is in the sources
+    out_dir         where to write the subset fonts
+    fonts           list of fonts:
+        font        the `lv_font_conv` C file
+        bpp         bits per pixel of the subset (1, 2, 4, 8 or 3 with compression), at most the font's
+        compress    true: RLE compress the bitmaps, false: store them plainly, the font's format by default
+        extra       letters to keep even if they aren't in the sources (e.g. from received data)
+        guard       the macro which disables the original font, its name in upper case by default
+
+Used as a PlatformIO `pre:` script it subsets the fonts before every build and disables the originals
+with `-D<guard>=0`. It can be run by hand too:
+
+    python3 tools/font_subset.py [--config FILE] [--out-dir DIR] [--dry-run]
+"""
+
+import json
+import os
+import re
+
+CONFIG_NAME = "font_subset.json"
+GENERATED_MARK = "Generated by tools/font_subset.py"
+
+# The letters a conversion of `printf` can print
+DIGITS = "0123456789"
+CONV_LETTERS = {
+    "d": "-" + DIGITS, "i": "-" + DIGITS, "u": DIGITS,
+    "f": "-." + DIGITS, "F": "-." + DIGITS,
+    "e": "-.+e" + DIGITS, "E": "-.+E" + DIGITS,
+    "g": "-.+e" + DIGITS, "G": "-.+E" + DIGITS,
+    "x": DIGITS + "abcdef", "X": DIGITS + "ABCDEF", "o": "01234567",
+    "p": "0x" + DIGITS + "abcdef",
+}
+FORMAT_SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|L|z|j|t)?([diufFeEgGxXoscp%])")
+
+# Size of the tables in `lv_font_fmt_txt.h`
+GLYPH_DSC_SIZE = 8
+CMAP_SIZE = 20
+KERN_DSC_SIZE = 16
+
+# Shorter runs of letters are cheaper in a sparse list (2 bytes per letter) than in an own cmap
+FORMAT0_MIN_RUN = CMAP_SIZE // 2 + 1
+
+
+# ---------------------------------------------------------------------------
+# Scanning the sources
+# ---------------------------------------------------------------------------
+
+def decode_literal(body):
+    """Bytes of the body of a C string literal"""
+    out = bytearray()
+    i = 0
+    while i < len(body):
+        c = body[i]
+        if c != "\\":
+            out += c.encode("utf-8")
+            i += 1
+            continue
+
+        e = body[i + 1]
+        i += 2
+        if e == "x":
+            m = re.match(r"[0-9a-fA-F]+", body[i:])
+            out.append(int(m.group(0), 16) & 0xFF)
+            i += len(m.group(0))
+        elif e in "01234567":
+            m = re.match(r"[0-7]{0,2}", body[i:])
+            out.append(int(e + m.group(0), 8) & 0xFF)
+            i += len(m.group(0))
+        elif e in "uU":
+            n = 4 if e == "u" else 8
+            out += chr(int(body[i:i + n], 16)).encode("utf-8")
+            i += n
+        else:
+            out += {"n": b"\n", "t": b"\t", "r": b"\r", "0": b"\0"}.get(e, e.encode("utf-8"))
+
+    return bytes(out)
+
+
+def strip_comments(text):
+    """Replace the comments with spaces but keep the string and char literals"""
+    pattern = re.compile(r'//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\\n])*"|\'(?:\\.|[^\'\\\n])*\'', re.S)
+
+    def repl(m):
+        s = m.group(0)
+        if s.startswith("/"):
+            return re.sub(r"[^\n]", " ", s)
+        return s
+
+    return pattern.sub(repl, text)
+
+
+def calling_function(text, pos):
+    """Name of the function whose argument list contains `pos`, e.g. `Serial.print`"""
+    depth = 0
+    i = pos - 1
+    while i >= 0:
+        c = text[i]
+        if c == ")":
+            depth += 1
+        elif c == "(":
+            if depth == 0:
+                m = re.search(r"([\w.>-]+)\s*$", text[:i])
+                return m.group(1) if m else ""
+            depth -= 1
+        elif c in ";{}":
+            return ""
+        i -= 1
+
+    return ""
+
+
+def scan_text(text, ignore_calls):
+    """The texts of the string literals of a source, adjacent literals joined"""
+    text = strip_comments(text)
+    texts = []
+    literal = re.compile(r'(?:u8|L|u|U)?"((?:\\.|[^"\\\n])*)"')
+    pos = 0
+    while True:
+        m = literal.search(text, pos)
+        if m is None:
+            break
+
+        start = m.start()
+        data = decode_literal(m.group(1))
+        pos = m.end()
+        while True:
+            n = re.compile(r'\s*(?:u8|L|u|U)?"((?:\\.|[^"\\\n])*)"').match(text, pos)
+            if n is None:
+                break
+            data += decode_literal(n.group(1))
+            pos = n.end()
+
+        line_start = text.rfind("\n", 0, start) + 1
+        line = text[line_start:start].lstrip()
+        if line.startswith("#include") or line.startswith("#pragma") or line.startswith("extern"):
+            continue
+
+        func = calling_function(text, start)
+        if func and any(re.fullmatch(r, func) for r in ignore_calls):
+            continue
+
+        texts.append(data.decode("utf-8", "ignore"))
+
+    return texts
+
+
+def text_letters(text, warnings):
+    """The letters a text can show, also as a `printf` format"""
+    letters = set()
+    pos = 0
+    for m in FORMAT_SPEC.finditer(text):
+        letters.update(text[pos:m.start()])
+        pos = m.end()
+
+        flags, conv = m.group(1), m.group(5)
+        if conv == "%":
+            letters.add("%")
+        elif conv in "sc":
+            warnings.add("'%s' in \"%s\" prints a runtime text, add its letters to `extra`" % (m.group(0), text))
+        else:
+            letters.update(CONV_LETTERS[conv])
+            letters.update(c for c in flags if c in "+ ")
+    letters.update(text[pos:])
+
+    return letters
+
+
+def read_symbols(paths):
+    symbols = {}
+    for path in paths:
+        with open(path, encoding="utf-8") as f:
+            for m in re.finditer(r'^\s*#define\s+(\w+)\s+"((?:\\.|[^"\\])*)"', f.read(), re.M):
+                symbols[m.group(1)] = decode_literal(m.group(2)).decode("utf-8", "ignore")
+
+    return symbols
+
+
+def scan_sources(root, cfg, warnings):
+    """All the letters the firmware can show"""
+    excludes = [os.path.normpath(os.path.join(root, d)) for d in cfg.get("exclude", [])]
+    excludes.append(os.path.normpath(os.path.join(root, cfg["out_dir"])))
+    symbols = read_symbols([os.path.join(root, p) for p in cfg.get("symbol_headers", [])])
+    ignore_calls = cfg.get("ignore_calls", [])
+
+    letters = set()
+    for scan_dir in cfg["scan"]:
+        for dirpath, dirnames, filenames in os.walk(os.path.join(root, scan_dir)):
+            dirnames[:] = [d for d in dirnames if os.path.normpath(os.path.join(dirpath, d)) not in excludes]
+            for fn in sorted(filenames):
+                if not fn.endswith((".c", ".cpp", ".h", ".hpp", ".ino")):
+                    continue
+                with open(os.path.join(dirpath, fn), encoding="utf-8", errors="ignore") as f:
+                    text = f.read()
+
+                for t in scan_text(text, ignore_calls):
+                    letters |= text_letters(t, warnings)
+
+                code = strip_comments(text)
+                for name in set(re.findall(r"\b[A-Z_][A-Z0-9_]*\b", code)) & symbols.keys():
+                    letters.update(symbols[name])
+
+    letters.discard("\n")
+    letters.discard("\r")
+    letters.discard("\t")
+    return letters
+
+
+# ---------------------------------------------------------------------------
+# Reading and writing lv_font_conv fonts
+# ---------------------------------------------------------------------------
+
+def parse_number(s):
+    s = s.strip()
+    return int(s, 0) if not s.startswith("-") else -int(s[1:], 0)
+
+
+def parse_fields(body):
+    return {m.group(1): m.group(2).strip() for m in re.finditer(r"\.(\w+)\s*=\s*([^,\n}]+)", body)}
+
+
+class Font:
+    """The tables of a font in LVGL's native format"""
+
+    def __init__(self, path):
+        with open(path, encoding="utf-8") as f:
+            text = f.read()
+        self.path = path
+        self.text = text
+
+        arrays = {}
+        for m in re.finditer(r"const\s+(\w+)\s+(\w+)\[\]\s*=\s*\{(.*?)\};", text, re.S):
+            arrays[m.group(2)] = (m.group(1), m.group(3))
+        self.arrays = arrays
+
+        m = re.search(r"lv_font_t\s+(\w+)\s*=\s*\{(.*?)\};", text, re.S)
+        self.name = m.group(1)
+        font = parse_fields(m.group(2))
+        self.line_height = int(font["line_height"])
+        self.base_line = int(font["base_line"])
+        self.subpx = font.get("subpx", "LV_FONT_SUBPX_NONE")
+        self.underline_position = int(font.get("underline_position", "0"))
+        self.underline_thickness = int(font.get("underline_thickness", "0"))
+
+        m = re.search(r"lv_font_fmt_txt_dsc_t\s+font_dsc\s*=\s*\{(.*?)\};", text, re.S)
+        dsc = parse_fields(m.group(1))
+        self.bpp = int(dsc["bpp"])
+        self.compressed = int(dsc.get("bitmap_format", "0")) != 0
+        self.kern_scale = int(dsc.get("kern_scale", "0"))
+
+        # Old fonts call it `gylph_bitmap`
+        self.bitmap = bytes(self.numbers(dsc["glyph_bitmap"]))
+        self.glyphs = []
+        for g in re.finditer(r"\{([^{}]*)\}", self.arrays[dsc["glyph_dsc"]][1]):
+            self.glyphs.append({k: parse_number(v) for k, v in parse_fields(g.group(1)).items()})
+
+        self.letters = {}
+        self.cmap_bytes = 0
+        m = re.search(r"lv_font_fmt_txt_cmap_t\s+cmaps\[\]\s*=\s*\{(.*?)\n\};", text, re.S)
+        for c in re.finditer(r"\{([^{}]*)\}", m.group(1)):
+            self.read_cmap(parse_fields(c.group(1)))
+
+        self.kern = None
+        self.kern_bytes = 0
+        kern = dsc.get("kern_dsc", "NULL")
+        if kern != "NULL":
+            m = re.search(r"\s%s\s*=\s*\{(.*?)\};" % kern.lstrip("&"), text, re.S)
+            self.read_kern(parse_fields(m.group(1)), int(dsc.get("kern_classes", "0")))
+
+    def numbers(self, name):
+        body = re.sub(r"/\*.*?\*/", "", self.arrays[name][1], flags=re.S)
+        return [parse_number(v) for v in body.split(",") if v.strip()]
+
+    def array_bytes(self, name):
+        size = {"uint8_t": 1, "int8_t": 1, "uint16_t": 2}[self.arrays[name][0]]
+        return size * len(self.numbers(name))
+
+    def read_cmap(self, c):
+        start = int(c["range_start"])
+        gid_start = int(c["glyph_id_start"])
+        ctype = c["type"]
+        unicode_list = self.numbers(c["unicode_list"]) if c["unicode_list"] != "NULL" else None
+        ofs_list = self.numbers(c["glyph_id_ofs_list"]) if c["glyph_id_ofs_list"] != "NULL" else None
+        self.cmap_bytes += CMAP_SIZE
+        if unicode_list:
+            self.cmap_bytes += self.array_bytes(c["unicode_list"])
+        if ofs_list:
+            self.cmap_bytes += self.array_bytes(c["glyph_id_ofs_list"])
+
+        if ctype.endswith("FORMAT0_TINY"):
+            for i in range(int(c["range_length"])):
+                self.letters[start + i] = gid_start + i
+        elif ctype.endswith("FORMAT0_FULL"):
+            for i, ofs in enumerate(ofs_list):
+                if ofs != 0 or i == 0:
+                    self.letters[start + i] = gid_start + ofs
+        elif ctype.endswith("SPARSE_TINY"):
+            for i, rcp in enumerate(unicode_list):
+                self.letters[start + rcp] = gid_start + i
+        else:
+            for i, rcp in enumerate(unicode_list):
+                self.letters[start + rcp] = gid_start + ofs_list[i]
+
+    def read_kern(self, k, classes):
+        self.kern_bytes = KERN_DSC_SIZE
+        if classes:
+            left = self.numbers(k["left_class_mapping"])
+            right = self.numbers(k["right_class_mapping"])
+            values = self.numbers(k["class_pair_values"])
+            right_cnt = int(k["right_class_cnt"])
+            self.kern_bytes += len(left) + len(right) + len(values)
+            self.kern = lambda l, r: (values[(left[l] - 1) * right_cnt + right[r] - 1]
+                                      if l < len(left) and r < len(right) and left[l] and right[r] else 0)
+            self.kern_classes = (left, right)
+        else:
+            ids = self.numbers(k["glyph_ids"])
+            values = self.numbers(k["values"])
+            self.kern_bytes += self.array_bytes(k["glyph_ids"]) + len(values)
+            pairs = {(ids[2 * i], ids[2 * i + 1]): v for i, v in enumerate(values)}
+            self.kern = lambda l, r: pairs.get((l, r), 0)
+            self.kern_classes = None
+            self.kern_pairs = pairs
+
+    def glyph_pixels(self, gid):
+        """The pixels of a glyph with the font's bpp, row by row"""
+        g = self.glyphs[gid]
+        cnt = g["box_w"] * g["box_h"]
+        if cnt == 0:
+            return []
+        if self.compressed:
+            return rle_decode(self.bitmap[g["bitmap_index"]:], g["box_w"], g["box_h"], self.bpp)
+
+        bpp = 4 if self.bpp == 3 else self.bpp
+        return [get_bits(self.bitmap, g["bitmap_index"] * 8 + i * bpp, bpp) for i in range(cnt)]
+
+    def glyph_bytes(self, gid):
+        """Size of the bitmap of a glyph in the font"""
+        starts = sorted({g["bitmap_index"] for g in self.glyphs} | {len(self.bitmap)})
+        start = self.glyphs[gid]["bitmap_index"]
+        return starts[starts.index(start) + 1] - start if self.glyphs[gid]["box_w"] else 0
+
+    def table_bytes(self):
+        return len(self.bitmap) + len(self.glyphs) * GLYPH_DSC_SIZE + self.cmap_bytes + self.kern_bytes
+
+    def glyph_buf_bytes(self, gid):
+        """RAM `lv_font_get_bitmap_fmt_txt` needs for a glyph on ESP8266 (or always if compressed)"""
+        g = self.glyphs[gid]
+        bpp = 4 if self.bpp == 3 else self.bpp
+        return (g["box_w"] * g["box_h"] * bpp + 7) // 8
+
+
+def get_bits(data, bit_pos, length):
+    v = 0
+    for i in range(length):
+        p = bit_pos + i
+        v = (v << 1) | ((data[p >> 3] >> (7 - (p & 7))) & 1)
+    return v
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def write(self, v, length):
+        self.bits.extend((v >> (length - 1 - i)) & 1 for i in range(length))
+
+    def to_bytes(self):
+        bits = self.bits + [0] * (-len(self.bits) % 8)
+        return bytes(int("".join(map(str, bits[i:i + 8])), 2) for i in range(0, len(bits), 8))
+
+
+def rle_decode(data, w, h, bpp):
+    """`decompress()` of lv_font_fmt_txt.c"""
+    pos = 0
+    state = "single"
+    prev = 0
+    cnt = 0
+    stream = []
+    for i in range(w * h):
+        if state == "single":
+            ret = get_bits(data, pos, bpp)
+            if pos != 0 and prev == ret:
+                cnt = 0
+                state = "repeat"
+            prev = ret
+            pos += bpp
+        elif state == "repeat":
+            v = get_bits(data, pos, 1)
+            cnt += 1
+            pos += 1
+            if v == 1:
+                ret = prev
+                if cnt == 11:
+                    cnt = get_bits(data, pos, 6)
+                    pos += 6
+                    if cnt != 0:
+                        state = "counter"
+                    else:
+                        ret = prev = get_bits(data, pos, bpp)
+                        pos += bpp
+                        state = "single"
+            else:
+                ret = prev = get_bits(data, pos, bpp)
+                pos += bpp
+                state = "single"
+        else:
+            ret = prev
+            cnt -= 1
+            if cnt == 0:
+                ret = prev = get_bits(data, pos, bpp)
+                pos += bpp
+                state = "single"
+        stream.append(ret)
+
+    out = stream[:w]
+    for y in range(1, h):
+        line = [stream[y * w + x] ^ out[(y - 1) * w + x] for x in range(w)]
+        out += line
+    return out
+
+
+def rle_encode(px, w, h, bpp):
+    """The inverse of `rle_decode`: XOR every row with the previous one, then RLE"""
+    stream = px[:w] + [px[i] ^ px[i - w] for i in range(w, w * h)]
+    out = BitWriter()
+    n = len(stream)
+    state = "single"
+    prev = 0
+    cnt = 0
+    i = 0
+    while i < n:
+        v = stream[i]
+        if state == "single":
+            out.write(v, bpp)
+            if i != 0 and v == prev:
+                cnt = 0
+                state = "repeat"
+            prev = v
+            i += 1
+        else:
+            cnt += 1
+            if v != prev:
+                out.write(0, 1)
+                out.write(v, bpp)
+                prev = v
+                state = "single"
+                i += 1
+            elif cnt < 11:
+                out.write(1, 1)
+                i += 1
+            else:
+                # This pixel is `prev`, the counter gives `c - 1` more of it and a new value
+                run = 0
+                while i + 1 + run < n and stream[i + 1 + run] == prev and run < 62:
+                    run += 1
+                c = run + 1
+                out.write(1, 1)
+                out.write(c, 6)
+                i += c
+                if i < n:
+                    prev = stream[i]
+                    out.write(prev, bpp)
+                    i += 1
+                state = "single"
+
+    return out.to_bytes()
+
+
+def requantize(px, src_bpp, bpp):
+    if src_bpp == bpp:
+        return px
+    src_max = (1 << src_bpp) - 1
+    dst_max = (1 << bpp) - 1
+    return [(v * dst_max + src_max // 2) // src_max for v in px]
+
+
+def c_array(values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt(v) for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def letter_comment(letter):
+    ch = chr(letter)
+    if ch in "\"\\" or not ch.isprintable():
+        return "U+%04X" % letter
+    return 'U+%04X "%s"' % (letter, ch)
+
+
+class Subset:
+    """A font with some of its letters"""
+
+    def __init__(self, font, letters, bpp, compress):
+        self.font = font
+        self.letters = sorted(l for l in letters if l in font.letters)
+        self.bpp = bpp
+        self.compress = compress
+
+        self.bitmap = bytearray()
+        self.glyphs = [dict(bitmap_index=0, adv_w=0, box_w=0, box_h=0, ofs_x=0, ofs_y=0)]
+        self.old_gids = [0]
+        for letter in self.letters:
+            gid = font.letters[letter]
+            g = dict(font.glyphs[gid])
+            g["bitmap_index"] = len(self.bitmap)
+            px = requantize(font.glyph_pixels(gid), font.bpp, bpp)
+            if px:
+                if compress:
+                    data = rle_encode(px, g["box_w"], g["box_h"], bpp)
+                    assert rle_decode(data, g["box_w"], g["box_h"], bpp) == px
+                else:
+                    w = BitWriter()
+                    for v in px:
+                        w.write(v, bpp)
+                    data = w.to_bytes()
+                self.bitmap += data
+            self.glyphs.append(g)
+            self.old_gids.append(gid)
+
+        # The decompression can read one byte after the last glyph
+        if compress:
+            self.bitmap.append(0)
+
+        if len(self.bitmap) >= 1 << 20:
+            raise ValueError("%s: the bitmaps don't fit into `bitmap_index`" % font.name)
+
+        self.cmaps = self.make_cmaps()
+        self.kern = self.make_kern()
+
+    def make_cmaps(self):
+        """Long runs of letters in FORMAT0_TINY cmaps, the others in SPARSE_TINY cmaps"""
+        runs = []
+        for letter in self.letters:
+            if runs and runs[-1][-1] == letter - 1:
+                runs[-1].append(letter)
+            else:
+                runs.append([letter])
+
+        cmaps = []
+        sparse = []
+        for run in runs + [None]:
+            if run is None or len(run) >= FORMAT0_MIN_RUN or (sparse and run[-1] - sparse[0] > 0xFFFF):
+                if sparse:
+                    cmaps.append(("SPARSE_TINY", sparse))
+                    sparse = []
+            if run is None:
+                break
+            if len(run) >= FORMAT0_MIN_RUN:
+                cmaps.append(("FORMAT0_TINY", run))
+            else:
+                sparse += run
+
+        gid = 1
+        result = []
+        for ctype, letters in cmaps:
+            result.append((ctype, letters, gid))
+            gid += len(letters)
+        return result
+
+    def make_kern(self):
+        font = self.font
+        if font.kern is None:
+            return None
+
+        n = len(self.old_gids)
+        if font.kern_classes:
+            left, right = font.kern_classes
+
+            def compact(mapping):
+                used = sorted({mapping[g] for g in self.old_gids[1:] if g < len(mapping) and mapping[g]})
+                new = {c: i + 1 for i, c in enumerate(used)}
+                return [new.get(mapping[g], 0) if g < len(mapping) else 0 for g in self.old_gids], used
+
+            new_left, left_used = compact(left)
+            new_right, right_used = compact(right)
+            values = []
+            for lc in left_used:
+                l_gid = left.index(lc)
+                for rc in right_used:
+                    values.append(font.kern(l_gid, right.index(rc)))
+            if not any(values):
+                return None
+            return ("classes", new_left, new_right, values, len(left_used), len(right_used))
+
+        pairs = []
+        for l in range(1, n):
+            for r in range(1, n):
+                v = font.kern_pairs.get((self.old_gids[l], self.old_gids[r]), 0)
+                if v:
+                    pairs.append((l, r, v))
+        if not pairs:
+            return None
+        return ("pairs", pairs)
+
+    def table_bytes(self):
+        size = len(self.bitmap) + len(self.glyphs) * GLYPH_DSC_SIZE
+        for ctype, letters, gid in self.cmaps:
+            size += CMAP_SIZE + (2 * len(letters) if ctype == "SPARSE_TINY" else 0)
+        if self.kern:
+            size += KERN_DSC_SIZE
+            if self.kern[0] == "classes":
+                size += len(self.kern[1]) + len(self.kern[2]) + len(self.kern[3])
+            else:
+                size += len(self.kern[1]) * (3 if len(self.glyphs) <= 256 else 5)
+        return size
+
+    def glyph_buf_bytes(self):
+        bpp = 4 if self.bpp == 3 else self.bpp
+        return max([(g["box_w"] * g["box_h"] * bpp + 7) // 8 for g in self.glyphs])
+
+    def write(self, path, source_rel):
+        font = self.font
+        o = []
+        o.append("/*" + "*" * 78)
+        o.append(" * Size: %d px" % font.line_height)
+        o.append(" * Bpp: %d" % self.bpp)
+        o.append(" * Opts: %s from %s, compressed: %s" % (GENERATED_MARK, source_rel, "yes" if self.compress else "no"))
+        o.append(" " + "*" * 78 + "/")
+        o.append("")
+        o.append("#include <lvgl.h>")
+        o.append("")
+        o.append("/*-----------------")
+        o.append(" *    BITMAPS")
+        o.append(" *----------------*/")
+        o.append("")
+        o.append("/*Store the image of the glyphs*/")
+        o.append("static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {")
+        for i, letter in enumerate(self.letters):
+            g = self.glyphs[i + 1]
+            end = self.glyphs[i + 2]["bitmap_index"] if i + 2 < len(self.glyphs) else len(self.bitmap)
+            data = self.bitmap[g["bitmap_index"]:end]
+            o.append("    /* %s */" % letter_comment(letter))
+            if data:
+                o.append(c_array(list(data), 8, lambda v: "0x%x" % v) + ("," if end < len(self.bitmap) else ""))
+            o.append("")
+        if not self.bitmap:
+            o.append("    0")
+        elif o[-1] == "":
+            o.pop()
+        o.append("};")
+        o.append("")
+        o.append("")
+        o.append("/*---------------------")
+        o.append(" *  GLYPH DESCRIPTION")
+        o.append(" *--------------------*/")
+        o.append("")
+        o.append("static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {")
+        rows = []
+        for i, g in enumerate(self.glyphs):
+            row = ("    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}" %
+                   (g["bitmap_index"], g["adv_w"], g["box_w"], g["box_h"], g["ofs_x"], g["ofs_y"]))
+            rows.append(row + (" /* id = 0 reserved */" if i == 0 else ""))
+        o.append(",\n".join(rows))
+        o.append("};")
+        o.append("")
+        o.append("/*---------------------")
+        o.append(" *  CHARACTER MAPPING")
+        o.append(" *--------------------*/")
+        o.append("")
+        for i, (ctype, letters, gid) in enumerate(self.cmaps):
+            if ctype == "SPARSE_TINY":
+                o.append("static LV_ATTRIBUTE_LARGE_CONST const uint16_t unicode_list_%d[] = {" % i)
+                o.append(c_array([l - letters[0] for l in letters], 8, lambda v: "0x%x" % v))
+                o.append("};")
+                o.append("")
+        o.append("/*Collect the unicode lists and glyph_id offsets*/")
+        o.append("static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_cmap_t cmaps[] =")
+        o.append("{")
+        rows = []
+        for i, (ctype, letters, gid) in enumerate(self.cmaps):
+            ulist = "unicode_list_%d" % i if ctype == "SPARSE_TINY" else "NULL"
+            list_len = len(letters) if ctype == "SPARSE_TINY" else 0
+            rows.append("    {\n        .range_start = %d, .range_length = %d, .glyph_id_start = %d,\n"
+                        "        .unicode_list = %s, .glyph_id_ofs_list = NULL, .list_length = %d, "
+                        ".type = LV_FONT_FMT_TXT_CMAP_%s\n    }" %
+                        (letters[0], letters[-1] - letters[0] + 1, gid, ulist, list_len, ctype))
+        o.append(",\n".join(rows))
+        o.append("};")
+        o.append("")
+        self.write_kern(o)
+        o.append("/*--------------------")
+        o.append(" *  ALL CUSTOM DATA")
+        o.append(" *--------------------*/")
+        o.append("")
+        o.append("/*Store all the custom data of the font*/")
+        o.append("static lv_font_fmt_txt_dsc_t font_dsc = {")
+        o.append("    .glyph_bitmap = glyph_bitmap,")
+        o.append("    .glyph_dsc = glyph_dsc,")
+        o.append("    .cmaps = cmaps,")
+        if self.kern:
+            o.append("    .kern_dsc = &%s," % ("kern_classes" if self.kern[0] == "classes" else "kern_pairs"))
+            o.append("    .kern_scale = %d," % font.kern_scale)
+        else:
+            o.append("    .kern_dsc = NULL,")
+            o.append("    .kern_scale = 0,")
+        o.append("    .cmap_num = %d," % len(self.cmaps))
+        o.append("    .bpp = %d," % self.bpp)
+        o.append("    .kern_classes = %d," % (1 if self.kern and self.kern[0] == "classes" else 0))
+        o.append("    .bitmap_format = %d" % (1 if self.compress else 0))
+        o.append("};")
+        o.append("")
+        o.append("")
+        o.append("/*-----------------")
+        o.append(" *  PUBLIC FONT")
+        o.append(" *----------------*/")
+        o.append("")
+        o.append("/*Initialize a public general font descriptor*/")
+        o.append("lv_font_t %s = {" % font.name)
+        o.append("    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph's data*/")
+        o.append("    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph's bitmap*/")
+        o.append("    .line_height = %d,          /*The maximum line height required by the font*/" %
+                 font.line_height)
+        o.append("    .base_line = %d,             /*Baseline measured from the bottom of the line*/" % font.base_line)
+        o.append("    .subpx = %s," % font.subpx)
+        o.append("#if LV_VERSION_CHECK(7, 4, 0) || LVGL_VERSION_MAJOR >= 8")
+        o.append("    .underline_position = %d," % font.underline_position)
+        o.append("    .underline_thickness = %d," % font.underline_thickness)
+        o.append("#endif")
+        o.append("    .dsc = &font_dsc           /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */")
+        o.append("};")
+        o.append("")
+
+        text = "\n".join(o)
+        if os.path.exists(path):
+            with open(path, encoding="utf-8") as f:
+                if f.read() == text:
+                    return
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(text)
+
+    def write_kern(self, o):
+        if self.kern is None:
+            return
+
+        o.append("/*-----------------")
+        o.append(" *    KERNING")
+        o.append(" *----------------*/")
+        o.append("")
+        o.append("")
+        if self.kern[0] == "classes":
+            _, left, right, values, left_cnt, right_cnt = self.kern
+            o.append("/*Map glyph_ids to kern left classes*/")
+            o.append("static LV_ATTRIBUTE_LARGE_CONST const uint8_t kern_left_class_mapping[] =")
+            o.append("{")
+            o.append(c_array(left, 8, str))
+            o.append("};")
+            o.append("")
+            o.append("/*Map glyph_ids to kern right classes*/")
+            o.append("static LV_ATTRIBUTE_LARGE_CONST const uint8_t kern_right_class_mapping[] =")
+            o.append("{")
+            o.append(c_array(right, 8, str))
+            o.append("};")
+            o.append("")
+            o.append("/*Kern values between classes*/")
+            o.append("static LV_ATTRIBUTE_LARGE_CONST const int8_t kern_class_values[] =")
+            o.append("{")
+            o.append(c_array(values, 8, str))
+            o.append("};")
+            o.append("")
+            o.append("")
+            o.append("/*Collect the kern class' data in one place*/")
+            o.append("static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_kern_classes_t kern_classes =")
+            o.append("{")
+            o.append("    .class_pair_values   = kern_class_values,")
+            o.append("    .left_class_mapping  = kern_left_class_mapping,")
+            o.append("    .right_class_mapping = kern_right_class_mapping,")
+            o.append("    .left_class_cnt      = %d," % left_cnt)
+            o.append("    .right_class_cnt     = %d," % right_cnt)
+            o.append("};")
+        else:
+            pairs = self.kern[1]
+            wide = len(self.glyphs) > 256
+            o.append("/*Pair left and right glyphs for kerning*/")
+            o.append("static LV_ATTRIBUTE_LARGE_CONST const %s kern_pair_glyph_ids[] =" %
+                     ("uint16_t" if wide else "uint8_t"))
+            o.append("{")
+            o.append(c_array([v for l, r, _ in pairs for v in (l, r)], 8, str))
+            o.append("};")
+            o.append("")
+            o.append("/* Kerning between the respective left and right glyphs")
+            o.append(" * 4.4 format which needs to scaled with `kern_scale`*/")
+            o.append("static LV_ATTRIBUTE_LARGE_CONST const int8_t kern_pair_values[] =")
+            o.append("{")
+            o.append(c_array([v for _, _, v in pairs], 8, str))
+            o.append("};")
+            o.append("")
+            o.append("/*Collect the kern pair's data in one place*/")
+            o.append("static LV_ATTRIBUTE_LARGE_CONST const lv_font_fmt_txt_kern_pair_t kern_pairs =")
+            o.append("{")
+            o.append("    .glyph_ids = kern_pair_glyph_ids,")
+            o.append("    .values = kern_pair_values,")
+            o.append("    .pair_cnt = %d," % len(pairs))
+            o.append("    .glyph_ids_size = %d" % (1 if wide else 0))
+            o.append("};")
+        o.append("")
+
+
+# ---------------------------------------------------------------------------
+# Main
+# ---------------------------------------------------------------------------
+
+def run(root, config=None, out_dir=None, dry_run=False, log=print):
+    """Subset the configured fonts. Returns the macros which disable the original fonts."""
+    with open(config or os.path.join(root, "tools", CONFIG_NAME), encoding="utf-8") as f:
+        cfg = json.load(f)
+    if out_dir is None:
+        out_dir = os.path.join(root, cfg["out_dir"])
+
+    warnings = set()
+    letters = {ord(c) for c in scan_sources(root, cfg, warnings)}
+    for w in sorted(warnings):
+        log("font_subset: warning: " + w)
+
+    if not dry_run:
+        os.makedirs(out_dir, exist_ok=True)
+
+    guards = []
+    outputs = set()
+    total_before = total_after = 0
+    buf_max_before = buf_max_after = 0
+    log("font_subset: %-20s %13s %17s %17s %15s" % ("font", "glyphs", "tables [B]", "bytes/glyph",
+                                                    "glyph buf [B]"))
+    for fc in cfg["fonts"]:
+        font = Font(os.path.join(root, fc["font"]))
+        bpp = fc.get("bpp", font.bpp)
+        compress = fc.get("compress", font.compressed)
+        if bpp > font.bpp:
+            raise ValueError("%s: bpp %d is more than the font's %d" % (font.name, bpp, font.bpp))
+        if bpp not in (1, 2, 4, 8) and not (bpp == 3 and compress):
+            raise ValueError("%s: bpp %d is not supported%s" % (font.name, bpp, " without compression"
+                                                                if bpp == 3 else ""))
+
+        font_letters = set(letters) | {ord(c) for c in fc.get("extra", "")}
+        for c in fc.get("extra", ""):
+            if ord(c) not in font.letters:
+                log("font_subset: warning: %s has no '%s'" % (font.name, c))
+        subset = Subset(font, font_letters, bpp, compress)
+
+        before = font.table_bytes()
+        after = subset.table_bytes()
+        total_before += before
+        total_after += after
+        buf_before = max(font.glyph_buf_bytes(g) for g in range(len(font.glyphs)))
+        glyph_cnt = max(len(subset.glyphs) - 1, 1)
+        buf_max_before = max(buf_max_before, buf_before)
+        buf_max_after = max(buf_max_after, subset.glyph_buf_bytes())
+        log("font_subset: %-20s %5d -> %5d %7d -> %7d %7.1f -> %7.1f %6d -> %6d" %
+            (font.name, len(font.glyphs) - 1, len(subset.glyphs) - 1, before, after,
+             sum(font.glyph_bytes(g) for g in subset.old_gids) / glyph_cnt, len(subset.bitmap) / glyph_cnt,
+             buf_before, subset.glyph_buf_bytes()))
+
+        fn = font.name + ".c"
+        outputs.add(fn)
+        if not dry_run:
+            subset.write(os.path.join(out_dir, fn), fc["font"])
+        guards.append(fc.get("guard", font.name.upper()))
+
+    # Only one glyph is unpacked at a time
+    buf_saved = buf_max_before - buf_max_after
+    log("font_subset: %d bytes of font tables saved in flash (in RAM where `LV_ATTRIBUTE_LARGE_CONST` is empty), "
+        "%d bytes less glyph buffer in lv_mem" % (total_before - total_after, buf_saved))
+
+    # Remove the fonts which aren't configured any more, their originals aren't disabled
+    if not dry_run:
+        for fn in os.listdir(out_dir):
+            path = os.path.join(out_dir, fn)
+            if fn.endswith(".c") and fn not in outputs:
+                with open(path, encoding="utf-8") as f:
+                    generated = GENERATED_MARK in f.read()
+                if generated:
+                    os.remove(path)
+
+    return guards
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Subset the fonts to the letters used in the sources")
+    parser.add_argument("--config", help="configuration file instead of tools/%s" % CONFIG_NAME)
+    parser.add_argument("--out-dir", help="write the fonts here instead of the configured directory")
+    parser.add_argument("--dry-run", action="store_true", help="only report the savings")
+    args = parser.parse_args()
+
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    guards = run(root, args.config, args.out_dir, args.dry_run)
+    print("font_subset: build with " + " ".join("-D%s=0" % g for g in guards))
+
+
+if "Import" not in globals():
+    main()
+else:
+    # PlatformIO `extra_scripts = pre:tools/font_subset.py`, run by SCons
+    Import("env")  # noqa: F821
+    for guard in run(env.subst("$PROJECT_DIR")):  # noqa: F821
+        env.Append(CPPDEFINES=[(guard, 0)])  # noqa: F821
@@ -0,0 +1,324 @@
+#!/usr/bin/env python3
+"""
+Replay of the heap trace of the firmware (`HEAP_TRACE`, the `nodemcuv2_heaptrace` environment).
+
+`src/HeapTrace.cpp` writes the allocations and frees of the Arduino heap (malloc of String, ArduinoJson, new)
+and of the `lv_mem` work memory to the serial port between the normal output, one event per line:
+
+    @h<heap> <base> <size>          address range of a heap, written once after the boot
+    @a<heap> <ptr> <size> <caller>  allocation, ptr 0 if it failed
+    @r<heap> <ptr> <size> <caller>  new block of a realloc, after the `@f` of the old block
+    @f<heap> <ptr> <caller>         free
+    @m <ms> <tag>                   mark of the firmware (`heapTraceMark`)
+    @s <ms> <heap> <free> <biggest> <frag>
+                                    status as the device sees it, once per `update()`
+    @d <count>                      events dropped because the buffer of the device was full
+
+The numbers are hexadecimal, except the times, the heap numbers and the fields of `@s` and `@d`.
+The blocks are replayed to follow which addresses are used. At every `@s` line a row is added to
+the picture of the heap: the addresses from left to right in gray (black: used), next to it
+the replayed fragmentation (red) and use (blue) in percent. The replay counts only the requested
+bytes, not the headers of the allocators, so the device values in the CSV are a bit worse.
+Blocks allocated while events were dropped are unknown until an allocation overlaps them.
+
+Outputs, with `-o PREFIX`:
+
+    PREFIX_heap<N>.png  the picture of every heap over time
+    PREFIX.csv          replayed and device values of every sample
+
+and a summary with the callers whose live bytes grew since the first sample: leaks or drift.
+With `--elf` the callers are resolved with addr2line (`xtensa-lx106-elf-addr2line` of PlatformIO).
+
+    python3 tools/heap_trace.py LOG [-o PREFIX] [--elf firmware.elf] [--addr2line PATH] [--width PX]
+"""
+
+import bisect
+import re
+import struct
+import subprocess
+import sys
+import zlib
+
+HEAP_NAMES = {0: "malloc", 1: "lv_mem"}
+
+EVENT_LINE = re.compile(r"@([harfmsd])(\d*) (.*)")
+
+# At most this many rows in a picture, the samples are skipped evenly above it
+MAX_ROWS = 1000
+PANEL_WIDTH = 101
+PANEL_GAP = 4
+
+TOP_CALLERS = 10
+
+
+# ---------------------------------------------------------------------------
+# Replay
+# ---------------------------------------------------------------------------
+
+class Heap:
+    def __init__(self, num, base, size):
+        self.num = num
+        self.base = base
+        self.size = size
+        self.addrs = []      # sorted start addresses of the live blocks
+        self.blocks = {}     # address -> (size, caller)
+        self.live = 0
+        self.events = 0
+        self.failed = 0
+        self.unknown_frees = 0
+        self.outside = 0
+        self.max_live = 0
+        self.samples = []
+        self.first_callers = None
+
+    def _remove(self, addr):
+        size, _ = self.blocks.pop(addr)
+        del self.addrs[bisect.bisect_left(self.addrs, addr)]
+        self.live -= size
+
+    def alloc(self, addr, size, caller):
+        self.events += 1
+        if addr == 0:
+            self.failed += 1
+            return
+        if not self.base <= addr < self.base + self.size:
+            self.outside += 1
+            return
+
+        # A block at the same addresses has been freed without an event (dropped)
+        i = bisect.bisect_left(self.addrs, addr)
+        if i > 0:
+            prev = self.addrs[i - 1]
+            if prev + self.blocks[prev][0] > addr:
+                i -= 1
+        while i < len(self.addrs) and self.addrs[i] < addr + max(size, 1):
+            self._remove(self.addrs[i])
+
+        bisect.insort(self.addrs, addr)
+        self.blocks[addr] = (size, caller)
+        self.live += size
+        self.max_live = max(self.max_live, self.live)
+
+    def free(self, addr):
+        self.events += 1
+        if addr in self.blocks:
+            self._remove(addr)
+        else:
+            self.unknown_frees += 1
+
+    def gaps(self):
+        """The free ranges between the live blocks"""
+        pos = self.base
+        for addr in self.addrs:
+            if addr > pos:
+                yield addr - pos
+            pos = max(pos, addr + self.blocks[addr][0])
+        end = self.base + self.size
+        if end > pos:
+            yield end - pos
+
+    def occupancy(self, bins):
+        """Used bytes of every address bin"""
+        row = [0] * bins
+        bin_size = self.size / bins
+        for addr in self.addrs:
+            start = addr - self.base
+            end = min(start + self.blocks[addr][0], self.size)
+            b = int(start / bin_size)
+            while b < bins and start < end:
+                bin_end = (b + 1) * bin_size
+                row[b] += min(end, bin_end) - start
+                start = bin_end
+                b += 1
+        return [min(1.0, used / bin_size) for used in row]
+
+    def callers(self):
+        live = {}
+        for size, caller in self.blocks.values():
+            live[caller] = live.get(caller, 0) + size
+        return live
+
+    def sample(self, ms, mark, device, bins):
+        free = self.size - self.live
+        biggest = max(self.gaps(), default=0)
+        frag = 100 - biggest * 100 // free if free else 0
+        self.samples.append({
+            "ms": ms, "mark": mark, "live": self.live, "blocks": len(self.blocks),
+            "free": free, "biggest": biggest, "frag": frag, "device": device,
+            "row": self.occupancy(bins),
+        })
+        if self.first_callers is None:
+            self.first_callers = self.callers()
+
+
+def replay(lines, bins):
+    """Replays the events of the log, only the last boot (`@h` lines) is kept"""
+    heaps = {}
+    dropped = 0
+    marks = {}
+    last_mark = ""
+
+    for line in lines:
+        m = EVENT_LINE.search(line)
+        if not m:
+            continue
+        op, heap_num, args = m.group(1), m.group(2), m.group(3).split()
+        try:
+            if op == "h":
+                num = int(heap_num)
+                if num == 0:
+                    # A new boot
+                    heaps = {}
+                    dropped = 0
+                    marks = {}
+                heaps[num] = Heap(num, int(args[0], 16), int(args[1], 16))
+            elif op == "m":
+                last_mark = args[1] if len(args) > 1 else ""
+                marks[last_mark] = marks.get(last_mark, 0) + 1
+            elif op == "d":
+                dropped += int(args[0])
+            elif op == "s":
+                heap = heaps.get(int(args[1]))
+                if heap:
+                    device = tuple(int(a) for a in args[2:5])
+                    heap.sample(int(args[0]), last_mark, device, bins)
+            else:
+                heap = heaps.get(int(heap_num))
+                if heap is None:
+                    continue
+                if op == "f":
+                    heap.free(int(args[0], 16))
+                else:
+                    heap.alloc(int(args[0], 16), int(args[1], 16), int(args[2], 16))
+        except (IndexError, ValueError):
+            # A line broken by other output or by a reset
+            continue
+
+    return heaps, dropped, marks
+
+
+# ---------------------------------------------------------------------------
+# Outputs
+# ---------------------------------------------------------------------------
+
+def write_png(path, width, height, pixels):
+    """Writes RGB rows (bytearrays of width * 3) as a PNG without other libraries"""
+    def chunk(kind, data):
+        return struct.pack(">I", len(data)) + kind + data + struct.pack(">I", zlib.crc32(kind + data) & 0xFFFFFFFF)
+
+    raw = b"".join(b"\x00" + bytes(row) for row in pixels)
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+def render(heap, bins):
+    samples = heap.samples
+    step = max(1, (len(samples) + MAX_ROWS - 1) // MAX_ROWS)
+    width = bins + PANEL_GAP + PANEL_WIDTH
+    rows = []
+    for s in samples[::step]:
+        row = bytearray(b"\xff" * (width * 3))
+        for x, occ in enumerate(s["row"]):
+            g = 255 - int(occ * 255)
+            row[x * 3:x * 3 + 3] = bytes((g, g, g))
+        panel = (bins + PANEL_GAP) * 3
+        row[panel:panel + PANEL_WIDTH * 3] = b"\xf0" * (PANEL_WIDTH * 3)
+        used = (heap.size - s["free"]) * 100 // heap.size
+        row[panel + used * 3:panel + used * 3 + 3] = b"\x00\x00\xff"
+        row[panel + s["frag"] * 3:panel + s["frag"] * 3 + 3] = b"\xff\x00\x00"
+        rows.append(row)
+    return width, rows
+
+
+def write_csv(path, heaps):
+    with open(path, "w") as f:
+        f.write("ms,heap,mark,live_bytes,live_blocks,free,biggest,frag,dev_free,dev_biggest,dev_frag\n")
+        samples = [(s["ms"], h.num, s) for h in heaps.values() for s in h.samples]
+        for ms, num, s in sorted(samples, key=lambda x: (x[0], x[1])):
+            f.write("%d,%s,%s,%d,%d,%d,%d,%d,%d,%d,%d\n" % (
+                ms, HEAP_NAMES.get(num, num), s["mark"], s["live"], s["blocks"], s["free"], s["biggest"],
+                s["frag"], *s["device"]))
+
+
+def resolve(addrs, elf, addr2line):
+    """Function and line of the callers, the address itself without an ELF file"""
+    names = {a: "0x%08x" % a for a in addrs}
+    if not elf or not addrs:
+        return names
+    addrs = sorted(addrs)
+    try:
+        out = subprocess.run([addr2line, "-pfC", "-e", elf] + ["0x%x" % a for a in addrs],
+                             capture_output=True, text=True, check=True).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("heap_trace: can't run %s: %s" % (addr2line, e), file=sys.stderr)
+        return names
+    for a, line in zip(addrs, out):
+        names[a] = "0x%08x %s" % (a, line.strip())
+    return names
+
+
+def summary(heaps, dropped, marks, elf, addr2line):
+    print("heap_trace: %d events dropped by the device" % dropped)
+    if marks:
+        print("heap_trace: marks " + ", ".join("%s %d" % m for m in sorted(marks.items())))
+
+    growth = {}
+    for heap in heaps.values():
+        first = heap.first_callers or {}
+        for caller, size in heap.callers().items():
+            grown = size - first.get(caller, 0)
+            if grown > 0:
+                growth[(heap.num, caller)] = grown
+    top = sorted(growth.items(), key=lambda x: -x[1])[:TOP_CALLERS]
+    names = resolve({caller for (_, caller), _ in top}, elf, addr2line)
+
+    for heap in heaps.values():
+        name = HEAP_NAMES.get(heap.num, str(heap.num))
+        print("%s: %d bytes at 0x%08x, %d events, %d failed, %d unknown frees, %d outside" % (
+            name, heap.size, heap.base, heap.events, heap.failed, heap.unknown_frees, heap.outside))
+        if not heap.samples:
+            continue
+        end = heap.samples[-1]
+        print("%s: peak %d bytes, end %d bytes in %d blocks, max frag %d%%, end frag %d%% (device %d%%)" % (
+            name, heap.max_live, end["live"], end["blocks"], max(s["frag"] for s in heap.samples), end["frag"],
+            end["device"][2]))
+        for (num, caller), grown in top:
+            if num == heap.num:
+                print("%s:   +%6d bytes  %s" % (name, grown, names[caller]))
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Replay the heap trace of the firmware")
+    parser.add_argument("log", nargs="?", help="serial log, stdin by default")
+    parser.add_argument("-o", "--out", default="heap_trace", help="prefix of the output files")
+    parser.add_argument("--elf", help="firmware ELF file to resolve the callers")
+    parser.add_argument("--addr2line", default="xtensa-lx106-elf-addr2line", help="addr2line of the toolchain")
+    parser.add_argument("--width", type=int, default=512, help="address bins of the pictures")
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, errors="replace") as f:
+            heaps, dropped, marks = replay(f, args.width)
+    else:
+        heaps, dropped, marks = replay(sys.stdin, args.width)
+
+    if not heaps:
+        print("heap_trace: no @h lines, was the firmware built with HEAP_TRACE?", file=sys.stderr)
+        return 1
+
+    for heap in heaps.values():
+        if heap.samples:
+            width, rows = render(heap, args.width)
+            write_png("%s_heap%d.png" % (args.out, heap.num), width, len(rows), rows)
+    write_csv(args.out + ".csv", heaps)
+    summary(heaps, dropped, marks, args.elf, args.addr2line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())